@@ -63,14 +63,17 @@ struct evt_options {
 	uint8_t timdev_cnt;
 	uint8_t nb_timer_adptrs;
 	uint8_t timdev_use_burst;
+	uint8_t timdev_use_wheel;
 	uint8_t per_port_pool;
 	uint8_t preschedule;
 	uint8_t preschedule_opted;
+	uint8_t dump_xstats;
 	uint8_t sched_type_list[EVT_MAX_STAGES];
 	uint16_t mbuf_sz;
 	uint16_t wkr_deq_dep;
 	uint16_t vector_size;
 	uint16_t eth_queues;
+	uint16_t timdev_churn;
 	uint16_t crypto_cipher_iv_sz;
 	uint32_t nb_flows;
 	uint32_t tx_first;
@@ -172,6 +175,43 @@ evt_service_setup(uint32_t service_id)
 	return 0;
 }
 
+/*
+ * Map the event device scheduler service, and any sibling scheduler service
+ * the driver registered as "<service name>_<n>", to the service lcores.
+ * Returns the number of scheduler services mapped or a negative value.
+ */
+static inline int
+evt_sched_service_setup(uint8_t dev_id)
+{
+	char name[RTE_SERVICE_NAME_MAX];
+	uint32_t service_id;
+	const char *base;
+	int nb_services;
+	int ret;
+
+	ret = rte_event_dev_service_id_get(dev_id, &service_id);
+	if (ret)
+		return ret;
+	ret = evt_service_setup(service_id);
+	if (ret)
+		return ret;
+
+	base = rte_service_get_name(service_id);
+	if (base == NULL)
+		return 1;
+
+	for (nb_services = 1; ; nb_services++) {
+		snprintf(name, sizeof(name), "%s_%d", base, nb_services);
+		if (rte_service_get_by_name(name, &service_id))
+			break;
+		ret = evt_service_setup(service_id);
+		if (ret)
+			return ret;
+	}
+
+	return nb_services;
+}
+
 static inline int
 evt_configure_eventdev(struct evt_options *opt, uint8_t nb_queues,
 		uint8_t nb_ports)
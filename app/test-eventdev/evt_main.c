@@ -2,6 +2,7 @@
  * Copyright(c) 2017 Cavium, Inc
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -29,6 +30,59 @@ signal_handler(int signum)
 	}
 }
 
+static void
+evt_xstats_dump_mode(uint8_t dev_id, enum rte_event_dev_xstats_mode mode,
+		     uint8_t queue_port_id)
+{
+	struct rte_event_dev_xstats_name *names;
+	uint64_t *ids, *values;
+	int nb_xstats, i;
+
+	nb_xstats = rte_event_dev_xstats_names_get(dev_id, mode, queue_port_id,
+						   NULL, NULL, 0);
+	if (nb_xstats <= 0)
+		return;
+
+	names = calloc(nb_xstats, sizeof(*names));
+	ids = calloc(nb_xstats, sizeof(*ids));
+	values = calloc(nb_xstats, sizeof(*values));
+	if (names == NULL || ids == NULL || values == NULL)
+		goto free;
+
+	nb_xstats = rte_event_dev_xstats_names_get(dev_id, mode, queue_port_id,
+						   names, ids, nb_xstats);
+	if (nb_xstats <= 0)
+		goto free;
+
+	nb_xstats = rte_event_dev_xstats_get(dev_id, mode, queue_port_id, ids,
+					     values, nb_xstats);
+
+	for (i = 0; i < nb_xstats; i++)
+		printf("%s: %"PRIu64"\n", names[i].name, values[i]);
+
+free:
+	free(names);
+	free(ids);
+	free(values);
+}
+
+static void
+evt_xstats_dump(struct evt_options *opts)
+{
+	uint32_t nb_ports = 0;
+	uint32_t port_id;
+
+	printf("Event device %d xstats:\n", opts->dev_id);
+
+	evt_xstats_dump_mode(opts->dev_id, RTE_EVENT_DEV_XSTATS_DEVICE, 0);
+
+	rte_event_dev_attr_get(opts->dev_id, RTE_EVENT_DEV_ATTR_PORT_COUNT,
+			       &nb_ports);
+	for (port_id = 0; port_id < nb_ports; port_id++)
+		evt_xstats_dump_mode(opts->dev_id, RTE_EVENT_DEV_XSTATS_PORT,
+				     port_id);
+}
+
 static inline void
 evt_options_dump_all(struct evt_test *test, struct evt_options *opts)
 {
@@ -170,6 +224,9 @@ main(int argc, char **argv)
 	if (test->ops.test_result)
 		test->ops.test_result(test, &opt);
 
+	if (opt.dump_xstats)
+		evt_xstats_dump(&opt);
+
 	if (test->ops.ethdev_destroy)
 		test->ops.ethdev_destroy(test, &opt);
 
@@ -157,6 +157,23 @@ evt_parse_timer_prod_type_burst(struct evt_options *opt,
 	return 0;
 }
 
+static int
+evt_parse_timdev_wheel(struct evt_options *opt, const char *arg __rte_unused)
+{
+	opt->timdev_use_wheel = 1;
+	return 0;
+}
+
+static int
+evt_parse_timdev_churn(struct evt_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint16(&(opt->timdev_churn), arg);
+
+	return ret;
+}
+
 static int
 evt_parse_dma_prod_type(struct evt_options *opt,
 			   const char *arg __rte_unused)
@@ -457,6 +474,13 @@ evt_parse_per_port_pool(struct evt_options *opt, const char *arg __rte_unused)
 	return 0;
 }
 
+static int
+evt_parse_dump_xstats(struct evt_options *opt, const char *arg __rte_unused)
+{
+	opt->dump_xstats = 1;
+	return 0;
+}
+
 static int
 evt_parse_prod_enq_burst_sz(struct evt_options *opt, const char *arg)
 {
@@ -494,6 +518,11 @@ usage(char *program)
 		"\t                     in ns.\n"
 		"\t--prod_type_timerdev_burst : use timer device as producer\n"
 		"\t                             burst mode.\n"
+		"\t--timdev_wheel     : use the timing wheel software timer\n"
+		"\t                     adapter.\n"
+		"\t--timdev_churn     : number of session timer bursts armed\n"
+		"\t                     and cancelled per timer burst, in\n"
+		"\t                     timer adapter burst mode.\n"
 		"\t--nb_timers        : number of timers to arm.\n"
 		"\t--nb_timer_adptrs  : number of timer adapters to use.\n"
 		"\t--timer_tick_nsec  : timer tick interval in ns.\n"
@@ -525,6 +554,8 @@ usage(char *program)
 		"                       0 - disable pre-schedule\n"
 		"                       1 - pre-schedule\n"
 		"                       2 - pre-schedule adaptive (Default)\n"
+		"\t--dump_xstats      : Dump event device and port xstats\n"
+		"                       at the end of the test.\n"
 		);
 	printf("available tests:\n");
 	evt_test_dump_names();
@@ -591,6 +622,8 @@ static struct option lgopts[] = {
 	{ EVT_PROD_CRYPTODEV,      0, 0, 0 },
 	{ EVT_PROD_TIMERDEV,       0, 0, 0 },
 	{ EVT_PROD_TIMERDEV_BURST, 0, 0, 0 },
+	{ EVT_TIMDEV_WHEEL,        0, 0, 0 },
+	{ EVT_TIMDEV_CHURN,        1, 0, 0 },
 	{ EVT_DMA_ADPTR_MODE,      1, 0, 0 },
 	{ EVT_CRYPTO_ADPTR_MODE,   1, 0, 0 },
 	{ EVT_CRYPTO_OP_TYPE,	   1, 0, 0 },
@@ -614,6 +647,7 @@ static struct option lgopts[] = {
 	{ EVT_TX_FIRST,            1, 0, 0 },
 	{ EVT_TX_PKT_SZ,           1, 0, 0 },
 	{ EVT_PRESCHEDULE,         1, 0, 0 },
+	{ EVT_DUMP_XSTATS,         0, 0, 0 },
 	{ NULL,                    0, 0, 0 }
 };
 
@@ -642,6 +676,8 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_PROD_DMADEV, evt_parse_dma_prod_type},
 		{ EVT_PROD_TIMERDEV, evt_parse_timer_prod_type},
 		{ EVT_PROD_TIMERDEV_BURST, evt_parse_timer_prod_type_burst},
+		{ EVT_TIMDEV_WHEEL, evt_parse_timdev_wheel},
+		{ EVT_TIMDEV_CHURN, evt_parse_timdev_churn},
 		{ EVT_DMA_ADPTR_MODE, evt_parse_dma_adptr_mode},
 		{ EVT_CRYPTO_ADPTR_MODE, evt_parse_crypto_adptr_mode},
 		{ EVT_CRYPTO_OP_TYPE, evt_parse_crypto_op_type},
@@ -664,6 +700,7 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_TX_FIRST, evt_parse_tx_first},
 		{ EVT_TX_PKT_SZ, evt_parse_tx_pkt_sz},
 		{ EVT_PRESCHEDULE, evt_parse_preschedule},
+		{ EVT_DUMP_XSTATS, evt_parse_dump_xstats},
 	};
 
 	for (i = 0; i < RTE_DIM(parsermap); i++) {
@@ -38,6 +38,8 @@
 #define EVT_PROD_DMADEV          ("prod_type_dmadev")
 #define EVT_PROD_TIMERDEV        ("prod_type_timerdev")
 #define EVT_PROD_TIMERDEV_BURST  ("prod_type_timerdev_burst")
+#define EVT_TIMDEV_WHEEL         ("timdev_wheel")
+#define EVT_TIMDEV_CHURN         ("timdev_churn")
 #define EVT_DMA_ADPTR_MODE       ("dma_adptr_mode")
 #define EVT_CRYPTO_ADPTR_MODE	 ("crypto_adptr_mode")
 #define EVT_CRYPTO_OP_TYPE	 ("crypto_op_type")
@@ -60,6 +62,7 @@
 #define EVT_TX_FIRST		 ("tx_first")
 #define EVT_TX_PKT_SZ		 ("tx_pkt_sz")
 #define EVT_PRESCHEDULE          ("preschedule")
+#define EVT_DUMP_XSTATS          ("dump_xstats")
 #define EVT_HELP                 ("help")
 
 void evt_options_default(struct evt_options *opt);
@@ -295,6 +298,10 @@ evt_dump_producer_type(struct evt_options *opt)
 			snprintf(name, EVT_PROD_MAX_NAME_LEN,
 				"Event timer adapter producer");
 		evt_dump("nb_timer_adapters", "%d", opt->nb_timer_adptrs);
+		evt_dump("timer_adapter_wheel", "%s",
+			 opt->timdev_use_wheel ? "true" : "false");
+		if (opt->timdev_churn)
+			evt_dump("timdev_churn", "%d", opt->timdev_churn);
 		evt_dump("max_tmo_nsec", "%"PRIu64"", opt->max_tmo_nsec);
 		evt_dump("expiry_nsec", "%"PRIu64"", opt->expiry_nsec);
 		if (opt->optm_timer_tick_nsec)
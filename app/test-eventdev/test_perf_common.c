@@ -301,6 +301,24 @@ perf_event_timer_producer(void *arg)
 	return 0;
 }
 
+static inline uint32_t
+perf_event_timer_churn(struct rte_event_timer_adapter *adptr,
+		       struct rte_event_timer **sess, uint64_t timeout_ticks,
+		       uint16_t nb_bursts)
+{
+	uint32_t churned = 0;
+	uint16_t i, armed;
+
+	/* Session timers refreshed before expiry: arm then cancel. */
+	for (i = 0; i < nb_bursts; i++) {
+		armed = rte_event_timer_arm_tmo_tick_burst(adptr, sess,
+				timeout_ticks, BURST_SIZE);
+		churned += rte_event_timer_cancel_burst(adptr, sess, armed);
+	}
+
+	return churned;
+}
+
 static inline int
 perf_event_timer_producer_burst(void *arg)
 {
@@ -319,6 +337,12 @@ perf_event_timer_producer_burst(void *arg)
 	struct rte_event_timer_adapter **adptr = t->timer_adptr;
 	struct rte_event_timer tim;
 	uint64_t timeout_ticks = opt->expiry_nsec / opt->timer_tick_nsec;
+	const uint16_t nb_churn = opt->timdev_churn;
+	struct rte_event_timer sess_tim[BURST_SIZE];
+	struct rte_event_timer *sess[BURST_SIZE];
+	uint64_t churn_cycles = 0;
+	uint64_t churn_count = 0;
+	uint64_t start;
 
 	memset(&tim, 0, sizeof(struct rte_event_timer));
 	timeout_ticks =
@@ -335,6 +359,11 @@ perf_event_timer_producer_burst(void *arg)
 	tim.state = RTE_EVENT_TIMER_NOT_ARMED;
 	tim.timeout_ticks = timeout_ticks;
 
+	for (i = 0; i < BURST_SIZE; i++) {
+		sess_tim[i] = tim;
+		sess[i] = &sess_tim[i];
+	}
+
 	if (opt->verbose_level > 1)
 		printf("%s(): lcore %d\n", __func__, rte_lcore_id());
 
@@ -355,6 +384,14 @@ perf_event_timer_producer_burst(void *arg)
 				BURST_SIZE);
 		arm_latency += rte_get_timer_cycles() - m[i - 1]->timestamp;
 		count += BURST_SIZE;
+
+		if (nb_churn) {
+			start = rte_get_timer_cycles();
+			churn_count += perf_event_timer_churn(
+					adptr[flow_counter % nb_timer_adptrs],
+					sess, tim.timeout_ticks, nb_churn);
+			churn_cycles += rte_get_timer_cycles() - start;
+		}
 	}
 	fflush(stdout);
 	rte_delay_ms(1000);
@@ -362,6 +399,12 @@ perf_event_timer_producer_burst(void *arg)
 			__func__, rte_lcore_id(),
 			count ? (float)(arm_latency / count) /
 			(rte_get_timer_hz() / 1000000) : 0);
+	if (nb_churn)
+		printf("%s(): lcore %d Session timers churned %"PRIu64
+				", average arm+cancel cost = %.3f us\n",
+				__func__, rte_lcore_id(), churn_count,
+				churn_count ? (float)churn_cycles / churn_count /
+				(rte_get_timer_hz() / 1000000) : 0);
 	return 0;
 }
 
@@ -1067,6 +1110,10 @@ perf_launch_lcores(struct evt_test *test, struct evt_options *opt,
 		}
 	}
 	printf("\n");
+	if (t->nb_sched_services > 0 && samples > 0)
+		printf("Scheduler services: %u, avg %.3f mpps per scheduler service\n",
+		       t->nb_sched_services,
+		       total_mpps / samples / t->nb_sched_services);
 	return 0;
 }
 
@@ -1135,6 +1182,8 @@ perf_event_timer_adapter_setup(struct test_perf *t)
 
 	if (nb_producers == 1)
 		flags |= RTE_EVENT_TIMER_ADAPTER_F_SP_PUT;
+	if (t->opt->timdev_use_wheel)
+		flags |= RTE_EVENT_TIMER_ADAPTER_F_TIMING_WHEEL;
 
 	for (i = 0; i < t->opt->nb_timer_adptrs; i++) {
 		struct rte_event_timer_adapter_conf config = {
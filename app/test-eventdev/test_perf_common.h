@@ -66,6 +66,8 @@ struct __rte_cache_aligned test_perf {
 	int done;
 	uint64_t outstand_pkts;
 	uint8_t nb_workers;
+	/* Scheduler services of a centralized scheduler, 0 otherwise. */
+	uint8_t nb_sched_services;
 	enum evt_test_result result;
 	uint32_t nb_flows;
 	uint64_t nb_pkts;
@@ -13,6 +13,7 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
+#include <rte_bitops.h>
 #include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_ip.h>
@@ -36,6 +37,20 @@
 #define	DEF_TUPLES_NUM	0x100000
 #define BURST_SZ_MAX	64
 
+enum {
+	SAD_LAYOUT_DEFAULT,
+	SAD_LAYOUT_COMBINED,
+	SAD_LAYOUT_NUM,
+};
+
+static const struct {
+	const char	*name;
+	uint32_t	flags;
+} sad_layouts[SAD_LAYOUT_NUM] = {
+	[SAD_LAYOUT_DEFAULT] = { "default", 0 },
+	[SAD_LAYOUT_COMBINED] = { "combined", RTE_IPSEC_SAD_FLAG_COMBINED },
+};
+
 static struct {
 	const char	*prgname;
 	const char	*rules_file;
@@ -55,6 +70,7 @@ static struct {
 	int		verbose;
 	int		parallel_lookup;
 	int		concurrent_rw;
+	uint32_t	layouts;
 } config = {
 	.rules_file = NULL,
 	.tuples_file = NULL,
@@ -72,7 +88,8 @@ static struct {
 	.ipv6 = 0,
 	.verbose = 0,
 	.parallel_lookup = 0,
-	.concurrent_rw = 0
+	.concurrent_rw = 0,
+	.layouts = RTE_BIT32(SAD_LAYOUT_DEFAULT)
 };
 
 enum {
@@ -148,7 +165,8 @@ print_usage(void)
 		"[-b <lookup burst size: 1-64 >]\n"
 		"[-v <verbose, print results on lookup>]\n"
 		"[-p <parallel lookup on all available cores>]\n"
-		"[-c <init sad supporting read/write concurrency>]\n",
+		"[-c <init sad supporting read/write concurrency>]\n"
+		"[-m <sad layout: default | combined | all>]\n",
 		config.prgname);
 
 }
@@ -350,13 +368,33 @@ tbl_init(struct rule **tbl, uint32_t *n_entries,
 		fclose(f);
 }
 
+static int
+parse_layout(const char *in)
+{
+	uint32_t i;
+
+	if (strcmp(in, "all") == 0) {
+		config.layouts = RTE_BIT32(SAD_LAYOUT_NUM) - 1;
+		return 0;
+	}
+
+	for (i = 0; i != SAD_LAYOUT_NUM; i++) {
+		if (strcmp(in, sad_layouts[i].name) == 0) {
+			config.layouts = RTE_BIT32(i);
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
 static void
 parse_opts(int argc, char **argv)
 {
 	int opt, ret;
 	char *endptr;
 
-	while ((opt = getopt(argc, argv, "f:t:n:d:l:r:6b:vpc")) != -1) {
+	while ((opt = getopt(argc, argv, "f:t:n:d:l:r:6b:vpcm:")) != -1) {
 		switch (opt) {
 		case 'f':
 			config.rules_file = optarg;
@@ -421,6 +459,13 @@ parse_opts(int argc, char **argv)
 		case 'c':
 			config.concurrent_rw = 1;
 			break;
+		case 'm':
+			ret = parse_layout(optarg);
+			if (ret != 0) {
+				print_usage();
+				rte_exit(-EINVAL, "Invalid option -m\n");
+			}
+			break;
 		default:
 			print_usage();
 			rte_exit(-EINVAL, "Invalid options\n");
@@ -616,6 +661,7 @@ main(int argc, char **argv)
 	struct rte_ipsec_sad *sad;
 	struct rte_ipsec_sad_conf conf = {0};
 	unsigned int lcore_id;
+	uint32_t i;
 
 	ret = rte_eal_init(argc, argv);
 	if (ret < 0)
@@ -646,23 +692,33 @@ main(int argc, char **argv)
 		conf.flags |= RTE_IPSEC_SAD_FLAG_IPV6;
 	if (config.concurrent_rw)
 		conf.flags |= RTE_IPSEC_SAD_FLAG_RW_CONCURRENCY;
-	sad = rte_ipsec_sad_create("test", &conf);
-	if (sad == NULL)
-		rte_exit(-rte_errno, "can not allocate SAD table\n");
 
 	print_config();
 
-	add_rules(sad, 10);
-	if (config.parallel_lookup)
-		rte_eal_mp_remote_launch(lookup, sad, SKIP_MAIN);
-
-	lookup(sad);
-	if (config.parallel_lookup)
-		RTE_LCORE_FOREACH_WORKER(lcore_id)
-			if (rte_eal_wait_lcore(lcore_id) < 0)
-				return -1;
-
-	del_rules(sad, 10);
+	for (i = 0; i != SAD_LAYOUT_NUM; i++) {
+		if ((config.layouts & RTE_BIT32(i)) == 0)
+			continue;
+
+		printf("\nSAD layout: %s\n", sad_layouts[i].name);
+		conf.flags &= ~RTE_IPSEC_SAD_FLAG_COMBINED;
+		conf.flags |= sad_layouts[i].flags;
+		sad = rte_ipsec_sad_create("test", &conf);
+		if (sad == NULL)
+			rte_exit(-rte_errno, "can not allocate SAD table\n");
+
+		add_rules(sad, 10);
+		if (config.parallel_lookup)
+			rte_eal_mp_remote_launch(lookup, sad, SKIP_MAIN);
+
+		lookup(sad);
+		if (config.parallel_lookup)
+			RTE_LCORE_FOREACH_WORKER(lcore_id)
+				if (rte_eal_wait_lcore(lcore_id) < 0)
+					return -1;
+
+		del_rules(sad, 10);
+		rte_ipsec_sad_destroy(sad);
+	}
 
 	return 0;
 }
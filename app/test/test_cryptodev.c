@@ -17718,6 +17718,33 @@ test_scheduler_mode_pkt_size_distr_op(void)
 	return 0;
 }
 
+static int
+test_scheduler_mode_cost_model_op(void)
+{
+	struct crypto_testsuite_params *ts_params = &testsuite_params;
+	struct rte_cryptodev_scheduler_cost_model_option option = {0};
+	uint8_t sched_id = ts_params->valid_devs[0];
+
+	TEST_ASSERT(test_scheduler_mode_op(CDEV_SCHED_MODE_COST_MODEL) ==
+			0, "Failed to set cost model mode");
+
+	option.sticky = 1;
+	TEST_ASSERT_SUCCESS(rte_cryptodev_scheduler_option_set(sched_id,
+			CDEV_SCHED_OPTION_COST_MODEL, &option),
+			"Failed to set cost model option");
+	memset(&option, 0, sizeof(option));
+	TEST_ASSERT_SUCCESS(rte_cryptodev_scheduler_option_get(sched_id,
+			CDEV_SCHED_OPTION_COST_MODEL, &option),
+			"Failed to get cost model option");
+	TEST_ASSERT_EQUAL(option.sticky, 1, "Sticky option not kept");
+
+	TEST_ASSERT_FAIL(rte_cryptodev_scheduler_option_set(sched_id,
+			CDEV_SCHED_OPTION_THRESHOLD, &option),
+			"Threshold option accepted in cost model mode");
+
+	return 0;
+}
+
 static int
 scheduler_multicore_testsuite_setup(void)
 {
@@ -17758,6 +17785,16 @@ scheduler_pkt_size_distr_testsuite_setup(void)
 	return 0;
 }
 
+static int
+scheduler_cost_model_testsuite_setup(void)
+{
+	if (test_scheduler_attach_worker_op() < 0)
+		return TEST_SKIPPED;
+	if (test_scheduler_mode_op(CDEV_SCHED_MODE_COST_MODEL) < 0)
+		return TEST_SKIPPED;
+	return 0;
+}
+
 static void
 scheduler_mode_testsuite_teardown(void)
 {
@@ -19865,11 +19902,18 @@ test_cryptodev_scheduler(void)
 		.teardown = scheduler_mode_testsuite_teardown,
 		.unit_test_cases = {TEST_CASES_END()}
 	};
+	static struct unit_test_suite scheduler_cost_model = {
+		.suite_name = "Scheduler Cost Model Unit Test Suite",
+		.setup = scheduler_cost_model_testsuite_setup,
+		.teardown = scheduler_mode_testsuite_teardown,
+		.unit_test_cases = {TEST_CASES_END()}
+	};
 	struct unit_test_suite *sched_mode_suites[] = {
 		&scheduler_multicore,
 		&scheduler_round_robin,
 		&scheduler_failover,
-		&scheduler_pkt_size_distr
+		&scheduler_pkt_size_distr,
+		&scheduler_cost_model
 	};
 	static struct unit_test_suite scheduler_config = {
 		.suite_name = "Crypto Device Scheduler Config Unit Test Suite",
@@ -19879,6 +19923,7 @@ test_cryptodev_scheduler(void)
 			TEST_CASE(test_scheduler_mode_roundrobin_op),
 			TEST_CASE(test_scheduler_mode_failover_op),
 			TEST_CASE(test_scheduler_mode_pkt_size_distr_op),
+			TEST_CASE(test_scheduler_mode_cost_model_op),
 			TEST_CASE(test_scheduler_detach_worker_op),
 
 			TEST_CASES_END() /**< NULL terminate array */
@@ -894,6 +894,57 @@ test_basic(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_app_register_matches(struct test_app *app)
+{
+	int i;
+	int rc;
+
+	for (i = 0; i < NUM_QUEUES; i++) {
+		struct app_queue *app_queue = &app->queues[i];
+		struct rte_dispatcher_match match = {
+			.flags = RTE_DISPATCHER_MATCH_QUEUE_ID,
+			.queue_id = app_queue->queue_id
+		};
+		int reg_id;
+
+		rc = test_app_unregister_callback(app, i);
+		if (rc != TEST_SUCCESS)
+			return rc;
+
+		reg_id = rte_dispatcher_register_match(app->dispatcher, &match,
+						       test_app_process_queue,
+						       app_queue);
+
+		TEST_ASSERT(reg_id >= 0, "Unable to register consumer "
+			    "match for queue %d", i);
+
+		app_queue->dispatcher_reg_id = reg_id;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_declarative_match(void)
+{
+	struct rte_dispatcher_match match = {
+		.flags = RTE_DISPATCHER_MATCH_EVENT_TYPE,
+		.event_type = RTE_EVENT_TYPE_MAX
+	};
+	int rc;
+
+	rc = rte_dispatcher_register_match(test_app->dispatcher, &match,
+					   test_app_never_process, NULL);
+	TEST_ASSERT_EQUAL(rc, -EINVAL, "Invalid event type accepted");
+
+	rc = test_app_register_matches(test_app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	return test_basic();
+}
+
 static int
 test_drop(void)
 {
@@ -1039,6 +1090,8 @@ static struct unit_test_suite test_suite = {
 	.unit_test_cases = {
 		TEST_CASE_ST(test_setup, test_teardown, test_basic),
 		TEST_CASE_ST(test_setup, test_teardown, test_drop),
+		TEST_CASE_ST(test_setup, test_teardown,
+			     test_declarative_match),
 		TEST_CASE_ST(test_setup, test_teardown,
 			     test_many_handler_registrations),
 		TEST_CASE_ST(test_setup, test_teardown,
@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_dispatcher.h>
+#include <rte_eventdev.h>
+#include <rte_random.h>
+#include <rte_service.h>
+
+#include "test.h"
+
+/*
+ * Dispatcher performance test, comparing the cost of delivering events
+ * to handlers selected by match callbacks and by declarative matches.
+ *
+ * Events are dequeued from a single DSW event port by the dispatcher
+ * service, run on the main lcore. Each handler is selected by one sub
+ * event type, and events are spread evenly over the handlers.
+ */
+
+#define DSW_VDEV "event_dsw0"
+
+#define QUEUE_ID 0
+#define PORT_ID 0
+#define MAX_EVENTS 4096
+#define BURST_SIZE 32
+#define NUM_BURSTS 100000
+#define MAX_POLLS 1000
+
+static const uint16_t num_handlers_list[] = { 4, 16, 32 };
+
+struct perf_app {
+	uint8_t event_dev_id;
+	uint64_t processed;
+};
+
+static bool
+match_sub_event_type(const struct rte_event *event, void *cb_data)
+{
+	uintptr_t sub_event_type = (uintptr_t)cb_data;
+
+	return event->sub_event_type == sub_event_type;
+}
+
+static void
+process_events(uint8_t event_dev_id __rte_unused,
+	       uint8_t event_port_id __rte_unused,
+	       struct rte_event *events __rte_unused, uint16_t num,
+	       void *cb_data)
+{
+	struct perf_app *app = cb_data;
+
+	app->processed += num;
+}
+
+static int
+setup_event_dev(struct perf_app *app)
+{
+	int rc;
+
+	rc = rte_vdev_init(DSW_VDEV, NULL);
+	if (rc < 0)
+		return TEST_SKIPPED;
+
+	app->event_dev_id = rte_event_dev_get_dev_id(DSW_VDEV);
+
+	struct rte_event_dev_config config = {
+		.nb_event_queues = 1,
+		.nb_event_ports = 1,
+		.nb_events_limit = MAX_EVENTS,
+		.nb_event_queue_flows = 64,
+		.nb_event_port_dequeue_depth = BURST_SIZE,
+		.nb_event_port_enqueue_depth = BURST_SIZE
+	};
+
+	rc = rte_event_dev_configure(app->event_dev_id, &config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to configure event device");
+
+	struct rte_event_queue_conf queue_config = {
+		.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.schedule_type = RTE_SCHED_TYPE_ATOMIC,
+		.nb_atomic_flows = 64
+	};
+
+	rc = rte_event_queue_setup(app->event_dev_id, QUEUE_ID, &queue_config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to setup queue");
+
+	struct rte_event_port_conf port_config = {
+		.new_event_threshold = MAX_EVENTS,
+		.dequeue_depth = BURST_SIZE,
+		.enqueue_depth = BURST_SIZE
+	};
+
+	rc = rte_event_port_setup(app->event_dev_id, PORT_ID, &port_config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to setup port");
+
+	rc = rte_event_port_link(app->event_dev_id, PORT_ID, NULL, NULL, 0);
+	TEST_ASSERT_EQUAL(rc, 1, "Unable to link port");
+
+	rc = rte_event_dev_start(app->event_dev_id);
+	TEST_ASSERT_SUCCESS(rc, "Unable to start event device");
+
+	return TEST_SUCCESS;
+}
+
+static void
+teardown_event_dev(struct perf_app *app)
+{
+	rte_event_dev_stop(app->event_dev_id);
+	rte_event_dev_close(app->event_dev_id);
+	rte_vdev_uninit(DSW_VDEV);
+}
+
+static int
+register_handlers(struct rte_dispatcher *dispatcher, struct perf_app *app,
+		  uint16_t num_handlers, bool declarative)
+{
+	uint16_t i;
+	int rc;
+
+	for (i = 0; i < num_handlers; i++) {
+		if (declarative) {
+			struct rte_dispatcher_match match = {
+				.flags = RTE_DISPATCHER_MATCH_QUEUE_ID |
+					RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE,
+				.queue_id = QUEUE_ID,
+				.sub_event_type = i
+			};
+
+			rc = rte_dispatcher_register_match(dispatcher, &match,
+							   process_events,
+							   app);
+		} else {
+			rc = rte_dispatcher_register(dispatcher,
+						     match_sub_event_type,
+						     (void *)(uintptr_t)i,
+						     process_events, app);
+		}
+
+		TEST_ASSERT(rc >= 0, "Unable to register handler %u", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+measure_dispatch(struct perf_app *app, uint16_t num_handlers, bool declarative)
+{
+	struct rte_event events[BURST_SIZE];
+	struct rte_dispatcher *dispatcher;
+	uint64_t cycles = 0;
+	uint32_t service_id;
+	unsigned int i;
+	int rc;
+
+	dispatcher = rte_dispatcher_create(app->event_dev_id);
+	TEST_ASSERT(dispatcher != NULL, "Unable to create dispatcher");
+
+	service_id = rte_dispatcher_service_id_get(dispatcher);
+
+	rc = register_handlers(dispatcher, app, num_handlers, declarative);
+	if (rc != TEST_SUCCESS)
+		goto out;
+
+	rc = rte_dispatcher_bind_port_to_lcore(dispatcher, PORT_ID, BURST_SIZE,
+					       0, rte_lcore_id());
+	TEST_ASSERT_SUCCESS(rc, "Unable to bind port");
+
+	rte_service_runstate_set(service_id, 1);
+	rte_dispatcher_start(dispatcher);
+
+	app->processed = 0;
+
+	for (i = 0; i < NUM_BURSTS; i++) {
+		uint64_t expected = app->processed + BURST_SIZE;
+		uint16_t enqueued = 0;
+		unsigned int polls = 0;
+		uint16_t j;
+
+		for (j = 0; j < BURST_SIZE; j++)
+			events[j] = (struct rte_event) {
+				.queue_id = QUEUE_ID,
+				.op = RTE_EVENT_OP_NEW,
+				.sched_type = RTE_SCHED_TYPE_ATOMIC,
+				.flow_id = rte_rand_max(64),
+				.event_type = RTE_EVENT_TYPE_CPU,
+				.sub_event_type = rte_rand_max(num_handlers)
+			};
+
+		while (enqueued < BURST_SIZE)
+			enqueued += rte_event_enqueue_new_burst(app->event_dev_id,
+					PORT_ID, events + enqueued,
+					BURST_SIZE - enqueued);
+
+		while (app->processed < expected && polls++ < MAX_POLLS) {
+			uint64_t start = rte_rdtsc_precise();
+
+			rte_service_run_iter_on_app_lcore(service_id, 1);
+			cycles += rte_rdtsc_precise() - start;
+		}
+	}
+
+	printf("%-12s %3u handlers: %8.2f cycles/event\n",
+	       declarative ? "declarative" : "callback", num_handlers,
+	       app->processed ? (double)cycles / app->processed : 0);
+
+	rte_dispatcher_stop(dispatcher);
+	rte_service_runstate_set(service_id, 0);
+	rte_dispatcher_unbind_port_from_lcore(dispatcher, PORT_ID,
+					      rte_lcore_id());
+
+	rc = app->processed == (uint64_t)NUM_BURSTS * BURST_SIZE ?
+		TEST_SUCCESS : TEST_FAILED;
+	if (rc != TEST_SUCCESS)
+		printf("Only %"PRIu64" events were dispatched\n",
+		       app->processed);
+
+out:
+	rte_dispatcher_free(dispatcher);
+
+	return rc;
+}
+
+static int
+test_dispatcher_perf(void)
+{
+	struct perf_app app = { 0 };
+	unsigned int i;
+	int rc;
+
+	rc = setup_event_dev(&app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	for (i = 0; i < RTE_DIM(num_handlers_list) && rc == TEST_SUCCESS;
+	     i++) {
+		rc = measure_dispatch(&app, num_handlers_list[i], false);
+		if (rc == TEST_SUCCESS)
+			rc = measure_dispatch(&app, num_handlers_list[i], true);
+	}
+
+	teardown_event_dev(&app);
+
+	return rc;
+}
+
+REGISTER_PERF_TEST(dispatcher_perf_autotest, test_dispatcher_perf);
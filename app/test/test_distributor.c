@@ -825,7 +825,8 @@ test_distributor(void)
 {
 	static struct rte_distributor *ds;
 	static struct rte_distributor *db;
-	static struct rte_distributor *dist[2];
+	static struct rte_distributor *dh;
+	static struct rte_distributor *dist[3];
 	static struct rte_mempool *p;
 	int i;
 
@@ -859,6 +860,19 @@ test_distributor(void)
 		rte_distributor_clear_returns(db);
 	}
 
+	if (dh == NULL) {
+		dh = rte_distributor_create("Test_dist_burst_hash", rte_socket_id(),
+				rte_lcore_count() - 1,
+				RTE_DIST_ALG_BURST_HASH);
+		if (dh == NULL) {
+			printf("Error creating burst hash distributor\n");
+			return -1;
+		}
+	} else {
+		rte_distributor_flush(dh);
+		rte_distributor_clear_returns(dh);
+	}
+
 	if (ds == NULL) {
 		ds = rte_distributor_create("Test_dist_single",
 				rte_socket_id(),
@@ -886,11 +900,15 @@ test_distributor(void)
 
 	dist[0] = ds;
 	dist[1] = db;
+	dist[2] = dh;
 
-	for (i = 0; i < 2; i++) {
+	for (i = 0; i < 3; i++) {
 
 		worker_params.dist = dist[i];
-		if (i)
+		if (i == 2)
+			strlcpy(worker_params.name, "burst hash",
+					sizeof(worker_params.name));
+		else if (i)
 			strlcpy(worker_params.name, "burst",
 					sizeof(worker_params.name));
 		else
@@ -23,11 +23,16 @@ test_distributor_perf(void)
 
 #include <rte_distributor.h>
 #include <rte_pause.h>
+#include <rte_random.h>
+#include <rte_vect.h>
 
 #define ITER_POWER_CL 25 /* log 2 of how many iterations  for Cache Line test */
 #define ITER_POWER 21 /* log 2 of how many iterations we do when timing. */
 #define BURST 64
 #define BIG_BATCH 1024
+#define SCALING_ITER_POWER 16 /* log 2 of how many bursts for scaling test */
+#define SCALING_BATCHES 16 /* bursts of different flows sent in turn */
+#define SCALING_MAX_WORKERS 32
 
 /* static vars - zero initialized by default */
 static volatile int quit;
@@ -185,6 +190,164 @@ perf_test(struct rte_distributor *d, struct rte_mempool *p)
 	return 0;
 }
 
+struct emulated_workers {
+	struct rte_distributor *d;
+	unsigned int nb_workers;
+};
+
+static RTE_ATOMIC(unsigned int) emulators_done;
+
+/*
+ * Worker function standing for several distributor workers, so that the
+ * scaling of the distributor can be measured with more workers than lcores.
+ * Each worker is polled in turn, and requests packets again as soon as it
+ * got a burst.
+ */
+static int
+handle_work_emulated(void *arg)
+{
+	struct emulated_workers *ew = arg;
+	const unsigned int nb_lcores = rte_lcore_count() - 1;
+	struct rte_mbuf *buf[SCALING_MAX_WORKERS][8];
+	unsigned int id, idx;
+	int num;
+
+	idx = rte_atomic_fetch_add_explicit(&worker_idx, 1, rte_memory_order_relaxed);
+
+	for (id = idx; id < ew->nb_workers; id += nb_lcores)
+		rte_distributor_request_pkt(ew->d, id, NULL, 0);
+
+	while (!quit) {
+		for (id = idx; id < ew->nb_workers; id += nb_lcores) {
+			num = rte_distributor_poll_pkt(ew->d, id, buf[id]);
+			if (num < 0)
+				continue;
+			worker_stats[idx].handled_packets += num;
+			rte_distributor_request_pkt(ew->d, id, buf[id], num);
+		}
+	}
+
+	for (id = idx; id < ew->nb_workers; id += nb_lcores)
+		rte_distributor_return_pkt(ew->d, id, NULL, 0);
+
+	rte_atomic_fetch_add_explicit(&emulators_done, 1, rte_memory_order_release);
+	return 0;
+}
+
+/*
+ * Time the distributor core with packets of random flows, for a given number
+ * of workers, returning the cycles per packet.
+ */
+static int
+perf_test_scaling(struct rte_distributor *d, unsigned int nb_workers,
+		struct rte_mempool *p, double *cycles)
+{
+	struct emulated_workers ew = { .d = d, .nb_workers = nb_workers };
+	const unsigned int nb_lcores = rte_lcore_count() - 1;
+	struct rte_mbuf *bufs[SCALING_BATCHES * BURST];
+	uint64_t start, end;
+	unsigned int i;
+
+	clear_packet_count();
+	if (rte_mempool_get_bulk(p, (void *)bufs, RTE_DIM(bufs)) != 0) {
+		printf("Error getting mbufs from pool\n");
+		return -1;
+	}
+	for (i = 0; i < RTE_DIM(bufs); i++)
+		bufs[i]->hash.usr = rte_rand();
+
+	rte_eal_mp_remote_launch(handle_work_emulated, &ew, SKIP_MAIN);
+
+	start = rte_rdtsc();
+	for (i = 0; i < (1 << SCALING_ITER_POWER); i++)
+		rte_distributor_process(d, &bufs[(i % SCALING_BATCHES) * BURST], BURST);
+	end = rte_rdtsc();
+
+	while (total_packet_count() < (BURST << SCALING_ITER_POWER))
+		rte_distributor_process(d, NULL, 0);
+
+	/* Keep handling the requests until all the workers have left */
+	quit = 1;
+	while (rte_atomic_load_explicit(&emulators_done, rte_memory_order_acquire) !=
+			nb_lcores)
+		rte_distributor_process(d, NULL, 0);
+	rte_eal_mp_wait_lcore();
+	rte_distributor_flush(d);
+	rte_distributor_clear_returns(d);
+	rte_atomic_store_explicit(&emulators_done, 0, rte_memory_order_relaxed);
+	quit = 0;
+	worker_idx = 0;
+
+	rte_mempool_put_bulk(p, (void *)bufs, RTE_DIM(bufs));
+
+	*cycles = (double)(end - start) / (BURST << SCALING_ITER_POWER);
+	return 0;
+}
+
+/*
+ * Compare the flow matching of the burst mode, with SSE and AVX512, and the
+ * flow hash mode which does no matching, from 8 to 32 workers.
+ */
+static int
+perf_test_scaling_all(struct rte_mempool *p)
+{
+	static const struct {
+		const char *name;
+		unsigned int alg_type;
+		uint16_t simd_bitwidth;
+	} modes[] = {
+		{ "burst/SSE", RTE_DIST_ALG_BURST, RTE_VECT_SIMD_256 },
+		{ "burst/AVX512", RTE_DIST_ALG_BURST, RTE_VECT_SIMD_512 },
+		{ "burst/hash", RTE_DIST_ALG_BURST_HASH, RTE_VECT_SIMD_256 },
+	};
+	static const unsigned int nb_workers[] = { 8, 16, SCALING_MAX_WORKERS };
+	static struct rte_distributor *d[RTE_DIM(modes)][RTE_DIM(nb_workers)];
+	const uint16_t simd_bitwidth = rte_vect_get_max_simd_bitwidth();
+	char name[RTE_MEMZONE_NAMESIZE];
+	double cycles;
+	unsigned int m, w;
+	int ret = 0;
+
+	/* The pool has at least 2 * BIG_BATCH - 1 mbufs */
+	RTE_BUILD_BUG_ON(SCALING_BATCHES * BURST >= BIG_BATCH * 2);
+
+	printf("=== Scaling test of distributor, %u lcores for the workers ===\n",
+			rte_lcore_count() - 1);
+	printf("%-8s", "workers");
+	for (m = 0; m < RTE_DIM(modes); m++)
+		printf(" %14s", modes[m].name);
+	printf("  (cycles per packet)\n");
+
+	for (w = 0; w < RTE_DIM(nb_workers) && ret == 0; w++) {
+		printf("%-8u", nb_workers[w]);
+		for (m = 0; m < RTE_DIM(modes) && ret == 0; m++) {
+			/* The matching function is picked at creation */
+			if (d[m][w] == NULL) {
+				if (rte_vect_set_max_simd_bitwidth(modes[m].simd_bitwidth) != 0) {
+					printf(" %14s", "n/a");
+					continue;
+				}
+				snprintf(name, sizeof(name), "Test_scale_%u_%u", m, w);
+				d[m][w] = rte_distributor_create(name, rte_socket_id(),
+						nb_workers[w], modes[m].alg_type);
+				rte_vect_set_max_simd_bitwidth(simd_bitwidth);
+				if (d[m][w] == NULL) {
+					printf("\nError creating distributor\n");
+					return -1;
+				}
+			}
+
+			ret = perf_test_scaling(d[m][w], nb_workers[w], p, &cycles);
+			if (ret == 0)
+				printf(" %14.1f", cycles);
+		}
+		printf("\n");
+	}
+	printf("=== Scaling test done ===\n\n");
+
+	return ret;
+}
+
 /* Useful function which ensures that all worker functions terminate */
 static void
 quit_workers(struct rte_distributor *d, struct rte_mempool *p)
@@ -272,6 +435,9 @@ test_distributor_perf(void)
 		return -1;
 	quit_workers(db, p);
 
+	if (perf_test_scaling_all(p) < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -20,6 +20,7 @@ test_efd(void)
 #include <rte_random.h>
 #include <rte_debug.h>
 #include <rte_ip.h>
+#include <rte_rcu_qsbr.h>
 
 #define EFD_TEST_KEY_LEN 8
 #define TABLE_SIZE (1 << 21)
@@ -325,6 +326,112 @@ static int test_five_keys(void)
 	return 0;
 }
 
+/*
+ * Sequence of operations for five keys, with RCU QSBR:
+ *	- associate RCU QSBR variable, again (fail)
+ *	- bulk add and lookup
+ *	- bulk update one key with the same value and the others with new ones
+ *	- lookup, delete
+ */
+static int test_efd_rcu(void)
+{
+	struct rte_efd_rcu_config rcu_cfg = {0};
+	struct rte_efd_table *handle;
+	const void *key_array[5] = {0};
+	efd_value_t result[5] = {0};
+	struct rte_rcu_qsbr *qsv;
+	int status[5];
+	unsigned int i;
+	int ret;
+
+	printf("Entering %s\n", __func__);
+
+	qsv = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_NOT_NULL(qsv, "Error allocating the RCU QSBR variable\n");
+	rte_rcu_qsbr_init(qsv, RTE_MAX_LCORE);
+
+	handle = rte_efd_create("test_efd_rcu", TABLE_SIZE,
+			sizeof(struct flow_key),
+			efd_get_all_sockets_bitmask(), test_socket_id);
+	if (handle == NULL) {
+		rte_free(qsv);
+		printf("Error creating the efd table\n");
+		return -1;
+	}
+
+	rcu_cfg.v = qsv;
+	rcu_cfg.mode = RTE_EFD_QSBR_MODE_DQ;
+	ret = rte_efd_rcu_qsbr_add(handle, &rcu_cfg);
+	if (ret != 0) {
+		printf("Error associating the RCU QSBR variable\n");
+		goto error;
+	}
+	ret = rte_efd_rcu_qsbr_add(handle, &rcu_cfg);
+	if (ret != -EEXIST) {
+		printf("RCU QSBR variable associated twice\n");
+		goto error;
+	}
+
+	for (i = 0; i < 5; i++) {
+		data[i] = mrand48() & VALUE_BITMASK;
+		key_array[i] = &keys[i];
+	}
+
+	/* Add */
+	if (rte_efd_update_bulk(handle, test_socket_id, 5, key_array, data,
+			status) != 0) {
+		printf("Error inserting the keys\n");
+		goto error;
+	}
+
+	/* Lookup */
+	rte_efd_lookup_bulk(handle, test_socket_id, 5, key_array, result);
+	for (i = 0; i < 5; i++) {
+		if (result[i] != data[i]) {
+			printf("bulk: failed to find key. Expected %d, got %d\n",
+				data[i], result[i]);
+			goto error;
+		}
+	}
+
+	/* Update, leaving the first key unchanged */
+	for (i = 1; i < 5; i++)
+		data[i] = (data[i] + 1) & VALUE_BITMASK;
+
+	if (rte_efd_update_bulk(handle, test_socket_id, 5, key_array, data,
+			status) != 0 || status[0] != RTE_EFD_UPDATE_NO_CHANGE) {
+		printf("Error updating the keys\n");
+		goto error;
+	}
+
+	/* Lookup */
+	for (i = 0; i < 5; i++) {
+		if (rte_efd_lookup(handle, test_socket_id, &keys[i]) != data[i]) {
+			printf("failed to find updated key %u\n", i);
+			goto error;
+		}
+	}
+
+	/* Delete */
+	for (i = 0; i < 5; i++) {
+		if (rte_efd_delete(handle, test_socket_id, &keys[i], NULL) != 0) {
+			printf("failed to delete key %u\n", i);
+			goto error;
+		}
+	}
+
+	rte_efd_free(handle);
+	rte_free(qsv);
+
+	return 0;
+
+error:
+	rte_efd_free(handle);
+	rte_free(qsv);
+	return -1;
+}
+
 /*
  * Test to see the average table utilization (entries added/max entries)
  * before hitting a random entry that cannot be added
@@ -463,6 +570,8 @@ test_efd(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_efd_rcu() < 0)
+		return -1;
 	if (test_efd_creation_with_bad_parameters() < 0)
 		return -1;
 	if (test_average_table_utilization() < 0)
@@ -23,6 +23,7 @@ test_efd_perf(void)
 #include <rte_random.h>
 #include <rte_efd.h>
 #include <rte_memcpy.h>
+#include <rte_rcu_qsbr.h>
 #include <rte_thash.h>
 
 #define NUM_KEYSIZES 10
@@ -381,6 +382,188 @@ run_all_tbl_perf_tests(void)
 	return 0;
 }
 
+/*
+ * Lookup latency while another lcore updates the table.
+ * The reader looks up the first half of the keys, whose values never change,
+ * while the main lcore changes the values of the second half in bursts.
+ * Without RCU, lookups may see groups being rewritten.
+ */
+#define RCU_PERF_KEYSIZE_IDX	2 /* 16 bytes */
+#define RCU_PERF_UPDATE_BURST	64
+#define RCU_PERF_ROUNDS		4
+#define RCU_PERF_IDLE_MS	200
+
+struct efd_rcu_perf_reader {
+	struct rte_efd_table *table;
+	struct rte_rcu_qsbr *v;
+	uint64_t lookups;
+	uint64_t cycles;
+	uint64_t max_cycles;
+	uint64_t mismatches;
+};
+
+static RTE_ATOMIC(uint32_t) rcu_perf_stop;
+
+static int
+rcu_perf_reader(void *arg)
+{
+	struct efd_rcu_perf_reader *r = arg;
+	efd_value_t result[RTE_EFD_BURST_MAX];
+	const void *keys_burst[RTE_EFD_BURST_MAX];
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t start, tsc;
+	unsigned int j, k;
+
+	if (r->v != NULL) {
+		rte_rcu_qsbr_thread_register(r->v, lcore_id);
+		rte_rcu_qsbr_thread_online(r->v, lcore_id);
+	}
+
+	while (rte_atomic_load_explicit(&rcu_perf_stop,
+			rte_memory_order_relaxed) == 0) {
+		for (j = 0; j < KEYS_TO_ADD / 2 / RTE_EFD_BURST_MAX; j++) {
+			for (k = 0; k < RTE_EFD_BURST_MAX; k++)
+				keys_burst[k] = keys[j * RTE_EFD_BURST_MAX + k];
+
+			start = rte_rdtsc();
+			rte_efd_lookup_bulk(r->table, test_socket_id,
+					RTE_EFD_BURST_MAX, keys_burst, result);
+			tsc = rte_rdtsc() - start;
+
+			r->cycles += tsc;
+			if (tsc > r->max_cycles)
+				r->max_cycles = tsc;
+			r->lookups += RTE_EFD_BURST_MAX;
+
+			for (k = 0; k < RTE_EFD_BURST_MAX; k++)
+				if (result[k] != data[j * RTE_EFD_BURST_MAX + k])
+					r->mismatches++;
+
+			if (r->v != NULL)
+				rte_rcu_qsbr_quiescent(r->v, lcore_id);
+		}
+	}
+
+	if (r->v != NULL) {
+		rte_rcu_qsbr_thread_offline(r->v, lcore_id);
+		rte_rcu_qsbr_thread_unregister(r->v, lcore_id);
+	}
+
+	return 0;
+}
+
+static int
+timed_lookups_under_updates(struct efd_perf_params *params,
+		struct rte_rcu_qsbr *v, unsigned int reader_lcore, bool update)
+{
+	struct efd_rcu_perf_reader r = {
+		.table = params->efd_table,
+		.v = v,
+	};
+	efd_value_t values[RCU_PERF_UPDATE_BURST];
+	const void *keys_burst[RCU_PERF_UPDATE_BURST];
+	uint64_t start, tsc = 0, num_updates = 0;
+	unsigned int i, j, k;
+
+	rte_atomic_store_explicit(&rcu_perf_stop, 0, rte_memory_order_relaxed);
+	rte_eal_remote_launch(rcu_perf_reader, &r, reader_lcore);
+
+	if (update) {
+		start = rte_rdtsc();
+		for (i = 0; i < RCU_PERF_ROUNDS; i++) {
+			for (j = KEYS_TO_ADD / 2; j + RCU_PERF_UPDATE_BURST <= KEYS_TO_ADD;
+					j += RCU_PERF_UPDATE_BURST) {
+				for (k = 0; k < RCU_PERF_UPDATE_BURST; k++) {
+					data[j + k] = (data[j + k] + 1) & VALUE_BITMASK;
+					keys_burst[k] = keys[j + k];
+					values[k] = data[j + k];
+				}
+				rte_efd_update_bulk(params->efd_table, test_socket_id,
+						RCU_PERF_UPDATE_BURST, keys_burst, values, NULL);
+				num_updates += RCU_PERF_UPDATE_BURST;
+			}
+		}
+		tsc = rte_rdtsc() - start;
+	} else {
+		rte_delay_ms(RCU_PERF_IDLE_MS);
+	}
+
+	rte_atomic_store_explicit(&rcu_perf_stop, 1, rte_memory_order_relaxed);
+	rte_eal_wait_lcore(reader_lcore);
+
+	printf("%-10s%-10s%-18.1f%-18"PRIu64"%-18"PRIu64"%-18"PRIu64"\n",
+			v != NULL ? "RCU" : "none", update ? "yes" : "no",
+			r.lookups ? (double)r.cycles / r.lookups : 0,
+			r.max_cycles, num_updates ? tsc / num_updates : 0,
+			r.mismatches);
+
+	/* Lookups of unchanged keys must never fail with RCU */
+	if (v != NULL && r.mismatches != 0)
+		return -1;
+
+	return 0;
+}
+
+static int
+run_rcu_perf_tests(void)
+{
+	struct rte_efd_rcu_config rcu_cfg = {0};
+	struct efd_perf_params params;
+	struct rte_rcu_qsbr *v = NULL;
+	unsigned int reader_lcore, i;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough cores for EFD lookups under updates, expecting at least 2\n");
+		return 0;
+	}
+	reader_lcore = rte_get_next_lcore(-1, 1, 0);
+
+	v = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	if (v == NULL)
+		return -1;
+	rte_rcu_qsbr_init(v, RTE_MAX_LCORE);
+	rcu_cfg.v = v;
+
+	printf("\nLookups of %u byte keys under updates (in CPU cycles)\n",
+			hashtest_key_lens[RCU_PERF_KEYSIZE_IDX]);
+	printf("-----------------------------------\n");
+	printf("\n%-10s%-10s%-18s%-18s%-18s%-18s\n", "RCU", "Updates",
+			"Lookup/key", "Max lookup_bulk", "Update/key",
+			"Wrong values");
+
+	for (i = 0; i < 2; i++) {
+		struct rte_rcu_qsbr *qsv = i == 0 ? NULL : v;
+
+		if (setup_keys_and_data(&params, RCU_PERF_KEYSIZE_IDX) < 0)
+			goto error;
+
+		if (qsv != NULL &&
+				rte_efd_rcu_qsbr_add(params.efd_table, &rcu_cfg) != 0) {
+			perform_frees(&params);
+			goto error;
+		}
+
+		if (timed_adds(&params) < 0 ||
+				timed_lookups_under_updates(&params, qsv,
+					reader_lcore, false) < 0 ||
+				timed_lookups_under_updates(&params, qsv,
+					reader_lcore, true) < 0) {
+			perform_frees(&params);
+			goto error;
+		}
+
+		perform_frees(&params);
+	}
+
+	rte_free(v);
+	return 0;
+
+error:
+	rte_free(v);
+	return -1;
+}
+
 static int
 test_efd_perf(void)
 {
@@ -388,6 +571,9 @@ test_efd_perf(void)
 	if (run_all_tbl_perf_tests() < 0)
 		return -1;
 
+	if (run_rcu_perf_tests() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -1491,6 +1491,12 @@ test_eventdev_selftest_sw(void)
 	return test_eventdev_selftest_impl("event_sw", "");
 }
 
+static int
+test_eventdev_selftest_dsw(void)
+{
+	return test_eventdev_selftest_impl("event_dsw", "");
+}
+
 static int
 test_eventdev_selftest_octeontx(void)
 {
@@ -1533,6 +1539,7 @@ REGISTER_FAST_TEST(eventdev_common_autotest, true, true, test_eventdev_common);
 
 #ifndef RTE_EXEC_ENV_WINDOWS
 REGISTER_FAST_TEST(eventdev_selftest_sw, true, true, test_eventdev_selftest_sw);
+REGISTER_FAST_TEST(eventdev_selftest_dsw, true, true, test_eventdev_selftest_dsw);
 REGISTER_DRIVER_TEST(eventdev_selftest_octeontx, test_eventdev_selftest_octeontx);
 REGISTER_DRIVER_TEST(eventdev_selftest_dpaa2, test_eventdev_selftest_dpaa2);
 REGISTER_DRIVER_TEST(eventdev_selftest_dlb2, test_eventdev_selftest_dlb2);
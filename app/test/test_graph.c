@@ -999,6 +999,70 @@ test_print_stats(void)
 	return 0;
 }
 
+static int
+test_graph_lat_trace(void)
+{
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = 5,
+		.node_patterns = node_patterns,
+		.lat_trace_enable = true,
+		.lat_trace_sample_rate = 1,
+	};
+	struct rte_graph_node_lat_stats lat;
+	struct rte_graph *graph;
+	rte_graph_t lat_graph_id;
+	uint64_t hist_total = 0;
+	rte_node_t src_id;
+	int ret = -1;
+	int i;
+
+	lat_graph_id = rte_graph_create("worker_lat", &gconf);
+	if (lat_graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return -1;
+	}
+
+	graph = rte_graph_lookup("worker_lat");
+	if (graph == NULL) {
+		printf("Graph lookup failed\n");
+		goto destroy;
+	}
+
+	for (i = 0; i < 5; i++)
+		rte_graph_walk(graph);
+
+	src_id = rte_node_from_name("test_node_source1");
+	if (rte_graph_node_lat_stats_get(lat_graph_id, src_id, &lat)) {
+		printf("Failed to get latency trace of source node\n");
+		goto destroy;
+	}
+
+	if (lat.samples != 5 || lat.objs != 5 * RTE_GRAPH_BURST_SIZE) {
+		printf("Latency samples mismatch, expected = 5 got = %" PRIu64 "\n",
+		       lat.samples);
+		goto destroy;
+	}
+
+	for (i = 0; i < RTE_GRAPH_LAT_HIST_BUCKETS; i++)
+		hist_total += lat.hist[i];
+	if (hist_total != lat.samples || lat.min_cycles > lat.max_cycles ||
+	    rte_graph_node_lat_percentile(&lat, 100) != lat.max_cycles) {
+		printf("Latency histogram is inconsistent\n");
+		goto destroy;
+	}
+
+	if (rte_graph_node_lat_stats_get(graph_id, src_id, &lat) != -ENOTSUP) {
+		printf("Latency trace reported on a graph without it\n");
+		goto destroy;
+	}
+
+	ret = 0;
+destroy:
+	rte_graph_destroy(lat_graph_id);
+	return ret;
+}
+
 static int
 graph_setup(void)
 {
@@ -1055,6 +1119,7 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_graph_lat_trace),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
@@ -17,6 +17,9 @@
 #include <rte_crypto.h>
 #include <rte_cryptodev.h>
 #include <rte_lcore.h>
+#include <rte_launch.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 
 #ifdef RTE_EXEC_ENV_WINDOWS
 static int
@@ -43,6 +46,7 @@ test_ipsec(void)
 #define REPLAY_WIN_64	64
 #define REPLAY_WIN_128	128
 #define REPLAY_WIN_256	256
+#define REPLAY_WIN_4096	4096
 #define DATA_64_BYTES	64
 #define DATA_80_BYTES	80
 #define DATA_100_BYTES	100
@@ -117,6 +121,12 @@ static const struct ipsec_test_cfg test_cfg[] = {
 	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_ATOM,
 		DATA_80_BYTES, 1, 0},
 	{REPLAY_WIN_256, ESN_DISABLED, 0, DATA_100_BYTES, 1, 0},
+	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_LOCKFREE,
+		DATA_80_BYTES, BURST_SIZE, REORDER_PKTS},
+	{REPLAY_WIN_4096, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_ATOM,
+		DATA_64_BYTES, BURST_SIZE, REORDER_PKTS},
+	{REPLAY_WIN_4096, ESN_DISABLED, RTE_IPSEC_SAFLAG_SQN_LOCKFREE,
+		DATA_64_BYTES, BURST_SIZE, 0},
 };
 
 static const int num_cfg = RTE_DIM(test_cfg);
@@ -2371,6 +2381,243 @@ test_ipsec_replay_inb_inside_burst_null_null_wrapper(void)
 	return rc;
 }
 
+/*
+ * Replay window update by several lcores for the same SA.
+ * Each round sends new SQNs twice, the SQNs of the previous round again
+ * and, without ESN, one SQN behind the window, spread over the lcores.
+ * Every round stays within the window, so which packets are accepted does
+ * not depend on the interleaving: it has to match a serial run on an SA
+ * without the atomic/lock-free flags. Rounds move forward by half the
+ * window, so the window ring wraps several times.
+ */
+#define REPLAY_MT_ROUNDS	32
+#define REPLAY_MT_NEW		64
+#define REPLAY_MT_MAX_PKTS	(3 * REPLAY_MT_NEW + 1)
+#define REPLAY_MT_LCORES	4
+
+struct replay_mt_worker {
+	struct rte_ipsec_session *ss;
+	RTE_ATOMIC(uint32_t) *cnt;
+	uint32_t nb_sqn;
+	bool serialize;
+	uint32_t num;
+	struct rte_mbuf *mb[REPLAY_MT_MAX_PKTS];
+};
+
+static struct replay_mt_worker replay_mt_wrk[REPLAY_MT_LCORES];
+static rte_spinlock_t replay_mt_lock = RTE_SPINLOCK_INITIALIZER;
+
+static uint32_t
+replay_mt_round(uint32_t r, uint32_t step, uint32_t win_sz, uint32_t esn,
+	uint32_t sqn[])
+{
+	uint32_t i, n, base, prev;
+
+	base = r * step;
+	prev = base - step;
+
+	n = 0;
+	for (i = 0; i != REPLAY_MT_NEW; i++) {
+		sqn[n++] = base + i + 1;
+		sqn[n++] = base + i + 1;
+		if (r != 0)
+			sqn[n++] = prev + i + 1;
+	}
+
+	/*
+	 * behind the window moved by the previous round,
+	 * with ESN it would be taken for the next SQN subspace
+	 */
+	if (esn == 0 && r != 0 && prev + REPLAY_MT_NEW > win_sz + 1)
+		sqn[n++] = prev + REPLAY_MT_NEW - win_sz - 1;
+
+	return n;
+}
+
+static int
+replay_mt_worker(void *arg)
+{
+	struct replay_mt_worker *w = arg;
+	uint32_t i, j, k, n, sqn;
+
+	for (i = 0; i != w->num; i += n) {
+		n = RTE_MIN(w->num - i, (uint32_t)BURST_SIZE);
+
+		if (w->serialize)
+			rte_spinlock_lock(&replay_mt_lock);
+		k = rte_ipsec_pkt_process(w->ss, w->mb + i, n);
+		if (w->serialize)
+			rte_spinlock_unlock(&replay_mt_lock);
+
+		/* SQN is carried at the start of the payload */
+		for (j = 0; j != k; j++) {
+			memcpy(&sqn, rte_pktmbuf_mtod(w->mb[i + j], void *),
+				sizeof(sqn));
+			if (sqn >= w->nb_sqn)
+				sqn = 0;
+			rte_atomic_fetch_add_explicit(&w->cnt[sqn], 1,
+				rte_memory_order_relaxed);
+		}
+	}
+
+	return 0;
+}
+
+static int
+replay_mt_run(struct rte_ipsec_session *ss, const uint32_t sqn[], uint32_t num,
+	RTE_ATOMIC(uint32_t) *cnt, uint32_t nb_sqn, uint32_t nb_lcore)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct replay_mt_worker *w;
+	char payload[DATA_64_BYTES];
+	uint32_t i, lcore_id;
+	int rc;
+
+	for (i = 0; i != nb_lcore; i++) {
+		w = &replay_mt_wrk[i];
+		w->ss = ss;
+		w->cnt = cnt;
+		w->nb_sqn = nb_sqn;
+		/* ATOM SA still expects one rte_ipsec_pkt_process() at a time */
+		w->serialize = (rte_ipsec_sa_type(ss->sa) &
+			RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM;
+		w->num = 0;
+	}
+
+	rc = 0;
+	memcpy(payload, null_plain_data, sizeof(payload));
+	for (i = 0; i != num && rc == 0; i++) {
+		memcpy(payload, &sqn[i], sizeof(sqn[i]));
+		w = &replay_mt_wrk[i % nb_lcore];
+		w->mb[w->num] = setup_test_string_tunneled(ts_params->mbuf_pool,
+			payload, sizeof(payload), INBOUND_SPI, sqn[i]);
+		if (w->mb[w->num] == NULL)
+			rc = TEST_FAILED;
+		else
+			w->num++;
+	}
+
+	if (rc == 0) {
+		i = 1;
+		RTE_LCORE_FOREACH_WORKER(lcore_id) {
+			if (i == nb_lcore)
+				break;
+			rte_eal_remote_launch(replay_mt_worker,
+				&replay_mt_wrk[i++], lcore_id);
+		}
+		replay_mt_worker(&replay_mt_wrk[0]);
+		rte_eal_mp_wait_lcore();
+	}
+
+	for (i = 0; i != nb_lcore; i++)
+		rte_pktmbuf_free_bulk(replay_mt_wrk[i].mb, replay_mt_wrk[i].num);
+
+	return rc;
+}
+
+static int
+test_ipsec_replay_inb_mt_null_null(int i)
+{
+	RTE_ATOMIC(uint32_t) *cnt, *ref;
+	uint32_t sqn[REPLAY_MT_MAX_PKTS];
+	uint32_t nb_lcore, nb_sqn, step, r, s, n, acc, nb_mt, nb_ref;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	int rc;
+
+	nb_lcore = RTE_MIN(rte_lcore_count(), (uint32_t)REPLAY_MT_LCORES);
+	step = test_cfg[i].replay_win_sz / 2;
+	nb_sqn = REPLAY_MT_ROUNDS * step + REPLAY_MT_NEW + 1;
+
+	/* SA under test and serial reference */
+	rc = create_sa(RTE_SECURITY_ACTION_TYPE_INLINE_CRYPTO,
+			test_cfg[i].replay_win_sz, test_cfg[i].flags, 0);
+	if (rc != 0) {
+		RTE_LOG(ERR, USER1, "create_sa failed, cfg %d\n", i);
+		return rc;
+	}
+	rc = create_sa(RTE_SECURITY_ACTION_TYPE_INLINE_CRYPTO,
+			test_cfg[i].replay_win_sz, 0, 1);
+	if (rc != 0) {
+		RTE_LOG(ERR, USER1, "create_sa failed, cfg %d\n", i);
+		destroy_sa(0);
+		return rc;
+	}
+
+	cnt = rte_zmalloc(NULL, nb_sqn * sizeof(*cnt), 0);
+	ref = rte_zmalloc(NULL, nb_sqn * sizeof(*ref), 0);
+	if (cnt == NULL || ref == NULL)
+		rc = TEST_FAILED;
+
+	for (r = 0; r != REPLAY_MT_ROUNDS && rc == 0; r++) {
+		n = replay_mt_round(r, step, test_cfg[i].replay_win_sz,
+			test_cfg[i].esn, sqn);
+		rc = replay_mt_run(&ut_params->ss[0], sqn, n, cnt, nb_sqn,
+			nb_lcore);
+		if (rc == 0)
+			rc = replay_mt_run(&ut_params->ss[1], sqn, n, ref,
+				nb_sqn, 1);
+	}
+
+	for (s = 0, acc = 0; s != nb_sqn && rc == 0; s++) {
+		nb_mt = rte_atomic_load_explicit(&cnt[s],
+			rte_memory_order_relaxed);
+		nb_ref = rte_atomic_load_explicit(&ref[s],
+			rte_memory_order_relaxed);
+		if (nb_mt != nb_ref) {
+			RTE_LOG(ERR, USER1,
+				"cfg %d: SQN %u accepted %u times, "
+				"serial reference %u\n", i, s, nb_mt, nb_ref);
+			rc = TEST_FAILED;
+		}
+		acc += nb_ref;
+	}
+
+	if (rc == 0 && acc != REPLAY_MT_ROUNDS * REPLAY_MT_NEW) {
+		RTE_LOG(ERR, USER1, "cfg %d: %u SQNs accepted, expected %u\n",
+			i, acc, REPLAY_MT_ROUNDS * REPLAY_MT_NEW);
+		rc = TEST_FAILED;
+	}
+
+	rte_free(cnt);
+	rte_free(ref);
+	destroy_sa(1);
+	destroy_sa(0);
+
+	return rc;
+}
+
+static int
+test_ipsec_replay_inb_mt_null_null_wrapper(void)
+{
+	int i;
+	int rc = 0;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	static const uint64_t msk = RTE_IPSEC_SAFLAG_SQN_ATOM |
+		RTE_IPSEC_SAFLAG_SQN_LOCKFREE;
+
+	if (rte_lcore_count() < 2) {
+		RTE_LOG(WARNING, USER1, "Need at least two lcores\n");
+		return TEST_SKIPPED;
+	}
+
+	ut_params->ipsec_xform.spi = INBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_INGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+
+	/* multi-lcore SAs, with room for a round within the window */
+	for (i = 0; i < num_cfg && rc == 0; i++) {
+		if ((test_cfg[i].flags & msk) == 0 ||
+				test_cfg[i].replay_win_sz < 2 * REPLAY_MT_NEW)
+			continue;
+		ut_params->ipsec_xform.options.esn = test_cfg[i].esn;
+		rc = test_ipsec_replay_inb_mt_null_null(i);
+	}
+
+	return rc;
+}
+
 
 static int
 crypto_inb_burst_2sa_null_null_check(struct ipsec_unitest_params *ut_params,
@@ -2570,6 +2817,305 @@ test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper(void)
 	return rc;
 }
 
+/*
+ * rte_ipsec_pkt_cpu_burst() has to give the same results as
+ * rte_ipsec_pkt_cpu_prepare() + rte_ipsec_pkt_process() called per SA.
+ * Two identical sets of AES-GCM SAs process the same bursts, one per SA
+ * and one with the fused call, on a cryptodev supporting CPU crypto.
+ */
+#define CPU_NB_SA	4
+#define CPU_KEY_LEN	16
+#define CPU_SALT	0x12345678
+#define CPU_OUTB_BAD	5	/* no tailroom, within group 1 */
+#define CPU_INB_BAD	10	/* corrupted, within group 2 */
+
+static const uint16_t cpu_grp_cnt[CPU_NB_SA] = {1, 7, 16, 8};
+
+static const uint8_t cpu_key[CPU_KEY_LEN] = {
+	0xde, 0xad, 0xbe, 0xef, 0x01, 0x23, 0x45, 0x67,
+	0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98,
+};
+
+struct cpu_burst_params {
+	uint8_t dev_id;
+	struct rte_mempool *sess_pool;
+	/* [0] per SA calls, [1] fused call */
+	struct rte_ipsec_session ss_out[2][CPU_NB_SA];
+	struct rte_ipsec_session ss_in[2][CPU_NB_SA];
+	struct rte_ipsec_group grp[2][CPU_NB_SA];
+};
+
+static int
+cpu_crypto_dev_find(uint8_t *dev_id)
+{
+	struct rte_cryptodev_info info;
+	uint8_t i;
+
+	for (i = 0; i < rte_cryptodev_count(); i++) {
+		rte_cryptodev_info_get(i, &info);
+		if (info.feature_flags & RTE_CRYPTODEV_FF_SYM_CPU_CRYPTO) {
+			*dev_id = i;
+			return 0;
+		}
+	}
+
+	return -ENODEV;
+}
+
+static int
+cpu_sa_create(struct cpu_burst_params *cp, struct rte_ipsec_session *ss,
+	enum rte_security_ipsec_sa_direction dir, uint32_t spi)
+{
+	struct rte_crypto_sym_xform xform;
+	struct rte_ipsec_sa_prm prm;
+	size_t sz;
+	int rc;
+
+	memset(&xform, 0, sizeof(xform));
+	xform.type = RTE_CRYPTO_SYM_XFORM_AEAD;
+	xform.aead.algo = RTE_CRYPTO_AEAD_AES_GCM;
+	xform.aead.op = (dir == RTE_SECURITY_IPSEC_SA_DIR_INGRESS) ?
+		RTE_CRYPTO_AEAD_OP_DECRYPT : RTE_CRYPTO_AEAD_OP_ENCRYPT;
+	xform.aead.key.data = cpu_key;
+	xform.aead.key.length = sizeof(cpu_key);
+	xform.aead.iv.offset = IV_OFFSET;
+	xform.aead.iv.length = 12;
+	xform.aead.digest_length = 16;
+	xform.aead.aad_length = sizeof(struct rte_esp_hdr);
+
+	memset(&prm, 0, sizeof(prm));
+	prm.ipsec_xform.spi = spi;
+	prm.ipsec_xform.salt = CPU_SALT;
+	prm.ipsec_xform.direction = dir;
+	prm.ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	prm.ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	prm.ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+	prm.ipsec_xform.replay_win_sz =
+		(dir == RTE_SECURITY_IPSEC_SA_DIR_INGRESS) ? REPLAY_WIN_64 : 0;
+	prm.tun.hdr_len = sizeof(ipv4_outer);
+	prm.tun.next_proto = IPPROTO_IPIP;
+	prm.tun.hdr = &ipv4_outer;
+	prm.crypto_xform = &xform;
+
+	memset(ss, 0, sizeof(*ss));
+
+	sz = rte_ipsec_sa_size(&prm);
+	TEST_ASSERT(sz > 0, "rte_ipsec_sa_size() failed\n");
+
+	ss->sa = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_NOT_NULL(ss->sa,
+		"failed to allocate memory for rte_ipsec_sa\n");
+
+	ss->type = RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO;
+	ss->crypto.dev_id = cp->dev_id;
+	ss->crypto.ses = rte_cryptodev_sym_session_create(cp->dev_id, &xform,
+			cp->sess_pool);
+	TEST_ASSERT_NOT_NULL(ss->crypto.ses,
+		"failed to create crypto session\n");
+
+	rc = rte_ipsec_sa_init(ss->sa, &prm, sz);
+	TEST_ASSERT(rc > 0 && (uint32_t)rc <= sz, "rte_ipsec_sa_init failed\n");
+
+	rc = rte_ipsec_session_prepare(ss);
+	TEST_ASSERT_SUCCESS(rc, "rte_ipsec_session_prepare failed\n");
+
+	return TEST_SUCCESS;
+}
+
+static void
+cpu_sa_destroy(struct cpu_burst_params *cp, struct rte_ipsec_session *ss)
+{
+	if (ss->crypto.ses != NULL)
+		rte_cryptodev_sym_session_free(cp->dev_id, ss->crypto.ses);
+	if (ss->sa != NULL) {
+		rte_ipsec_sa_fini(ss->sa);
+		rte_free(ss->sa);
+	}
+	memset(ss, 0, sizeof(*ss));
+}
+
+static uint32_t
+cpu_burst_run(struct rte_ipsec_group grp[], bool fused)
+{
+	struct rte_ipsec_session *ss;
+	uint32_t i, k;
+
+	if (fused)
+		return rte_ipsec_pkt_cpu_burst(grp, CPU_NB_SA);
+
+	for (i = 0, k = 0; i != CPU_NB_SA; i++) {
+		ss = grp[i].id.ptr;
+		grp[i].rc = rte_ipsec_pkt_process(ss, grp[i].m,
+			rte_ipsec_pkt_cpu_prepare(ss, grp[i].m, grp[i].cnt));
+		k += grp[i].rc;
+	}
+
+	return k;
+}
+
+static int
+cpu_burst_check(struct cpu_burst_params *cp, const uint16_t rc[])
+{
+	struct rte_mbuf *m0, *m1;
+	uint32_t i, j;
+
+	for (i = 0; i != CPU_NB_SA; i++) {
+		TEST_ASSERT_EQUAL(cp->grp[0][i].rc, rc[i],
+			"group %u: %d good packets per SA, expected %u\n",
+			i, cp->grp[0][i].rc, rc[i]);
+		TEST_ASSERT_EQUAL(cp->grp[1][i].rc, rc[i],
+			"group %u: %d good packets fused, expected %u\n",
+			i, cp->grp[1][i].rc, rc[i]);
+
+		/* good packets first, then the failed ones */
+		for (j = 0; j != cp->grp[0][i].cnt; j++) {
+			m0 = cp->grp[0][i].m[j];
+			m1 = cp->grp[1][i].m[j];
+
+			TEST_ASSERT_EQUAL(m0->pkt_len, m1->pkt_len,
+				"group %u pkt %u: pkt_len differs\n", i, j);
+			TEST_ASSERT_EQUAL(m0->data_len, m1->data_len,
+				"group %u pkt %u: data_len differs\n", i, j);
+			TEST_ASSERT_EQUAL(
+				(m0->ol_flags & RTE_MBUF_F_RX_SEC_OFFLOAD_FAILED),
+				(m1->ol_flags & RTE_MBUF_F_RX_SEC_OFFLOAD_FAILED),
+				"group %u pkt %u: status differs\n", i, j);
+			TEST_ASSERT_BUFFERS_ARE_EQUAL(
+				rte_pktmbuf_mtod(m0, void *),
+				rte_pktmbuf_mtod(m1, void *), m0->data_len,
+				"group %u pkt %u: data differs\n", i, j);
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+cpu_burst_outb_inb(struct cpu_burst_params *cp)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	struct rte_mbuf **mb[2] = { ut_params->ibuf, ut_params->testbuf };
+	uint16_t rc[CPU_NB_SA];
+	uint32_t i, j, n, ofs;
+	uint8_t *p;
+
+	/* same plain packets for both paths, one without tailroom */
+	for (i = 0; i != 2; i++) {
+		for (j = 0; j != BURST_SIZE; j++) {
+			mb[i][j] = setup_test_string(ts_params->mbuf_pool,
+				null_plain_data, sizeof(null_plain_data),
+				DATA_64_BYTES, 0);
+			TEST_ASSERT_NOT_NULL(mb[i][j],
+				"failed to allocate mbuf\n");
+		}
+		rte_pktmbuf_append(mb[i][CPU_OUTB_BAD],
+			rte_pktmbuf_tailroom(mb[i][CPU_OUTB_BAD]));
+
+		for (j = 0, n = 0; j != CPU_NB_SA; j++) {
+			cp->grp[i][j].id.ptr = &cp->ss_out[i][j];
+			cp->grp[i][j].m = mb[i] + n;
+			cp->grp[i][j].cnt = cpu_grp_cnt[j];
+			n += cpu_grp_cnt[j];
+		}
+	}
+
+	for (i = 0; i != CPU_NB_SA; i++)
+		rc[i] = cpu_grp_cnt[i];
+	rc[1]--;
+
+	TEST_ASSERT_EQUAL(cpu_burst_run(cp->grp[0], false), BURST_SIZE - 1,
+		"per SA outbound processing failed\n");
+	TEST_ASSERT_EQUAL(cpu_burst_run(cp->grp[1], true), BURST_SIZE - 1,
+		"fused outbound processing failed\n");
+	if (cpu_burst_check(cp, rc) != TEST_SUCCESS)
+		return TEST_FAILED;
+
+	/*
+	 * Decrypt the good packets, with one payload byte corrupted.
+	 * The mbuf left behind stays at the end of its group.
+	 */
+	ofs = sizeof(ipv4_outer) + sizeof(struct rte_esp_hdr) + 8;
+	for (i = 0; i != 2; i++) {
+		p = rte_pktmbuf_mtod_offset(mb[i][CPU_INB_BAD], uint8_t *, ofs);
+		*p ^= 0xff;
+
+		for (j = 0; j != CPU_NB_SA; j++) {
+			cp->grp[i][j].id.ptr = &cp->ss_in[i][j];
+			cp->grp[i][j].cnt = rc[j];
+		}
+	}
+	rc[2]--;
+
+	TEST_ASSERT_EQUAL(cpu_burst_run(cp->grp[0], false), BURST_SIZE - 2,
+		"per SA inbound processing failed\n");
+	TEST_ASSERT_EQUAL(cpu_burst_run(cp->grp[1], true), BURST_SIZE - 2,
+		"fused inbound processing failed\n");
+	if (cpu_burst_check(cp, rc) != TEST_SUCCESS)
+		return TEST_FAILED;
+
+	for (i = 0; i != CPU_NB_SA; i++) {
+		for (j = 0; j != rc[i]; j++) {
+			TEST_ASSERT_EQUAL(cp->grp[1][i].m[j]->pkt_len,
+				DATA_64_BYTES, "unexpected decrypted length\n");
+			TEST_ASSERT_BUFFERS_ARE_EQUAL(null_plain_data,
+				rte_pktmbuf_mtod(cp->grp[1][i].m[j], void *),
+				DATA_64_BYTES, "decrypted data does not match\n");
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_ipsec_cpu_burst_aes_gcm(void)
+{
+	static struct cpu_burst_params cp;
+	size_t sess_sz;
+	uint32_t i, j;
+	int rc;
+
+	memset(&cp, 0, sizeof(cp));
+
+	if (cpu_crypto_dev_find(&cp.dev_id) != 0) {
+		RTE_LOG(WARNING, USER1, "No CPU crypto capable device found\n");
+		return TEST_SKIPPED;
+	}
+
+	sess_sz = rte_cryptodev_sym_get_private_session_size(cp.dev_id);
+	cp.sess_pool = rte_cryptodev_sym_session_pool_create(
+			"test_cpu_sess_mp", 4 * CPU_NB_SA, sess_sz, 0, 0,
+			SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(cp.sess_pool,
+		"session mempool allocation failed\n");
+
+	rc = TEST_SUCCESS;
+	for (i = 0; i != 2 && rc == TEST_SUCCESS; i++) {
+		for (j = 0; j != CPU_NB_SA && rc == TEST_SUCCESS; j++) {
+			rc = cpu_sa_create(&cp, &cp.ss_out[i][j],
+				RTE_SECURITY_IPSEC_SA_DIR_EGRESS,
+				OUTBOUND_SPI + j);
+			if (rc == TEST_SUCCESS)
+				rc = cpu_sa_create(&cp, &cp.ss_in[i][j],
+					RTE_SECURITY_IPSEC_SA_DIR_INGRESS,
+					OUTBOUND_SPI + j);
+		}
+	}
+
+	if (rc == TEST_SUCCESS)
+		rc = cpu_burst_outb_inb(&cp);
+
+	for (i = 0; i != 2; i++) {
+		for (j = 0; j != CPU_NB_SA; j++) {
+			cpu_sa_destroy(&cp, &cp.ss_out[i][j]);
+			cpu_sa_destroy(&cp, &cp.ss_in[i][j]);
+		}
+	}
+	rte_mempool_free(cp.sess_pool);
+
+	return rc;
+}
+
 static struct unit_test_suite ipsec_testsuite  = {
 	.suite_name = "IPsec NULL Unit Test Suite",
 	.setup = testsuite_setup,
@@ -2601,10 +3147,14 @@ static struct unit_test_suite ipsec_testsuite  = {
 			test_ipsec_replay_inb_repeat_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_replay_inb_inside_burst_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_replay_inb_mt_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_cpu_burst_aes_gcm),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
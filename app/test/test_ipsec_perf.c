@@ -19,8 +19,16 @@ test_libipsec_perf(void)
 	return TEST_SKIPPED;
 }
 
+static int
+test_libipsec_cpu_burst_perf(void)
+{
+	printf("ipsec_cpu_burst_perf not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
 #else
 
+#include <rte_esp.h>
 #include <rte_ipsec.h>
 #include <rte_random.h>
 
@@ -31,6 +39,10 @@ test_libipsec_perf(void)
 #define NUM_MBUF	4095
 #define DEFAULT_SPI     7
 
+#define CPU_NB_SA_MAX		16
+#define CPU_NB_ITERATIONS	10000
+#define CPU_KEY_LEN		16
+
 struct ipsec_test_cfg {
 	uint32_t replay_win_sz;
 	uint32_t esn;
@@ -629,6 +641,231 @@ test_libipsec_perf(void)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Compare per SA rte_ipsec_pkt_cpu_prepare() + rte_ipsec_pkt_process()
+ * with rte_ipsec_pkt_cpu_burst() for bursts spread over several SAs,
+ * on a cryptodev supporting CPU crypto (e.g. --vdev crypto_aesni_mb).
+ */
+struct cpu_perf_ctx {
+	uint8_t dev_id;
+	struct rte_mempool *sess_pool;
+	struct rte_mempool *pkt_pool;
+	struct ipsec_sa sa[CPU_NB_SA_MAX];
+};
+
+static const uint8_t cpu_key[CPU_KEY_LEN] = {
+	0xde, 0xad, 0xbe, 0xef, 0x01, 0x23, 0x45, 0x67,
+	0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98,
+};
+
+static int
+cpu_dev_find(uint8_t *dev_id)
+{
+	struct rte_cryptodev_info info;
+	uint8_t i;
+
+	for (i = 0; i < rte_cryptodev_count(); i++) {
+		rte_cryptodev_info_get(i, &info);
+		if (info.feature_flags & RTE_CRYPTODEV_FF_SYM_CPU_CRYPTO) {
+			*dev_id = i;
+			return 0;
+		}
+	}
+
+	return -ENODEV;
+}
+
+static int
+cpu_dev_setup(struct cpu_perf_ctx *ctx)
+{
+	struct rte_cryptodev_config conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_queue_pairs = 1,
+	};
+	struct rte_cryptodev_qp_conf qp_conf = {
+		.nb_descriptors = BURST_SIZE,
+	};
+
+	ctx->sess_pool = rte_cryptodev_sym_session_pool_create(
+			"IPSEC_CPU_PERF_SESS_POOL", CPU_NB_SA_MAX, 0, 0, 0,
+			SOCKET_ID_ANY);
+	if (ctx->sess_pool == NULL)
+		return -ENOMEM;
+
+	ctx->pkt_pool = rte_pktmbuf_pool_create("IPSEC_CPU_PERF_MBUFPOOL",
+			2 * BURST_SIZE, 0, 0, MBUF_SIZE, SOCKET_ID_ANY);
+	if (ctx->pkt_pool == NULL)
+		return -ENOMEM;
+
+	qp_conf.mp_session = ctx->sess_pool;
+
+	if (rte_cryptodev_configure(ctx->dev_id, &conf) != 0 ||
+			rte_cryptodev_queue_pair_setup(ctx->dev_id, 0, &qp_conf,
+				SOCKET_ID_ANY) != 0 ||
+			rte_cryptodev_start(ctx->dev_id) != 0)
+		return -EINVAL;
+
+	return 0;
+}
+
+static int
+cpu_sa_create(struct cpu_perf_ctx *ctx, struct ipsec_sa *sa, uint32_t spi)
+{
+	size_t sz;
+	int rc;
+
+	fill_ipsec_sa_out(&test_cfg[0], sa);
+	sa->ipsec_xform.spi = spi;
+	fill_ipsec_param(sa);
+
+	sa->aead_xform.aead.key.data = cpu_key;
+	sa->aead_xform.aead.key.length = sizeof(cpu_key);
+	sa->aead_xform.aead.aad_length = sizeof(struct rte_esp_hdr);
+
+	sz = rte_ipsec_sa_size(&sa->sa_prm);
+	TEST_ASSERT(sz > 0, "rte_ipsec_sa_size() failed\n");
+
+	memset(&sa->ss[0], 0, sizeof(sa->ss[0]));
+	sa->ss[0].sa = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_NOT_NULL(sa->ss[0].sa,
+		"failed to allocate memory for rte_ipsec_sa\n");
+
+	sa->ss[0].type = RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO;
+	sa->ss[0].crypto.dev_id = ctx->dev_id;
+	sa->ss[0].crypto.ses = rte_cryptodev_sym_session_create(ctx->dev_id,
+			sa->crypto_xforms, ctx->sess_pool);
+	TEST_ASSERT_NOT_NULL(sa->ss[0].crypto.ses,
+		"failed to create crypto session\n");
+
+	rc = rte_ipsec_sa_init(sa->ss[0].sa, &sa->sa_prm, sz);
+	TEST_ASSERT(rc > 0 && (uint32_t)rc <= sz, "rte_ipsec_sa_init failed\n");
+
+	rc = rte_ipsec_session_prepare(&sa->ss[0]);
+	TEST_ASSERT_SUCCESS(rc, "rte_ipsec_session_prepare failed\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+cpu_burst_measure(struct cpu_perf_ctx *ctx, uint32_t nb_sa, bool fused,
+		long double *cycles)
+{
+	struct rte_mbuf *mb[BURST_SIZE];
+	struct rte_ipsec_group grp[CPU_NB_SA_MAX];
+	struct rte_ipsec_session *ss;
+	uint64_t tsc, elapsed = 0;
+	uint32_t i, j, k, n;
+
+	if (rte_pktmbuf_alloc_bulk(ctx->pkt_pool, mb, BURST_SIZE) != 0)
+		return TEST_FAILED;
+
+	for (j = 0; j != CPU_NB_ITERATIONS; j++) {
+
+		/* same burst spread evenly over the SAs, grouped by SA */
+		for (i = 0, n = 0; i != nb_sa; i++) {
+			grp[i].id.ptr = &ctx->sa[i].ss[0];
+			grp[i].m = mb + n;
+			grp[i].cnt = BURST_SIZE / nb_sa;
+			n += grp[i].cnt;
+		}
+
+		for (i = 0; i != n; i++) {
+			rte_pktmbuf_reset(mb[i]);
+			mb[i]->data_len = 64;
+			mb[i]->pkt_len = 64;
+		}
+
+		tsc = rte_rdtsc_precise();
+		if (fused) {
+			k = rte_ipsec_pkt_cpu_burst(grp, nb_sa);
+		} else {
+			for (i = 0, k = 0; i != nb_sa; i++) {
+				ss = grp[i].id.ptr;
+				k += rte_ipsec_pkt_process(ss, grp[i].m,
+					rte_ipsec_pkt_cpu_prepare(ss, grp[i].m,
+						grp[i].cnt));
+			}
+		}
+		elapsed += rte_rdtsc_precise() - tsc;
+
+		if (k != n) {
+			rte_pktmbuf_free_bulk(mb, BURST_SIZE);
+			return TEST_FAILED;
+		}
+	}
+
+	rte_pktmbuf_free_bulk(mb, BURST_SIZE);
+	*cycles = (long double)elapsed / ((uint64_t)CPU_NB_ITERATIONS * n);
+
+	return TEST_SUCCESS;
+}
+
+static void
+cpu_perf_teardown(struct cpu_perf_ctx *ctx)
+{
+	uint32_t i;
+
+	rte_cryptodev_stop(ctx->dev_id);
+
+	for (i = 0; i != CPU_NB_SA_MAX; i++) {
+		if (ctx->sa[i].ss[0].crypto.ses != NULL)
+			rte_cryptodev_sym_session_free(ctx->dev_id,
+				ctx->sa[i].ss[0].crypto.ses);
+		if (ctx->sa[i].ss[0].sa != NULL)
+			rte_ipsec_sa_fini(ctx->sa[i].ss[0].sa);
+		rte_free(ctx->sa[i].ss[0].sa);
+	}
+
+	rte_mempool_free(ctx->sess_pool);
+	rte_mempool_free(ctx->pkt_pool);
+}
+
+static int
+test_libipsec_cpu_burst_perf(void)
+{
+	static const uint32_t nb_sa[] = {1, 4, CPU_NB_SA_MAX};
+	static struct cpu_perf_ctx ctx;
+	long double per_sa, fused;
+	uint32_t i;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	if (cpu_dev_find(&ctx.dev_id) != 0) {
+		RTE_LOG(WARNING, USER1, "No CPU crypto capable device found\n");
+		return TEST_SKIPPED;
+	}
+
+	ret = cpu_dev_setup(&ctx);
+	for (i = 0; ret == 0 && i != CPU_NB_SA_MAX; i++)
+		ret = cpu_sa_create(&ctx, &ctx.sa[i], DEFAULT_SPI + i);
+	if (ret != 0) {
+		cpu_perf_teardown(&ctx);
+		return TEST_FAILED;
+	}
+
+	printf("\nMetrics of libipsec cpu crypto api, AES_GCM outbound, "
+		"burst of %u pkts:\n", BURST_SIZE);
+
+	for (i = 0; i != RTE_DIM(nb_sa); i++) {
+		if (cpu_burst_measure(&ctx, nb_sa[i], false, &per_sa) != 0 ||
+				cpu_burst_measure(&ctx, nb_sa[i], true,
+					&fused) != 0) {
+			cpu_perf_teardown(&ctx);
+			return TEST_FAILED;
+		}
+
+		printf("%u SA: avg cycles per pkt with per SA prepare/process "
+			"= %.2Lf, with cpu burst = %.2Lf\n",
+			nb_sa[i], per_sa, fused);
+	}
+
+	cpu_perf_teardown(&ctx);
+
+	return TEST_SUCCESS;
+}
+
 #endif /* !RTE_EXEC_ENV_WINDOWS */
 
 REGISTER_PERF_TEST(ipsec_perf_autotest, test_libipsec_perf);
+REGISTER_PERF_TEST(ipsec_cpu_burst_perf_autotest, test_libipsec_cpu_burst_perf);
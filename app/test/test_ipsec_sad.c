@@ -688,7 +688,7 @@ test_lookup_adv(void)
 
 
 static int32_t
-__test_lookup_order(int ipv6, union rte_ipsec_sad_key *tuple,
+__test_lookup_order(int ipv6, uint32_t flags, union rte_ipsec_sad_key *tuple,
 	union rte_ipsec_sad_key *tuple_1, union rte_ipsec_sad_key *tuple_2)
 {
 	int status;
@@ -703,9 +703,9 @@ __test_lookup_order(int ipv6, union rte_ipsec_sad_key *tuple,
 	config.max_sa[RTE_IPSEC_SAD_SPI_DIP] = MAX_SA;
 	config.max_sa[RTE_IPSEC_SAD_SPI_DIP_SIP] = MAX_SA;
 	config.socket_id = SOCKET_ID_ANY;
-	config.flags = 0;
+	config.flags = flags;
 	if (ipv6)
-		config.flags = RTE_IPSEC_SAD_FLAG_IPV6;
+		config.flags |= RTE_IPSEC_SAD_FLAG_IPV6;
 	sad = rte_ipsec_sad_create(__func__, &config);
 	RTE_TEST_ASSERT_NOT_NULL(sad, "Failed to create SAD\n");
 
@@ -843,11 +843,13 @@ __test_lookup_order(int ipv6, union rte_ipsec_sad_key *tuple,
 }
 
 /*
- * Check an order of add and delete
+ * Check an order of add and delete, with both SAD layouts
  */
 int32_t
 test_lookup_order(void)
 {
+	static const uint32_t layout_flags[] = {0, RTE_IPSEC_SAD_FLAG_COMBINED};
+	unsigned int i;
 	int status;
 	/* key to install*/
 	struct rte_ipsec_sadv4_key tuple_v4 = {SPI, DIP, SIP};
@@ -861,16 +863,23 @@ test_lookup_order(void)
 	struct rte_ipsec_sadv6_key tuple_v6_2 = {SPI,
 		RTE_IPV6(0x0bad, 0, 0, 0, 0, 0, 0, 0), RTE_IPV6(0xf00d, 0, 0, 0, 0, 0, 0, 0)};
 
-	status = __test_lookup_order(0, (union rte_ipsec_sad_key *)&tuple_v4,
-			(union rte_ipsec_sad_key *)&tuple_v4_1,
-			(union rte_ipsec_sad_key *)&tuple_v4_2);
-	if (status != TEST_SUCCESS)
-		return status;
+	for (i = 0; i != RTE_DIM(layout_flags); i++) {
+		status = __test_lookup_order(0, layout_flags[i],
+				(union rte_ipsec_sad_key *)&tuple_v4,
+				(union rte_ipsec_sad_key *)&tuple_v4_1,
+				(union rte_ipsec_sad_key *)&tuple_v4_2);
+		if (status != TEST_SUCCESS)
+			return status;
+
+		status = __test_lookup_order(1, layout_flags[i],
+				(union rte_ipsec_sad_key *)&tuple_v6,
+				(union rte_ipsec_sad_key *)&tuple_v6_1,
+				(union rte_ipsec_sad_key *)&tuple_v6_2);
+		if (status != TEST_SUCCESS)
+			return status;
+	}
 
-	status = __test_lookup_order(1, (union rte_ipsec_sad_key *)&tuple_v6,
-			(union rte_ipsec_sad_key *)&tuple_v6_1,
-			(union rte_ipsec_sad_key *)&tuple_v6_2);
-	return status;
+	return TEST_SUCCESS;
 }
 
 static struct unit_test_suite ipsec_sad_tests = {
@@ -30,6 +30,8 @@ struct rte_member_setsum *setsum_ht;
 struct rte_member_setsum *setsum_cache;
 struct rte_member_setsum *setsum_vbf;
 struct rte_member_setsum *setsum_sketch;
+struct rte_member_setsum *setsum_cuckoo;
+struct rte_member_setsum *setsum_bbf;
 
 /* 5-tuple key type */
 struct __rte_packed_begin flow_key {
@@ -692,12 +694,157 @@ test_member_loadfactor(void)
 	return 0;
 }
 
+/*
+ * Sequence of operations for the single set filters
+ *
+ *  - add half of the generated keys, with set id 1 only
+ *  - lookup them single and bulk: no false negative
+ *  - lookup the other half: false positive rate
+ *  - delete them from cuckoo filter: empty, unsupported by blocked bloom
+ *  - fill cuckoo filter until no space: keys added before are kept
+ */
+static int
+test_member_filter(void)
+{
+	const void *key_ptrs[RTE_MEMBER_LOOKUP_BULK_MAX];
+	member_set_t set_ids[RTE_MEMBER_LOOKUP_BULK_MAX];
+	struct rte_member_setsum *filters[2];
+	unsigned int i, j, k, added_keys, false_hits;
+	member_set_t set_id;
+	int ret;
+
+	params.key_len = KEY_SIZE;
+	params.num_keys = MAX_ENTRIES / 2;
+	params.name = "test_member_cuckoo";
+	params.type = RTE_MEMBER_TYPE_CUCKOO;
+	setsum_cuckoo = rte_member_create(&params);
+
+	params.name = "test_member_bbf";
+	params.type = RTE_MEMBER_TYPE_BBF;
+	setsum_bbf = rte_member_create(&params);
+	params.num_keys = MAX_ENTRIES;
+
+	if (setsum_cuckoo == NULL || setsum_bbf == NULL) {
+		printf("Creation of filter setsums fail\n");
+		return -1;
+	}
+
+	filters[0] = setsum_cuckoo;
+	filters[1] = setsum_bbf;
+
+	for (j = 0; j < RTE_DIM(filters); j++) {
+		if (rte_member_add(filters[j], &generated_keys[0], 2) !=
+				-EINVAL) {
+			printf("filter add should fail with set id 2\n");
+			return -1;
+		}
+
+		for (i = 0; i < MAX_ENTRIES / 2; i++) {
+			if (rte_member_add(filters[j], &generated_keys[i],
+					1) != 0) {
+				printf("filter add fail\n");
+				return -1;
+			}
+		}
+
+		for (i = 0; i < MAX_ENTRIES / 2;
+				i += RTE_MEMBER_LOOKUP_BULK_MAX) {
+			for (k = 0; k < RTE_MEMBER_LOOKUP_BULK_MAX; k++)
+				key_ptrs[k] = &generated_keys[i + k];
+
+			ret = rte_member_lookup_bulk(filters[j], key_ptrs,
+					RTE_MEMBER_LOOKUP_BULK_MAX, set_ids);
+			if (ret != RTE_MEMBER_LOOKUP_BULK_MAX) {
+				printf("filter lookup bulk false negative\n");
+				return -1;
+			}
+
+			for (k = 0; k < RTE_MEMBER_LOOKUP_BULK_MAX; k++) {
+				if (set_ids[k] != 1 ||
+						rte_member_lookup(filters[j],
+						key_ptrs[k], &set_id) != 1 ||
+						set_id != 1) {
+					printf("filter lookup false negative\n");
+					return -1;
+				}
+			}
+		}
+
+		false_hits = 0;
+		for (i = MAX_ENTRIES / 2; i < MAX_ENTRIES;
+				i += RTE_MEMBER_LOOKUP_BULK_MAX) {
+			for (k = 0; k < RTE_MEMBER_LOOKUP_BULK_MAX; k++)
+				key_ptrs[k] = &generated_keys[i + k];
+
+			false_hits += rte_member_lookup_bulk(filters[j],
+					key_ptrs, RTE_MEMBER_LOOKUP_BULK_MAX,
+					set_ids);
+		}
+
+		printf("filter %u false positive rate = %.4f\n", j,
+			(double)false_hits / (MAX_ENTRIES / 2));
+		if (false_hits > params.false_positive_rate * MAX_ENTRIES) {
+			printf("filter false positive rate too high\n");
+			return -1;
+		}
+	}
+
+	if (rte_member_delete(setsum_bbf, &generated_keys[0], 1) != -EINVAL) {
+		printf("blocked bloom filter delete should fail\n");
+		return -1;
+	}
+
+	for (i = 0; i < MAX_ENTRIES / 2; i++) {
+		if (rte_member_delete(setsum_cuckoo, &generated_keys[i],
+				1) != 0) {
+			printf("cuckoo filter delete fail\n");
+			return -1;
+		}
+	}
+
+	for (i = 0; i < MAX_ENTRIES; i++) {
+		if (rte_member_lookup(setsum_cuckoo, &generated_keys[i],
+				&set_id) != 0) {
+			printf("cuckoo filter not empty after delete\n");
+			return -1;
+		}
+	}
+
+	/* Sized for half of the keys, adding all of them must fail */
+	ret = 0;
+	for (added_keys = 0; added_keys < MAX_ENTRIES; added_keys++) {
+		ret = rte_member_add(setsum_cuckoo, &generated_keys[added_keys],
+				1);
+		if (ret != 0)
+			break;
+	}
+	if (ret != -ENOSPC) {
+		printf("Unexpected error when adding keys\n");
+		return -1;
+	}
+
+	for (i = 0; i < added_keys; i++) {
+		if (rte_member_lookup(setsum_cuckoo, &generated_keys[i],
+				&set_id) != 1) {
+			printf("cuckoo filter lost a key when full\n");
+			return -1;
+		}
+	}
+
+	printf("Keys inserted when no space(cuckoo filter) = %u\n",
+		added_keys);
+
+	return 0;
+}
+
 static void
 perform_free(void)
 {
 	rte_member_free(setsum_ht);
 	rte_member_free(setsum_cache);
 	rte_member_free(setsum_vbf);
+	rte_member_free(setsum_cuckoo);
+	rte_member_free(setsum_bbf);
 }
 
 static void
@@ -869,6 +1016,85 @@ sketch_test(uint32_t *keys, uint32_t total_pkt, int count_byte, int reset_test)
 	return 0;
 }
 
+/*
+ * Per lcore sketch, updated by the main lcore only:
+ *  - nothing is seen before a merge
+ *  - merge with no decay: counts are at least the real ones
+ *  - merge with decay and no new packet: counts are scaled
+ *  - heavy hitters are reported from the merged sketch
+ *  - deletion and invalid decay are rejected
+ */
+static int
+sketch_lcore_test(uint32_t *keys, uint32_t total_pkt)
+{
+	uint64_t count[TOP_K], cnt, cnt_half;
+	uint32_t i, tmp_key = 0;
+	int hh_cnt;
+
+	params.name = "test_member_sketch_lcore";
+	params.error_rate = 0.001;
+	params.sample_rate = 1;
+	params.extra_flag = RTE_MEMBER_SKETCH_PER_LCORE;
+
+	setsum_sketch = rte_member_create(&params);
+	if (setsum_sketch == NULL) {
+		printf("Creation of per lcore sketch failed\n");
+		return -1;
+	}
+
+	for (i = 0; i < total_pkt; i++) {
+		if (rte_member_add(setsum_sketch, &keys[i], 1) < 0) {
+			printf("sketch add error\n");
+			goto error;
+		}
+	}
+
+	rte_member_query_count(setsum_sketch, &tmp_key, &cnt);
+	if (cnt != 0) {
+		printf("per lcore sketch counted before merge\n");
+		goto error;
+	}
+
+	if (rte_member_sketch_merge(setsum_sketch, 1) < 0)
+		goto error;
+	rte_member_query_count(setsum_sketch, &tmp_key, &cnt);
+	if (cnt < SKETCH_LARGEST_KEY_SIZE) {
+		printf("merged count %"PRIu64" below real count\n", cnt);
+		goto error;
+	}
+
+	if (rte_member_sketch_merge(setsum_sketch, 0.5) < 0)
+		goto error;
+	rte_member_query_count(setsum_sketch, &tmp_key, &cnt_half);
+	if (cnt_half != cnt / 2) {
+		printf("decayed count %"PRIu64" instead of %"PRIu64"\n",
+			cnt_half, cnt / 2);
+		goto error;
+	}
+
+	hh_cnt = rte_member_report_heavyhitter(setsum_sketch, heavy_hitters, count);
+	if (hh_cnt <= 0 || *(uint32_t *)heavy_hitters[0] != tmp_key ||
+			count[0] != cnt_half) {
+		printf("per lcore sketch report heavy hitter error\n");
+		goto error;
+	}
+
+	if (rte_member_delete(setsum_sketch, &tmp_key, 0) != -ENOTSUP ||
+			rte_member_sketch_merge(setsum_sketch, 2) != -EINVAL) {
+		printf("per lcore sketch accepted invalid operation\n");
+		goto error;
+	}
+
+	rte_member_free(setsum_sketch);
+	setsum_sketch = NULL;
+	return 0;
+
+error:
+	rte_member_free(setsum_sketch);
+	setsum_sketch = NULL;
+	return -1;
+}
+
 static int
 test_member_sketch(void)
 {
@@ -947,6 +1173,12 @@ test_member_sketch(void)
 		return -1;
 	}
 
+	printf("\n[Sketch with Per Lcore Mode]\n");
+	if (sketch_lcore_test(keys, total_pkt) < 0) {
+		rte_free(keys);
+		return -1;
+	}
+
 	rte_free(keys);
 	return 0;
 }
@@ -986,6 +1218,11 @@ test_member(void)
 		return -1;
 	}
 
+	if (test_member_filter() < 0) {
+		perform_free();
+		return -1;
+	}
+
 	if (test_member_sketch() < 0) {
 		perform_free();
 		return -1;
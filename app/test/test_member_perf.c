@@ -51,6 +51,8 @@ enum sstype {
 	HT = 0,
 	CACHE,
 	VBF,
+	CUCKOO,
+	BBF,
 	SKETCH,
 	SKETCH_BOUNDED,
 	SKETCH_BYTE,
@@ -168,6 +170,7 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 
 		data[HT][i] = data[CACHE][i] = (rte_rand() & 0x7FFE) + 1;
 		data[VBF][i] = rte_rand() % VBF_SET_CNT + 1;
+		data[CUCKOO][i] = data[BBF][i] = 1;
 	}
 
 	/* Remove duplicates from the keys array */
@@ -242,6 +245,18 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 	if (params->setsum[VBF] == NULL)
 		fprintf(stderr, "VBF create fail\n");
 
+	member_params.name = "test_member_cuckoo";
+	member_params.type = RTE_MEMBER_TYPE_CUCKOO;
+	params->setsum[CUCKOO] = rte_member_create(&member_params);
+	if (params->setsum[CUCKOO] == NULL)
+		fprintf(stderr, "cuckoo create fail\n");
+
+	member_params.name = "test_member_bbf";
+	member_params.type = RTE_MEMBER_TYPE_BBF;
+	params->setsum[BBF] = rte_member_create(&member_params);
+	if (params->setsum[BBF] == NULL)
+		fprintf(stderr, "BBF create fail\n");
+
 	member_params.name = "test_member_sketch";
 	member_params.key_len = params->key_size;
 	member_params.type = RTE_MEMBER_TYPE_SKETCH;
@@ -561,7 +576,7 @@ timed_deletes(struct member_perf_params *params, int type)
 	unsigned int i;
 	int32_t ret;
 
-	if (type == VBF)
+	if (type == VBF || type == BBF)
 		return 0;
 	const uint64_t start_tsc = rte_rdtsc();
 	for (i = 0; i < KEYS_TO_ADD; i++) {
@@ -12,6 +12,7 @@
 
 #include <rte_cycles.h>
 #include <rte_meter.h>
+#include <rte_random.h>
 
 #define mlog(format, ...) do{\
 		printf("Line %d:",__LINE__);\
@@ -676,6 +677,124 @@ tm_test_trtcm_rfc4115_color_aware_check(void)
 	return 0;
 }
 
+#define TM_TEST_BURST_METERS 8
+#define TM_TEST_BURST_SIZE 48
+#define TM_TEST_BURST_ITERS 1000
+
+/**
+ * functional test for burst metering, against the per packet API
+ */
+static inline int
+tm_test_color_check_burst(void)
+{
+#define BURST_CHECK_MSG "color_check_burst"
+	struct rte_meter_srtcm sm[TM_TEST_BURST_METERS], sm_ref[TM_TEST_BURST_METERS];
+	struct rte_meter_trtcm tm[TM_TEST_BURST_METERS], tm_ref[TM_TEST_BURST_METERS];
+	struct rte_meter_trtcm_rfc4115 rm[TM_TEST_BURST_METERS], rm_ref[TM_TEST_BURST_METERS];
+	struct rte_meter_srtcm_profile sp;
+	struct rte_meter_trtcm_profile tp;
+	struct rte_meter_trtcm_rfc4115_profile rp;
+	struct rte_meter_srtcm *smb[TM_TEST_BURST_SIZE];
+	struct rte_meter_srtcm_profile *spb[TM_TEST_BURST_SIZE];
+	struct rte_meter_trtcm *tmb[TM_TEST_BURST_SIZE];
+	struct rte_meter_trtcm_profile *tpb[TM_TEST_BURST_SIZE];
+	struct rte_meter_trtcm_rfc4115 *rmb[TM_TEST_BURST_SIZE];
+	struct rte_meter_trtcm_rfc4115_profile *rpb[TM_TEST_BURST_SIZE];
+	enum rte_color in[TM_TEST_BURST_SIZE], out[TM_TEST_BURST_SIZE];
+	uint32_t idx[TM_TEST_BURST_SIZE], len[TM_TEST_BURST_SIZE];
+	uint32_t i, j, n;
+	uint64_t time;
+	int aware;
+
+	if (rte_meter_srtcm_profile_config(&sp, &sparams) != 0)
+		melog(BURST_CHECK_MSG);
+	if (rte_meter_trtcm_profile_config(&tp, &tparams) != 0)
+		melog(BURST_CHECK_MSG);
+	if (rte_meter_trtcm_rfc4115_profile_config(&rp, &rfc4115params) != 0)
+		melog(BURST_CHECK_MSG);
+
+	for (i = 0; i < TM_TEST_BURST_METERS; i++) {
+		if (rte_meter_srtcm_config(&sm[i], &sp) != 0)
+			melog(BURST_CHECK_MSG);
+		if (rte_meter_trtcm_config(&tm[i], &tp) != 0)
+			melog(BURST_CHECK_MSG);
+		if (rte_meter_trtcm_rfc4115_config(&rm[i], &rp) != 0)
+			melog(BURST_CHECK_MSG);
+	}
+
+	memcpy(sm_ref, sm, sizeof(sm));
+	memcpy(tm_ref, tm, sizeof(tm));
+	memcpy(rm_ref, rm, sizeof(rm));
+	time = rte_get_tsc_cycles();
+
+	/* Few meters, so that bursts hit the same meter several times */
+	for (i = 0; i < TM_TEST_BURST_ITERS; i++) {
+		time += rte_rand_max(rte_get_tsc_hz() / 10000);
+		n = rte_rand_max(TM_TEST_BURST_SIZE + 1);
+		aware = rte_rand() & 1;
+
+		for (j = 0; j < n; j++) {
+			idx[j] = rte_rand_max(TM_TEST_BURST_METERS);
+			len[j] = rte_rand_max(TM_TEST_TRTCM_PBS_DF);
+			in[j] = rte_rand_max(RTE_COLORS);
+			smb[j] = &sm[idx[j]];
+			spb[j] = &sp;
+			tmb[j] = &tm[idx[j]];
+			tpb[j] = &tp;
+			rmb[j] = &rm[idx[j]];
+			rpb[j] = &rp;
+		}
+
+		if (aware)
+			rte_meter_srtcm_color_aware_check_burst(smb, spb, time, len, in, out, n);
+		else
+			rte_meter_srtcm_color_blind_check_burst(smb, spb, time, len, out, n);
+		for (j = 0; j < n; j++) {
+			if (out[j] != (aware ?
+				rte_meter_srtcm_color_aware_check(&sm_ref[idx[j]], &sp, time,
+					len[j], in[j]) :
+				rte_meter_srtcm_color_blind_check(&sm_ref[idx[j]], &sp, time,
+					len[j])))
+				melog(BURST_CHECK_MSG" srTCM");
+		}
+
+		if (aware)
+			rte_meter_trtcm_color_aware_check_burst(tmb, tpb, time, len, in, out, n);
+		else
+			rte_meter_trtcm_color_blind_check_burst(tmb, tpb, time, len, out, n);
+		for (j = 0; j < n; j++) {
+			if (out[j] != (aware ?
+				rte_meter_trtcm_color_aware_check(&tm_ref[idx[j]], &tp, time,
+					len[j], in[j]) :
+				rte_meter_trtcm_color_blind_check(&tm_ref[idx[j]], &tp, time,
+					len[j])))
+				melog(BURST_CHECK_MSG" trTCM");
+		}
+
+		if (aware)
+			rte_meter_trtcm_rfc4115_color_aware_check_burst(rmb, rpb, time, len,
+				in, out, n);
+		else
+			rte_meter_trtcm_rfc4115_color_blind_check_burst(rmb, rpb, time, len,
+				out, n);
+		for (j = 0; j < n; j++) {
+			if (out[j] != (aware ?
+				rte_meter_trtcm_rfc4115_color_aware_check(&rm_ref[idx[j]], &rp,
+					time, len[j], in[j]) :
+				rte_meter_trtcm_rfc4115_color_blind_check(&rm_ref[idx[j]], &rp,
+					time, len[j])))
+				melog(BURST_CHECK_MSG" trTCM RFC4115");
+		}
+
+		if (memcmp(sm, sm_ref, sizeof(sm)) != 0 ||
+		    memcmp(tm, tm_ref, sizeof(tm)) != 0 ||
+		    memcmp(rm, rm_ref, sizeof(rm)) != 0)
+			melog(BURST_CHECK_MSG" state");
+	}
+
+	return 0;
+}
+
 /**
  * test main entrance for library meter
  */
@@ -709,6 +828,9 @@ test_meter(void)
 	if (tm_test_trtcm_rfc4115_color_aware_check() != 0)
 		return -1;
 
+	if (tm_test_color_check_burst() != 0)
+		return -1;
+
 	return 0;
 
 }
@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_meter.h>
+#include <rte_random.h>
+
+#include "test.h"
+
+/*
+ * Compare per packet and burst metering, with packets spread randomly over a
+ * large number of meters, as done by per subscriber policers.
+ */
+
+#define PERF_NB_METERS		(1 << 20)
+#define PERF_NB_PKTS		(1 << 16)
+#define PERF_BURST		32
+#define PERF_ITERATIONS		64
+
+struct meter_perf_data {
+	uint32_t idx[PERF_NB_PKTS];
+	uint32_t len[PERF_NB_PKTS];
+	enum rte_color in[PERF_NB_PKTS];
+	enum rte_color out[PERF_NB_PKTS];
+};
+
+static void
+perf_data_init(struct meter_perf_data *d)
+{
+	uint32_t i;
+
+	for (i = 0; i < PERF_NB_PKTS; i++) {
+		d->idx[i] = rte_rand_max(PERF_NB_METERS);
+		d->len[i] = 64 + rte_rand_max(1454);
+		d->in[i] = rte_rand_max(RTE_COLORS);
+	}
+}
+
+static void
+perf_print(const char *name, uint64_t tsc)
+{
+	printf("%-40s %8.2f cycles/pkt\n", name,
+	       (double)tsc / (PERF_NB_PKTS * PERF_ITERATIONS));
+}
+
+static int
+perf_srtcm(struct meter_perf_data *d)
+{
+	struct rte_meter_srtcm_params params = {
+		.cir = 1000000, .cbs = 4096, .ebs = 8192,
+	};
+	struct rte_meter_srtcm_profile *pb[PERF_BURST];
+	struct rte_meter_srtcm *mb[PERF_BURST];
+	struct rte_meter_srtcm_profile sp;
+	struct rte_meter_srtcm *m;
+	uint64_t start, tsc, time;
+	uint32_t i, j, k;
+
+	m = rte_zmalloc(NULL, sizeof(*m) * PERF_NB_METERS, RTE_CACHE_LINE_SIZE);
+	if (m == NULL)
+		return -1;
+
+	if (rte_meter_srtcm_profile_config(&sp, &params) != 0)
+		goto fail;
+	for (i = 0; i < PERF_NB_METERS; i++)
+		rte_meter_srtcm_config(&m[i], &sp);
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i++)
+			d->out[i] = rte_meter_srtcm_color_blind_check(&m[d->idx[i]], &sp,
+					rte_rdtsc(), d->len[i]);
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("srTCM blind, per packet", tsc);
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i += PERF_BURST) {
+			time = rte_rdtsc();
+			for (j = i; j < i + PERF_BURST; j++)
+				d->out[j] = rte_meter_srtcm_color_blind_check(&m[d->idx[j]],
+						&sp, time, d->len[j]);
+		}
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("srTCM blind, per packet, time per burst", tsc);
+
+	for (j = 0; j < PERF_BURST; j++)
+		pb[j] = &sp;
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i += PERF_BURST) {
+			for (j = 0; j < PERF_BURST; j++)
+				mb[j] = &m[d->idx[i + j]];
+			rte_meter_srtcm_color_blind_check_burst(mb, pb, rte_rdtsc(),
+					&d->len[i], &d->out[i], PERF_BURST);
+		}
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("srTCM blind, burst", tsc);
+
+	rte_free(m);
+	return 0;
+
+fail:
+	rte_free(m);
+	return -1;
+}
+
+static int
+perf_trtcm(struct meter_perf_data *d)
+{
+	struct rte_meter_trtcm_params params = {
+		.cir = 1000000, .pir = 2000000, .cbs = 4096, .pbs = 8192,
+	};
+	struct rte_meter_trtcm_profile *pb[PERF_BURST];
+	struct rte_meter_trtcm *mb[PERF_BURST];
+	struct rte_meter_trtcm_profile tp;
+	struct rte_meter_trtcm *m;
+	uint64_t start, tsc, time;
+	uint32_t i, j, k;
+
+	m = rte_zmalloc(NULL, sizeof(*m) * PERF_NB_METERS, RTE_CACHE_LINE_SIZE);
+	if (m == NULL)
+		return -1;
+
+	if (rte_meter_trtcm_profile_config(&tp, &params) != 0)
+		goto fail;
+	for (i = 0; i < PERF_NB_METERS; i++)
+		rte_meter_trtcm_config(&m[i], &tp);
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i++)
+			d->out[i] = rte_meter_trtcm_color_aware_check(&m[d->idx[i]], &tp,
+					rte_rdtsc(), d->len[i], d->in[i]);
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("trTCM aware, per packet", tsc);
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i += PERF_BURST) {
+			time = rte_rdtsc();
+			for (j = i; j < i + PERF_BURST; j++)
+				d->out[j] = rte_meter_trtcm_color_aware_check(&m[d->idx[j]],
+						&tp, time, d->len[j], d->in[j]);
+		}
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("trTCM aware, per packet, time per burst", tsc);
+
+	for (j = 0; j < PERF_BURST; j++)
+		pb[j] = &tp;
+
+	start = rte_rdtsc_precise();
+	for (k = 0; k < PERF_ITERATIONS; k++)
+		for (i = 0; i < PERF_NB_PKTS; i += PERF_BURST) {
+			for (j = 0; j < PERF_BURST; j++)
+				mb[j] = &m[d->idx[i + j]];
+			rte_meter_trtcm_color_aware_check_burst(mb, pb, rte_rdtsc(),
+					&d->len[i], &d->in[i], &d->out[i], PERF_BURST);
+		}
+	tsc = rte_rdtsc_precise() - start;
+	perf_print("trTCM aware, burst", tsc);
+
+	rte_free(m);
+	return 0;
+
+fail:
+	rte_free(m);
+	return -1;
+}
+
+static int
+test_meter_perf(void)
+{
+	struct meter_perf_data *d;
+	int ret;
+
+	d = rte_zmalloc(NULL, sizeof(*d), RTE_CACHE_LINE_SIZE);
+	if (d == NULL)
+		return TEST_FAILED;
+
+	perf_data_init(d);
+
+	printf("%u meters, %u packets, burst %u\n",
+	       PERF_NB_METERS, PERF_NB_PKTS, PERF_BURST);
+
+	ret = perf_srtcm(d);
+	if (ret == 0)
+		ret = perf_trtcm(d);
+
+	rte_free(d);
+
+	return ret == 0 ? TEST_SUCCESS : TEST_FAILED;
+}
+
+REGISTER_PERF_TEST(meter_perf_autotest, test_meter_perf);
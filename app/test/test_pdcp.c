@@ -2101,6 +2101,98 @@ test_combined_data_walkthrough(struct pdcp_test_conf *test_conf)
 	return TEST_SUCCESS;
 }
 
+#define PARALLEL_NB_PKT 16
+
+static int
+test_parallel(struct pdcp_test_conf *t_conf)
+{
+	struct rte_mbuf *mb[PARALLEL_NB_PKT], **out_mb = NULL;
+	struct rte_pdcp_parallel_conf par_conf = {0};
+	struct rte_pdcp_parallel *par = NULL;
+	struct rte_pdcp_entity *pdcp_entity;
+	uint16_t i, nb_pkt, nb_out, nb_err;
+	uint32_t sn, prev_sn = 0;
+	int ret = 0;
+
+	const enum rte_security_pdcp_sn_size sn_size = t_conf->entity.pdcp_xfrm.sn_size;
+	const bool is_ul = t_conf->entity.pdcp_xfrm.pkt_dir == RTE_SECURITY_PDCP_UPLINK;
+
+	pdcp_entity = test_entity_create(t_conf, &ret);
+	if (pdcp_entity == NULL)
+		return ret;
+
+	out_mb = rte_malloc(NULL, (pdcp_entity->max_pkt_cache + PARALLEL_NB_PKT) *
+			    sizeof(uintptr_t), 0);
+	if (out_mb == NULL) {
+		ret = -ENOMEM;
+		goto entity_release;
+	}
+
+	par_conf.name = "test_pdcp_parallel";
+	par_conf.entity = pdcp_entity;
+	par_conf.nb_elem = PARALLEL_NB_PKT;
+	par_conf.socket_id = SOCKET_ID_ANY;
+
+	par = rte_pdcp_parallel_create(&par_conf);
+	if (par == NULL) {
+		RTE_LOG(ERR, USER1, "Could not create PDCP parallel context\n");
+		ret = TEST_FAILED;
+		goto entity_release;
+	}
+
+	/* Same SDU transmitted several times must get consecutive SNs */
+	nb_pkt = is_ul ? PARALLEL_NB_PKT : 1;
+
+	for (i = 0; i < nb_pkt; i++) {
+		mb[i] = mbuf_from_data_create(t_conf->input, t_conf->input_len);
+		if (mb[i] == NULL) {
+			rte_pktmbuf_free_bulk(mb, i);
+			ret = -ENOMEM;
+			goto parallel_free;
+		}
+	}
+
+	if (rte_pdcp_parallel_enqueue(par, mb, nb_pkt) != nb_pkt) {
+		RTE_LOG(ERR, USER1, "Could not enqueue PDCP packets\n");
+		rte_pktmbuf_free_bulk(mb, nb_pkt);
+		ret = TEST_FAILED;
+		goto parallel_free;
+	}
+
+	/* Split the work in small batches, as several workers would */
+	while (rte_pdcp_parallel_process(par, 0, 3) != 0)
+		;
+
+	nb_out = rte_pdcp_parallel_dequeue(par, out_mb, nb_pkt, &nb_err);
+	if (nb_out != nb_pkt || nb_err != 0) {
+		RTE_LOG(ERR, USER1, "Could not process PDCP packets in parallel mode\n");
+		rte_pktmbuf_free_bulk(out_mb, nb_out + nb_err);
+		ret = TEST_FAILED;
+		goto parallel_free;
+	}
+
+	ret = pdcp_known_vec_verify(out_mb[0], t_conf->output, t_conf->output_len);
+
+	for (i = 0; is_ul && i < nb_out && ret == 0; i++) {
+		sn = pdcp_sn_from_raw_get(rte_pktmbuf_mtod(out_mb[i], void *), sn_size);
+		if (i != 0 && sn != ((prev_sn + 1) & pdcp_sn_mask_get(sn_size))) {
+			RTE_LOG(ERR, USER1, "Packet %u out of order, SN %u after %u\n",
+				i, sn, prev_sn);
+			ret = TEST_FAILED;
+		}
+		prev_sn = sn;
+	}
+
+	rte_pktmbuf_free_bulk(out_mb, nb_out);
+
+parallel_free:
+	rte_pdcp_parallel_free(par);
+entity_release:
+	rte_pdcp_entity_release(pdcp_entity, out_mb);
+	rte_free(out_mb);
+	return ret;
+}
+
 #ifdef RTE_LIB_EVENTDEV
 static inline void
 eventdev_conf_default_set(struct rte_event_dev_config *dev_conf, struct rte_event_dev_info *info)
@@ -2243,6 +2335,15 @@ static struct unit_test_suite combined_mode_cases  = {
 	}
 };
 
+static struct unit_test_suite parallel_mode_cases  = {
+	.suite_name = "PDCP parallel mode",
+	.unit_test_cases = {
+		TEST_CASE_NAMED_WITH_DATA("parallel mode", ut_setup_pdcp, ut_teardown_pdcp,
+			run_test_with_all_known_vec, test_parallel),
+		TEST_CASES_END() /**< NULL terminate unit test array */
+	}
+};
+
 static struct unit_test_suite hfn_sn_test_cases  = {
 	.suite_name = "PDCP HFN/SN",
 	.unit_test_cases = {
@@ -2334,6 +2435,7 @@ struct unit_test_suite *test_suites[] = {
 	NULL, /* Place holder for known_vector_cases */
 	&sdap_test_cases,
 	&combined_mode_cases,
+	&parallel_mode_cases,
 	&hfn_sn_test_cases,
 	&reorder_test_cases,
 	&status_report_test_cases,
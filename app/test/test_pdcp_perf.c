@@ -0,0 +1,408 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <stdio.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cryptodev.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_pdcp.h>
+
+#include "test.h"
+
+/*
+ * Compare throughput of one PDCP entity processed by a single lcore against
+ * the same entity spread over several workers with rte_pdcp_parallel API.
+ *
+ * A device supporting AES-CTR is used when present (e.g. --vdev=crypto_aesni_mb),
+ * otherwise a crypto_null device is created and only the lib PDCP overhead
+ * is measured.
+ */
+
+#define PERF_NB_PKTS		(1 << 19)
+#define PERF_BURST		32
+#define PERF_PKT_LEN		1024
+#define PERF_NB_MBUF		16383
+#define PERF_NB_DESC		2048
+#define PERF_RING_SIZE		1024
+#define PERF_CACHE_SIZE		256
+#define PERF_KEY_LEN		16
+#define PERF_IV_LEN		16
+#define PERF_NULL_CDEV		"crypto_null_pdcp_perf"
+
+struct pdcp_perf_params {
+	struct rte_mempool *mbuf_pool;
+	struct rte_mempool *cop_pool;
+	struct rte_mempool *sess_pool;
+	struct rte_crypto_sym_xform c_xfrm;
+	uint8_t dev_id;
+	uint16_t nb_qp;
+	bool null_cdev;
+};
+
+static struct pdcp_perf_params perf_params;
+
+static const uint8_t perf_key[PERF_KEY_LEN] = {
+	0x5a, 0xcb, 0x1d, 0x64, 0x4c, 0x0d, 0x51, 0x20,
+	0x4e, 0xa5, 0xf1, 0x45, 0x10, 0x10, 0xd8, 0x52,
+};
+
+struct pdcp_perf_worker {
+	struct rte_pdcp_parallel *par;
+	RTE_ATOMIC(uint32_t) *stop;
+	uint16_t qp_id;
+};
+
+static int
+perf_cdev_find(void)
+{
+	struct pdcp_perf_params *p = &perf_params;
+	const struct rte_cryptodev_symmetric_capability *cap;
+	struct rte_cryptodev_sym_capability_idx cap_idx;
+	int i, dev_id, nb_devs;
+
+	cap_idx.type = RTE_CRYPTO_SYM_XFORM_CIPHER;
+	cap_idx.algo.cipher = RTE_CRYPTO_CIPHER_AES_CTR;
+
+	nb_devs = rte_cryptodev_count();
+	for (i = 0; i < nb_devs; i++) {
+		cap = rte_cryptodev_sym_capability_get(i, &cap_idx);
+		if (cap != NULL && rte_cryptodev_sym_capability_check_cipher(cap,
+				PERF_KEY_LEN, PERF_IV_LEN) == 0) {
+			p->c_xfrm.cipher.algo = RTE_CRYPTO_CIPHER_AES_CTR;
+			p->c_xfrm.cipher.key.data = perf_key;
+			p->c_xfrm.cipher.key.length = PERF_KEY_LEN;
+			p->c_xfrm.cipher.iv.length = PERF_IV_LEN;
+			return i;
+		}
+	}
+
+	if (rte_vdev_init(PERF_NULL_CDEV, NULL) != 0)
+		return -ENODEV;
+
+	dev_id = rte_cryptodev_get_dev_id(PERF_NULL_CDEV);
+	if (dev_id < 0)
+		return dev_id;
+
+	p->null_cdev = true;
+	p->c_xfrm.cipher.algo = RTE_CRYPTO_CIPHER_NULL;
+
+	return dev_id;
+}
+
+static int
+perf_cdev_init(void)
+{
+	struct pdcp_perf_params *p = &perf_params;
+	struct rte_cryptodev_qp_conf qp_conf = { 0 };
+	struct rte_cryptodev_config config = { 0 };
+	struct rte_cryptodev_info info;
+	int dev_id, socket_id;
+	uint16_t qp;
+
+	dev_id = perf_cdev_find();
+	if (dev_id < 0)
+		return dev_id;
+
+	p->dev_id = dev_id;
+	rte_cryptodev_info_get(p->dev_id, &info);
+	socket_id = rte_cryptodev_socket_id(p->dev_id);
+
+	/* One queue pair per lcore, the main one is for the single-core run */
+	p->nb_qp = RTE_MIN(rte_lcore_count(), info.max_nb_queue_pairs);
+
+	rte_cryptodev_stop(p->dev_id);
+
+	config.nb_queue_pairs = p->nb_qp;
+	config.socket_id = socket_id;
+	if (rte_cryptodev_configure(p->dev_id, &config) < 0)
+		return -ENODEV;
+
+	qp_conf.nb_descriptors = PERF_NB_DESC;
+	for (qp = 0; qp < p->nb_qp; qp++) {
+		if (rte_cryptodev_queue_pair_setup(p->dev_id, qp, &qp_conf, socket_id) < 0)
+			return -ENODEV;
+	}
+
+	if (rte_cryptodev_start(p->dev_id) < 0)
+		return -ENODEV;
+
+	p->sess_pool = rte_cryptodev_sym_session_pool_create("pdcp_perf_sess", 16,
+			rte_cryptodev_sym_get_private_session_size(p->dev_id), 0, 0,
+			socket_id);
+	if (p->sess_pool == NULL)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static int
+perf_setup(void)
+{
+	struct pdcp_perf_params *p = &perf_params;
+	int ret;
+
+	memset(p, 0, sizeof(*p));
+	p->c_xfrm.type = RTE_CRYPTO_SYM_XFORM_CIPHER;
+	p->c_xfrm.cipher.op = RTE_CRYPTO_CIPHER_OP_ENCRYPT;
+
+	ret = perf_cdev_init();
+	if (ret != 0) {
+		printf("Could not initialize crypto device: %d\n", ret);
+		return ret;
+	}
+
+	p->mbuf_pool = rte_pktmbuf_pool_create("pdcp_perf_mbuf", PERF_NB_MBUF,
+			PERF_CACHE_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (p->mbuf_pool == NULL)
+		return -ENOMEM;
+
+	p->cop_pool = rte_crypto_op_pool_create("pdcp_perf_cop",
+			RTE_CRYPTO_OP_TYPE_SYMMETRIC, PERF_NB_MBUF, PERF_CACHE_SIZE,
+			2 * PERF_IV_LEN, SOCKET_ID_ANY);
+	if (p->cop_pool == NULL)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void
+perf_teardown(void)
+{
+	struct pdcp_perf_params *p = &perf_params;
+
+	rte_cryptodev_stop(p->dev_id);
+	if (p->null_cdev)
+		rte_vdev_uninit(PERF_NULL_CDEV);
+
+	rte_mempool_free(p->sess_pool);
+	rte_mempool_free(p->cop_pool);
+	rte_mempool_free(p->mbuf_pool);
+}
+
+static struct rte_pdcp_entity *
+perf_entity_create(void)
+{
+	struct pdcp_perf_params *p = &perf_params;
+	struct rte_pdcp_entity_conf conf = { 0 };
+
+	conf.pdcp_xfrm.domain = RTE_SECURITY_PDCP_MODE_DATA;
+	conf.pdcp_xfrm.pkt_dir = RTE_SECURITY_PDCP_UPLINK;
+	conf.pdcp_xfrm.sn_size = RTE_SECURITY_PDCP_SN_SIZE_18;
+	conf.pdcp_xfrm.bearer = 1;
+	conf.crypto_xfrm = &p->c_xfrm;
+	conf.sess_mpool = p->sess_pool;
+	conf.cop_pool = p->cop_pool;
+	conf.ctrl_pdu_pool = p->mbuf_pool;
+	conf.dev_id = p->dev_id;
+
+	return rte_pdcp_entity_establish(&conf);
+}
+
+static int
+perf_burst_alloc(struct rte_mbuf *mb[], uint16_t num)
+{
+	uint16_t i;
+
+	if (rte_pktmbuf_alloc_bulk(perf_params.mbuf_pool, mb, num) != 0)
+		return -ENOMEM;
+
+	for (i = 0; i < num; i++)
+		rte_pktmbuf_append(mb[i], PERF_PKT_LEN);
+
+	return 0;
+}
+
+/* Baseline: the whole processing of the entity done by one lcore. */
+static int
+perf_single_core(struct rte_pdcp_entity *entity, uint64_t *tsc)
+{
+	struct rte_mbuf *mb[PERF_BURST], *out_mb[PERF_BURST];
+	struct rte_crypto_op *cop[PERF_BURST];
+	struct rte_pdcp_group grp[PERF_BURST];
+	uint16_t nb_cop, nb_err, nb_deq, nb_grp, nb_out, n;
+	const uint8_t dev_id = perf_params.dev_id;
+	uint64_t start;
+	uint32_t i;
+
+	start = rte_rdtsc_precise();
+
+	for (i = 0; i < PERF_NB_PKTS; i += PERF_BURST) {
+		if (perf_burst_alloc(mb, PERF_BURST) != 0)
+			return -ENOMEM;
+
+		nb_cop = rte_pdcp_pkt_pre_process(entity, mb, cop, PERF_BURST, &nb_err);
+		if (nb_cop != PERF_BURST)
+			return -EIO;
+
+		n = 0;
+		while (n != nb_cop)
+			n += rte_cryptodev_enqueue_burst(dev_id, 0, cop + n, nb_cop - n);
+
+		nb_deq = 0;
+		while (nb_deq != nb_cop)
+			nb_deq += rte_cryptodev_dequeue_burst(dev_id, 0, cop + nb_deq,
+							      nb_cop - nb_deq);
+
+		nb_grp = rte_pdcp_pkt_crypto_group(cop, mb, grp, nb_deq);
+		for (n = 0; n < nb_grp; n++) {
+			nb_out = rte_pdcp_pkt_post_process(entity, grp[n].m, out_mb,
+							   grp[n].cnt, &nb_err);
+			rte_pktmbuf_free_bulk(out_mb, nb_out + nb_err);
+		}
+	}
+
+	*tsc = rte_rdtsc_precise() - start;
+
+	return 0;
+}
+
+static int
+perf_worker(void *arg)
+{
+	struct pdcp_perf_worker *w = arg;
+
+	while (rte_atomic_load_explicit(w->stop, rte_memory_order_relaxed) == 0)
+		rte_pdcp_parallel_process(w->par, w->qp_id, PERF_BURST);
+
+	return 0;
+}
+
+/* Main lcore distributes and merges, workers do pre-process and crypto. */
+static int
+perf_parallel(struct rte_pdcp_entity *entity, uint16_t nb_worker, uint64_t *tsc)
+{
+	struct pdcp_perf_worker worker[RTE_MAX_LCORE];
+	struct rte_pdcp_parallel_conf conf = { 0 };
+	struct rte_mbuf *mb[PERF_BURST], *out_mb[PERF_BURST];
+	RTE_ATOMIC(uint32_t) stop = 0;
+	struct rte_pdcp_parallel *par;
+	uint32_t nb_enq = 0, nb_done = 0;
+	uint16_t n, nb_out, nb_err;
+	unsigned int lcore_id;
+	uint64_t start;
+	uint16_t w = 0;
+	int ret = 0;
+
+	conf.name = "pdcp_perf_par";
+	conf.entity = entity;
+	conf.nb_elem = PERF_RING_SIZE;
+	conf.socket_id = SOCKET_ID_ANY;
+
+	par = rte_pdcp_parallel_create(&conf);
+	if (par == NULL)
+		return -rte_errno;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (w == nb_worker)
+			break;
+		worker[w].par = par;
+		worker[w].stop = &stop;
+		/* Queue pair 0 is left to the single-core run */
+		worker[w].qp_id = w + 1;
+		rte_eal_remote_launch(perf_worker, &worker[w], lcore_id);
+		w++;
+	}
+
+	start = rte_rdtsc_precise();
+
+	while (nb_done < PERF_NB_PKTS) {
+		/* Keep the number of packets in flight within the ring size */
+		if (nb_enq < PERF_NB_PKTS && nb_enq - nb_done <= PERF_RING_SIZE - PERF_BURST &&
+		    perf_burst_alloc(mb, PERF_BURST) == 0) {
+			n = rte_pdcp_parallel_enqueue(par, mb, PERF_BURST);
+			if (n != PERF_BURST)
+				rte_pktmbuf_free_bulk(mb + n, PERF_BURST - n);
+			nb_enq += n;
+		}
+
+		nb_out = rte_pdcp_parallel_dequeue(par, out_mb, PERF_BURST, &nb_err);
+		rte_pktmbuf_free_bulk(out_mb, nb_out + nb_err);
+		nb_done += nb_out + nb_err;
+		if (nb_err != 0)
+			ret = -EIO;
+	}
+
+	*tsc = rte_rdtsc_precise() - start;
+
+	rte_atomic_store_explicit(&stop, 1, rte_memory_order_relaxed);
+	rte_eal_mp_wait_lcore();
+
+	rte_pdcp_parallel_free(par);
+
+	return ret;
+}
+
+static void
+perf_result_print(const char *mode, uint64_t tsc, uint64_t base_tsc)
+{
+	double mpps = (double)PERF_NB_PKTS * rte_get_tsc_hz() / tsc / 1E6;
+
+	printf("%-24s %10.2f cycles/pkt %8.2f Mpps %6.2fx\n", mode,
+	       (double)tsc / PERF_NB_PKTS, mpps, (double)base_tsc / tsc);
+}
+
+static int
+test_pdcp_perf(void)
+{
+	struct rte_pdcp_entity *entity = NULL;
+	uint64_t base_tsc, tsc;
+	char mode[32];
+	uint16_t w;
+	int ret;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough lcores, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	ret = perf_setup();
+	if (ret != 0) {
+		perf_teardown();
+		return ret == -ENODEV ? TEST_SKIPPED : TEST_FAILED;
+	}
+
+	printf("PDCP UL, %s, %u bytes, burst %u\n",
+	       perf_params.null_cdev ? "NULL cipher" : "AES-CTR", PERF_PKT_LEN, PERF_BURST);
+
+	entity = perf_entity_create();
+	if (entity == NULL) {
+		ret = TEST_FAILED;
+		goto exit;
+	}
+
+	ret = perf_single_core(entity, &base_tsc);
+	if (ret != 0) {
+		printf("Single core run failed: %d\n", ret);
+		ret = TEST_FAILED;
+		goto exit;
+	}
+	perf_result_print("single core", base_tsc, base_tsc);
+
+	for (w = 1; w < perf_params.nb_qp; w++) {
+		ret = perf_parallel(entity, w, &tsc);
+		if (ret != 0) {
+			printf("Parallel run with %u workers failed: %d\n", w, ret);
+			ret = TEST_FAILED;
+			goto exit;
+		}
+		snprintf(mode, sizeof(mode), "parallel, %u workers", w);
+		perf_result_print(mode, tsc, base_tsc);
+	}
+
+	ret = TEST_SUCCESS;
+
+exit:
+	if (entity != NULL)
+		rte_pdcp_entity_release(entity, NULL);
+	perf_teardown();
+	return ret;
+}
+
+REGISTER_PERF_TEST(pdcp_perf_autotest, test_pdcp_perf);
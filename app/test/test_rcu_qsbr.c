@@ -5,11 +5,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <rte_pause.h>
+#include <rte_rcu_ebr.h>
 #include <rte_rcu_qsbr.h>
 #include <rte_hash.h>
 #include <rte_hash_crc.h>
 #include <rte_malloc.h>
 #include <rte_cycles.h>
+#include <rte_errno.h>
 #include <rte_random.h>
 #include <unistd.h>
 
@@ -1331,6 +1333,133 @@ test_rcu_qsbr_mw_mv_mqs(void)
 	return -1;
 }
 
+/*
+ * rte_rcu_ebr_check: a grace period is over once the readers in a critical
+ * section entered it after the grace period started.
+ */
+static int
+test_rcu_ebr_check(void)
+{
+	struct rte_rcu_ebr *e;
+	uint64_t token;
+	size_t sz;
+
+	printf("\nTest rte_rcu_ebr_check()\n");
+
+	sz = rte_rcu_ebr_get_memsize(RTE_MAX_LCORE);
+	e = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	TEST_RCU_QSBR_RETURN_IF_ERROR((e == NULL), "EBR allocation");
+	rte_rcu_ebr_init(e, RTE_MAX_LCORE);
+
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_rcu_ebr_thread_register(e, RTE_MAX_LCORE) == 0),
+		"Register invalid thread id");
+	rte_rcu_ebr_thread_register(e, 0);
+	rte_rcu_ebr_thread_register(e, 1);
+
+	/* Readers outside of critical sections do not delay the writer */
+	token = rte_rcu_ebr_start(e);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_rcu_ebr_check(e, token, false) != 1), "No reader");
+
+	rte_rcu_ebr_read_lock(e, 0);
+	rte_rcu_ebr_read_lock(e, 0);
+	token = rte_rcu_ebr_start(e);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_rcu_ebr_check(e, token, false) != 0), "Reader in old epoch");
+
+	/* A reader entering after the start does not delay the writer */
+	rte_rcu_ebr_read_lock(e, 1);
+	rte_rcu_ebr_read_unlock(e, 0);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_rcu_ebr_check(e, token, false) != 0), "Nested critical section");
+
+	rte_rcu_ebr_read_unlock(e, 0);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_rcu_ebr_check(e, token, false) != 1), "Reader in new epoch");
+	rte_rcu_ebr_read_unlock(e, 1);
+
+	rte_rcu_ebr_synchronize(e);
+	rte_rcu_ebr_dump(stdout, e);
+
+	rte_free(e);
+	return 0;
+
+error:
+	rte_free(e);
+	return -1;
+}
+
+/*
+ * rte_rcu_ebr_dq_xxx and rte_hash_rcu_ebr_add: deleted keys are not reused
+ * while a reader is in a critical section entered before the delete.
+ */
+static int
+test_rcu_ebr_hash(void)
+{
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	struct rte_hash_parameters hash_params = {
+		.name = "test_ebr",
+		.entries = 16,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_hash_crc,
+		.socket_id = SOCKET_ID_ANY,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+	struct rte_hash *hash = NULL;
+	struct rte_rcu_ebr *e;
+	unsigned int freed, pending;
+	uint32_t key = 1;
+	size_t sz;
+
+	printf("\nTest rte_hash_rcu_ebr_add()\n");
+
+	sz = rte_rcu_ebr_get_memsize(RTE_MAX_LCORE);
+	e = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	TEST_RCU_QSBR_RETURN_IF_ERROR((e == NULL), "EBR allocation");
+	rte_rcu_ebr_init(e, RTE_MAX_LCORE);
+	rte_rcu_ebr_thread_register(e, 0);
+
+	hash = rte_hash_create(&hash_params);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error, (hash == NULL), "Hash creation");
+
+	rcu_cfg.v = t[0];
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_hash_rcu_ebr_add(hash, &rcu_cfg, e) == 0),
+		"EBR added with a QSBR variable");
+	rcu_cfg.v = NULL;
+	rcu_cfg.mode = RTE_HASH_QSBR_MODE_DQ;
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_hash_rcu_ebr_add(hash, &rcu_cfg, e) != 0), "EBR add");
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_hash_rcu_ebr_add(hash, &rcu_cfg, e) == 0 ||
+		 rte_errno != EEXIST), "EBR added twice");
+
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_hash_add_key(hash, &key) < 0), "Key add");
+
+	rte_rcu_ebr_read_lock(e, 0);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error,
+		(rte_hash_del_key(hash, &key) < 0), "Key delete");
+	rte_hash_rcu_qsbr_dq_reclaim(hash, &freed, &pending, NULL);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error, (freed != 0 || pending != 1),
+		"Key freed in a grace period");
+	rte_rcu_ebr_read_unlock(e, 0);
+
+	rte_hash_rcu_qsbr_dq_reclaim(hash, &freed, &pending, NULL);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(error, (freed != 1 || pending != 0),
+		"Key not freed after the grace period");
+
+	rte_hash_free(hash);
+	rte_free(e);
+	return 0;
+
+error:
+	rte_hash_free(hash);
+	rte_free(e);
+	return -1;
+}
+
 static int
 test_rcu_qsbr_main(void)
 {
@@ -1407,6 +1536,12 @@ test_rcu_qsbr_main(void)
 	if (test_rcu_qsbr_dq_functional(7, 128, RTE_RCU_QSBR_DQ_MT_UNSAFE) < 0)
 		goto test_fail;
 
+	if (test_rcu_ebr_check() < 0)
+		goto test_fail;
+
+	if (test_rcu_ebr_hash() < 0)
+		goto test_fail;
+
 	free_rcu();
 
 	printf("\n");
@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <rte_pause.h>
+#include <rte_rcu_ebr.h>
 #include <rte_rcu_qsbr.h>
 #include <rte_hash.h>
 #include <rte_hash_crc.h>
@@ -28,6 +29,7 @@ static volatile uint8_t all_registered;
 static volatile RTE_ATOMIC(uint32_t) thr_id;
 
 static struct rte_rcu_qsbr *t[RTE_MAX_LCORE];
+static struct rte_rcu_ebr *ebr;
 static struct rte_hash *h;
 static char hash_name[8];
 static RTE_ATOMIC(uint64_t) updates;
@@ -613,6 +615,175 @@ test_rcu_qsbr_sw_sv_1qs_non_blocking(void)
 	return -1;
 }
 
+static int
+test_rcu_ebr_reader_perf(void *arg)
+{
+	bool writer_present = (bool)arg;
+	uint32_t thread_id = alloc_thread_id();
+	uint64_t loop_cnt = 0;
+	uint64_t begin, cycles;
+
+	rte_rcu_ebr_thread_register(ebr, thread_id);
+
+	begin = rte_rdtsc_precise();
+
+	if (writer_present) {
+		while (!writer_done) {
+			/* Empty read-side critical section */
+			rte_rcu_ebr_read_lock(ebr, thread_id);
+			rte_rcu_ebr_read_unlock(ebr, thread_id);
+			loop_cnt++;
+		}
+	} else {
+		while (loop_cnt < 100000000) {
+			/* Empty read-side critical section */
+			rte_rcu_ebr_read_lock(ebr, thread_id);
+			rte_rcu_ebr_read_unlock(ebr, thread_id);
+			loop_cnt++;
+		}
+	}
+
+	cycles = rte_rdtsc_precise() - begin;
+	rte_atomic_fetch_add_explicit(&update_cycles, cycles, rte_memory_order_relaxed);
+	rte_atomic_fetch_add_explicit(&updates, loop_cnt, rte_memory_order_relaxed);
+
+	rte_rcu_ebr_thread_unregister(ebr, thread_id);
+
+	return 0;
+}
+
+static int
+test_rcu_ebr_writer_perf(__rte_unused void *arg)
+{
+	uint64_t loop_cnt = 0;
+	uint64_t begin, cycles;
+
+	begin = rte_rdtsc_precise();
+
+	do {
+		rte_rcu_ebr_synchronize(ebr);
+		loop_cnt++;
+	} while (loop_cnt < 20000000);
+
+	cycles = rte_rdtsc_precise() - begin;
+	rte_atomic_fetch_add_explicit(&check_cycles, cycles, rte_memory_order_relaxed);
+	rte_atomic_fetch_add_explicit(&checks, loop_cnt, rte_memory_order_relaxed);
+	return 0;
+}
+
+static int
+test_rcu_ebr_init(unsigned int max_threads)
+{
+	size_t sz;
+
+	sz = rte_rcu_ebr_get_memsize(max_threads);
+	ebr = rte_zmalloc("ebr", sz, RTE_CACHE_LINE_SIZE);
+	if (ebr == NULL) {
+		printf("No memory\n");
+		return -1;
+	}
+
+	return rte_rcu_ebr_init(ebr, max_threads);
+}
+
+/*
+ * Perf test: Reader/writer, epoch based reclamation
+ * Single writer, Multiple Readers, Single EBR var, Blocking rcu_ebr_check.
+ * Compare with the QSBR version to get the read-side overhead of
+ * explicit critical sections.
+ */
+static int
+test_rcu_ebr_perf(void)
+{
+	unsigned int i;
+
+	writer_done = 0;
+
+	rte_atomic_store_explicit(&updates, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&update_cycles, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&checks, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&check_cycles, 0, rte_memory_order_relaxed);
+
+	printf("\nPerf Test: %d EBR Readers/1 Writer('wait' in ebr_check == true)\n",
+		num_cores - 1);
+
+	rte_atomic_store_explicit(&thr_id, 0, rte_memory_order_seq_cst);
+
+	if (test_rcu_ebr_init(all_registered == 1 ? num_cores - 1 : RTE_MAX_LCORE) != 0)
+		return -1;
+
+	/* Reader threads are launched */
+	for (i = 0; i < num_cores - 1; i++)
+		rte_eal_remote_launch(test_rcu_ebr_reader_perf, (void *)1,
+					enabled_core_ids[i]);
+
+	/* Writer thread is launched */
+	rte_eal_remote_launch(test_rcu_ebr_writer_perf,
+			      NULL, enabled_core_ids[i]);
+
+	/* Wait for the writer thread */
+	rte_eal_wait_lcore(enabled_core_ids[i]);
+	writer_done = 1;
+
+	/* Wait until all readers have exited */
+	rte_eal_mp_wait_lcore();
+
+	printf("Total read-side critical sections = %"PRIi64"\n",
+		rte_atomic_load_explicit(&updates, rte_memory_order_relaxed));
+	printf("Cycles per %d read-side critical sections: %"PRIi64"\n",
+		RCU_SCALE_DOWN,
+		rte_atomic_load_explicit(&update_cycles, rte_memory_order_relaxed) /
+		(rte_atomic_load_explicit(&updates, rte_memory_order_relaxed) / RCU_SCALE_DOWN));
+	printf("Total EBR synchronize = %"PRIi64"\n", rte_atomic_load_explicit(&checks,
+			rte_memory_order_relaxed));
+	printf("Cycles per %d synchronize: %"PRIi64"\n", RCU_SCALE_DOWN,
+		rte_atomic_load_explicit(&check_cycles, rte_memory_order_relaxed) /
+		(rte_atomic_load_explicit(&checks, rte_memory_order_relaxed) / RCU_SCALE_DOWN));
+
+	rte_free(ebr);
+
+	return 0;
+}
+
+/*
+ * Perf test: Readers, epoch based reclamation
+ * Multiple readers, Single EBR variable
+ */
+static int
+test_rcu_ebr_rperf(void)
+{
+	unsigned int i;
+
+	rte_atomic_store_explicit(&updates, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&update_cycles, 0, rte_memory_order_relaxed);
+
+	rte_atomic_store_explicit(&thr_id, 0, rte_memory_order_seq_cst);
+
+	printf("\nPerf Test: %d EBR Readers\n", num_cores);
+
+	if (test_rcu_ebr_init(all_registered == 1 ? num_cores : RTE_MAX_LCORE) != 0)
+		return -1;
+
+	/* Reader threads are launched */
+	for (i = 0; i < num_cores; i++)
+		rte_eal_remote_launch(test_rcu_ebr_reader_perf, NULL,
+					enabled_core_ids[i]);
+
+	/* Wait until all readers have exited */
+	rte_eal_mp_wait_lcore();
+
+	printf("Total read-side critical sections = %"PRIi64"\n",
+		rte_atomic_load_explicit(&updates, rte_memory_order_relaxed));
+	printf("Cycles per %d read-side critical sections: %"PRIi64"\n",
+		RCU_SCALE_DOWN,
+		rte_atomic_load_explicit(&update_cycles, rte_memory_order_relaxed) /
+		(rte_atomic_load_explicit(&updates, rte_memory_order_relaxed) / RCU_SCALE_DOWN));
+
+	rte_free(ebr);
+
+	return 0;
+}
+
 static int
 test_rcu_qsbr_main(void)
 {
@@ -657,6 +828,12 @@ test_rcu_qsbr_main(void)
 	if (test_rcu_qsbr_sw_sv_1qs_non_blocking() < 0)
 		goto test_fail;
 
+	if (test_rcu_ebr_perf() < 0)
+		goto test_fail;
+
+	if (test_rcu_ebr_rperf() < 0)
+		goto test_fail;
+
 	/* Make sure the actual number of cores provided is less than
 	 * RTE_MAX_LCORE. This will allow for some threads not
 	 * to be registered on the QS variable.
@@ -686,6 +863,12 @@ test_rcu_qsbr_main(void)
 	if (test_rcu_qsbr_sw_sv_1qs_non_blocking() < 0)
 		goto test_fail;
 
+	if (test_rcu_ebr_perf() < 0)
+		goto test_fail;
+
+	if (test_rcu_ebr_rperf() < 0)
+		goto test_fail;
+
 	printf("\n");
 
 	return 0;
@@ -0,0 +1,346 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_random.h>
+#include <rte_reorder.h>
+
+#define BURST 32
+#define REORDER_MP_SIZE 1024
+#define NUM_MBUFS (2 * REORDER_MP_SIZE)
+#define MT_NUM_PKTS (1 << 20)
+
+struct reorder_mp_unittest_params {
+	struct rte_mempool *p;
+	struct rte_reorder_mp *b;
+};
+
+static struct reorder_mp_unittest_params default_params = {
+	.p = NULL,
+	.b = NULL
+};
+
+static struct reorder_mp_unittest_params *test_params = &default_params;
+
+static int
+test_reorder_mp_create(void)
+{
+	struct rte_reorder_mp *b;
+
+	b = rte_reorder_mp_create(NULL, rte_socket_id(), REORDER_MP_SIZE);
+	TEST_ASSERT((b == NULL) && (rte_errno == EINVAL),
+			"No error on create() with NULL name");
+
+	b = rte_reorder_mp_create("PKT_MP", rte_socket_id(), REORDER_MP_SIZE + 1);
+	TEST_ASSERT((b == NULL) && (rte_errno == EINVAL),
+			"No error on create() with invalid buffer size param.");
+
+	rte_reorder_mp_free(NULL);
+
+	return 0;
+}
+
+static int
+test_reorder_mp_order(void)
+{
+	struct rte_reorder_mp *b = test_params->b;
+	struct rte_mbuf *bufs[BURST], *first[4], *second[4], *robufs[BURST];
+	uint32_t tok1, tok2;
+	unsigned int i, cnt;
+	int ret = -1;
+
+	TEST_ASSERT_SUCCESS(rte_reorder_mp_min_seqn_set(b, 100),
+			"Cannot set seqn of empty buffer");
+
+	if (rte_mempool_get_bulk(test_params->p, (void *)bufs, 8) != 0) {
+		printf("%s: Error getting mbuf from pool\n", __func__);
+		return -1;
+	}
+
+	cnt = rte_reorder_mp_enqueue(b, bufs, 8);
+	if (cnt != 8) {
+		printf("%s:%d: enqueued %u packets\n", __func__, __LINE__, cnt);
+		goto exit;
+	}
+	for (i = 0; i < 8; i++) {
+		if (*rte_reorder_seqn(bufs[i]) != 100 + i) {
+			printf("%s:%d: wrong seqn %u\n", __func__, __LINE__,
+					*rte_reorder_seqn(bufs[i]));
+			goto exit;
+		}
+	}
+
+	if (rte_reorder_mp_min_seqn_set(b, 0) != -ENOTEMPTY) {
+		printf("%s:%d: seqn set on non empty buffer\n", __func__, __LINE__);
+		goto exit;
+	}
+
+	if (rte_reorder_mp_acquire(b, first, 4, &tok1) != 4 ||
+	    rte_reorder_mp_acquire(b, second, 4, &tok2) != 4) {
+		printf("%s:%d: cannot acquire packets\n", __func__, __LINE__);
+		goto exit;
+	}
+
+	/* Second batch finishes first, nothing is ready until the first one does */
+	rte_pktmbuf_free(second[1]);
+	second[1] = NULL;
+	rte_reorder_mp_release(b, second, 4, tok2);
+
+	cnt = rte_reorder_mp_drain(b, robufs, BURST);
+	if (cnt != 0) {
+		printf("%s:%d: drained %u packets out of order\n", __func__, __LINE__, cnt);
+		goto exit;
+	}
+
+	rte_reorder_mp_release(b, NULL, 4, tok1);
+
+	/* 100..103 then 104, 106, 107: the dropped packet leaves a gap */
+	cnt = rte_reorder_mp_drain_up_to_seqn(b, robufs, BURST, 102);
+	if (cnt != 2 || robufs[0] != bufs[0] || robufs[1] != bufs[1]) {
+		printf("%s:%d: drained %u packets up to seqn 102\n", __func__, __LINE__, cnt);
+		goto exit;
+	}
+	cnt = rte_reorder_mp_drain_up_to_seqn(b, robufs, BURST, 101);
+	if (cnt != 0) {
+		printf("%s:%d: drained %u packets up to drained seqn\n", __func__,
+				__LINE__, cnt);
+		goto exit;
+	}
+	rte_pktmbuf_free(bufs[0]);
+	rte_pktmbuf_free(bufs[1]);
+	bufs[0] = bufs[1] = NULL;
+
+	cnt = rte_reorder_mp_drain(b, robufs, BURST);
+	if (cnt != 5 || robufs[0] != bufs[2] || robufs[1] != bufs[3] ||
+	    robufs[2] != bufs[4] || robufs[3] != bufs[6] || robufs[4] != bufs[7]) {
+		printf("%s:%d: drained %u packets\n", __func__, __LINE__, cnt);
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(robufs, cnt);
+	memset(bufs, 0, sizeof(bufs));
+
+	TEST_ASSERT_SUCCESS(rte_reorder_mp_min_seqn_set(b, 0),
+			"Cannot set seqn of drained buffer");
+	ret = 0;
+exit:
+	for (i = 0; i < 8; i++)
+		rte_pktmbuf_free(bufs[i]);
+	return ret;
+}
+
+static int
+test_reorder_mp_full(void)
+{
+	struct rte_reorder_mp *b = test_params->b;
+	struct rte_mbuf *bufs[REORDER_MP_SIZE + 1];
+	unsigned int n, cnt, total;
+	uint32_t tok;
+
+	if (rte_mempool_get_bulk(test_params->p, (void *)bufs, RTE_DIM(bufs)) != 0) {
+		printf("%s: Error getting mbuf from pool\n", __func__);
+		return -1;
+	}
+
+	/* The last packet does not fit */
+	cnt = rte_reorder_mp_enqueue(b, bufs, RTE_DIM(bufs));
+	rte_pktmbuf_free(bufs[REORDER_MP_SIZE]);
+	TEST_ASSERT_EQUAL(cnt, REORDER_MP_SIZE, "Enqueued %u packets", cnt);
+
+	for (total = 0; total != cnt; total += n) {
+		n = rte_reorder_mp_acquire(b, bufs, BURST, &tok);
+		rte_reorder_mp_release(b, NULL, n, tok);
+	}
+
+	for (total = 0; total != cnt; total += n) {
+		n = rte_reorder_mp_drain(b, bufs, BURST);
+		rte_pktmbuf_free_bulk(bufs, n);
+		if (n == 0)
+			break;
+	}
+	TEST_ASSERT_EQUAL(total, cnt, "Drained %u out of %u packets", total, cnt);
+
+	TEST_ASSERT_SUCCESS(rte_reorder_mp_min_seqn_set(b, 0),
+			"Cannot set seqn of drained buffer");
+	return 0;
+}
+
+static int
+test_reorder_mp_free(void)
+{
+	struct rte_reorder_mp *b;
+	struct rte_mbuf *bufs[8], *acq[4];
+	unsigned int avail, cnt;
+	uint32_t tok;
+
+	b = rte_reorder_mp_create("PKT_MP_FREE", rte_socket_id(), REORDER_MP_SIZE);
+	TEST_ASSERT_NOT_NULL(b, "Cannot create reorder buffer");
+
+	avail = rte_mempool_avail_count(test_params->p);
+	if (rte_mempool_get_bulk(test_params->p, (void *)bufs, RTE_DIM(bufs)) != 0) {
+		printf("%s: Error getting mbuf from pool\n", __func__);
+		rte_reorder_mp_free(b);
+		return -1;
+	}
+
+	cnt = rte_reorder_mp_enqueue(b, bufs, RTE_DIM(bufs));
+	TEST_ASSERT_EQUAL(cnt, RTE_DIM(bufs), "Enqueued %u packets", cnt);
+
+	/* 4 packets released but not drained, 4 packets never acquired */
+	cnt = rte_reorder_mp_acquire(b, acq, RTE_DIM(acq), &tok);
+	TEST_ASSERT_EQUAL(cnt, RTE_DIM(acq), "Acquired %u packets", cnt);
+	rte_reorder_mp_release(b, NULL, cnt, tok);
+
+	rte_reorder_mp_free(b);
+
+	TEST_ASSERT_EQUAL(rte_mempool_avail_count(test_params->p), avail,
+			"Packets leaked by free");
+
+	return 0;
+}
+
+static RTE_ATOMIC(uint32_t) mt_stop;
+
+static int
+reorder_mp_worker(void *arg)
+{
+	struct rte_reorder_mp *b = arg;
+	struct rte_mbuf *bufs[BURST];
+	unsigned int n;
+	uint32_t tok;
+
+	while (rte_atomic_load_explicit(&mt_stop, rte_memory_order_relaxed) == 0) {
+		n = rte_reorder_mp_acquire(b, bufs, 1 + rte_rand_max(BURST), &tok);
+		if (n == 0) {
+			rte_pause();
+			continue;
+		}
+
+		/* Hold some bursts so that the others overtake them */
+		if (rte_rand_max(4) == 0)
+			rte_delay_us(1);
+		rte_reorder_mp_release(b, bufs, n, tok);
+	}
+
+	return 0;
+}
+
+static int
+test_reorder_mp_mt(void)
+{
+	struct rte_reorder_mp *b = test_params->b;
+	struct rte_mbuf *bufs[BURST];
+	uint32_t enq = 0, deq = 0;
+	unsigned int i, n, lcore_id;
+	int ret = 0;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough cores for reorder_mp_autotest, expecting at least 2\n");
+		return TEST_SKIPPED;
+	}
+
+	rte_atomic_store_explicit(&mt_stop, 0, rte_memory_order_relaxed);
+	RTE_LCORE_FOREACH_WORKER(lcore_id)
+		rte_eal_remote_launch(reorder_mp_worker, b, lcore_id);
+
+	while (deq != MT_NUM_PKTS && ret == 0) {
+		n = RTE_MIN((uint32_t)BURST, MT_NUM_PKTS - enq);
+		if (n != 0 && rte_pktmbuf_alloc_bulk(test_params->p, bufs, n) == 0) {
+			i = rte_reorder_mp_enqueue(b, bufs, n);
+			rte_pktmbuf_free_bulk(bufs + i, n - i);
+			enq += i;
+		}
+
+		n = rte_reorder_mp_drain_up_to_seqn(b, bufs, BURST, MT_NUM_PKTS);
+		for (i = 0; i != n; i++, deq++) {
+			if (*rte_reorder_seqn(bufs[i]) != deq) {
+				printf("%s: seqn %u, expected %u\n", __func__,
+						*rte_reorder_seqn(bufs[i]), deq);
+				ret = -1;
+				break;
+			}
+		}
+		rte_pktmbuf_free_bulk(bufs, n);
+	}
+
+	rte_atomic_store_explicit(&mt_stop, 1, rte_memory_order_relaxed);
+	rte_eal_mp_wait_lcore();
+
+	/* Nothing is acquired anymore, whatever is left can be drained */
+	do {
+		n = rte_reorder_mp_drain(b, bufs, BURST);
+		rte_pktmbuf_free_bulk(bufs, n);
+	} while (n != 0);
+
+	TEST_ASSERT_SUCCESS(ret, "Packets drained out of order");
+	TEST_ASSERT_SUCCESS(rte_reorder_mp_min_seqn_set(b, 0),
+			"Packets left in the buffer");
+
+	return 0;
+}
+
+static int
+test_setup(void)
+{
+	if (test_params->b == NULL) {
+		test_params->b = rte_reorder_mp_create("PKT_RO_MP", rte_socket_id(),
+							REORDER_MP_SIZE);
+		if (test_params->b == NULL) {
+			printf("%s: Error creating reorder buffer instance b\n",
+					__func__);
+			return -1;
+		}
+	}
+
+	if (test_params->p == NULL) {
+		test_params->p = rte_pktmbuf_pool_create("RO_MP_MBUF_POOL",
+			NUM_MBUFS, BURST, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			rte_socket_id());
+		if (test_params->p == NULL) {
+			printf("%s: Error creating mempool\n", __func__);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+static void
+test_teardown(void)
+{
+	rte_reorder_mp_free(test_params->b);
+	test_params->b = NULL;
+	rte_mempool_free(test_params->p);
+	test_params->p = NULL;
+}
+
+static struct unit_test_suite reorder_mp_test_suite = {
+	.setup = test_setup,
+	.teardown = test_teardown,
+	.suite_name = "Multi-producer Reorder Unit Test Suite",
+	.unit_test_cases = {
+		TEST_CASE(test_reorder_mp_create),
+		TEST_CASE(test_reorder_mp_order),
+		TEST_CASE(test_reorder_mp_full),
+		TEST_CASE(test_reorder_mp_free),
+		TEST_CASE(test_reorder_mp_mt),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_reorder_mp(void)
+{
+	return unit_test_suite_runner(&reorder_mp_test_suite);
+}
+
+REGISTER_FAST_TEST(reorder_mp_autotest, true, true, test_reorder_mp);
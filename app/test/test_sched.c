@@ -11,6 +11,7 @@
 #include "test.h"
 
 #include <rte_cycles.h>
+#include <rte_malloc.h>
 #include <rte_ether.h>
 #include <rte_ip.h>
 #include <rte_byteorder.h>
@@ -80,7 +81,7 @@ static struct rte_sched_port_params port_param = {
 	.n_pipes_per_subport = 1024,
 };
 
-#define NB_MBUF          32
+#define NB_MBUF          64
 #define MBUF_DATA_SZ     (2048 + RTE_PKTMBUF_HEADROOM)
 #define MEMPOOL_CACHE_SZ 0
 #define SOCKET           0
@@ -132,6 +133,285 @@ prepare_pkt(struct rte_sched_port *port, struct rte_mbuf *mbuf)
 }
 
 
+#define SHARD_NB_PKTS    10
+
+static int
+test_sched_shard(void)
+{
+	struct rte_sched_port_params params = port_param;
+	struct rte_sched_port *shard[2] = { NULL };
+	struct rte_mbuf *in_mbufs[SHARD_NB_PKTS];
+	struct rte_mbuf *out_mbufs[SHARD_NB_PKTS];
+	struct rte_sched_port *port;
+	struct rte_mempool *mp;
+	uint32_t subport, pipe, traffic_class, queue;
+	uint32_t s;
+	int i, err;
+
+	mp = create_mempool();
+	TEST_ASSERT_NOT_NULL(mp, "Error creating mempool\n");
+
+	params.n_subports_per_port = RTE_DIM(shard);
+
+	port = rte_sched_port_config(&params);
+	TEST_ASSERT_NOT_NULL(port, "Error config sched port\n");
+
+	for (s = 0; s < RTE_DIM(shard); s++) {
+		err = rte_sched_subport_config(port, s, subport_param, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched, err=%d\n", err);
+
+		err = rte_sched_pipe_config(port, s, PIPE, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched pipe, err=%d\n", err);
+	}
+
+	TEST_ASSERT_NULL(rte_sched_port_shard_create(port, 0, 0),
+			 "Empty shard created\n");
+	TEST_ASSERT_NULL(rte_sched_port_shard_create(port, 1, 2),
+			 "Shard beyond last subport created\n");
+
+	for (s = 0; s < RTE_DIM(shard); s++) {
+		shard[s] = rte_sched_port_shard_create(port, s, 1);
+		TEST_ASSERT_NOT_NULL(shard[s], "Error creating shard %u\n", s);
+	}
+
+	TEST_ASSERT_NULL(rte_sched_port_shard_create(shard[0], 0, 1),
+			 "Shard of a shard created\n");
+	err = rte_sched_subport_config(shard[0], 0, NULL, 0);
+	TEST_ASSERT_FAIL(err, "Subport configured through a shard\n");
+
+	for (s = 0; s < RTE_DIM(shard); s++) {
+		for (i = 0; i < SHARD_NB_PKTS; i++) {
+			in_mbufs[i] = rte_pktmbuf_alloc(mp);
+			TEST_ASSERT_NOT_NULL(in_mbufs[i], "Packet allocation failed\n");
+			rte_sched_port_pkt_write(shard[s], in_mbufs[i], s, PIPE, TC,
+						 QUEUE, RTE_COLOR_GREEN);
+			in_mbufs[i]->pkt_len = 60;
+			in_mbufs[i]->data_len = 60;
+		}
+
+		err = rte_sched_port_enqueue(shard[s], in_mbufs, SHARD_NB_PKTS);
+		TEST_ASSERT_EQUAL(err, SHARD_NB_PKTS, "Wrong enqueue, err=%d\n", err);
+	}
+
+	/* Each shard only dequeues the packets of its own subports */
+	for (s = 0; s < RTE_DIM(shard); s++) {
+		err = rte_sched_port_dequeue(shard[s], out_mbufs, SHARD_NB_PKTS);
+		TEST_ASSERT_EQUAL(err, SHARD_NB_PKTS, "Wrong dequeue, err=%d\n", err);
+
+		for (i = 0; i < SHARD_NB_PKTS; i++) {
+			rte_sched_port_pkt_read_tree_path(port, out_mbufs[i],
+					&subport, &pipe, &traffic_class, &queue);
+			TEST_ASSERT_EQUAL(subport, s, "Wrong subport\n");
+			rte_pktmbuf_free(out_mbufs[i]);
+		}
+	}
+
+	for (s = 0; s < RTE_DIM(shard); s++)
+		rte_sched_port_free(shard[s]);
+	rte_sched_port_free(port);
+
+	return 0;
+}
+
+static struct rte_sched_pipe_params shard_rate_pipe_profile[] = {
+	{
+		.tb_rate = 1000000,
+		.tb_size = 3200,
+
+		.tc_rate = {1000000, 1000000, 1000000, 1000000, 1000000,
+			1000000, 1000000, 1000000, 1000000, 1000000, 1000000,
+			1000000, 1000000},
+		.tc_period = 40,
+		.tc_ov_weight = 1,
+
+		.wrr_weights = {1, 1, 1, 1},
+	},
+};
+
+static struct rte_sched_subport_profile_params shard_rate_subport_profile[] = {
+	{
+		.tb_rate = 1000000,
+		.tb_size = 3200,
+		.tc_rate = {1000000, 1000000, 1000000, 1000000, 1000000,
+			1000000, 1000000, 1000000, 1000000, 1000000, 1000000,
+			1000000, 1000000},
+		.tc_period = 10,
+	},
+};
+
+#define SHARD_RATE_NB_PKTS 16
+#define SHARD_RATE_PKT_LEN 1500
+#define SHARD_RATE_MS      250
+
+/*
+ * Each subport may send at the port rate on its own, so the shards only
+ * stay within the port rate together if they share it.
+ */
+static int
+test_sched_shard_rate(void)
+{
+	struct rte_sched_port_params params = port_param;
+	struct rte_sched_subport_params sp_params = subport_param[0];
+	struct rte_sched_port *shard[2] = { NULL };
+	struct rte_mbuf *mbufs[SHARD_RATE_NB_PKTS];
+	uint64_t bytes = 0, start, cycles, expected, burst;
+	struct rte_sched_port *port;
+	struct rte_mempool *mp;
+	uint32_t s;
+	int i, n, err;
+
+	mp = create_mempool();
+	TEST_ASSERT_NOT_NULL(mp, "Error creating mempool\n");
+
+	params.rate = 1000000;
+	params.n_subports_per_port = RTE_DIM(shard);
+	params.subport_profiles = shard_rate_subport_profile;
+	sp_params.pipe_profiles = shard_rate_pipe_profile;
+
+	port = rte_sched_port_config(&params);
+	TEST_ASSERT_NOT_NULL(port, "Error config sched port\n");
+
+	for (s = 0; s < RTE_DIM(shard); s++) {
+		err = rte_sched_subport_config(port, s, &sp_params, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched, err=%d\n", err);
+
+		err = rte_sched_pipe_config(port, s, PIPE, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched pipe, err=%d\n", err);
+
+		shard[s] = rte_sched_port_shard_create(port, s, 1);
+		TEST_ASSERT_NOT_NULL(shard[s], "Error creating shard %u\n", s);
+
+		for (i = 0; i < SHARD_RATE_NB_PKTS; i++) {
+			mbufs[i] = rte_pktmbuf_alloc(mp);
+			TEST_ASSERT_NOT_NULL(mbufs[i], "Packet allocation failed\n");
+			rte_sched_port_pkt_write(shard[s], mbufs[i], s, PIPE, TC,
+						 QUEUE, RTE_COLOR_GREEN);
+			mbufs[i]->pkt_len = SHARD_RATE_PKT_LEN;
+			mbufs[i]->data_len = SHARD_RATE_PKT_LEN;
+		}
+
+		n = rte_sched_port_enqueue(shard[s], mbufs, SHARD_RATE_NB_PKTS);
+		TEST_ASSERT_EQUAL(n, SHARD_RATE_NB_PKTS, "Wrong enqueue, n=%d\n", n);
+	}
+
+	/* Keep the queues backlogged, sending the packets again */
+	start = rte_get_tsc_cycles();
+	cycles = rte_get_tsc_hz() * SHARD_RATE_MS / MS_PER_S;
+	while (rte_get_tsc_cycles() - start < cycles) {
+		for (s = 0; s < RTE_DIM(shard); s++) {
+			n = rte_sched_port_dequeue(shard[s], mbufs,
+						   SHARD_RATE_NB_PKTS);
+			for (i = 0; i < n; i++)
+				bytes += mbufs[i]->pkt_len + params.frame_overhead;
+
+			err = rte_sched_port_enqueue(shard[s], mbufs, n);
+			TEST_ASSERT_EQUAL(err, n, "Wrong enqueue, err=%d\n", err);
+		}
+	}
+
+	/*
+	 * The shards may run RTE_SCHED_PORT_SHARD_BURST (64) frames ahead of
+	 * the port, plus a frame each.
+	 */
+	expected = params.rate * SHARD_RATE_MS / MS_PER_S;
+	burst = (uint64_t)(params.mtu + params.frame_overhead) *
+		(64 + RTE_DIM(shard));
+	printf("Shards sent %"PRIu64" bytes in %u ms at %"PRIu64" bytes/s\n",
+	       bytes, SHARD_RATE_MS, params.rate);
+	TEST_ASSERT(bytes <= expected + burst,
+		    "Shards exceeded the port rate: %"PRIu64" bytes\n", bytes);
+	TEST_ASSERT(bytes >= expected / 2,
+		    "Shards stalled below the port rate: %"PRIu64" bytes\n",
+		    bytes);
+
+	for (s = 0; s < RTE_DIM(shard); s++)
+		rte_sched_port_free(shard[s]);
+	rte_sched_port_free(port);
+
+	return 0;
+}
+
+#define VCLOCK_NB_PKTS   10
+
+/* Calendar of at most 4096 buckets and its bitmap, no memory per pipe */
+#define VCLOCK_FOOTPRINT_MAX (4096 * 8 + 4096)
+
+static int
+test_sched_vclock(void)
+{
+	struct rte_mbuf *in_mbufs[VCLOCK_NB_PKTS];
+	struct rte_mbuf *out_mbufs[VCLOCK_NB_PKTS];
+	uint32_t subport, pipe, traffic_class, queue;
+	struct rte_sched_subport_params *sp_params[] = { subport_param };
+	struct rte_malloc_socket_stats pre, post;
+	struct rte_sched_port *port;
+	struct rte_mempool *mp;
+	uint32_t footprint;
+	size_t size;
+	int i, err;
+
+	mp = create_mempool();
+	TEST_ASSERT_NOT_NULL(mp, "Error creating mempool\n");
+
+	port = rte_sched_port_config(&port_param);
+	TEST_ASSERT_NOT_NULL(port, "Error config sched port\n");
+
+	err = rte_sched_subport_config(port, SUBPORT, subport_param, 0);
+	TEST_ASSERT_SUCCESS(err, "Error config sched, err=%d\n", err);
+
+	err = rte_sched_pipe_config(port, SUBPORT, PIPE, 0);
+	TEST_ASSERT_SUCCESS(err, "Error config sched pipe, err=%d\n", err);
+
+	rte_malloc_get_socket_stats(port_param.socket, &pre);
+	err = rte_sched_subport_vclock_config(port, SUBPORT, true);
+	TEST_ASSERT_SUCCESS(err, "Error enabling virtual clock, err=%d\n", err);
+	rte_malloc_get_socket_stats(port_param.socket, &post);
+
+	size = post.heap_allocsz_bytes - pre.heap_allocsz_bytes;
+	footprint = rte_sched_port_get_memory_footprint(&port_param, sp_params);
+	printf("Virtual clock: %zu bytes on top of %u bytes, %u pipes\n",
+	       size, footprint, subport_param[0].n_pipes_per_subport_enabled);
+	TEST_ASSERT(size <= VCLOCK_FOOTPRINT_MAX,
+		    "Virtual clock takes %zu bytes\n", size);
+
+	/* Lowest priority TC enqueued first */
+	for (i = 0; i < VCLOCK_NB_PKTS; i++) {
+		in_mbufs[i] = rte_pktmbuf_alloc(mp);
+		TEST_ASSERT_NOT_NULL(in_mbufs[i], "Packet allocation failed\n");
+		rte_sched_port_pkt_write(port, in_mbufs[i], SUBPORT, PIPE,
+					 i < VCLOCK_NB_PKTS / 2 ? TC : 0, QUEUE,
+					 RTE_COLOR_GREEN);
+		in_mbufs[i]->pkt_len = 60;
+		in_mbufs[i]->data_len = 60;
+	}
+
+	err = rte_sched_port_enqueue(port, in_mbufs, VCLOCK_NB_PKTS);
+	TEST_ASSERT_EQUAL(err, VCLOCK_NB_PKTS, "Wrong enqueue, err=%d\n", err);
+
+	err = rte_sched_subport_vclock_config(port, SUBPORT, false);
+	TEST_ASSERT_EQUAL(err, -EBUSY, "Virtual clock disabled with packets queued\n");
+
+	err = rte_sched_port_dequeue(port, out_mbufs, VCLOCK_NB_PKTS);
+	TEST_ASSERT_EQUAL(err, VCLOCK_NB_PKTS, "Wrong dequeue, err=%d\n", err);
+
+	for (i = 0; i < VCLOCK_NB_PKTS; i++) {
+		rte_sched_port_pkt_read_tree_path(port, out_mbufs[i],
+				&subport, &pipe, &traffic_class, &queue);
+		TEST_ASSERT_EQUAL(pipe, PIPE, "Wrong pipe\n");
+		TEST_ASSERT_EQUAL(traffic_class,
+				  (uint32_t)(i < VCLOCK_NB_PKTS / 2 ? 0 : TC),
+				  "Wrong traffic class priority\n");
+		rte_pktmbuf_free(out_mbufs[i]);
+	}
+
+	err = rte_sched_subport_vclock_config(port, SUBPORT, false);
+	TEST_ASSERT_SUCCESS(err, "Error disabling virtual clock, err=%d\n", err);
+
+	rte_sched_port_free(port);
+
+	return 0;
+}
+
 /**
  * test main entrance for library sched
  */
@@ -210,7 +490,15 @@ test_sched(void)
 
 	rte_sched_port_free(port);
 
-	return 0;
+	err = test_sched_shard();
+	if (err != 0)
+		return err;
+
+	err = test_sched_shard_rate();
+	if (err != 0)
+		return err;
+
+	return test_sched_vclock();
 }
 
 #endif /* !RTE_EXEC_ENV_WINDOWS */
@@ -0,0 +1,267 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+
+#include "test.h"
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_sched_perf(void)
+{
+	printf("sched not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+#else
+
+#include <rte_sched.h>
+
+/*
+ * Compare the grinders and the virtual clock pipe scheduler on the same port
+ * parameters: memory footprint, rate accuracy of the pipes when the subport
+ * is undersubscribed and oversubscribed, and cycles per packet.
+ */
+
+#define PERF_PORT_RATE		100000000 /* bytes per second */
+#define PERF_NB_PIPES		16
+#define PERF_NB_PROFILES	4 /* pipe rates 1:2:4:8 */
+#define PERF_QSIZE		64
+#define PERF_NB_MBUF		(PERF_NB_PIPES * RTE_SCHED_BE_QUEUES_PER_PIPE * PERF_QSIZE)
+#define PERF_BURST		32
+#define PERF_DURATION_MS	500
+#define PERF_FOOTPRINT_PIPES	4096
+
+static struct rte_sched_pipe_params perf_pipe_profiles[PERF_NB_PROFILES];
+
+static struct rte_sched_subport_profile_params perf_subport_profile = {
+	.tb_rate = PERF_PORT_RATE,
+	.tb_size = 1000000,
+	.tc_rate = {PERF_PORT_RATE, PERF_PORT_RATE, PERF_PORT_RATE,
+		PERF_PORT_RATE, PERF_PORT_RATE, PERF_PORT_RATE, PERF_PORT_RATE,
+		PERF_PORT_RATE, PERF_PORT_RATE, PERF_PORT_RATE, PERF_PORT_RATE,
+		PERF_PORT_RATE, PERF_PORT_RATE},
+	.tc_period = 10,
+};
+
+static struct rte_sched_subport_params perf_subport_param = {
+	.n_pipes_per_subport_enabled = PERF_NB_PIPES,
+	.qsize = {PERF_QSIZE, PERF_QSIZE, PERF_QSIZE, PERF_QSIZE, PERF_QSIZE,
+		PERF_QSIZE, PERF_QSIZE, PERF_QSIZE, PERF_QSIZE, PERF_QSIZE,
+		PERF_QSIZE, PERF_QSIZE, PERF_QSIZE},
+	.pipe_profiles = perf_pipe_profiles,
+	.n_pipe_profiles = PERF_NB_PROFILES,
+	.n_max_pipe_profiles = PERF_NB_PROFILES,
+};
+
+static struct rte_sched_port_params perf_port_param = {
+	.rate = PERF_PORT_RATE,
+	.mtu = 1522,
+	.frame_overhead = RTE_SCHED_FRAME_OVERHEAD_DEFAULT,
+	.n_subports_per_port = 1,
+	.n_subport_profiles = 1,
+	.subport_profiles = &perf_subport_profile,
+	.n_max_subport_profiles = 1,
+	.n_pipes_per_subport = PERF_NB_PIPES,
+};
+
+static void
+perf_profiles_init(uint64_t pipe_rate)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < PERF_NB_PROFILES; i++) {
+		struct rte_sched_pipe_params *pp = &perf_pipe_profiles[i];
+
+		pp->tb_rate = pipe_rate << i;
+		pp->tb_size = 4000;
+		for (j = 0; j < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; j++)
+			pp->tc_rate[j] = pipe_rate << i;
+		pp->tc_period = 40;
+		pp->tc_ov_weight = 1;
+		for (j = 0; j < RTE_SCHED_BE_QUEUES_PER_PIPE; j++)
+			pp->wrr_weights[j] = 1;
+	}
+}
+
+static struct rte_sched_port *
+perf_port_create(bool vclock)
+{
+	struct rte_sched_port *port;
+	uint32_t i;
+
+	perf_port_param.socket = rte_socket_id();
+	port = rte_sched_port_config(&perf_port_param);
+	if (port == NULL)
+		return NULL;
+
+	if (rte_sched_subport_config(port, 0, &perf_subport_param, 0) != 0)
+		goto fail;
+
+	for (i = 0; i < perf_subport_param.n_pipes_per_subport_enabled; i++)
+		if (rte_sched_pipe_config(port, 0, i, i % PERF_NB_PROFILES) != 0)
+			goto fail;
+
+	if (vclock && rte_sched_subport_vclock_config(port, 0, true) != 0)
+		goto fail;
+
+	return port;
+
+fail:
+	rte_sched_port_free(port);
+	return NULL;
+}
+
+static int
+perf_footprint(bool vclock)
+{
+	struct rte_malloc_socket_stats pre, post;
+	struct rte_sched_port *port;
+	size_t size;
+
+	perf_port_param.n_pipes_per_subport = PERF_FOOTPRINT_PIPES;
+	perf_subport_param.n_pipes_per_subport_enabled = PERF_FOOTPRINT_PIPES;
+
+	rte_malloc_get_socket_stats(rte_socket_id(), &pre);
+	port = perf_port_create(vclock);
+	rte_malloc_get_socket_stats(rte_socket_id(), &post);
+
+	perf_port_param.n_pipes_per_subport = PERF_NB_PIPES;
+	perf_subport_param.n_pipes_per_subport_enabled = PERF_NB_PIPES;
+
+	if (port == NULL)
+		return -1;
+
+	size = post.heap_allocsz_bytes - pre.heap_allocsz_bytes;
+	printf("  footprint, %u pipes: %zu bytes, %.1f bytes/pipe\n",
+	       PERF_FOOTPRINT_PIPES, size, (double)size / PERF_FOOTPRINT_PIPES);
+
+	rte_sched_port_free(port);
+	return 0;
+}
+
+static int
+perf_accuracy(bool vclock, uint64_t pipe_rate, struct rte_mempool *mp)
+{
+	struct rte_mbuf *pool[PERF_NB_MBUF];
+	struct rte_mbuf *out[PERF_BURST];
+	uint64_t bytes[PERF_NB_PIPES] = { 0 };
+	uint64_t start, end, tsc = 0, n_pkts = 0, rate_sum = 0;
+	struct rte_sched_port *port;
+	double error_max = 0;
+	uint32_t i, j, n, np;
+
+	perf_profiles_init(pipe_rate);
+	port = perf_port_create(vclock);
+	if (port == NULL)
+		return -1;
+
+	if (rte_pktmbuf_alloc_bulk(mp, pool, PERF_NB_MBUF) != 0) {
+		rte_sched_port_free(port);
+		return -1;
+	}
+
+	/* Each BE queue gets exactly as many packets as it can hold */
+	for (i = 0; i < PERF_NB_MBUF; i++) {
+		pool[i]->pkt_len = 64 + rte_rand_max(1454);
+		pool[i]->data_len = pool[i]->pkt_len;
+		rte_sched_port_pkt_write(port, pool[i], 0, i % PERF_NB_PIPES,
+				RTE_SCHED_TRAFFIC_CLASS_BE,
+				(i / PERF_NB_PIPES) % RTE_SCHED_BE_QUEUES_PER_PIPE,
+				RTE_COLOR_GREEN);
+	}
+	np = PERF_NB_MBUF;
+
+	end = rte_rdtsc() + rte_get_tsc_hz() * PERF_DURATION_MS / 1000;
+	while (rte_rdtsc() < end) {
+		start = rte_rdtsc();
+		n = RTE_MIN(np, (uint32_t)PERF_BURST);
+		np -= n;
+		rte_sched_port_enqueue(port, &pool[np], n);
+		n = rte_sched_port_dequeue(port, out, PERF_BURST);
+		tsc += rte_rdtsc() - start;
+
+		for (i = 0; i < n; i++) {
+			uint32_t subport, pipe, tc, queue;
+
+			rte_sched_port_pkt_read_tree_path(port, out[i], &subport,
+					&pipe, &tc, &queue);
+			bytes[pipe] += out[i]->pkt_len +
+				RTE_SCHED_FRAME_OVERHEAD_DEFAULT;
+			pool[np++] = out[i];
+		}
+		n_pkts += n;
+	}
+
+	/* Packets still queued are freed with the port */
+	rte_sched_port_free(port);
+	rte_pktmbuf_free_bulk(pool, np);
+
+	for (i = 0; i < PERF_NB_PIPES; i++)
+		rate_sum += pipe_rate << (i % PERF_NB_PROFILES);
+
+	/* Pipe rates, or their share of the port when oversubscribed */
+	printf("  pipe rates %s:\n", rate_sum > PERF_PORT_RATE ?
+	       "oversubscribed" : "undersubscribed");
+	for (i = 0; i < PERF_NB_PROFILES; i++) {
+		double expected = pipe_rate << i, measured = 0, error;
+
+		if (rate_sum > PERF_PORT_RATE)
+			expected = expected * PERF_PORT_RATE / rate_sum;
+
+		for (j = i; j < PERF_NB_PIPES; j += PERF_NB_PROFILES)
+			measured += bytes[j];
+		measured = measured * 1000 /
+			(PERF_DURATION_MS * (PERF_NB_PIPES / PERF_NB_PROFILES));
+
+		error = (measured - expected) * 100 / expected;
+		error_max = RTE_MAX(error_max, fabs(error));
+		printf("    %10.0f bytes/s expected, %10.0f measured, %+6.2f%%\n",
+		       expected, measured, error);
+	}
+	printf("  max rate error %.2f%%, %.1f cycles/pkt\n", error_max,
+	       n_pkts ? (double)tsc / n_pkts : 0);
+
+	return 0;
+}
+
+static int
+test_sched_perf(void)
+{
+	struct rte_mempool *mp;
+	uint32_t i;
+	int ret = 0;
+
+	mp = rte_pktmbuf_pool_create("test_sched_perf", PERF_NB_MBUF, 0, 0,
+				     RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+	if (mp == NULL)
+		return TEST_FAILED;
+
+	for (i = 0; i < 2 && ret == 0; i++) {
+		bool vclock = i != 0;
+
+		printf("%s pipe scheduler\n", vclock ? "Virtual clock" : "Grinder");
+		ret = perf_footprint(vclock);
+		if (ret == 0)
+			ret = perf_accuracy(vclock, PERF_PORT_RATE / 100, mp);
+		if (ret == 0)
+			ret = perf_accuracy(vclock, PERF_PORT_RATE / 12, mp);
+	}
+
+	rte_mempool_free(mp);
+
+	return ret == 0 ? TEST_SUCCESS : TEST_FAILED;
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_PERF_TEST(sched_perf_autotest, test_sched_perf);
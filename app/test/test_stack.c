@@ -2,6 +2,7 @@
  * Copyright(c) 2019 Intel Corporation
  */
 
+#include <inttypes.h>
 #include <string.h>
 
 #include <rte_lcore.h>
@@ -339,6 +340,106 @@ test_stack_multithreaded(uint32_t flags)
 	return result;
 }
 
+static int
+stack_thread_objects(__rte_unused void *args)
+{
+	struct rte_stack *s = thread_test_args.s;
+	void *held[2 * MAX_BULK];
+	unsigned int i, num, n_held = MAX_BULK;
+	uintptr_t base;
+
+	/* Each lcore starts with its own objects, they move between lcores */
+	base = rte_lcore_index(rte_lcore_id()) * MAX_BULK;
+	for (i = 0; i < n_held; i++)
+		held[i] = (void *)(base + i);
+
+	for (i = 0; i < NUM_ITERS_PER_THREAD; i++) {
+		num = rte_rand_max(n_held + 1);
+		if (rte_stack_push(s, &held[n_held - num], num) != num) {
+			printf("[%s():%u] Failed to push %u pointers\n",
+			       __func__, __LINE__, num);
+			return -1;
+		}
+		n_held -= num;
+
+		num = rte_rand_max(RTE_MIN((unsigned int)MAX_BULK, RTE_DIM(held) - n_held) + 1);
+		n_held += rte_stack_pop(s, &held[n_held], num);
+	}
+
+	if (rte_stack_push(s, held, n_held) != n_held) {
+		printf("[%s():%u] Failed to push %u pointers\n",
+		       __func__, __LINE__, n_held);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Check that no object is lost or duplicated by concurrent push and pop. */
+static int
+test_stack_mt_objects(uint32_t flags)
+{
+	unsigned int lcore_id, total, n;
+	uint8_t *seen = NULL;
+	struct rte_stack *s;
+	int result = 0;
+	uintptr_t obj;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough cores for test_stack_mt_objects, expecting at least 2\n");
+		return TEST_SKIPPED;
+	}
+
+	/* Leave room for the list elements of the operations in progress */
+	total = MAX_BULK * rte_lcore_count();
+	s = rte_stack_create("test", 2 * total, rte_socket_id(), flags);
+	if (s == NULL) {
+		printf("[%s():%u] Failed to create a stack\n",
+		       __func__, __LINE__);
+		return -1;
+	}
+
+	thread_test_args.s = s;
+
+	if (rte_eal_mp_remote_launch(stack_thread_objects, NULL, CALL_MAIN))
+		rte_panic("Failed to launch tests\n");
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		if (rte_eal_wait_lcore(lcore_id) < 0)
+			result = -1;
+	}
+	if (result < 0)
+		goto exit;
+
+	seen = rte_zmalloc(NULL, total, 0);
+	if (seen == NULL) {
+		printf("[%s():%u] failed to allocate %u bytes\n",
+		       __func__, __LINE__, total);
+		result = -1;
+		goto exit;
+	}
+
+	for (n = 0; rte_stack_pop(s, (void **)&obj, 1) == 1; n++) {
+		if (obj >= total || seen[obj]++ != 0) {
+			printf("[%s():%u] Unexpected object %" PRIuPTR "\n",
+			       __func__, __LINE__, obj);
+			result = -1;
+			goto exit;
+		}
+	}
+
+	if (n != total) {
+		printf("[%s():%u] Popped %u objects (expected %u)\n",
+		       __func__, __LINE__, n, total);
+		result = -1;
+	}
+
+exit:
+	rte_free(seen);
+	rte_stack_free(s);
+	return result;
+}
+
 static int
 __test_stack(uint32_t flags)
 {
@@ -379,5 +480,37 @@ test_lf_stack(void)
 #endif
 }
 
+static int
+test_lf_elim_stack(void)
+{
+#if defined(RTE_STACK_LF_SUPPORTED)
+	struct rte_stack *s;
+
+	s = rte_stack_create("test", STACK_SIZE, rte_socket_id(), RTE_STACK_F_ELIM);
+	if (s != NULL || rte_errno != EINVAL) {
+		printf("[%s():%u] Elimination allowed without lock-free stack\n",
+		       __func__, __LINE__);
+		rte_stack_free(s);
+		return -1;
+	}
+
+	return __test_stack(RTE_STACK_F_LF | RTE_STACK_F_ELIM);
+#else
+	return TEST_SKIPPED;
+#endif
+}
+
+static int
+test_lf_elim_stack_objects(void)
+{
+#if defined(RTE_STACK_LF_SUPPORTED)
+	return test_stack_mt_objects(RTE_STACK_F_LF | RTE_STACK_F_ELIM);
+#else
+	return TEST_SKIPPED;
+#endif
+}
+
 REGISTER_FAST_TEST(stack_autotest, false, true, test_stack);
 REGISTER_FAST_TEST(stack_lf_autotest, false, true, test_lf_stack);
+REGISTER_FAST_TEST(stack_lf_elim_autotest, false, true, test_lf_elim_stack);
+REGISTER_FAST_TEST(stack_lf_elim_objects_autotest, false, true, test_lf_elim_stack_objects);
@@ -160,6 +160,40 @@ bulk_push_pop(void *p)
 	return 0;
 }
 
+/*
+ * Same as bulk_push_pop(), with the objects popped in two halves, as a mempool
+ * cache refill does not match the size of a cache flush.
+ */
+static int
+bulk_push_pop_split(void *p)
+{
+	unsigned int iterations = 1000000;
+	struct thread_args *args = p;
+	void *objs[MAX_BURST] = {0};
+	unsigned int size, i;
+	struct rte_stack *s;
+
+	s = args->s;
+	size = args->sz;
+
+	rte_atomic_fetch_sub_explicit(&lcore_barrier, 1, rte_memory_order_relaxed);
+	rte_wait_until_equal_32((uint32_t *)(uintptr_t)&lcore_barrier, 0, rte_memory_order_relaxed);
+
+	uint64_t start = rte_rdtsc();
+
+	for (i = 0; i < iterations; i++) {
+		rte_stack_push(s, objs, size);
+		rte_stack_pop(s, objs, size / 2);
+		rte_stack_pop(s, objs, size - size / 2);
+	}
+
+	uint64_t end = rte_rdtsc();
+
+	args->avg = ((double)(end - start))/(iterations * size);
+
+	return 0;
+}
+
 /*
  * Run bulk_push_pop() simultaneously on pairs of cores, to measure stack
  * perf when between hyperthread siblings, cores on the same socket, and cores
@@ -334,6 +368,10 @@ __test_stack_perf(uint32_t flags)
 	printf("\n### Testing on all %u lcores ###\n", rte_lcore_count());
 	run_on_n_cores(s, bulk_push_pop, rte_lcore_count());
 
+	printf("\n### Testing on all %u lcores, popping in two halves ###\n",
+	       rte_lcore_count());
+	run_on_n_cores(s, bulk_push_pop_split, rte_lcore_count());
+
 	rte_stack_free(s);
 	return 0;
 }
@@ -354,5 +392,16 @@ test_lf_stack_perf(void)
 #endif
 }
 
+static int
+test_lf_elim_stack_perf(void)
+{
+#if defined(RTE_STACK_LF_SUPPORTED)
+	return __test_stack_perf(RTE_STACK_F_LF | RTE_STACK_F_ELIM);
+#else
+	return TEST_SKIPPED;
+#endif
+}
+
 REGISTER_PERF_TEST(stack_perf_autotest, test_stack_perf);
 REGISTER_PERF_TEST(stack_lf_perf_autotest, test_lf_stack_perf);
+REGISTER_PERF_TEST(stack_lf_elim_perf_autotest, test_lf_elim_stack_perf);
@@ -2328,6 +2328,79 @@ aesni_mb_process_bulk(struct rte_cryptodev *dev __rte_unused,
 	return k;
 }
 
+uint32_t
+aesni_mb_process_bulk_multi(struct rte_cryptodev *dev __rte_unused,
+	struct rte_cryptodev_sym_session *sess[],
+	const union rte_crypto_sym_ofs sofs[], struct rte_crypto_sym_vec *vec)
+{
+	int32_t ret;
+	uint32_t i, j, k, len;
+	void *buf;
+	IMB_JOB *job;
+	IMB_MGR *mb_mgr;
+	struct aesni_mb_session *s;
+	uint8_t tmp_dgst[vec->num][DIGEST_LENGTH_MAX];
+
+	/* get per-thread MB MGR, create one if needed */
+	mb_mgr = get_per_thread_mb_mgr();
+	if (unlikely(mb_mgr == NULL))
+		return 0;
+
+	/* jobs of all sessions share the manager lanes */
+	for (i = 0, j = 0, k = 0; i != vec->num; i++) {
+		ret = check_crypto_sgl(sofs[i], vec->src_sgl + i);
+		if (ret != 0) {
+			vec->status[i] = ret;
+			continue;
+		}
+
+		buf = vec->src_sgl[i].vec[0].base;
+		len = vec->src_sgl[i].vec[0].len;
+		s = CRYPTODEV_GET_SYM_SESS_PRIV(sess[i]);
+
+		job = IMB_GET_NEXT_JOB(mb_mgr);
+		if (job == NULL) {
+			k += flush_mb_sync_mgr(mb_mgr);
+			job = IMB_GET_NEXT_JOB(mb_mgr);
+			RTE_ASSERT(job != NULL);
+		}
+
+		/* Submit job for processing */
+		set_cpu_mb_job_params(job, s, sofs[i], buf, len, &vec->iv[i],
+			&vec->aad[i], tmp_dgst[i], &vec->status[i]);
+		job = submit_sync_job(mb_mgr);
+		j++;
+
+		/* handle completed jobs */
+		k += handle_completed_sync_jobs(job, mb_mgr);
+	}
+
+	/* flush remaining jobs */
+	while (k != j)
+		k += flush_mb_sync_mgr(mb_mgr);
+
+	/* finish processing for successful jobs: check/update digest */
+	for (i = 0, k = 0; i != vec->num; i++) {
+		if (vec->status[i] != 0)
+			continue;
+
+		s = CRYPTODEV_GET_SYM_SESS_PRIV(sess[i]);
+		if (s->auth.operation == RTE_CRYPTO_AUTH_OP_VERIFY) {
+			if (memcmp(vec->digest[i].va, tmp_dgst[i],
+					s->auth.req_digest_len) != 0) {
+				vec->status[i] = EBADMSG;
+				continue;
+			}
+		} else {
+			memcpy(vec->digest[i].va, tmp_dgst[i],
+				s->auth.req_digest_len);
+		}
+		k++;
+	}
+
+	return k;
+}
+
 struct rte_cryptodev_ops aesni_mb_pmd_ops = {
 	.dev_configure = ipsec_mb_config,
 	.dev_start = ipsec_mb_start,
@@ -2343,6 +2416,7 @@ struct rte_cryptodev_ops aesni_mb_pmd_ops = {
 	.queue_pair_release = ipsec_mb_qp_release,
 
 	.sym_cpu_process = aesni_mb_process_bulk,
+	.sym_cpu_process_multi = aesni_mb_process_bulk_multi,
 
 	.sym_session_get_size = ipsec_mb_sym_session_get_size,
 	.sym_session_configure = ipsec_mb_sym_session_configure,
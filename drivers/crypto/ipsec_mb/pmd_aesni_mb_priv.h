@@ -32,6 +32,11 @@ aesni_mb_process_bulk(struct rte_cryptodev *dev __rte_unused,
 	struct rte_cryptodev_sym_session *sess, union rte_crypto_sym_ofs sofs,
 	struct rte_crypto_sym_vec *vec);
 
+uint32_t
+aesni_mb_process_bulk_multi(struct rte_cryptodev *dev __rte_unused,
+	struct rte_cryptodev_sym_session *sess[],
+	const union rte_crypto_sym_ofs sofs[], struct rte_crypto_sym_vec *vec);
+
 static const struct rte_cryptodev_capabilities aesni_mb_capabilities[] = {
 	{	/* MD5 HMAC */
 		.op = RTE_CRYPTO_OP_TYPE_SYMMETRIC,
@@ -40,6 +40,8 @@ extern "C" {
 #define SCHEDULER_MODE_NAME_FAIL_OVER		fail-over
 /** multi-core scheduling mode string */
 #define SCHEDULER_MODE_NAME_MULTI_CORE		multi-core
+/** Cost model scheduling mode string */
+#define SCHEDULER_MODE_NAME_COST_MODEL		cost-model
 
 /**
  * Crypto scheduler PMD operation modes
@@ -56,6 +58,8 @@ enum rte_cryptodev_scheduler_mode {
 	CDEV_SCHED_MODE_FAILOVER,
 	/** multi-core mode */
 	CDEV_SCHED_MODE_MULTICORE,
+	/** Cost model mode */
+	CDEV_SCHED_MODE_COST_MODEL,
 
 	CDEV_SCHED_MODE_COUNT /**< number of modes */
 };
@@ -69,6 +73,7 @@ enum rte_cryptodev_scheduler_mode {
 enum rte_cryptodev_schedule_option_type {
 	CDEV_SCHED_OPTION_NOT_SET = 0,
 	CDEV_SCHED_OPTION_THRESHOLD,
+	CDEV_SCHED_OPTION_COST_MODEL,
 
 	CDEV_SCHED_OPTION_COUNT
 };
@@ -81,6 +86,22 @@ struct rte_cryptodev_scheduler_threshold_option {
 	uint32_t threshold;	/**< Threshold for packet-size mode */
 };
 
+/**
+ * Cost model option structure
+ *
+ * Only sticky is used when setting the option, the per worker
+ * counters are filled when getting it.
+ */
+#define RTE_CRYPTODEV_SCHEDULER_PARAM_STICKY	"sticky"
+struct rte_cryptodev_scheduler_cost_model_option {
+	/** Keep the ops of a symmetric session on one worker at a time */
+	uint32_t sticky;
+	/** Ops enqueued to each worker, in attach order */
+	uint64_t worker_ops[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	/** Estimated cycles per op of each worker, averaged over queue pairs */
+	uint64_t worker_cost[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+};
+
 struct rte_cryptodev_scheduler;
 
 /**
@@ -276,6 +297,8 @@ extern struct rte_cryptodev_scheduler *crypto_scheduler_pkt_size_based_distr;
 extern struct rte_cryptodev_scheduler *crypto_scheduler_failover;
 /** multi-core mode scheduler */
 extern struct rte_cryptodev_scheduler *crypto_scheduler_multicore;
+/** Cost model mode scheduler */
+extern struct rte_cryptodev_scheduler *crypto_scheduler_cost_model;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,468 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <cryptodev_pmd.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+
+#include "rte_cryptodev_scheduler_operations.h"
+#include "scheduler_pmd_private.h"
+
+#define CM_MAX_ENQ_BURST	128
+#define CM_COST_SHIFT		4	/* fraction bits of the op cost */
+#define CM_COST_EWMA_SHIFT	3	/* weight of a new cost sample is 1/8 */
+#define CM_NB_BATCHES		64	/* timed bursts in flight per worker */
+#define CM_BATCH_MASK		(CM_NB_BATCHES - 1)
+#define CM_NB_STICKY_SLOTS	1024
+#define CM_STICKY_SLOT_MASK	(CM_NB_STICKY_SLOTS - 1)
+
+/** cost model scheduler context */
+struct cm_scheduler_ctx {
+	uint32_t sticky;
+};
+
+/** burst enqueued to a worker, timed until its last op is dequeued */
+struct cm_batch {
+	uint64_t tsc;
+	uint32_t depth;		/**< ops in flight on the worker with the burst */
+	uint16_t nb_ops;	/**< ops of the burst not dequeued yet */
+};
+
+struct cm_worker {
+	struct scheduler_worker worker;
+	uint64_t cost;		/**< estimated cycles per op, fixed point */
+	uint64_t nb_ops;	/**< ops enqueued to the worker */
+	uint16_t batch_head;
+	uint16_t batch_tail;
+	struct cm_batch batches[CM_NB_BATCHES];
+};
+
+/** sessions hashed to a slot stay on one worker while they have ops in flight */
+struct cm_sticky_slot {
+	uint16_t nb_inflight;
+	uint8_t worker_idx;
+};
+
+/** cost model scheduler queue pair context */
+struct __rte_cache_aligned cm_scheduler_qp_ctx {
+	struct cm_worker workers[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	uint32_t nb_workers;
+	uint32_t last_deq_worker_idx;
+	uint32_t sticky;
+	struct cm_sticky_slot slots[CM_NB_STICKY_SLOTS];
+};
+
+static __rte_always_inline struct cm_sticky_slot *
+cm_sticky_slot_get(struct cm_scheduler_qp_ctx *cm_qp_ctx,
+		struct rte_crypto_op *op)
+{
+	uintptr_t sess = (uintptr_t)op->sym->session;
+
+	/* Security sessions carry protocol state, always keep them in order. */
+	if (op->sess_type == RTE_CRYPTO_OP_SECURITY_SESSION ||
+			(cm_qp_ctx->sticky &&
+			 op->sess_type == RTE_CRYPTO_OP_WITH_SESSION))
+		return &cm_qp_ctx->slots[((sess >> 6) ^ (sess >> 16)) &
+				CM_STICKY_SLOT_MASK];
+
+	return NULL;
+}
+
+/*
+ * Credit the completion of nb_ops ops of a worker to its oldest bursts,
+ * and update the cost estimate with the latency of the fully completed ones.
+ */
+static __rte_always_inline void
+cm_worker_complete(struct cm_worker *w, uint16_t nb_ops, uint64_t now)
+{
+	struct cm_batch *b;
+	int64_t sample;
+	uint16_t n;
+
+	while (nb_ops != 0 && w->batch_head != w->batch_tail) {
+		b = &w->batches[w->batch_head & CM_BATCH_MASK];
+		n = RTE_MIN(nb_ops, b->nb_ops);
+		b->nb_ops -= n;
+		nb_ops -= n;
+		if (b->nb_ops != 0)
+			break;
+
+		sample = ((now - b->tsc) << CM_COST_SHIFT) / b->depth;
+		w->cost += (sample - (int64_t)w->cost) >> CM_COST_EWMA_SHIFT;
+		if (unlikely(w->cost == 0))
+			w->cost = 1;
+		w->batch_head++;
+	}
+}
+
+static __rte_always_inline void
+cm_worker_record(struct cm_worker *w, uint16_t nb_ops, uint64_t now)
+{
+	struct cm_batch *b;
+
+	w->nb_ops += nb_ops;
+
+	/* Too many bursts in flight, account the ops to the newest one. */
+	if ((uint16_t)(w->batch_tail - w->batch_head) == CM_NB_BATCHES) {
+		b = &w->batches[(w->batch_tail - 1) & CM_BATCH_MASK];
+		b->nb_ops += nb_ops;
+		b->depth = w->worker.nb_inflight_cops;
+		return;
+	}
+
+	b = &w->batches[w->batch_tail++ & CM_BATCH_MASK];
+	b->tsc = now;
+	b->depth = w->worker.nb_inflight_cops;
+	b->nb_ops = nb_ops;
+}
+
+static uint16_t
+schedule_enqueue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct scheduler_qp_ctx *qp_ctx = qp;
+	struct cm_scheduler_qp_ctx *cm_qp_ctx = qp_ctx->private_qp_ctx;
+	struct rte_crypto_op *sched_ops[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS]
+			[CM_MAX_ENQ_BURST];
+	uint16_t pos[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS] = {0};
+	uint64_t next[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	uint32_t nb_workers = cm_qp_ctx->nb_workers;
+	struct cm_sticky_slot *slot;
+	struct cm_worker *w;
+	uint16_t i, processed_ops, nb_enqd = 0;
+	uint64_t now;
+	uint32_t j, target;
+
+	if (unlikely(nb_ops == 0))
+		return 0;
+
+	nb_ops = RTE_MIN(nb_ops, CM_MAX_ENQ_BURST);
+
+	/* Expected completion time of one more op on each worker */
+	for (j = 0; j < nb_workers; j++) {
+		w = &cm_qp_ctx->workers[j];
+		next[j] = (w->worker.nb_inflight_cops + 1) * w->cost;
+	}
+
+	for (i = 0; i < nb_ops; i++) {
+		if (i + 4 < nb_ops)
+			rte_prefetch0(ops[i + 4]->sym);
+
+		slot = cm_sticky_slot_get(cm_qp_ctx, ops[i]);
+		if (slot != NULL && slot->nb_inflight != 0) {
+			target = slot->worker_idx;
+		} else {
+			target = 0;
+			for (j = 1; j < nb_workers; j++)
+				if (next[j] < next[target])
+					target = j;
+		}
+
+		/* stop before the worker queue is full, see packet-size-distr */
+		w = &cm_qp_ctx->workers[target];
+		if (pos[target] + w->worker.nb_inflight_cops ==
+				qp_ctx->max_nb_objs)
+			break;
+
+		if (slot != NULL) {
+			slot->worker_idx = target;
+			slot->nb_inflight++;
+		}
+
+		scheduler_set_single_worker_session(ops[i], target);
+		sched_ops[target][pos[target]++] = ops[i];
+		next[target] += w->cost;
+	}
+
+	now = rte_rdtsc();
+	for (j = 0; j < nb_workers; j++) {
+		if (pos[j] == 0)
+			continue;
+
+		w = &cm_qp_ctx->workers[j];
+		processed_ops = rte_cryptodev_enqueue_burst(w->worker.dev_id,
+				w->worker.qp_id, sched_ops[j], pos[j]);
+		/* enqueue shall not fail as the worker queue is monitored */
+		RTE_ASSERT(processed_ops == pos[j]);
+
+		w->worker.nb_inflight_cops += processed_ops;
+		cm_worker_record(w, processed_ops, now);
+		nb_enqd += processed_ops;
+	}
+
+	return nb_enqd;
+}
+
+static uint16_t
+schedule_enqueue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+	uint16_t nb_ops_to_enq = get_max_enqueue_order_count(order_ring,
+			nb_ops);
+	uint16_t nb_ops_enqd = schedule_enqueue(qp, ops,
+			nb_ops_to_enq);
+
+	scheduler_order_insert(order_ring, ops, nb_ops_enqd);
+
+	return nb_ops_enqd;
+}
+
+static uint16_t
+schedule_dequeue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct cm_scheduler_qp_ctx *cm_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint32_t worker_idx = cm_qp_ctx->last_deq_worker_idx;
+	struct cm_sticky_slot *slot;
+	struct cm_worker *w;
+	uint16_t i, nb_deq_ops, nb_deq = 0;
+	uint64_t now = 0;
+	uint32_t n;
+
+	for (n = 0; n < cm_qp_ctx->nb_workers && nb_deq < nb_ops; n++) {
+		w = &cm_qp_ctx->workers[worker_idx];
+		if (++worker_idx == cm_qp_ctx->nb_workers)
+			worker_idx = 0;
+
+		if (w->worker.nb_inflight_cops == 0)
+			continue;
+
+		nb_deq_ops = rte_cryptodev_dequeue_burst(w->worker.dev_id,
+				w->worker.qp_id, &ops[nb_deq], nb_ops - nb_deq);
+		if (nb_deq_ops == 0)
+			continue;
+
+		scheduler_retrieve_sessions(&ops[nb_deq], nb_deq_ops);
+		for (i = nb_deq; i < nb_deq + nb_deq_ops; i++) {
+			slot = cm_sticky_slot_get(cm_qp_ctx, ops[i]);
+			if (slot != NULL)
+				slot->nb_inflight--;
+		}
+
+		if (now == 0)
+			now = rte_rdtsc();
+		w->worker.nb_inflight_cops -= nb_deq_ops;
+		cm_worker_complete(w, nb_deq_ops, now);
+		nb_deq += nb_deq_ops;
+	}
+
+	cm_qp_ctx->last_deq_worker_idx = worker_idx;
+
+	return nb_deq;
+}
+
+static uint16_t
+schedule_dequeue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+
+	schedule_dequeue(qp, ops, nb_ops);
+
+	return scheduler_order_drain(order_ring, ops, nb_ops);
+}
+
+static int
+worker_attach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+worker_detach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+scheduler_start(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	struct cm_scheduler_ctx *cm_ctx = sched_ctx->private_ctx;
+	uint16_t i;
+
+	if (sched_ctx->nb_workers == 0) {
+		CR_SCHED_LOG(ERR, "not enough workers to start");
+		return -1;
+	}
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct cm_scheduler_qp_ctx *cm_qp_ctx = qp_ctx->private_qp_ctx;
+		uint32_t j;
+
+		memset(cm_qp_ctx, 0, sizeof(*cm_qp_ctx));
+		for (j = 0; j < sched_ctx->nb_workers; j++) {
+			cm_qp_ctx->workers[j].worker.dev_id =
+					sched_ctx->workers[j].dev_id;
+			cm_qp_ctx->workers[j].worker.qp_id = i;
+			/* equal costs until the workers are measured */
+			cm_qp_ctx->workers[j].cost = 1 << CM_COST_SHIFT;
+		}
+
+		cm_qp_ctx->nb_workers = sched_ctx->nb_workers;
+		cm_qp_ctx->sticky = cm_ctx->sticky;
+	}
+
+	if (sched_ctx->reordering_enabled) {
+		dev->enqueue_burst = &schedule_enqueue_ordering;
+		dev->dequeue_burst = &schedule_dequeue_ordering;
+	} else {
+		dev->enqueue_burst = &schedule_enqueue;
+		dev->dequeue_burst = &schedule_dequeue;
+	}
+
+	return 0;
+}
+
+static int
+scheduler_stop(struct rte_cryptodev *dev)
+{
+	uint16_t i;
+	uint32_t j;
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct cm_scheduler_qp_ctx *cm_qp_ctx = qp_ctx->private_qp_ctx;
+
+		for (j = 0; j < cm_qp_ctx->nb_workers; j++) {
+			if (cm_qp_ctx->workers[j].worker.nb_inflight_cops) {
+				CR_SCHED_LOG(ERR, "Some crypto ops left in worker queue");
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+scheduler_config_qp(struct rte_cryptodev *dev, uint16_t qp_id)
+{
+	struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[qp_id];
+	struct cm_scheduler_qp_ctx *cm_qp_ctx;
+
+	cm_qp_ctx = rte_zmalloc_socket(NULL, sizeof(*cm_qp_ctx), 0,
+			rte_socket_id());
+	if (!cm_qp_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory for private queue pair");
+		return -ENOMEM;
+	}
+
+	qp_ctx->private_qp_ctx = (void *)cm_qp_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_create_private_ctx(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	struct cm_scheduler_ctx *cm_ctx;
+
+	if (sched_ctx->private_ctx) {
+		rte_free(sched_ctx->private_ctx);
+		sched_ctx->private_ctx = NULL;
+	}
+
+	cm_ctx = rte_zmalloc_socket(NULL, sizeof(struct cm_scheduler_ctx), 0,
+			rte_socket_id());
+	if (!cm_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory");
+		return -ENOMEM;
+	}
+
+	sched_ctx->private_ctx = (void *)cm_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_option_set(struct rte_cryptodev *dev, uint32_t option_type,
+		void *option)
+{
+	struct cm_scheduler_ctx *cm_ctx = ((struct scheduler_ctx *)
+			dev->data->dev_private)->private_ctx;
+
+	if ((enum rte_cryptodev_schedule_option_type)option_type !=
+			CDEV_SCHED_OPTION_COST_MODEL) {
+		CR_SCHED_LOG(ERR, "Option not supported");
+		return -EINVAL;
+	}
+
+	cm_ctx->sticky = !!((struct rte_cryptodev_scheduler_cost_model_option *)
+			option)->sticky;
+
+	return 0;
+}
+
+static int
+scheduler_option_get(struct rte_cryptodev *dev, uint32_t option_type,
+		void *option)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	struct cm_scheduler_ctx *cm_ctx = sched_ctx->private_ctx;
+	struct rte_cryptodev_scheduler_cost_model_option *cm_option = option;
+	uint32_t nb_qps[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS] = {0};
+	uint16_t i;
+	uint32_t j;
+
+	if ((enum rte_cryptodev_schedule_option_type)option_type !=
+			CDEV_SCHED_OPTION_COST_MODEL) {
+		CR_SCHED_LOG(ERR, "Option not supported");
+		return -EINVAL;
+	}
+
+	memset(cm_option, 0, sizeof(*cm_option));
+	cm_option->sticky = cm_ctx->sticky;
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct cm_scheduler_qp_ctx *cm_qp_ctx;
+
+		if (qp_ctx == NULL || qp_ctx->private_qp_ctx == NULL)
+			continue;
+
+		cm_qp_ctx = qp_ctx->private_qp_ctx;
+		for (j = 0; j < cm_qp_ctx->nb_workers; j++) {
+			cm_option->worker_ops[j] += cm_qp_ctx->workers[j].nb_ops;
+			cm_option->worker_cost[j] += cm_qp_ctx->workers[j].cost;
+			nb_qps[j]++;
+		}
+	}
+
+	/* average cost over the queue pairs, in cycles per op */
+	for (j = 0; j < sched_ctx->nb_workers; j++)
+		if (nb_qps[j] != 0)
+			cm_option->worker_cost[j] = (cm_option->worker_cost[j] /
+					nb_qps[j]) >> CM_COST_SHIFT;
+
+	return 0;
+}
+
+static struct rte_cryptodev_scheduler_ops scheduler_cm_ops = {
+	worker_attach,
+	worker_detach,
+	scheduler_start,
+	scheduler_stop,
+	scheduler_config_qp,
+	scheduler_create_private_ctx,
+	scheduler_option_set,
+	scheduler_option_get
+};
+
+static struct rte_cryptodev_scheduler scheduler = {
+		.name = "cost-model-scheduler",
+		.description = "scheduler which spreads each burst across "
+				"worker crypto devices to minimize the expected "
+				"completion time",
+		.mode = CDEV_SCHED_MODE_COST_MODEL,
+		.ops = &scheduler_cm_ops
+};
+
+struct rte_cryptodev_scheduler *crypto_scheduler_cost_model = &scheduler;
@@ -2,11 +2,16 @@
  * Copyright(c) 2018 Ericsson AB
  */
 
+#include <ctype.h>
+#include <errno.h>
 #include <stdbool.h>
 
+#include <stdlib.h>
+
 #include <rte_cycles.h>
 #include <eventdev_pmd.h>
 #include <eventdev_pmd_vdev.h>
+#include <rte_kvargs.h>
 #include <rte_random.h>
 #include <rte_ring_elem.h>
 
@@ -14,6 +19,9 @@
 
 #define EVENTDEV_NAME_DSW_PMD event_dsw
 
+#define FLOWS_PER_MIGRATION_ARG "flows_per_migration"
+#define PIPELINED_MIGRATION_ARG "pipelined_migration"
+
 static int
 dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 	       const struct rte_event_port_conf *conf)
@@ -435,18 +443,102 @@ static struct eventdev_ops dsw_evdev_ops = {
 	.crypto_adapter_caps_get = dsw_crypto_adapter_caps_get,
 	.xstats_get = dsw_xstats_get,
 	.xstats_get_names = dsw_xstats_get_names,
-	.xstats_get_by_name = dsw_xstats_get_by_name
+	.xstats_get_by_name = dsw_xstats_get_by_name,
+	.dev_selftest = test_dsw_eventdev
 };
 
+/* Only accept a plain decimal number, within [min, max] */
+static int
+dsw_parse_int(const char *value, int min, int max, int *result)
+{
+	char *end;
+	long v;
+
+	if (value == NULL || !isdigit((unsigned char)value[0]))
+		return -1;
+
+	errno = 0;
+	v = strtol(value, &end, 10);
+	if (errno != 0 || *end != '\0' || v < min || v > max)
+		return -1;
+
+	*result = v;
+	return 0;
+}
+
+static int
+set_flows_per_migration(const char *key __rte_unused, const char *value,
+			void *opaque)
+{
+	return dsw_parse_int(value, 1, DSW_MAX_FLOWS_PER_MIGRATION, opaque);
+}
+
+static int
+set_pipelined_migration(const char *key __rte_unused, const char *value,
+			void *opaque)
+{
+	return dsw_parse_int(value, 0, 1, opaque);
+}
+
+static int
+dsw_parse_params(const char *name, const char *params,
+		 int *flows_per_migration, int *pipelined_migration)
+{
+	static const char *const args[] = {
+		FLOWS_PER_MIGRATION_ARG,
+		PIPELINED_MIGRATION_ARG,
+		NULL
+	};
+	struct rte_kvargs *kvlist;
+	int ret;
+
+	if (params == NULL || params[0] == '\0')
+		return 0;
+
+	kvlist = rte_kvargs_parse(params, args);
+	if (kvlist == NULL) {
+		RTE_LOG_LINE(ERR, EVENT_DSW,
+			"%s: Invalid or unsupported parameters '%s'",
+			name, params);
+		return -EINVAL;
+	}
+
+	ret = rte_kvargs_process(kvlist, FLOWS_PER_MIGRATION_ARG,
+				 set_flows_per_migration, flows_per_migration);
+	if (ret != 0) {
+		RTE_LOG_LINE(ERR, EVENT_DSW,
+			"%s: Error parsing flows per migration parameter",
+			name);
+		goto out;
+	}
+
+	ret = rte_kvargs_process(kvlist, PIPELINED_MIGRATION_ARG,
+				 set_pipelined_migration, pipelined_migration);
+	if (ret != 0)
+		RTE_LOG_LINE(ERR, EVENT_DSW,
+			"%s: Error parsing pipelined migration parameter",
+			name);
+
+out:
+	rte_kvargs_free(kvlist);
+	return ret != 0 ? -EINVAL : 0;
+}
+
 static int
 dsw_probe(struct rte_vdev_device *vdev)
 {
 	const char *name;
 	struct rte_eventdev *dev;
 	struct dsw_evdev *dsw;
+	int flows_per_migration = DSW_DEFAULT_FLOWS_PER_MIGRATION;
+	int pipelined_migration = 0;
 
 	name = rte_vdev_device_name(vdev);
 
+	if (dsw_parse_params(name, rte_vdev_device_args(vdev),
+			     &flows_per_migration, &pipelined_migration) != 0)
+		return -EINVAL;
+
 	dev = rte_event_pmd_vdev_init(name, sizeof(struct dsw_evdev),
 				      rte_socket_id(), vdev);
 	if (dev == NULL)
@@ -464,6 +556,8 @@ dsw_probe(struct rte_vdev_device *vdev)
 
 	dsw = dev->data->dev_private;
 	dsw->data = dev->data;
+	dsw->flows_per_migration = flows_per_migration;
+	dsw->pipelined_migration = pipelined_migration;
 
 	event_dev_probing_finish(dev);
 	return 0;
@@ -487,4 +581,6 @@ static struct rte_vdev_driver evdev_dsw_pmd_drv = {
 };
 
 RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_DSW_PMD, evdev_dsw_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(event_dsw, FLOWS_PER_MIGRATION_ARG "=<int> "
+		PIPELINED_MIGRATION_ARG "=<0|1>");
 RTE_LOG_REGISTER_DEFAULT(event_dsw_logtype, NOTICE);
@@ -100,16 +100,34 @@
 
 #define DSW_MAX_EVENTS_RECORDED (128)
 
-#define DSW_MAX_FLOWS_PER_MIGRATION (8)
+/* The number of flows moved in one migration round may be configured
+ * with the 'flows_per_migration' devarg, up to the maximum.
+ */
+#define DSW_DEFAULT_FLOWS_PER_MIGRATION (8)
+#define DSW_MAX_FLOWS_PER_MIGRATION (32)
 
-/* Only one outstanding migration per port is allowed */
-#define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION)
+/* Only one outstanding migration per port is allowed, except in
+ * pipelined mode, where one migration may be pausing while the
+ * previous one is still being unpaused.
+ */
+#define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION*2)
 
-/* Enough room for pause request/confirm and unpaus request/confirm for
- * all possible senders.
+/* Enough room for pause request/confirm and unpause request/confirm
+ * for all possible senders. In pipelined mode, a port has at most one
+ * unpause and one pause request outstanding, and so the same size
+ * holds.
  */
 #define DSW_CTL_IN_RING_SIZE ((DSW_MAX_PORTS-1)*4)
 
+/* In pipelined migration mode, the control ring is drained up to this
+ * many messages per background task, instead of one, to shorten the
+ * pause/unpause handshake.
+ */
+#define DSW_MAX_CTL_MSGS_PER_BG_TASK (8)
+
+/* Log2-scaled histogram of flow migration latency, in timer cycles. */
+#define DSW_MIGRATION_LATENCY_BUCKETS (40)
+
 /* With DSW_SORT_DEQUEUED enabled, the scheduler will, at the point of
  * dequeue(), arrange events so that events with the same flow id on
  * the same queue forms a back-to-back "burst", and also so that such
@@ -176,7 +194,10 @@ struct __rte_cache_aligned dsw_port {
 
 	uint64_t emigration_start;
 	uint64_t emigrations;
+	uint64_t emigration_rounds;
 	uint64_t emigration_latency;
+	uint64_t emigration_latency_max;
+	uint64_t emigration_latency_hist[DSW_MIGRATION_LATENCY_BUCKETS];
 
 	uint8_t emigration_target_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	struct dsw_queue_flow
@@ -184,6 +205,15 @@ struct __rte_cache_aligned dsw_port {
 	uint8_t emigration_targets_len;
 	uint8_t cfm_cnt;
 
+	/* In pipelined migration mode, the flows of the previous
+	 * migration round are kept here until all ports have confirmed
+	 * they are unpaused, while the next round may already proceed.
+	 */
+	uint64_t unpausing_start;
+	struct dsw_queue_flow unpausing_qfs[DSW_MAX_FLOWS_PER_MIGRATION];
+	uint8_t unpausing_qfs_len;
+	uint8_t unpause_cfm_cnt;
+
 	uint64_t immigrations;
 
 	uint16_t paused_flows_len;
@@ -256,12 +286,16 @@ struct dsw_evdev {
 	uint8_t num_queues;
 	int32_t max_inflight;
 
+	uint8_t flows_per_migration;
+	bool pipelined_migration;
+
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) credits_on_loan;
 };
 
 #define DSW_CTL_PAUSE_REQ (0)
 #define DSW_CTL_UNPAUSE_REQ (1)
-#define DSW_CTL_CFM (2)
+#define DSW_CTL_PAUSE_CFM (2)
+#define DSW_CTL_UNPAUSE_CFM (3)
 
 struct __rte_aligned(4) dsw_ctl_msg {
 	uint8_t type;
@@ -295,6 +329,8 @@ int dsw_xstats_get(const struct rte_eventdev *dev,
 uint64_t dsw_xstats_get_by_name(const struct rte_eventdev *dev,
 				const char *name, uint64_t *id);
 
+int test_dsw_eventdev(void);
+
 static inline struct dsw_evdev *
 dsw_pmd_priv(const struct rte_eventdev *eventdev)
 {
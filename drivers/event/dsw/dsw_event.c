@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <rte_bitops.h>
 #include <rte_cycles.h>
 #include <rte_memcpy.h>
 #include <rte_random.h>
@@ -325,7 +326,7 @@ dsw_port_handle_pause_flows(struct dsw_evdev *dsw, struct dsw_port *port,
 			    uint8_t qfs_len)
 {
 	struct dsw_ctl_msg cfm = {
-		.type = DSW_CTL_CFM,
+		.type = DSW_CTL_PAUSE_CFM,
 		.originating_port_id = port->id
 	};
 
@@ -491,6 +492,14 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 					     qf->queue_id, qf->flow_hash))
 			continue;
 
+		/* Flows still being unpaused from the previous
+		 * (pipelined) migration round are left alone.
+		 */
+		if (dsw_is_queue_flow_in_ary(source_port->unpausing_qfs,
+					     source_port->unpausing_qfs_len,
+					     qf->queue_id, qf->flow_hash))
+			continue;
+
 		flow_load = dsw_flow_load(burst->count, source_port_load);
 
 		for (port_id = 0; port_id < num_ports; port_id++) {
@@ -551,7 +560,7 @@ dsw_select_emigration_targets(struct dsw_evdev *dsw,
 	uint8_t *targets_len = &source_port->emigration_targets_len;
 	uint16_t i;
 
-	for (i = 0; i < DSW_MAX_FLOWS_PER_MIGRATION; i++) {
+	for (i = 0; i < dsw->flows_per_migration; i++) {
 		bool found;
 
 		found = dsw_select_emigration_target(dsw, source_port,
@@ -740,14 +749,21 @@ dsw_port_flush_no_longer_paused_events(struct dsw_evdev *dsw,
 }
 
 static void
-dsw_port_emigration_stats(struct dsw_port *port, uint8_t finished)
+dsw_port_emigration_stats(struct dsw_port *port, uint64_t start,
+			  uint8_t finished)
 {
 	uint64_t flow_migration_latency;
+	unsigned int bucket;
 
-	flow_migration_latency =
-		(rte_get_timer_cycles() - port->emigration_start);
+	flow_migration_latency = (rte_get_timer_cycles() - start);
 	port->emigration_latency += (flow_migration_latency * finished);
 	port->emigrations += finished;
+
+	bucket = RTE_MIN(rte_fls_u64(flow_migration_latency),
+			 DSW_MIGRATION_LATENCY_BUCKETS - 1U);
+	port->emigration_latency_hist[bucket] += finished;
+	port->emigration_latency_max = RTE_MAX(port->emigration_latency_max,
+					       flow_migration_latency);
 }
 
 static void
@@ -783,7 +799,8 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 	finished = port->emigration_targets_len - left_qfs_len;
 
 	if (finished > 0)
-		dsw_port_emigration_stats(port, finished);
+		dsw_port_emigration_stats(port, port->emigration_start,
+					  finished);
 
 	for (i = 0; i < left_qfs_len; i++) {
 		port->emigration_target_port_ids[i] = left_port_ids[i];
@@ -933,6 +950,7 @@ dsw_port_consider_emigration(struct dsw_evdev *dsw,
 
 	source_port->migration_state = DSW_MIGRATION_STATE_FINISH_PENDING;
 	source_port->emigration_start = rte_get_timer_cycles();
+	source_port->emigration_rounds++;
 
 	/* No need to go through the whole pause procedure for
 	 * parallel queues, since atomic/ordered semantics need not to
@@ -1020,7 +1038,7 @@ dsw_port_handle_unpause_flows(struct dsw_evdev *dsw, struct dsw_port *port,
 {
 	uint16_t i;
 	struct dsw_ctl_msg cfm = {
-		.type = DSW_CTL_CFM,
+		.type = DSW_CTL_UNPAUSE_CFM,
 		.originating_port_id = port->id
 	};
 
@@ -1170,6 +1188,28 @@ dsw_port_forward_emigrated_flows(struct dsw_evdev *dsw,
 	source_port->emigrating_events_len = 0;
 }
 
+static void
+dsw_port_pipeline_emigration(struct dsw_port *source_port)
+{
+	RTE_ASSERT(source_port->unpausing_qfs_len == 0);
+
+	/* The flows are already moved. Waiting for the other ports
+	 * to confirm them being unpaused needs not to hold up the
+	 * next migration round.
+	 */
+	rte_memcpy(source_port->unpausing_qfs,
+		   source_port->emigration_target_qfs,
+		   source_port->emigration_targets_len *
+		   sizeof(struct dsw_queue_flow));
+	source_port->unpausing_qfs_len = source_port->emigration_targets_len;
+	source_port->unpausing_start = source_port->emigration_start;
+	source_port->unpause_cfm_cnt = 0;
+
+	source_port->emigration_targets_len = 0;
+	source_port->seen_events_len = 0;
+	source_port->migration_state = DSW_MIGRATION_STATE_IDLE;
+}
+
 static void
 dsw_port_move_emigrating_flows(struct dsw_evdev *dsw,
 			       struct dsw_port *source_port)
@@ -1220,12 +1260,49 @@ dsw_port_move_emigrating_flows(struct dsw_evdev *dsw,
 			       source_port->emigration_target_qfs,
 			       source_port->emigration_targets_len);
 	source_port->cfm_cnt = 0;
-	source_port->migration_state = DSW_MIGRATION_STATE_UNPAUSING;
+
+	if (dsw->pipelined_migration)
+		dsw_port_pipeline_emigration(source_port);
+	else
+		source_port->migration_state = DSW_MIGRATION_STATE_UNPAUSING;
 }
 
 static void
-dsw_port_handle_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
+dsw_port_end_unpausing(struct dsw_port *port)
 {
+	uint8_t i;
+
+	for (i = 0; i < port->unpausing_qfs_len; i++)
+		DSW_LOG_DP_PORT_LINE(DEBUG, port->id, "Migration completed for "
+				"queue_id %d flow_hash %d.",
+				port->unpausing_qfs[i].queue_id,
+				port->unpausing_qfs[i].flow_hash);
+
+	dsw_port_emigration_stats(port, port->unpausing_start,
+				  port->unpausing_qfs_len);
+
+	port->unpausing_qfs_len = 0;
+}
+
+static void
+dsw_port_handle_confirm(struct dsw_evdev *dsw, struct dsw_port *port,
+			uint8_t type)
+{
+	/* In pipelined mode, unpause confirmations relate to the
+	 * previous migration round, and are counted separately from
+	 * the pause confirmations of the current one. All ports
+	 * process control messages in order, so the previous round is
+	 * always fully unpaused before the current one is fully
+	 * paused.
+	 */
+	if (type == DSW_CTL_UNPAUSE_CFM && dsw->pipelined_migration) {
+		port->unpause_cfm_cnt++;
+
+		if (port->unpause_cfm_cnt == (dsw->num_ports - 1))
+			dsw_port_end_unpausing(port);
+		return;
+	}
+
 	port->cfm_cnt++;
 
 	if (port->cfm_cnt == (dsw->num_ports - 1)) {
@@ -1247,9 +1324,15 @@ dsw_port_handle_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
 static void
 dsw_port_ctl_process(struct dsw_evdev *dsw, struct dsw_port *port)
 {
+	uint16_t max_msgs = dsw->pipelined_migration ?
+		DSW_MAX_CTL_MSGS_PER_BG_TASK : 1;
 	struct dsw_ctl_msg msg;
+	uint16_t i;
+
+	for (i = 0; i < max_msgs; i++) {
+		if (dsw_port_ctl_dequeue(port, &msg) != 0)
+			break;
 
-	if (dsw_port_ctl_dequeue(port, &msg) == 0) {
 		switch (msg.type) {
 		case DSW_CTL_PAUSE_REQ:
 			dsw_port_handle_pause_flows(dsw, port,
@@ -1261,8 +1344,9 @@ dsw_port_ctl_process(struct dsw_evdev *dsw, struct dsw_port *port)
 						      msg.originating_port_id,
 						      msg.qfs, msg.qfs_len);
 			break;
-		case DSW_CTL_CFM:
-			dsw_port_handle_confirm(dsw, port);
+		case DSW_CTL_PAUSE_CFM:
+		case DSW_CTL_UNPAUSE_CFM:
+			dsw_port_handle_confirm(dsw, port, msg.type);
 			break;
 		}
 	}
@@ -0,0 +1,292 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <bus_vdev_driver.h>
+#include <rte_cycles.h>
+#include <rte_eventdev.h>
+
+#include "dsw_evdev.h"
+
+#define TEST_NAME "event_dsw_selftest"
+
+#define TEST_NUM_FLOWS 64
+#define TEST_NEW_BURST 8
+#define TEST_MIN_ROUNDS 4
+#define TEST_TIMEOUT_US (5 * US_PER_S)
+
+/* Ports 0 and 1 serve the atomic queue, port 2 only produces */
+#define TEST_LOADED_PORT 0
+#define TEST_IDLE_PORT 1
+#define TEST_PRODUCER_PORT 2
+#define TEST_NUM_PORTS 3
+
+struct test_flows {
+	uint32_t enq_seqn[TEST_NUM_FLOWS];
+	uint32_t deq_seqn[TEST_NUM_FLOWS];
+	uint64_t enqueued;
+	uint64_t dequeued;
+};
+
+static int
+test_setup(uint8_t dev_id)
+{
+	struct rte_event_dev_config config = {
+		.nb_event_queues = 1,
+		.nb_event_ports = TEST_NUM_PORTS,
+		.nb_events_limit = 4096,
+		.nb_event_queue_flows = 1024,
+		.nb_event_port_dequeue_depth = 128,
+		.nb_event_port_enqueue_depth = 128,
+	};
+	struct rte_event_queue_conf queue_conf;
+	struct rte_event_port_conf port_conf;
+	uint8_t queue_id = 0;
+	uint8_t port_id;
+
+	if (rte_event_dev_configure(dev_id, &config) < 0) {
+		printf("%d: Error configuring device\n", __LINE__);
+		return -1;
+	}
+
+	rte_event_queue_default_conf_get(dev_id, queue_id, &queue_conf);
+	queue_conf.schedule_type = RTE_SCHED_TYPE_ATOMIC;
+	if (rte_event_queue_setup(dev_id, queue_id, &queue_conf) < 0) {
+		printf("%d: Error setting up queue\n", __LINE__);
+		return -1;
+	}
+
+	for (port_id = 0; port_id < TEST_NUM_PORTS; port_id++) {
+		rte_event_port_default_conf_get(dev_id, port_id, &port_conf);
+		if (rte_event_port_setup(dev_id, port_id, &port_conf) < 0) {
+			printf("%d: Error setting up port %u\n", __LINE__,
+			       port_id);
+			return -1;
+		}
+		if (port_id != TEST_PRODUCER_PORT &&
+		    rte_event_port_link(dev_id, port_id, &queue_id, NULL,
+					1) != 1) {
+			printf("%d: Error linking port %u\n", __LINE__,
+			       port_id);
+			return -1;
+		}
+	}
+
+	if (rte_event_dev_start(dev_id) < 0) {
+		printf("%d: Error starting device\n", __LINE__);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+test_produce(uint8_t dev_id, struct test_flows *flows)
+{
+	unsigned int i;
+
+	for (i = 0; i < TEST_NEW_BURST; i++) {
+		uint32_t flow_id = flows->enqueued % TEST_NUM_FLOWS;
+		struct rte_event ev = {
+			.op = RTE_EVENT_OP_NEW,
+			.queue_id = 0,
+			.sched_type = RTE_SCHED_TYPE_ATOMIC,
+			.flow_id = flow_id,
+			.u64 = flows->enq_seqn[flow_id],
+		};
+
+		/* out of credits, the consumers are behind */
+		if (rte_event_enqueue_new_burst(dev_id, TEST_PRODUCER_PORT,
+						&ev, 1) != 1)
+			break;
+
+		flows->enq_seqn[flow_id]++;
+		flows->enqueued++;
+	}
+
+	rte_event_maintain(dev_id, TEST_PRODUCER_PORT, 0);
+}
+
+static int
+test_consume(uint8_t dev_id, uint8_t port_id, uint16_t max,
+	     struct test_flows *flows)
+{
+	struct rte_event evs[128];
+	uint16_t i, n;
+
+	/* The previous events are released implicitly */
+	n = rte_event_dequeue_burst(dev_id, port_id, evs, max, 0);
+
+	for (i = 0; i < n; i++) {
+		uint32_t flow_id = evs[i].flow_id;
+
+		if (flow_id >= TEST_NUM_FLOWS ||
+		    evs[i].u64 != flows->deq_seqn[flow_id]) {
+			printf("%d: Port %u got flow %u seqn %" PRIu64
+			       " expected %u\n", __LINE__, port_id, flow_id,
+			       evs[i].u64, flow_id < TEST_NUM_FLOWS ?
+			       flows->deq_seqn[flow_id] : 0);
+			return -1;
+		}
+		flows->deq_seqn[flow_id]++;
+	}
+	flows->dequeued += n;
+
+	return n;
+}
+
+static uint64_t
+test_port_xstat(uint8_t dev_id, uint8_t port_id, const char *stat)
+{
+	char name[RTE_EVENT_DEV_XSTATS_NAME_SIZE];
+
+	snprintf(name, sizeof(name), "port_%u_%s", port_id, stat);
+
+	return rte_event_dev_xstats_by_name_get(dev_id, name, NULL);
+}
+
+/*
+ * A single lcore drives all ports. The loaded port only takes one event
+ * per call and builds up a backlog, so it stays busy. The idle port
+ * drains its events on every call. Flows are thus migrated from the
+ * former to the latter, round after round, while their order is checked.
+ */
+static int
+test_pipelined_emigration(uint8_t dev_id)
+{
+	struct test_flows flows = { 0 };
+	uint64_t deadline, rounds = 0;
+	int n;
+
+	if (test_setup(dev_id) < 0)
+		return -1;
+
+	deadline = rte_get_timer_cycles() +
+		TEST_TIMEOUT_US * rte_get_timer_hz() / US_PER_S;
+
+	while (rounds < TEST_MIN_ROUNDS) {
+		if (rte_get_timer_cycles() > deadline) {
+			printf("%d: Only %" PRIu64 " migration rounds\n",
+			       __LINE__, rounds);
+			goto err;
+		}
+
+		test_produce(dev_id, &flows);
+
+		if (test_consume(dev_id, TEST_LOADED_PORT, 1, &flows) < 0)
+			goto err;
+
+		do {
+			n = test_consume(dev_id, TEST_IDLE_PORT, 128, &flows);
+			if (n < 0)
+				goto err;
+		} while (n > 0);
+
+		rounds = test_port_xstat(dev_id, TEST_LOADED_PORT,
+					 "migration_rounds");
+	}
+
+	/* Drain, no event may be lost while the flows moved */
+	deadline = rte_get_timer_cycles() + rte_get_timer_hz();
+	while (flows.dequeued != flows.enqueued) {
+		if (rte_get_timer_cycles() > deadline) {
+			printf("%d: Dequeued %" PRIu64 " of %" PRIu64
+			       " events\n", __LINE__, flows.dequeued,
+			       flows.enqueued);
+			goto err;
+		}
+
+		rte_event_maintain(dev_id, TEST_PRODUCER_PORT, 0);
+		if (test_consume(dev_id, TEST_LOADED_PORT, 128, &flows) < 0 ||
+		    test_consume(dev_id, TEST_IDLE_PORT, 128, &flows) < 0)
+			goto err;
+	}
+
+	if (test_port_xstat(dev_id, TEST_IDLE_PORT, "immigrations") == 0) {
+		printf("%d: No flow immigrated\n", __LINE__);
+		goto err;
+	}
+
+	/* release the last events */
+	test_consume(dev_id, TEST_LOADED_PORT, 128, &flows);
+	test_consume(dev_id, TEST_IDLE_PORT, 128, &flows);
+
+	rte_event_dev_stop(dev_id);
+	return 0;
+
+err:
+	rte_event_dev_dump(dev_id, stdout);
+	rte_event_dev_stop(dev_id);
+	return -1;
+}
+
+static int
+test_invalid_params(void)
+{
+	static const char *const params[] = {
+		"pipelined_migration=2",
+		"pipelined_migration=",
+		"flows_per_migration=0",
+		"flows_per_migration=8x",
+		"flows_per_migration=-8",
+		"unknown_param=1",
+	};
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(params); i++) {
+		if (rte_vdev_init(TEST_NAME, params[i]) == 0) {
+			printf("%d: Device created with '%s'\n", __LINE__,
+			       params[i]);
+			rte_vdev_uninit(TEST_NAME);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int
+test_dsw_eventdev(void)
+{
+	int dev_id;
+	int ret;
+
+	printf("*** Running Invalid Parameters test...\n");
+	if (test_invalid_params() < 0) {
+		printf("ERROR - Invalid Parameters test FAILED.\n");
+		goto fail;
+	}
+
+	/* A dedicated instance, whatever the options of the tested one */
+	if (rte_vdev_init(TEST_NAME, "pipelined_migration=1") < 0) {
+		printf("Error creating eventdev\n");
+		goto fail;
+	}
+	dev_id = rte_event_dev_get_dev_id(TEST_NAME);
+	if (dev_id < 0) {
+		printf("Error finding newly created eventdev\n");
+		rte_vdev_uninit(TEST_NAME);
+		goto fail;
+	}
+
+	printf("*** Running Pipelined Emigration test...\n");
+	ret = test_pipelined_emigration(dev_id);
+	if (ret != 0)
+		printf("ERROR - Pipelined Emigration test FAILED.\n");
+
+	if (rte_vdev_uninit(TEST_NAME) < 0) {
+		printf("Error removing eventdev\n");
+		ret = -1;
+	}
+	if (ret != 0)
+		goto fail;
+
+	printf("DSW Eventdev Selftest Successful.\n");
+	return 0;
+fail:
+	printf("DSW Eventdev Selftest Failed.\n");
+	return -1;
+}
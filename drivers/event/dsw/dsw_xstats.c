@@ -97,6 +97,38 @@ dsw_xstats_port_get_migration_latency(struct dsw_evdev *dsw, uint8_t port_id,
 	return num_emigrations > 0 ? total_latency / num_emigrations : 0;
 }
 
+DSW_GEN_PORT_ACCESS_FN(emigration_latency_max)
+
+static uint64_t
+dsw_xstats_port_get_migration_latency_p99(struct dsw_evdev *dsw,
+					  uint8_t port_id,
+					  uint8_t queue_id __rte_unused)
+{
+	struct dsw_port *port = &dsw->ports[port_id];
+	uint64_t target;
+	uint64_t count = 0;
+	unsigned int i;
+
+	if (port->emigrations == 0)
+		return 0;
+
+	target = RTE_MAX((port->emigrations * 99) / 100, UINT64_C(1));
+
+	/* Report the upper bound of the first log2 bucket reaching
+	 * the target, but never more than the highest latency seen.
+	 */
+	for (i = 0; i < DSW_MIGRATION_LATENCY_BUCKETS - 1; i++) {
+		count += port->emigration_latency_hist[i];
+		if (count >= target)
+			return RTE_MIN(UINT64_C(1) << i,
+				       port->emigration_latency_max);
+	}
+
+	return port->emigration_latency_max;
+}
+
+DSW_GEN_PORT_ACCESS_FN(emigration_rounds)
+
 static uint64_t
 dsw_xstats_port_get_event_proc_latency(struct dsw_evdev *dsw, uint8_t port_id,
 				       uint8_t queue_id __rte_unused)
@@ -150,6 +182,12 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	  false },
 	{ "port_%u_migration_latency", dsw_xstats_port_get_migration_latency,
 	  false },
+	{ "port_%u_migration_latency_max",
+	  dsw_xstats_port_get_emigration_latency_max, false },
+	{ "port_%u_migration_latency_p99",
+	  dsw_xstats_port_get_migration_latency_p99, false },
+	{ "port_%u_migration_rounds", dsw_xstats_port_get_emigration_rounds,
+	  false },
 	{ "port_%u_immigrations", dsw_xstats_port_get_immigrations,
 	  false },
 	{ "port_%u_event_proc_latency", dsw_xstats_port_get_event_proc_latency,
@@ -24,6 +24,7 @@
 #define MIN_BURST_SIZE_ARG "min_burst"
 #define DEQ_BURST_SIZE_ARG "deq_burst"
 #define REFIL_ONCE_ARG "refill_once"
+#define SCHED_SHARDS_ARG "sched_shards"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
@@ -114,12 +115,15 @@ sw_port_unlink(struct rte_eventdev *dev, void *port, uint8_t queues[],
 				if (q->type == RTE_SCHED_TYPE_ORDERED)
 					p->num_ordered_qids--;
 
+				/* acked by the shard scheduling the qid */
+				sw->shards[q->shard].ports[p->id]
+					.unlinks_in_progress++;
+
 				continue;
 			}
 		}
 	}
 
-	p->unlinks_in_progress += unlinked;
 	rte_smp_mb();
 
 	return unlinked;
@@ -128,9 +132,76 @@ sw_port_unlink(struct rte_eventdev *dev, void *port, uint8_t queues[],
 static int
 sw_port_unlinks_in_progress(struct rte_eventdev *dev, void *port)
 {
-	RTE_SET_USED(dev);
+	struct sw_evdev *sw = sw_pmd_priv(dev);
 	struct sw_port *p = port;
-	return p->unlinks_in_progress;
+	int unlinks_in_progress = 0;
+	uint32_t s;
+
+	for (s = 0; s < sw->nb_shards; s++)
+		unlinks_in_progress +=
+			sw->shards[s].ports[p->id].unlinks_in_progress;
+
+	return unlinks_in_progress;
+}
+
+static int
+sw_shard_port_setup(struct rte_eventdev *dev, struct sw_shard *sh,
+		uint8_t port_id, const struct rte_event_port_conf *conf)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	struct sw_port *p = &sh->ports[port_id];
+	char buf[RTE_RING_NAMESIZE];
+	unsigned int i;
+
+	*p = (struct sw_port){0}; /* zero entire structure */
+	p->id = port_id;
+	p->sw = sw;
+
+	snprintf(buf, sizeof(buf), "sw%d_p%u_s%u_rx_worker_ring",
+			dev->data->dev_id, port_id, sh->id);
+	rte_event_ring_free(rte_event_ring_lookup(buf));
+
+	p->rx_worker_ring = rte_event_ring_create(buf, MAX_SW_PROD_Q_DEPTH,
+			dev->data->socket_id,
+			RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (p->rx_worker_ring == NULL) {
+		SW_LOG_ERR("Error creating RX worker ring for port %d shard %d",
+				port_id, sh->id);
+		return -1;
+	}
+
+	snprintf(buf, sizeof(buf), "sw%d_p%u_s%u_cq_worker_ring",
+			dev->data->dev_id, port_id, sh->id);
+	rte_event_ring_free(rte_event_ring_lookup(buf));
+
+	p->cq_worker_ring = rte_event_ring_create(buf, conf->dequeue_depth,
+			dev->data->socket_id,
+			RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (p->cq_worker_ring == NULL) {
+		rte_event_ring_free(p->rx_worker_ring);
+		p->rx_worker_ring = NULL;
+		SW_LOG_ERR("Error creating CQ worker ring for port %d shard %d",
+				port_id, sh->id);
+		return -1;
+	}
+	sh->cq_ring_space[port_id] = conf->dequeue_depth;
+
+	/* set hist list contents to empty */
+	for (i = 0; i < SW_PORT_HIST_LIST; i++) {
+		p->hist_list[i].fid = -1;
+		p->hist_list[i].qid = -1;
+	}
+
+	p->initialized = 1;
+	return 0;
+}
+
+static void
+sw_shard_port_release(struct sw_port *p)
+{
+	rte_event_ring_free(p->rx_worker_ring);
+	rte_event_ring_free(p->cq_worker_ring);
+	memset(p, 0, sizeof(*p));
 }
 
 static int
@@ -140,7 +211,7 @@ sw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	struct sw_port *p = &sw->ports[port_id];
 	char buf[RTE_RING_NAMESIZE];
-	unsigned int i;
+	unsigned int i, s;
 
 	struct rte_event_dev_info info;
 	sw_info_get(dev, &info);
@@ -153,6 +224,9 @@ sw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 		 * the sum to no leak credits
 		 */
 		int possible_inflights = p->inflight_credits + p->inflights;
+		for (s = 1; s < sw->nb_shards; s++)
+			possible_inflights +=
+				sw->shards[s].ports[port_id].inflights;
 		rte_atomic32_sub(&sw->inflights, possible_inflights);
 	}
 
@@ -197,13 +271,28 @@ sw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 				port_id);
 		return -1;
 	}
-	sw->cq_ring_space[port_id] = conf->dequeue_depth;
+	sw->shards[0].cq_ring_space[port_id] = conf->dequeue_depth;
 
 	/* set hist list contents to empty */
 	for (i = 0; i < SW_PORT_HIST_LIST; i++) {
 		p->hist_list[i].fid = -1;
 		p->hist_list[i].qid = -1;
 	}
+
+	/* the other shards have their own rings to the port */
+	for (s = 1; s < sw->nb_shards; s++) {
+		if (sw_shard_port_setup(dev, &sw->shards[s], port_id,
+				conf) < 0) {
+			while (--s > 0)
+				sw_shard_port_release(
+					&sw->shards[s].ports[port_id]);
+			rte_event_ring_free(p->rx_worker_ring);
+			rte_event_ring_free(p->cq_worker_ring);
+			p->rx_worker_ring = NULL;
+			p->cq_worker_ring = NULL;
+			return -1;
+		}
+	}
 	dev->data->ports[port_id] = p;
 
 	rte_smp_wmb();
@@ -215,9 +304,17 @@ static void
 sw_port_release(void *port)
 {
 	struct sw_port *p = (void *)port;
+	struct sw_evdev *sw;
+	uint32_t s;
+
 	if (p == NULL)
 		return;
 
+	sw = p->sw;
+	if (sw != NULL)
+		for (s = 1; s < sw->nb_shards; s++)
+			sw_shard_port_release(&sw->shards[s].ports[p->id]);
+
 	rte_event_ring_free(p->rx_worker_ring);
 	rte_event_ring_free(p->cq_worker_ring);
 	memset(p, 0, sizeof(*p));
@@ -239,6 +336,7 @@ qid_init(struct sw_evdev *sw, unsigned int idx, int type,
 	qid->id = idx;
 	qid->type = type;
 	qid->priority = queue_conf->priority;
+	qid->shard = idx % sw->nb_shards;
 
 	if (qid->type == RTE_SCHED_TYPE_ORDERED) {
 		uint32_t window_size;
@@ -359,7 +457,7 @@ sw_init_qid_iqs(struct sw_evdev *sw)
 			continue;
 
 		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			iq_init(&sw->shards[qid->shard], &qid->iq[j]);
 	}
 }
 
@@ -381,12 +479,19 @@ sw_qids_empty(struct sw_evdev *sw)
 static int
 sw_ports_empty(struct sw_evdev *sw)
 {
-	unsigned int i;
+	unsigned int i, s;
 
-	for (i = 0; i < sw->port_count; i++) {
-		if ((rte_event_ring_count(sw->ports[i].rx_worker_ring)) ||
-		     rte_event_ring_count(sw->ports[i].cq_worker_ring))
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		if (sh->xfer_ring && rte_event_ring_count(sh->xfer_ring))
 			return 0;
+
+		for (i = 0; i < sw->port_count; i++) {
+			if ((rte_event_ring_count(sh->ports[i].rx_worker_ring)) ||
+			     rte_event_ring_count(sh->ports[i].cq_worker_ring))
+				return 0;
+		}
 	}
 
 	return 1;
@@ -419,9 +524,8 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_shard *sh, struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -433,7 +537,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(sh, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -447,8 +551,10 @@ sw_drain_queues(struct rte_eventdev *dev)
 	unsigned int i, j;
 
 	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_shard *sh = &sw->shards[sw->qids[i].shard];
+
 		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+			sw_drain_queue(dev, sh, &sw->qids[i].iq[j]);
 	}
 }
 
@@ -465,7 +571,8 @@ sw_clean_qid_iqs(struct rte_eventdev *dev)
 		for (j = 0; j < SW_IQS_MAX; j++) {
 			if (!qid->iq[j].head)
 				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
+			iq_free_chunk_list(&sw->shards[qid->shard],
+					qid->iq[j].head);
 			qid->iq[j].head = NULL;
 		}
 	}
@@ -507,34 +614,63 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
+	char buf[RTE_RING_NAMESIZE];
 	int num_chunks, i;
+	uint32_t s;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
 	sw->nb_events_limit = conf->nb_events_limit;
 	rte_atomic32_set(&sw->inflights, 0);
 
-	/* Number of chunks sized for worst-case spread of events across IQs */
-	num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
-			sw->qid_count*SW_IQS_MAX*2;
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+		uint32_t shard_qids = (sw->qid_count + sw->nb_shards - 1 - s) /
+				sw->nb_shards;
 
-	/* If this is a reconfiguration, free the previous IQ allocation. All
-	 * IQ chunk references were cleaned out of the QIDs in sw_stop(), and
-	 * will be reinitialized in sw_start().
-	 */
-	rte_free(sw->chunks);
+		/* Number of chunks sized for worst-case spread of events
+		 * across the IQs of the shard
+		 */
+		num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
+				shard_qids*SW_IQS_MAX*2;
 
-	sw->chunks = rte_malloc_socket(NULL,
-				       sizeof(struct sw_queue_chunk) *
-				       num_chunks,
-				       0,
-				       sw->data->socket_id);
-	if (!sw->chunks)
-		return -ENOMEM;
+		/* If this is a reconfiguration, free the previous IQ
+		 * allocation. All IQ chunk references were cleaned out of the
+		 * QIDs in sw_stop(), and will be reinitialized in sw_start().
+		 */
+		rte_free(sh->chunks);
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
+		sh->chunks = rte_malloc_socket(NULL,
+					       sizeof(struct sw_queue_chunk) *
+					       num_chunks,
+					       0,
+					       sw->data->socket_id);
+		if (!sh->chunks)
+			return -ENOMEM;
+
+		sh->chunk_list_head = NULL;
+		for (i = 0; i < num_chunks; i++)
+			iq_free_chunk(sh, &sh->chunks[i]);
+
+		if (sw->nb_shards == 1)
+			continue;
+
+		/* Reordered events move between shards through a ring sized
+		 * for all the events the device may hold.
+		 */
+		snprintf(buf, sizeof(buf), "sw%d_s%u_xfer_ring",
+				data->dev_id, s);
+		rte_event_ring_free(rte_event_ring_lookup(buf));
+
+		sh->xfer_ring = rte_event_ring_create(buf,
+				SW_INFLIGHT_EVENTS_TOTAL, data->socket_id,
+				RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (sh->xfer_ring == NULL) {
+			SW_LOG_ERR("Error creating transfer ring for shard %d",
+					s);
+			return -ENOMEM;
+		}
+	}
 
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
@@ -627,12 +763,23 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	fprintf(f, "EventDev %s: ports %d, qids %d\n",
 		dev->data->name, sw->port_count, sw->qid_count);
 
-	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+	for (i = 0; i < sw->nb_shards; i++) {
+		const struct sw_shard *sh = &sw->shards[i];
+
+		if (sw->nb_shards > 1)
+			fprintf(f, "  Scheduler shard %d (qids %d)\n", i,
+				sh->qid_count);
+		fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
+			sh->stats.rx_pkts, sh->stats.rx_dropped,
+			sh->stats.tx_pkts);
+		fprintf(f, "\tsched calls: %"PRIu64"\n", sh->sched_called);
+		fprintf(f, "\tsched cq/qid call: %"PRIu64"\n",
+			sh->sched_cq_qid_called);
+		fprintf(f, "\tsched no IQ enq: %"PRIu64"\n",
+			sh->sched_no_iq_enqueues);
+		fprintf(f, "\tsched no CQ enq: %"PRIu64"\n",
+			sh->sched_no_cq_enqueues);
+	}
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
@@ -765,16 +912,20 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 static int
 sw_start(struct rte_eventdev *dev)
 {
-	unsigned int i, j;
+	unsigned int i, j, s;
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 
-	rte_service_component_runstate_set(sw->service_id, 1);
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		rte_service_component_runstate_set(sh->service_id, 1);
 
-	/* check a service core is mapped to this service */
-	if (!rte_service_runstate_get(sw->service_id)) {
-		SW_LOG_ERR("Warning: No Service core enabled on service %s",
-				sw->service_name);
-		return -ENOENT;
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(sh->service_id)) {
+			SW_LOG_ERR("Warning: No Service core enabled on service %s",
+					sh->service_name);
+			return -ENOENT;
+		}
 	}
 
 	/* check all ports are set up */
@@ -798,12 +949,17 @@ sw_start(struct rte_eventdev *dev)
 	 * "If two members compare as equal, their order in the sorted
 	 * array is undefined."
 	 */
-	uint32_t qidx = 0;
+	for (s = 0; s < sw->nb_shards; s++)
+		sw->shards[s].qid_count = 0;
 	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
 		for (i = 0; i < sw->qid_count; i++) {
 			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
+				struct sw_shard *sh =
+					&sw->shards[sw->qids[i].shard];
+
+				sh->qids_prioritized[sh->qid_count] =
+					&sw->qids[i];
+				sh->qid_count++;
 			}
 		}
 	}
@@ -823,15 +979,21 @@ static void
 sw_stop(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int32_t runstate;
+	int32_t runstate[SW_SCHED_SHARDS_MAX];
+	uint32_t s;
 
-	/* Stop the scheduler if it's running */
-	runstate = rte_service_runstate_get(sw->service_id);
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 0);
+	/* Stop the schedulers if they are running */
+	for (s = 0; s < sw->nb_shards; s++) {
+		uint32_t service_id = sw->shards[s].service_id;
+
+		runstate[s] = rte_service_runstate_get(service_id);
+		if (runstate[s] == 1)
+			rte_service_runstate_set(service_id, 0);
+	}
 
-	while (rte_service_may_be_active(sw->service_id))
-		rte_pause();
+	for (s = 0; s < sw->nb_shards; s++)
+		while (rte_service_may_be_active(sw->shards[s].service_id))
+			rte_pause();
 
 	/* Flush all events out of the device */
 	while (!(sw_qids_empty(sw) && sw_ports_empty(sw))) {
@@ -845,8 +1007,92 @@ sw_stop(struct rte_eventdev *dev)
 	sw->started = 0;
 	rte_smp_wmb();
 
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 1);
+	for (s = 0; s < sw->nb_shards; s++)
+		if (runstate[s] == 1)
+			rte_service_runstate_set(sw->shards[s].service_id, 1);
+}
+
+static int32_t sw_sched_service_func(void *args)
+{
+	struct sw_shard *sh = args;
+	return sw_shard_schedule(sh);
+}
+
+static void
+sw_shard_service_unregister(struct sw_shard *sh)
+{
+	uint32_t service_id;
+
+	/* the service may already be gone, or its id reused */
+	if (rte_service_get_by_name(sh->service_name, &service_id) == 0 &&
+			service_id == sh->service_id)
+		rte_service_component_unregister(sh->service_id);
+}
+
+static void
+sw_shards_free(struct sw_evdev *sw)
+{
+	uint32_t s;
+
+	for (s = 0; s < SW_SCHED_SHARDS_MAX; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		if (s > 0 && s < sw->nb_shards)
+			sw_shard_service_unregister(sh);
+		if (s > 0)
+			rte_free(sh->ports);
+		sh->ports = NULL;
+		rte_free(sh->chunks);
+		sh->chunks = NULL;
+	}
+}
+
+static int
+sw_shards_init(struct sw_evdev *sw, const char *name, int socket_id)
+{
+	uint32_t s;
+
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+		struct rte_service_spec service;
+
+		sh->sw = sw;
+		sh->id = s;
+		if (s == 0)
+			sh->ports = sw->ports;
+		else
+			sh->ports = rte_zmalloc_socket(NULL,
+					sizeof(struct sw_port) * SW_PORTS_MAX,
+					RTE_CACHE_LINE_SIZE, socket_id);
+		if (sh->ports == NULL) {
+			SW_LOG_ERR("shard %u ports alloc failed", s);
+			return -ENOMEM;
+		}
+
+		/* register service with EAL, the first shard keeps the
+		 * service name of an unsharded device
+		 */
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		if (s == 0)
+			snprintf(sh->service_name, sizeof(sh->service_name),
+					"%s_service", name);
+		else
+			snprintf(sh->service_name, sizeof(sh->service_name),
+					"%s_service_%u", name, s);
+		strlcpy(service.name, sh->service_name, sizeof(service.name));
+		service.socket_id = socket_id;
+		service.callback = sw_sched_service_func;
+		service.callback_userdata = (void *)sh;
+
+		int32_t ret = rte_service_component_register(&service,
+				&sh->service_id);
+		if (ret) {
+			SW_LOG_ERR("service register() failed");
+			return -ENOEXEC;
+		}
+	}
+
+	return 0;
 }
 
 static int
@@ -863,11 +1109,21 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		rte_event_ring_free(sh->xfer_ring);
+		sh->xfer_ring = NULL;
+
+		memset(&sh->stats, 0, sizeof(sh->stats));
+		sh->sched_called = 0;
+		sh->sched_no_iq_enqueues = 0;
+		sh->sched_no_cq_enqueues = 0;
+		sh->sched_cq_qid_called = 0;
+	}
+
+	/* the device cannot be restarted once closed */
+	sw_shards_free(sw);
 
 	return 0;
 }
@@ -932,10 +1188,14 @@ set_refill_once(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
-static int32_t sw_sched_service_func(void *args)
+static int
+set_sched_shards(const char *key __rte_unused, const char *value, void *opaque)
 {
-	struct rte_eventdev *dev = args;
-	return sw_event_schedule(dev);
+	int *sched_shards = opaque;
+	*sched_shards = atoi(value);
+	if (*sched_shards < 1 || *sched_shards > SW_SCHED_SHARDS_MAX)
+		return -1;
+	return 0;
 }
 
 static int
@@ -980,6 +1240,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		MIN_BURST_SIZE_ARG,
 		DEQ_BURST_SIZE_ARG,
 		REFIL_ONCE_ARG,
+		SCHED_SHARDS_ARG,
 		NULL
 	};
 	const char *name;
@@ -992,6 +1253,7 @@ sw_probe(struct rte_vdev_device *vdev)
 	int min_burst_size = 1;
 	int deq_burst_size = SCHED_DEQUEUE_DEFAULT_BURST_SIZE;
 	int refill_once = 0;
+	int sched_shards = 1;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1063,6 +1325,16 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_SHARDS_ARG,
+					set_sched_shards, &sched_shards);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing scheduler shards parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
@@ -1070,9 +1342,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	SW_LOG_INFO(
 			"Creating eventdev sw device %s, numa_node=%d, "
 			"sched_quanta=%d, credit_quanta=%d "
-			"min_burst=%d, deq_burst=%d, refill_once=%d",
+			"min_burst=%d, deq_burst=%d, refill_once=%d, "
+			"sched_shards=%d",
 			name, socket_id, sched_quanta, credit_quanta,
-			min_burst_size, deq_burst_size, refill_once);
+			min_burst_size, deq_burst_size, refill_once,
+			sched_shards);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id, vdev);
@@ -1081,10 +1355,17 @@ sw_probe(struct rte_vdev_device *vdev)
 		return -EFAULT;
 	}
 	dev->dev_ops = &evdev_sw_ops;
-	dev->enqueue_burst = sw_event_enqueue_burst;
-	dev->enqueue_new_burst = sw_event_enqueue_burst;
-	dev->enqueue_forward_burst = sw_event_enqueue_burst;
-	dev->dequeue_burst = sw_event_dequeue_burst;
+	if (sched_shards > 1) {
+		dev->enqueue_burst = sw_event_enqueue_burst_sharded;
+		dev->enqueue_new_burst = sw_event_enqueue_burst_sharded;
+		dev->enqueue_forward_burst = sw_event_enqueue_burst_sharded;
+		dev->dequeue_burst = sw_event_dequeue_burst_sharded;
+	} else {
+		dev->enqueue_burst = sw_event_enqueue_burst;
+		dev->enqueue_new_burst = sw_event_enqueue_burst;
+		dev->enqueue_forward_burst = sw_event_enqueue_burst;
+		dev->dequeue_burst = sw_event_dequeue_burst;
+	}
 
 	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
 		return 0;
@@ -1098,25 +1379,17 @@ sw_probe(struct rte_vdev_device *vdev)
 	sw->sched_min_burst_size = min_burst_size;
 	sw->sched_deq_burst_size = deq_burst_size;
 	sw->refill_once_per_iter = refill_once;
+	sw->nb_shards = sched_shards;
 
-	/* register service with EAL */
-	struct rte_service_spec service;
-	memset(&service, 0, sizeof(struct rte_service_spec));
-	snprintf(service.name, sizeof(service.name), "%s_service", name);
-	snprintf(sw->service_name, sizeof(sw->service_name), "%s_service",
-			name);
-	service.socket_id = socket_id;
-	service.callback = sw_sched_service_func;
-	service.callback_userdata = (void *)dev;
-
-	int32_t ret = rte_service_component_register(&service, &sw->service_id);
+	int ret = sw_shards_init(sw, name, socket_id);
 	if (ret) {
-		SW_LOG_ERR("service register() failed");
-		return -ENOEXEC;
+		sw_shard_service_unregister(&sw->shards[0]);
+		sw_shards_free(sw);
+		return ret;
 	}
 
 	dev->data->service_inited = 1;
-	dev->data->service_id = sw->service_id;
+	dev->data->service_id = sw->shards[0].service_id;
 
 	event_dev_probing_finish(dev);
 
@@ -1126,7 +1399,11 @@ sw_probe(struct rte_vdev_device *vdev)
 static int
 sw_remove(struct rte_vdev_device *vdev)
 {
+	struct rte_eventdev *dev;
+	struct sw_evdev *sw;
 	const char *name;
+	uint32_t s;
+	int ret;
 
 	name = rte_vdev_device_name(vdev);
 	if (name == NULL)
@@ -1134,7 +1411,24 @@ sw_remove(struct rte_vdev_device *vdev)
 
 	SW_LOG_INFO("Closing eventdev sw device %s", name);
 
-	return rte_event_pmd_vdev_uninit(name);
+	dev = rte_event_pmd_get_named_dev(name);
+	if (dev == NULL)
+		return -ENODEV;
+
+	ret = rte_event_dev_close(dev->data->dev_id);
+	if (ret < 0)
+		return ret;
+
+	/* the services of all the shards go away with the device, the
+	 * first one included
+	 */
+	if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
+		sw = sw_pmd_priv(dev);
+		for (s = 0; s < sw->nb_shards; s++)
+			sw_shard_service_unregister(&sw->shards[s]);
+	}
+
+	return rte_event_pmd_release(dev);
 }
 
 static struct rte_vdev_driver evdev_sw_pmd_drv = {
@@ -1146,5 +1440,5 @@ RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
 		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>"
 		MIN_BURST_SIZE_ARG "=<int>" DEQ_BURST_SIZE_ARG "=<int>"
-		REFIL_ONCE_ARG "=<int>");
+		REFIL_ONCE_ARG "=<int>" SCHED_SHARDS_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(eventdev_sw_log_level, NOTICE);
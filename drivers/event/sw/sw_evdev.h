@@ -36,6 +36,9 @@
 /* Flush the pipeline after this many no enq to cq */
 #define SCHED_NO_ENQ_CYCLE_FLUSH 256
 
+/* max number of scheduler shards, each run by its own service */
+#define SW_SCHED_SHARDS_MAX 4
+
 
 #define SW_PORT_HIST_LIST (MAX_SW_PROD_Q_DEPTH) /* size of our history list */
 #define NUM_SAMPLES 64 /* how many data points use for average stats */
@@ -133,6 +136,9 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+
+	/* The scheduler shard this QID is scheduled by */
+	uint8_t shard;
 };
 
 struct sw_hist_list_entry {
@@ -207,6 +213,60 @@ struct sw_port {
 	struct rte_event cq_buf[MAX_SW_CONS_Q_DEPTH];
 
 	uint8_t num_qids_mapped;
+
+	/* With a sharded scheduler, the worker records the shard of each
+	 * dequeued event, to return its completion to the shard that
+	 * scheduled it. Outstanding events never exceed the
+	 * device inflight limit, which is no more than SW_PORT_HIST_LIST.
+	 */
+	uint16_t deq_shard_head;
+	uint16_t deq_shard_tail;
+	uint8_t deq_next_shard;
+	uint8_t deq_shard[SW_PORT_HIST_LIST];
+};
+
+/* A scheduler shard. Each shard schedules a subset of the QIDs, and
+ * has its own set of rx/cq rings and history lists to every port. Shard
+ * 0 uses the ports of the device, which the workers enqueue and dequeue
+ * through.
+ */
+struct sw_shard {
+	struct sw_evdev *sw;
+	uint8_t id;
+
+	/* Ports of this shard, indexed by port id */
+	struct sw_port *ports;
+	/* Reordered events for this shard's QIDs from other shards */
+	struct rte_event_ring *xfer_ring;
+
+	/* IQ chunk pool of the QIDs of this shard */
+	struct sw_queue_chunk *chunk_list_head;
+	struct sw_queue_chunk *chunks;
+
+	/* Number of QIDs of this shard, and those QIDs sorted by
+	 * priority level
+	 */
+	uint32_t qid_count;
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+
+	/* Cache how many packets are in each cq */
+	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
+
+	/* Current values */
+	uint32_t sched_flush_count;
+	uint32_t sched_min_burst;
+
+	/* Stats */
+	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
+	uint64_t sched_called;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+	uint64_t sched_last_iter_bitmask;
+	uint8_t sched_progress_last_iter;
+
+	uint32_t service_id;
+	char service_name[SW_PMD_NAME_MAX];
 };
 
 struct sw_evdev {
@@ -226,9 +286,8 @@ struct sw_evdev {
 	uint32_t sched_deq_burst_size;
 	/* Refill pp buffers only once per scheduler call*/
 	uint32_t refill_once_per_iter;
-	/* Current values */
-	uint32_t sched_flush_count;
-	uint32_t sched_min_burst;
+	/* Number of scheduler shards */
+	uint32_t nb_shards;
 
 	/* Contains all ports - load balanced and directed */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_port ports[SW_PORTS_MAX];
@@ -243,24 +302,11 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV];
-	struct sw_queue_chunk *chunk_list_head;
-	struct sw_queue_chunk *chunks;
-
-	/* Cache how many packets are in each cq */
-	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Scheduler shards */
+	struct sw_shard shards[SW_SCHED_SHARDS_MAX];
 
-	/* Stats */
-	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-	uint64_t sched_last_iter_bitmask;
-	uint8_t sched_progress_last_iter;
 
 	uint8_t started;
 	uint32_t credit_update_quanta;
@@ -271,9 +317,6 @@ struct sw_evdev {
 	/* store num stats and offset of the stats for each queue */
 	uint16_t xstats_count_per_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
 	uint16_t xstats_offset_for_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
-
-	uint32_t service_id;
-	char service_name[SW_PMD_NAME_MAX];
 };
 
 static inline struct sw_evdev *
@@ -293,6 +336,11 @@ uint16_t sw_event_enqueue_burst(void *port, const struct rte_event ev[],
 
 uint16_t sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 			uint64_t wait);
+uint16_t sw_event_enqueue_burst_sharded(void *port, const struct rte_event ev[],
+		uint16_t num);
+uint16_t sw_event_dequeue_burst_sharded(void *port, struct rte_event *ev,
+		uint16_t num, uint64_t wait);
+int32_t sw_shard_schedule(struct sw_shard *sh);
 int32_t sw_event_schedule(struct rte_eventdev *dev);
 int sw_xstats_init(struct sw_evdev *dev);
 int sw_xstats_uninit(struct sw_evdev *dev);
@@ -21,6 +21,7 @@
 #include <rte_cycles.h>
 #include <rte_eventdev.h>
 #include <rte_pause.h>
+#include <rte_random.h>
 #include <rte_service.h>
 #include <rte_service_component.h>
 #include <bus_vdev_driver.h>
@@ -3303,6 +3304,396 @@ worker_loopback(struct test *t, uint8_t disable_implicit_release)
 	return 0;
 }
 
+#define SHARDED_NB_SHARDS 2
+#define SHARDED_NB_PKTS 48
+
+static uint32_t shard_service_id[SHARDED_NB_SHARDS];
+
+static void
+run_shards(void)
+{
+	unsigned int s;
+
+	for (s = 0; s < RTE_DIM(shard_service_id); s++)
+		rte_service_run_iter_on_app_lcore(shard_service_id[s], 1);
+}
+
+static int
+sharded_ordered(struct test *t)
+{
+	const uint8_t rx_port = 0;
+	const uint8_t w1_port = 1;
+	const uint8_t w3_port = 3;
+	const uint8_t tx_port = 4;
+	struct rte_event ev[SHARDED_NB_PKTS];
+	uint8_t ev_port[SHARDED_NB_PKTS];
+	struct test_event_dev_stats stats;
+	uint32_t i, n, iter;
+	int err, p;
+
+	/*
+	 * The ordered qid0 is scheduled by shard 0 and the directed qid1 by
+	 * shard 1, so every reordered event goes through the transfer ring
+	 * of shard 1.
+	 *
+	 * rx_port - qid0 - w[1-3]_port - qid1 - tx_port
+	 */
+	if (init(t, 2, tx_port + 1) < 0 ||
+			create_ports(t, tx_port + 1) < 0 ||
+			create_ordered_qids(t, 1) < 0 ||
+			create_directed_qids(t, 1, &tx_port)) {
+		printf("%d: Error initializing device\n", __LINE__);
+		return -1;
+	}
+
+	for (p = w1_port; p <= w3_port; p++) {
+		err = rte_event_port_link(evdev, t->port[p], &t->qid[0], NULL,
+				1);
+		if (err != 1) {
+			printf("%d: error mapping lb qid\n", __LINE__);
+			cleanup(t);
+			return -1;
+		}
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		return -1;
+	}
+
+	for (i = 0; i < SHARDED_NB_PKTS; i++) {
+		struct rte_event new_ev = {
+			.op = RTE_EVENT_OP_NEW,
+			.queue_id = t->qid[0],
+			.flow_id = i,
+			.u64 = i,
+		};
+
+		err = rte_event_enqueue_burst(evdev, t->port[rx_port],
+				&new_ev, 1);
+		if (err != 1) {
+			printf("%d: Failed to enqueue event %u\n", __LINE__, i);
+			goto err;
+		}
+	}
+
+	/* spread the events over the workers */
+	for (n = 0, iter = 0; n < SHARDED_NB_PKTS && iter < 100; iter++) {
+		run_shards();
+		for (p = w1_port; p <= w3_port; p++) {
+			uint16_t deq = rte_event_dequeue_burst(evdev,
+					t->port[p], &ev[n],
+					SHARDED_NB_PKTS - n, 0);
+
+			memset(&ev_port[n], p, deq);
+			n += deq;
+		}
+	}
+	if (n != SHARDED_NB_PKTS) {
+		printf("%d: Got %u events at the workers, expected %u\n",
+				__LINE__, n, SHARDED_NB_PKTS);
+		goto err;
+	}
+
+	/* forward them in reverse order, to the queue of the other shard */
+	for (i = SHARDED_NB_PKTS; i-- > 0; ) {
+		ev[i].op = RTE_EVENT_OP_FORWARD;
+		ev[i].queue_id = t->qid[1];
+		err = rte_event_enqueue_burst(evdev, t->port[ev_port[i]],
+				&ev[i], 1);
+		if (err != 1) {
+			printf("%d: Failed to forward event %u\n", __LINE__, i);
+			goto err;
+		}
+	}
+
+	for (n = 0, iter = 0; n < SHARDED_NB_PKTS && iter < 100; iter++) {
+		run_shards();
+		n += rte_event_dequeue_burst(evdev, t->port[tx_port], &ev[n],
+				SHARDED_NB_PKTS - n, 0);
+	}
+	if (n != SHARDED_NB_PKTS) {
+		printf("%d: Got %u events at tx port, expected %u\n",
+				__LINE__, n, SHARDED_NB_PKTS);
+		goto err;
+	}
+
+	/* the shard 1 scheduled them in the original order */
+	for (i = 0; i < SHARDED_NB_PKTS; i++) {
+		if (ev[i].u64 != i) {
+			printf("%d: Event %u out of order, got %"PRIu64"\n",
+					__LINE__, i, ev[i].u64);
+			goto err;
+		}
+	}
+
+	/* no event was lost crossing shards and the worker credits are back */
+	test_event_dev_stats_get(evdev, &stats);
+	if (stats.rx_dropped != 0) {
+		printf("%d: %"PRIu64" events dropped\n", __LINE__,
+				stats.rx_dropped);
+		goto err;
+	}
+	for (p = w1_port; p <= w3_port; p++) {
+		if (stats.port_inflight[p] != 0) {
+			printf("%d: port %d still has %"PRIu64" inflights\n",
+					__LINE__, p, stats.port_inflight[p]);
+			goto err;
+		}
+	}
+
+	cleanup(t);
+	return 0;
+err:
+	rte_event_dev_dump(evdev, stdout);
+	cleanup(t);
+	return -1;
+}
+
+#define SHARDED_MT_MAX_WORKERS 3
+#define SHARDED_MT_NB_FLOWS 4
+#define SHARDED_MT_NB_PKTS (1 << 16)
+
+struct sharded_mt_worker {
+	uint8_t port;
+	uint8_t qid;
+};
+
+static RTE_ATOMIC(uint32_t) sharded_mt_done;
+
+static int
+sharded_atomic_worker_fn(void *arg)
+{
+	const struct sharded_mt_worker *w = arg;
+	struct rte_event ev[8];
+	uint16_t i, n, sent, spin;
+
+	while (!rte_atomic_load_explicit(&sharded_mt_done,
+			rte_memory_order_acquire)) {
+		n = rte_event_dequeue_burst(evdev, w->port, ev, RTE_DIM(ev), 0);
+		if (n == 0)
+			continue;
+
+		for (i = 0; i < n; i++) {
+			ev[i].op = RTE_EVENT_OP_FORWARD;
+			ev[i].queue_id = w->qid;
+		}
+
+		/* uneven processing time, so flows move between workers */
+		for (spin = rte_rand() & 63; spin > 0; spin--)
+			rte_pause();
+
+		for (sent = 0; sent < n && !rte_atomic_load_explicit(
+				&sharded_mt_done, rte_memory_order_acquire); )
+			sent += rte_event_enqueue_burst(evdev, w->port,
+					&ev[sent], n - sent);
+	}
+
+	return 0;
+}
+
+static int
+sharded_atomic_mt(struct test *t)
+{
+	static struct sharded_mt_worker workers[SHARDED_MT_MAX_WORKERS];
+	uint32_t expected[SHARDED_MT_NB_FLOWS] = {0};
+	struct test_event_dev_stats stats;
+	struct rte_event ev[32];
+	uint32_t produced = 0, received = 0;
+	uint32_t nb_workers, i, lcore;
+	uint8_t rx_port, tx_port;
+	uint64_t deadline;
+	uint16_t n;
+	int err;
+
+	/*
+	 * The atomic qid0 is scheduled by shard 0 and the atomic qid1 by
+	 * shard 1. Workers on their own lcores forward every event from
+	 * qid0 to qid1, and flows move between them, so a flow can only
+	 * keep its order across the shards if it stays pinned to its worker
+	 * until the forwarded event reached shard 1.
+	 *
+	 * rx_port - qid0 - w[0-n]_port - qid1 - tx_port
+	 */
+	nb_workers = RTE_MIN(rte_lcore_count() - 1,
+			(unsigned int)SHARDED_MT_MAX_WORKERS);
+	rx_port = 0;
+	tx_port = nb_workers + 1;
+
+	if (init(t, 2, tx_port + 1) < 0 ||
+			create_ports(t, tx_port + 1) < 0 ||
+			create_atomic_qids(t, 2) < 0) {
+		printf("%d: Error initializing device\n", __LINE__);
+		return -1;
+	}
+
+	for (i = 0; i < nb_workers; i++) {
+		workers[i].port = t->port[i + 1];
+		workers[i].qid = t->qid[1];
+		err = rte_event_port_link(evdev, workers[i].port, &t->qid[0],
+				NULL, 1);
+		if (err != 1) {
+			printf("%d: error mapping lb qid\n", __LINE__);
+			cleanup(t);
+			return -1;
+		}
+	}
+	err = rte_event_port_link(evdev, t->port[tx_port], &t->qid[1], NULL,
+			1);
+	if (err != 1) {
+		printf("%d: error mapping lb qid\n", __LINE__);
+		cleanup(t);
+		return -1;
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		return -1;
+	}
+
+	rte_atomic_store_explicit(&sharded_mt_done, 0,
+			rte_memory_order_relaxed);
+	i = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore) {
+		if (i == nb_workers)
+			break;
+		rte_eal_remote_launch(sharded_atomic_worker_fn, &workers[i++],
+				lcore);
+	}
+
+	deadline = rte_get_timer_cycles() + 10 * rte_get_timer_hz();
+	while (received < SHARDED_MT_NB_PKTS) {
+		if (rte_get_timer_cycles() > deadline) {
+			printf("%d: Got %u events at tx port, expected %u\n",
+					__LINE__, received, SHARDED_MT_NB_PKTS);
+			goto err;
+		}
+
+		for (n = 0; n < RTE_DIM(ev) &&
+				produced + n < SHARDED_MT_NB_PKTS; n++) {
+			ev[n] = (struct rte_event) {
+				.op = RTE_EVENT_OP_NEW,
+				.queue_id = t->qid[0],
+				.sched_type = RTE_SCHED_TYPE_ATOMIC,
+				.flow_id = (produced + n) % SHARDED_MT_NB_FLOWS,
+				.u64 = (produced + n) / SHARDED_MT_NB_FLOWS,
+			};
+		}
+		if (n > 0)
+			produced += rte_event_enqueue_burst(evdev,
+					t->port[rx_port], ev, n);
+
+		run_shards();
+
+		n = rte_event_dequeue_burst(evdev, t->port[tx_port], ev,
+				RTE_DIM(ev), 0);
+		for (i = 0; i < n; i++) {
+			uint32_t flow = ev[i].flow_id;
+
+			if (flow >= SHARDED_MT_NB_FLOWS ||
+					ev[i].u64 != expected[flow]) {
+				printf("%d: Flow %u got event %"PRIu64
+						", expected %u\n", __LINE__,
+						flow, ev[i].u64,
+						flow < SHARDED_MT_NB_FLOWS ?
+						expected[flow] : 0);
+				goto err;
+			}
+			expected[flow]++;
+		}
+		received += n;
+	}
+
+	rte_atomic_store_explicit(&sharded_mt_done, 1,
+			rte_memory_order_release);
+	rte_eal_mp_wait_lcore();
+
+	test_event_dev_stats_get(evdev, &stats);
+	if (stats.rx_dropped != 0) {
+		printf("%d: %"PRIu64" events dropped\n", __LINE__,
+				stats.rx_dropped);
+		goto err_stopped;
+	}
+
+	cleanup(t);
+	return 0;
+err:
+	rte_atomic_store_explicit(&sharded_mt_done, 1,
+			rte_memory_order_release);
+	rte_eal_mp_wait_lcore();
+err_stopped:
+	rte_event_dev_dump(evdev, stdout);
+	cleanup(t);
+	return -1;
+}
+
+/* Run the tests needing more than one scheduler shard on a dedicated
+ * instance, the shared one keeps the default single shard.
+ */
+static int
+sharded_tests(struct test *t)
+{
+	static const char sharded_name[] = "event_sw_sharded";
+	char service_name[RTE_SERVICE_NAME_MAX] = "";
+	int evdev_single = evdev;
+	unsigned int s;
+	int ret = -1;
+
+	if (rte_vdev_init(sharded_name, "sched_shards="
+			RTE_STR(SHARDED_NB_SHARDS)) < 0) {
+		printf("Error creating sharded eventdev\n");
+		return -1;
+	}
+
+	evdev = rte_event_dev_get_dev_id(sharded_name);
+	if (evdev < 0) {
+		printf("Error finding sharded eventdev\n");
+		goto out;
+	}
+
+	for (s = 0; s < SHARDED_NB_SHARDS; s++) {
+		if (s == 0)
+			snprintf(service_name, sizeof(service_name),
+					"%s_service", sharded_name);
+		else
+			snprintf(service_name, sizeof(service_name),
+					"%s_service_%u", sharded_name, s);
+		if (rte_service_get_by_name(service_name,
+				&shard_service_id[s]) != 0) {
+			printf("Failed to get service %s\n", service_name);
+			goto out;
+		}
+		rte_service_runstate_set(shard_service_id[s], 1);
+		rte_service_set_runstate_mapped_check(shard_service_id[s], 0);
+	}
+
+	printf("*** Running Sharded Ordered test...\n");
+	ret = sharded_ordered(t);
+	if (ret != 0) {
+		printf("ERROR - Sharded Ordered test FAILED.\n");
+		goto out;
+	}
+
+	if (rte_lcore_count() >= 3) {
+		printf("*** Running Sharded Atomic multi-lcore test...\n");
+		ret = sharded_atomic_mt(t);
+		if (ret != 0)
+			printf("ERROR - Sharded Atomic multi-lcore test FAILED.\n");
+	} else
+		printf("### Not enough cores for sharded atomic multi-lcore test.\n");
+
+out:
+	evdev = evdev_single;
+	/* the services of the shards must be gone with the device */
+	if (rte_vdev_uninit(sharded_name) < 0 ||
+			rte_service_get_by_name(service_name,
+				&shard_service_id[0]) == 0) {
+		printf("%d: Error removing sharded eventdev\n", __LINE__);
+		ret = -1;
+	}
+	return ret;
+}
+
 static struct rte_mempool *eventdev_func_mempool;
 
 int
@@ -3539,6 +3930,9 @@ test_sw_eventdev(void)
 		printf("### Not enough cores for worker loopback tests.\n");
 		printf("### Need at least 3 cores for the tests.\n");
 	}
+	ret = sharded_tests(t);
+	if (ret != 0)
+		goto test_fail;
 
 	/*
 	 * Free test instance, leaving mempool initialized, and a pointer to it
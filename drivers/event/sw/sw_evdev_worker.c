@@ -172,3 +172,227 @@ sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 end:
 	return ndeq;
 }
+
+/*
+ * With a sharded scheduler, each port has a pair of rings to every shard.
+ * Events are enqueued to the shard scheduling their destination QID, and
+ * completions are returned to the shard the event was dequeued from.
+ */
+static inline uint8_t
+sw_deq_shard_peek(const struct sw_port *p, uint16_t idx)
+{
+	return p->deq_shard[idx & (SW_PORT_HIST_LIST - 1)];
+}
+
+static inline void
+sw_event_release_sharded(struct sw_port *p)
+{
+	struct sw_evdev *sw = p->sw;
+	uint8_t shard;
+	struct sw_port *sp;
+
+	shard = sw_deq_shard_peek(p, p->deq_shard_tail++);
+	sp = &sw->shards[shard].ports[p->id];
+
+	/* create drop message */
+	struct rte_event ev;
+	ev.op = sw_qe_flag_map[RTE_EVENT_OP_RELEASE];
+
+	uint16_t free_count;
+	rte_event_ring_enqueue_burst(sp->rx_worker_ring, &ev, 1, &free_count);
+
+	/* each release returns one credit */
+	p->outstanding_releases--;
+	p->inflight_credits++;
+}
+
+uint16_t
+sw_event_enqueue_burst_sharded(void *port, const struct rte_event ev[],
+		uint16_t num)
+{
+	int32_t i;
+	struct sw_port *p = port;
+	struct sw_evdev *sw = (void *)p->sw;
+	const uint32_t nb_shards = sw->nb_shards;
+	struct rte_event shard_evs[SW_SCHED_SHARDS_MAX]
+			[PORT_ENQUEUE_MAX_BURST_SIZE];
+	uint16_t shard_count[SW_SCHED_SHARDS_MAX] = {0};
+	unsigned int shard_free[SW_SCHED_SHARDS_MAX];
+	uint32_t sw_inflights = rte_atomic32_read(&sw->inflights);
+	uint32_t credit_update_quanta = sw->credit_update_quanta;
+	uint32_t s;
+	int new = 0;
+
+	if (num > PORT_ENQUEUE_MAX_BURST_SIZE)
+		num = PORT_ENQUEUE_MAX_BURST_SIZE;
+
+	for (i = 0; i < num; i++)
+		new += (ev[i].op == RTE_EVENT_OP_NEW);
+
+	if (unlikely(new > 0 && p->inflight_max < sw_inflights))
+		return 0;
+
+	if (p->inflight_credits < new) {
+		/* check if event enqueue brings port over max threshold */
+		if (sw_inflights + credit_update_quanta > sw->nb_events_limit)
+			return 0;
+
+		rte_atomic32_add(&sw->inflights, credit_update_quanta);
+		p->inflight_credits += (credit_update_quanta);
+
+		/* If there are fewer inflight credits than new events, limit
+		 * the number of enqueued events.
+		 */
+		num = (p->inflight_credits < new) ? p->inflight_credits : new;
+	}
+
+	/* this port is the only producer to its shard rings, so the free
+	 * space can only grow until the events are enqueued below
+	 */
+	for (s = 0; s < nb_shards; s++)
+		shard_free[s] = rte_event_ring_free_count(
+				sw->shards[s].ports[p->id].rx_worker_ring);
+
+	for (i = 0; i < num; i++) {
+		int op = ev[i].op;
+		int outstanding = p->outstanding_releases > 0;
+		const uint8_t invalid_qid = (ev[i].queue_id >= sw->qid_count);
+		uint8_t flags = sw_qe_flag_map[op];
+		uint8_t dest_shard = 0;
+		int complete, valid;
+
+		flags &= ~(invalid_qid << QE_FLAG_VALID_SHIFT);
+		complete = (flags & QE_FLAG_COMPLETE) && outstanding;
+		valid = flags & QE_FLAG_VALID;
+
+		/* Completions go back to the shard the event came from, even
+		 * when forwarded to a queue of another shard. That shard
+		 * releases the flow and hands the event over in one step, so
+		 * the next event of an atomic flow cannot overtake it, and
+		 * ordered events are reordered first.
+		 */
+		if (complete)
+			dest_shard = sw_deq_shard_peek(p, p->deq_shard_tail);
+		else if (valid)
+			dest_shard = sw->qids[ev[i].queue_id].shard;
+
+		if ((complete || valid) &&
+				shard_count[dest_shard] >= shard_free[dest_shard])
+			break;
+
+		p->inflight_credits -= (op == RTE_EVENT_OP_NEW);
+		p->inflight_credits += (op == RTE_EVENT_OP_RELEASE) *
+					outstanding;
+
+		if (complete) {
+			p->outstanding_releases--;
+			p->deq_shard_tail++;
+		}
+
+		/* error case: branch to avoid touching p->stats */
+		if (unlikely(invalid_qid && op != RTE_EVENT_OP_RELEASE)) {
+			p->stats.rx_dropped++;
+			p->inflight_credits++;
+		}
+
+		if (!complete && !valid) {
+			/* nothing for the scheduler to do */
+			continue;
+		} else if (!complete) {
+			flags &= ~QE_FLAG_COMPLETE;
+		}
+
+		struct rte_event *out =
+			&shard_evs[dest_shard][shard_count[dest_shard]++];
+		*out = ev[i];
+		out->op = flags;
+	}
+
+	for (s = 0; s < nb_shards; s++)
+		if (shard_count[s] > 0)
+			rte_event_ring_enqueue_burst(
+				sw->shards[s].ports[p->id].rx_worker_ring,
+				shard_evs[s], shard_count[s], NULL);
+
+	if (p->outstanding_releases == 0 && p->last_dequeue_burst_sz != 0) {
+		uint64_t burst_ticks = rte_get_timer_cycles() -
+				p->last_dequeue_ticks;
+		uint64_t burst_pkt_ticks =
+			burst_ticks / p->last_dequeue_burst_sz;
+		p->avg_pkt_ticks -= p->avg_pkt_ticks / NUM_SAMPLES;
+		p->avg_pkt_ticks += burst_pkt_ticks / NUM_SAMPLES;
+		p->last_dequeue_ticks = 0;
+	}
+
+	/* Replenish credits if enough releases are performed */
+	if (p->inflight_credits >= credit_update_quanta * 2) {
+		rte_atomic32_sub(&sw->inflights, credit_update_quanta);
+		p->inflight_credits -= credit_update_quanta;
+	}
+
+	/* returns number of events actually enqueued */
+	return i;
+}
+
+uint16_t
+sw_event_dequeue_burst_sharded(void *port, struct rte_event *ev, uint16_t num,
+		uint64_t wait)
+{
+	RTE_SET_USED(wait);
+	struct sw_port *p = (void *)port;
+	struct sw_evdev *sw = (void *)p->sw;
+	const uint32_t nb_shards = sw->nb_shards;
+	uint32_t s = p->deq_next_shard;
+	uint16_t ndeq = 0;
+	uint32_t k;
+
+	/* check that all previous dequeues have been released */
+	if (p->implicit_release) {
+		uint32_t credit_update_quanta = sw->credit_update_quanta;
+		uint16_t out_rels = p->outstanding_releases;
+		uint16_t i;
+		for (i = 0; i < out_rels; i++)
+			sw_event_release_sharded(p);
+
+		/* Replenish credits if enough releases are performed */
+		if (p->inflight_credits >= credit_update_quanta * 2) {
+			rte_atomic32_sub(&sw->inflights, credit_update_quanta);
+			p->inflight_credits -= credit_update_quanta;
+		}
+	}
+
+	/* poll the shards round-robin, starting from a different one each
+	 * call to not favour any of them
+	 */
+	for (k = 0; k < nb_shards && ndeq < num; k++) {
+		struct rte_event_ring *ring =
+			sw->shards[s].ports[p->id].cq_worker_ring;
+		uint16_t n, j;
+
+		n = rte_event_ring_dequeue_burst(ring, &ev[ndeq], num - ndeq,
+				NULL);
+		for (j = 0; j < n; j++)
+			p->deq_shard[p->deq_shard_head++ &
+					(SW_PORT_HIST_LIST - 1)] = s;
+		ndeq += n;
+
+		if (++s == nb_shards)
+			s = 0;
+	}
+	p->deq_next_shard = (p->deq_next_shard + 1) % nb_shards;
+
+	if (unlikely(ndeq == 0)) {
+		p->zero_polls++;
+		p->total_polls++;
+		goto end;
+	}
+
+	p->outstanding_releases += ndeq;
+	p->last_dequeue_burst_sz = ndeq;
+	p->last_dequeue_ticks = rte_get_timer_cycles();
+	p->poll_buckets[(ndeq - 1) >> SW_DEQ_STAT_BUCKET_SHIFT]++;
+	p->total_polls++;
+
+end:
+	return ndeq;
+}
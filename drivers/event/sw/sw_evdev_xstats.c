@@ -49,38 +49,55 @@ struct sw_xstats_entry {
 };
 
 static uint64_t
-get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
-		enum xstats_type type, int extra_arg __rte_unused)
+get_shard_stat(const struct sw_shard *sh, enum xstats_type type)
 {
 	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
-	case sched_last_iter_bitmask: return sw->sched_last_iter_bitmask;
-	case sched_progress_last_iter: return sw->sched_progress_last_iter;
+	case rx: return sh->stats.rx_pkts;
+	case tx: return sh->stats.tx_pkts;
+	case dropped: return sh->stats.rx_dropped;
+	case calls: return sh->sched_called;
+	case no_iq_enq: return sh->sched_no_iq_enqueues;
+	case no_cq_enq: return sh->sched_no_cq_enqueues;
+	case sched_last_iter_bitmask: return sh->sched_last_iter_bitmask;
+	case sched_progress_last_iter: return sh->sched_progress_last_iter;
 
 	default: return -1;
 	}
 }
 
 static uint64_t
-get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
+get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
 		enum xstats_type type, int extra_arg __rte_unused)
 {
-	const struct sw_port *p = &sw->ports[obj_idx];
+	uint64_t val = 0;
+	uint32_t s;
 
+	/* counters add up across shards, the last iteration bitmasks of the
+	 * shards are merged
+	 */
+	for (s = 0; s < sw->nb_shards; s++) {
+		uint64_t v = get_shard_stat(&sw->shards[s], type);
+
+		if (v == (uint64_t)-1)
+			return v;
+		if (type == sched_last_iter_bitmask ||
+				type == sched_progress_last_iter)
+			val |= v;
+		else
+			val += v;
+	}
+
+	return val;
+}
+
+static uint64_t
+get_shard_port_stat(const struct sw_port *p, enum xstats_type type)
+{
 	switch (type) {
 	case rx: return p->stats.rx_pkts;
 	case tx: return p->stats.tx_pkts;
 	case dropped: return p->stats.rx_dropped;
 	case inflight: return p->inflights;
-	case pkt_cycles: return p->avg_pkt_ticks;
-	case calls: return p->total_polls;
-	case credits: return p->inflight_credits;
-	case poll_return: return p->zero_polls;
 	case rx_used: return rte_event_ring_count(p->rx_worker_ring);
 	case rx_free: return rte_event_ring_free_count(p->rx_worker_ring);
 	case tx_used: return rte_event_ring_count(p->cq_worker_ring);
@@ -89,6 +106,35 @@ get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 	}
 }
 
+static uint64_t
+get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
+		enum xstats_type type, int extra_arg __rte_unused)
+{
+	const struct sw_port *p = &sw->ports[obj_idx];
+	uint64_t val = 0;
+	uint32_t s;
+
+	switch (type) {
+	case pkt_cycles: return p->avg_pkt_ticks;
+	case calls: return p->total_polls;
+	case credits: return p->inflight_credits;
+	case poll_return: return p->zero_polls;
+	default: break;
+	}
+
+	/* each shard has its own rings and counters for the port */
+	for (s = 0; s < sw->nb_shards; s++) {
+		uint64_t v = get_shard_port_stat(
+				&sw->shards[s].ports[obj_idx], type);
+
+		if (v == (uint64_t)-1)
+			return v;
+		val += v;
+	}
+
+	return val;
+}
+
 static uint64_t
 get_port_bucket_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg)
@@ -38,6 +38,9 @@ enum {VIRTIO_RXQ, VIRTIO_TXQ, VIRTIO_QNUM};
 #define ETH_VHOST_LINEAR_BUF		"linear-buffer"
 #define ETH_VHOST_EXT_BUF		"ext-buffer"
 #define ETH_VHOST_LEGACY_OL_FLAGS	"legacy-ol-flags"
+#define ETH_VHOST_ADAPTIVE_BUSY_US	"adaptive-busy-us"
+#define ETH_VHOST_ADAPTIVE_MONITOR_US	"adaptive-monitor-us"
+#define ETH_VHOST_DEQUEUE_ZERO_COPY	"dequeue-zero-copy"
 #define VHOST_MAX_PKT_BURST 32
 
 static const char *valid_arguments[] = {
@@ -50,6 +53,9 @@ static const char *valid_arguments[] = {
 	ETH_VHOST_LINEAR_BUF,
 	ETH_VHOST_EXT_BUF,
 	ETH_VHOST_LEGACY_OL_FLAGS,
+	ETH_VHOST_ADAPTIVE_BUSY_US,
+	ETH_VHOST_ADAPTIVE_MONITOR_US,
+	ETH_VHOST_DEQUEUE_ZERO_COPY,
 	NULL
 };
 
@@ -96,6 +102,8 @@ struct pmd_internal {
 	bool vlan_strip;
 	bool rx_sw_csum;
 	bool tx_sw_csum;
+	bool adaptive_poll;
+	struct rte_vhost_adaptive_poll_conf adaptive;
 };
 
 struct internal_list {
@@ -856,6 +864,12 @@ new_device(int vid)
 	for (i = 0; i < rte_vhost_get_vring_num(vid); i++)
 		rte_vhost_enable_guest_notification(vid, i, 0);
 
+	for (i = 0; internal->adaptive_poll && i < eth_dev->data->nb_rx_queues; i++) {
+		if (rte_vhost_adaptive_poll_configure(vid, i * VIRTIO_QNUM + VIRTIO_TXQ,
+				&internal->adaptive) < 0)
+			VHOST_LOG_LINE(DEBUG, "Adaptive polling not enabled on rxq %u", i);
+	}
+
 	rte_vhost_get_mtu(vid, &eth_dev->data->mtu);
 
 	eth_dev->data->dev_link.link_status = RTE_ETH_LINK_UP;
@@ -1111,6 +1125,27 @@ rte_eth_vhost_get_vid_from_port_id(uint16_t port_id)
 	return vid;
 }
 
+int
+rte_eth_vhost_get_queue_poll_state(uint16_t port_id, uint16_t queue_id)
+{
+	struct rte_eth_dev *eth_dev;
+	struct vhost_queue *vq;
+
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return -1;
+
+	eth_dev = &rte_eth_devices[port_id];
+	if (eth_dev->rx_pkt_burst != eth_vhost_rx ||
+			queue_id >= eth_dev->data->nb_rx_queues)
+		return -1;
+
+	vq = eth_dev->data->rx_queues[queue_id];
+	if (vq == NULL || vq->vid < 0)
+		return -1;
+
+	return rte_vhost_adaptive_poll_state_get(vq->vid, vq->virtqueue_id);
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev)
 {
@@ -1501,7 +1536,8 @@ static const struct eth_dev_ops ops = {
 static int
 eth_dev_vhost_create(struct rte_vdev_device *dev, char *iface_name,
 	int16_t queues, const unsigned int numa_node, uint64_t flags,
-	uint64_t disable_flags)
+	uint64_t disable_flags,
+	const struct rte_vhost_adaptive_poll_conf *adaptive)
 {
 	const char *name = rte_vdev_device_name(dev);
 	struct rte_eth_dev_data *data;
@@ -1543,6 +1579,10 @@ eth_dev_vhost_create(struct rte_vdev_device *dev, char *iface_name,
 	internal->vid = -1;
 	internal->flags = flags;
 	internal->disable_flags = disable_flags;
+	if (adaptive != NULL) {
+		internal->adaptive_poll = true;
+		internal->adaptive = *adaptive;
+	}
 	data->dev_link = pmd_link;
 	data->dev_flags = RTE_ETH_DEV_INTR_LSC |
 				RTE_ETH_DEV_AUTOFILL_QUEUE_XSTATS;
@@ -1611,6 +1651,10 @@ rte_pmd_vhost_probe(struct rte_vdev_device *dev)
 	int linear_buf = 0;
 	int ext_buf = 0;
 	int legacy_ol_flags = 0;
+	int dequeue_zero_copy = 0;
+	uint16_t adaptive_busy_us = 50;
+	uint16_t adaptive_monitor_us = 0;
+	struct rte_vhost_adaptive_poll_conf adaptive;
 	struct rte_eth_dev *eth_dev;
 	const char *name = rte_vdev_device_name(dev);
 
@@ -1731,11 +1775,42 @@ rte_pmd_vhost_probe(struct rte_vdev_device *dev)
 	if (legacy_ol_flags == 0)
 		flags |= RTE_VHOST_USER_NET_COMPLIANT_OL_FLAGS;
 
+	if (rte_kvargs_count(kvlist, ETH_VHOST_ADAPTIVE_BUSY_US) == 1) {
+		ret = rte_kvargs_process(kvlist,
+				ETH_VHOST_ADAPTIVE_BUSY_US,
+				&open_int, &adaptive_busy_us);
+		if (ret < 0)
+			goto out_free;
+	}
+
+	if (rte_kvargs_count(kvlist, ETH_VHOST_ADAPTIVE_MONITOR_US) == 1) {
+		ret = rte_kvargs_process(kvlist,
+				ETH_VHOST_ADAPTIVE_MONITOR_US,
+				&open_int, &adaptive_monitor_us);
+		if (ret < 0)
+			goto out_free;
+	}
+
+	if (rte_kvargs_count(kvlist, ETH_VHOST_DEQUEUE_ZERO_COPY) == 1) {
+		ret = rte_kvargs_process(kvlist,
+				ETH_VHOST_DEQUEUE_ZERO_COPY,
+				&open_int, &dequeue_zero_copy);
+		if (ret < 0)
+			goto out_free;
+
+		if (dequeue_zero_copy == 1)
+			flags |= RTE_VHOST_USER_DEQUEUE_ZERO_COPY;
+	}
+
+	adaptive.busy_poll_us = adaptive_busy_us;
+	adaptive.monitor_us = adaptive_monitor_us;
+
 	if (dev->device.numa_node == SOCKET_ID_ANY)
 		dev->device.numa_node = rte_socket_id();
 
 	ret = eth_dev_vhost_create(dev, iface_name, queues,
-				   dev->device.numa_node, flags, disable_flags);
+				   dev->device.numa_node, flags, disable_flags,
+				   adaptive_monitor_us ? &adaptive : NULL);
 	if (ret == -1)
 		VHOST_LOG_LINE(ERR, "Failed to create %s", name);
 
@@ -1779,4 +1854,8 @@ RTE_PMD_REGISTER_PARAM_STRING(net_vhost,
 	"postcopy-support=<0|1> "
 	"tso=<0|1> "
 	"linear-buffer=<0|1> "
-	"ext-buffer=<0|1>");
+	"ext-buffer=<0|1> "
+	"legacy-ol-flags=<0|1> "
+	"adaptive-busy-us=<int> "
+	"adaptive-monitor-us=<int> "
+	"dequeue-zero-copy=<0|1>");
@@ -52,6 +52,31 @@ int rte_eth_vhost_get_queue_event(uint16_t port_id,
  */
 int rte_eth_vhost_get_vid_from_port_id(uint16_t port_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Get the waiting mode advised for an Rx queue of a port created with the
+ * 'adaptive-monitor-us' devarg.
+ *
+ * The state is the one computed by the vhost library on the last Rx burst,
+ * see rte_vhost_adaptive_poll_state_get(). The driver only reports it:
+ * it does not wait, and does not switch the queue between modes by itself.
+ * Acting on the state is left to the thread polling the queue, e.g. after
+ * an empty Rx burst, waiting with rte_power_monitor() on the condition from
+ * rte_eth_get_monitor_addr() in RTE_VHOST_POLL_MONITOR state.
+ *
+ * @param port_id
+ *  Port id.
+ * @param queue_id
+ *  Rx queue id.
+ * @return
+ *  - On success, the rte_vhost_poll_state of the queue.
+ *  - On failure, or if adaptive polling is disabled, a negative value.
+ */
+__rte_experimental
+int rte_eth_vhost_get_queue_poll_state(uint16_t port_id, uint16_t queue_id);
+
 #ifdef __cplusplus
 }
 #endif
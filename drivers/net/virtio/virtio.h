@@ -187,6 +187,7 @@ struct virtio_hw {
 	uint16_t vtnet_hdr_size;
 	uint8_t started;
 	uint8_t weak_barriers;
+	uint8_t use_event_idx;
 	uint8_t vlan_strip;
 	uint8_t has_hash_report;
 	bool rx_ol_scatter;
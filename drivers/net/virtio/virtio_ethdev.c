@@ -134,6 +134,7 @@ static const struct rte_virtio_xstats_name_off rte_virtio_txq_stat_strings[] = {
 	{"size_512_1023_packets",  offsetof(struct virtnet_tx, stats.size_bins[5])},
 	{"size_1024_1518_packets", offsetof(struct virtnet_tx, stats.size_bins[6])},
 	{"size_1519_max_packets",  offsetof(struct virtnet_tx, stats.size_bins[7])},
+	{"kicks",                  offsetof(struct virtnet_tx, stats.kicks)},
 };
 
 #define VIRTIO_NB_RXQ_XSTATS (sizeof(rte_virtio_rxq_stat_strings) / \
@@ -1788,6 +1789,7 @@ virtio_init_device(struct rte_eth_dev *eth_dev, uint64_t req_features)
 		return -EINVAL;
 
 	hw->weak_barriers = !virtio_with_feature(hw, VIRTIO_F_ORDER_PLATFORM);
+	hw->use_event_idx = virtio_with_feature(hw, VIRTIO_RING_F_EVENT_IDX);
 
 	/* If host does not support both status and MSI-X then disable LSC */
 	if (virtio_with_feature(hw, VIRTIO_NET_F_STATUS) && hw->intr_lsc)
@@ -128,7 +128,19 @@ struct vring {
  * versa. They are at the end for backwards compatibility.
  */
 #define vring_used_event(vr)  ((vr)->avail->ring[(vr)->num])
-#define vring_avail_event(vr) (*(uint16_t *)&(vr)->used->ring[(vr)->num])
+
+/*
+ * The avail event index is a 16-bit field following the used ring, not a
+ * vring_used_elem: read it through a pointer of its own type.
+ */
+static inline uint16_t
+vring_avail_event(const struct vring *vr)
+{
+	const volatile uint16_t *avail_event = RTE_PTR_ADD(vr->used->ring,
+			vr->num * sizeof(struct vring_used_elem));
+
+	return *avail_event;
+}
 
 static inline size_t
 vring_size(struct virtio_hw *hw, unsigned int num, unsigned long align)
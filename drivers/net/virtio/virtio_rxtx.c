@@ -1847,6 +1847,7 @@ virtio_xmit_pkts_packed(void *tx_queue, struct rte_mbuf **tx_pkts,
 	if (likely(nb_tx)) {
 		if (unlikely(virtqueue_kick_prepare_packed(vq))) {
 			virtqueue_notify(vq);
+			txvq->stats.kicks++;
 			PMD_TX_LOG(DEBUG, "Notified backend after xmit");
 		}
 	}
@@ -1931,6 +1932,7 @@ virtio_xmit_pkts(void *tx_queue, struct rte_mbuf **tx_pkts, uint16_t nb_pkts)
 
 		if (unlikely(virtqueue_kick_prepare(vq))) {
 			virtqueue_notify(vq);
+			txvq->stats.kicks++;
 			PMD_TX_LOG(DEBUG, "Notified backend after xmit");
 		}
 	}
@@ -2056,6 +2058,7 @@ virtio_xmit_pkts_inorder(void *tx_queue,
 
 		if (unlikely(virtqueue_kick_prepare(vq))) {
 			virtqueue_notify(vq);
+			txvq->stats.kicks++;
 			PMD_TX_LOG(DEBUG, "Notified backend after xmit");
 		}
 	}
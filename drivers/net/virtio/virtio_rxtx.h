@@ -15,6 +15,7 @@ struct virtnet_stats {
 	uint64_t	broadcast;
 	/* Size bins in array as RFC 2819, undersized [0], 64 [1], etc */
 	uint64_t	size_bins[8];
+	uint64_t	kicks;
 };
 
 struct virtnet_rx {
@@ -68,6 +68,7 @@ virtio_xmit_pkts_packed_vec(void *tx_queue, struct rte_mbuf **tx_pkts,
 	if (likely(nb_tx)) {
 		if (unlikely(virtqueue_kick_prepare_packed(vq))) {
 			virtqueue_notify(vq);
+			txvq->stats.kicks++;
 			PMD_TX_LOG(DEBUG, "Notified backend after xmit");
 		}
 	}
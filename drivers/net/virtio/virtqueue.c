@@ -205,6 +205,8 @@ virtqueue_rxvq_reset_packed(struct virtqueue *vq)
 	vq->vq_used_cons_idx = 0;
 	vq->vq_desc_head_idx = 0;
 	vq->vq_avail_idx = 0;
+	vq->vq_kick_idx = 0;
+	vq->vq_kick_wrap = true;
 	vq->vq_desc_tail_idx = (uint16_t)(vq->vq_nentries - 1);
 	vq->vq_free_cnt = vq->vq_nentries;
 
@@ -239,6 +241,8 @@ virtqueue_txvq_reset_packed(struct virtqueue *vq)
 	vq->vq_used_cons_idx = 0;
 	vq->vq_desc_head_idx = 0;
 	vq->vq_avail_idx = 0;
+	vq->vq_kick_idx = 0;
+	vq->vq_kick_wrap = true;
 	vq->vq_desc_tail_idx = (uint16_t)(vq->vq_nentries - 1);
 	vq->vq_free_cnt = vq->vq_nentries;
 
@@ -278,6 +282,8 @@ virtio_init_vring(struct virtqueue *vq)
 	vq->vq_used_cons_idx = 0;
 	vq->vq_desc_head_idx = 0;
 	vq->vq_avail_idx = 0;
+	vq->vq_kick_idx = 0;
+	vq->vq_kick_wrap = true;
 	vq->vq_desc_tail_idx = (uint16_t)(vq->vq_nentries - 1);
 	vq->vq_free_cnt = vq->vq_nentries;
 	memset(vq->vq_descx, 0, sizeof(struct vq_desc_extra) * vq->vq_nentries);
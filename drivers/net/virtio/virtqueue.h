@@ -190,6 +190,8 @@ struct virtqueue {
 	uint16_t vq_free_cnt;  /**< num of desc available */
 	uint16_t vq_avail_idx; /**< sync until needed */
 	uint16_t vq_free_thresh; /**< free threshold */
+	uint16_t vq_kick_idx; /**< avail idx at the last kick decision */
+	bool vq_kick_wrap; /**< avail wrap counter at the last kick decision */
 
 	/**
 	 * Head of the free chain in the descriptor table. If
@@ -354,6 +356,9 @@ static inline void
 virtqueue_disable_intr_split(struct virtqueue *vq)
 {
 	vq->vq_split.ring.avail->flags |= VRING_AVAIL_F_NO_INTERRUPT;
+	/* Flags are ignored with event index, point the event far away. */
+	if (vq->hw->use_event_idx)
+		vring_used_event(&vq->vq_split.ring) = vq->vq_used_cons_idx - 1;
 }
 
 /**
@@ -388,6 +393,8 @@ static inline void
 virtqueue_enable_intr_split(struct virtqueue *vq)
 {
 	vq->vq_split.ring.avail->flags &= (~VRING_AVAIL_F_NO_INTERRUPT);
+	if (vq->hw->use_event_idx)
+		vring_used_event(&vq->vq_split.ring) = vq->vq_used_cons_idx;
 }
 
 /**
@@ -511,29 +518,66 @@ vq_update_avail_ring(struct virtqueue *vq, uint16_t desc_idx)
 	vq->vq_avail_idx++;
 }
 
+/*
+ * With VIRTIO_RING_F_EVENT_IDX, the backend publishes the avail index it
+ * wants to be kicked at. A polling backend lets it lag behind, so kicks are
+ * only sent when the backend is about to sleep, whatever the burst size.
+ */
 static inline int
 virtqueue_kick_prepare(struct virtqueue *vq)
 {
+	uint16_t old_idx;
+
 	/*
 	 * Ensure updated avail->idx is visible to vhost before reading
 	 * the used->flags.
 	 */
 	virtio_mb(vq->hw->weak_barriers);
-	return !(vq->vq_split.ring.used->flags & VRING_USED_F_NO_NOTIFY);
+	if (!vq->hw->use_event_idx)
+		return !(vq->vq_split.ring.used->flags & VRING_USED_F_NO_NOTIFY);
+
+	old_idx = vq->vq_kick_idx;
+	vq->vq_kick_idx = vq->vq_avail_idx;
+
+	return vring_need_event(vring_avail_event(&vq->vq_split.ring),
+				vq->vq_avail_idx, old_idx);
 }
 
 static inline int
 virtqueue_kick_prepare_packed(struct virtqueue *vq)
 {
-	uint16_t flags;
+	uint16_t flags, off_wrap, event_idx, new_idx, old_idx;
+	bool wrap, old_wrap;
 
 	/*
 	 * Ensure updated data is visible to vhost before reading the flags.
 	 */
 	virtio_mb(vq->hw->weak_barriers);
 	flags = vq->vq_packed.ring.device->desc_event_flags;
+	if (flags != RING_EVENT_FLAGS_DESC || !vq->hw->use_event_idx)
+		return flags != RING_EVENT_FLAGS_DISABLE;
+
+	off_wrap = vq->vq_packed.ring.device->desc_event_off_wrap;
+	wrap = !!(vq->vq_packed.cached_flags & VRING_PACKED_DESC_F_AVAIL);
+	new_idx = vq->vq_avail_idx;
+	old_idx = vq->vq_kick_idx;
+	old_wrap = vq->vq_kick_wrap;
+	vq->vq_kick_idx = new_idx;
+	vq->vq_kick_wrap = wrap;
+
+	/* Express the indexes relative to the current ring lap. */
+	if (old_wrap != wrap) {
+		/* A whole ring was made available since the last kick. */
+		if (old_idx <= new_idx)
+			return 1;
+		old_idx -= vq->vq_nentries;
+	}
+
+	event_idx = off_wrap & ~(1 << 15);
+	if ((off_wrap >> 15) != wrap)
+		event_idx -= vq->vq_nentries;
 
-	return flags != RING_EVENT_FLAGS_DISABLE;
+	return vring_need_event(event_idx, new_idx, old_idx);
 }
 
 /*
@@ -277,7 +277,7 @@ print_stats_cb(__rte_unused void *param)
 {
 	uint64_t total_packets_dropped, total_packets_tx, total_packets_rx;
 	uint64_t total_frag_packets_dropped = 0;
-	float burst_percent, rx_per_call, tx_per_call;
+	float burst_percent, rx_per_call, tx_per_call, cpu_crypto_per_call;
 	unsigned int coreid;
 
 	total_packets_dropped = 0;
@@ -302,6 +302,12 @@ print_stats_cb(__rte_unused void *param)
 				       core_statistics[coreid].rx_call;
 		tx_per_call =  (float)(core_statistics[coreid].tx)/
 				       core_statistics[coreid].tx_call;
+		/* the CPU crypto path may not be used by this core */
+		cpu_crypto_per_call = 0;
+		if (core_statistics[coreid].cpu_crypto_call != 0)
+			cpu_crypto_per_call =
+				(float)(core_statistics[coreid].cpu_crypto)/
+				core_statistics[coreid].cpu_crypto_call;
 		printf("\nStatistics for core %u ------------------------------"
 			   "\nPackets received: %20"PRIu64
 			   "\nPackets sent: %24"PRIu64
@@ -309,7 +315,8 @@ print_stats_cb(__rte_unused void *param)
 			   "\nFrag Packets dropped: %16"PRIu64
 			   "\nBurst percent: %23.2f"
 			   "\nPackets per Rx call: %17.2f"
-			   "\nPackets per Tx call: %17.2f",
+			   "\nPackets per Tx call: %17.2f"
+			   "\nPackets per CPU crypto call: %9.2f",
 			   coreid,
 			   core_statistics[coreid].rx,
 			   core_statistics[coreid].tx,
@@ -317,7 +324,8 @@ print_stats_cb(__rte_unused void *param)
 			   core_statistics[coreid].frag_dropped,
 			   burst_percent,
 			   rx_per_call,
-			   tx_per_call);
+			   tx_per_call,
+			   cpu_crypto_per_call);
 
 		total_packets_dropped += core_statistics[coreid].dropped;
 		total_frag_packets_dropped += core_statistics[coreid].frag_dropped;
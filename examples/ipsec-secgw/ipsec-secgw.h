@@ -106,6 +106,8 @@ struct __rte_cache_aligned ipsec_core_statistics {
 	uint64_t dropped;
 	uint64_t frag_dropped;
 	uint64_t burst_rx;
+	uint64_t cpu_crypto;
+	uint64_t cpu_crypto_call;
 
 	struct {
 		struct ipsec_spd_stats spd4;
@@ -183,6 +185,14 @@ core_stats_update_tx(int n)
 	core_statistics[lcore_id].tx_call++;
 }
 
+static inline void
+core_stats_update_cpu_crypto(int n)
+{
+	int lcore_id = rte_lcore_id();
+	core_statistics[lcore_id].cpu_crypto += n;
+	core_statistics[lcore_id].cpu_crypto_call++;
+}
+
 static inline void
 core_stats_update_drop(int n)
 {
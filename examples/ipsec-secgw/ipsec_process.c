@@ -210,23 +210,36 @@ ipsec_process_inline_group(struct rte_ipsec_session *ips, void *sa,
 }
 
 /*
- * process packets synchronously
+ * process packets of all CPU crypto groups synchronously, in one call,
+ * so that the crypto device gets packets of all SAs at once.
  */
-static uint32_t
-ipsec_process_cpu_group(struct rte_ipsec_session *ips, void *sa,
-	struct ipsec_traffic *trf, struct rte_mbuf *mb[], uint32_t cnt)
+static void
+ipsec_process_cpu_groups(struct ipsec_traffic *trf,
+	struct rte_ipsec_group grp[], uint32_t num)
 {
 	uint64_t satp;
-	uint32_t k;
+	uint32_t i, k, n;
+	struct rte_ipsec_session *ips;
 
-	/* get SA type */
-	satp = rte_ipsec_sa_type(ips->sa);
-	prep_process_group(sa, mb, cnt);
+	n = 0;
+	for (i = 0; i != num; i++)
+		n += grp[i].cnt;
+	core_stats_update_cpu_crypto(n);
 
-	k = rte_ipsec_pkt_cpu_prepare(ips, mb, cnt);
-	k = rte_ipsec_pkt_process(ips, mb, k);
-	copy_to_trf(trf, satp, mb, k);
-	return k;
+	rte_ipsec_pkt_cpu_burst(grp, num);
+
+	for (i = 0; i != num; i++) {
+		ips = grp[i].id.ptr;
+		k = grp[i].rc;
+
+		/* get SA type */
+		satp = rte_ipsec_sa_type(ips->sa);
+		copy_to_trf(trf, satp, grp[i].m, k);
+
+		/* drop packets that cannot be processed */
+		if (k != grp[i].cnt)
+			free_pkts(grp[i].m + k, grp[i].cnt - k);
+	}
 }
 
 /*
@@ -239,13 +252,15 @@ ipsec_process_cpu_group(struct rte_ipsec_session *ips, void *sa,
 void
 ipsec_process(struct ipsec_ctx *ctx, struct ipsec_traffic *trf)
 {
-	uint32_t i, k, n;
+	uint32_t i, k, n, nc;
 	struct ipsec_sa *sa;
 	struct rte_ipsec_group *pg;
 	struct rte_ipsec_session *ips;
 	struct rte_ipsec_group grp[RTE_DIM(trf->ipsec.pkts)];
+	struct rte_ipsec_group cpu_grp[RTE_DIM(trf->ipsec.pkts)];
 
 	n = sa_group(trf->ipsec.saptr, trf->ipsec.pkts, grp, trf->ipsec.num);
+	nc = 0;
 
 	for (i = 0; i != n; i++) {
 
@@ -278,10 +293,12 @@ ipsec_process(struct ipsec_ctx *ctx, struct ipsec_traffic *trf)
 				k = ipsec_process_inline_group(ips, sa,
 					trf, pg->m, pg->cnt);
 				break;
+			/* defer to process all CPU crypto SAs together */
 			case RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO:
-				k = ipsec_process_cpu_group(ips, sa,
-					trf, pg->m, pg->cnt);
-				break;
+				prep_process_group(sa, pg->m, pg->cnt);
+				cpu_grp[nc] = *pg;
+				cpu_grp[nc++].id.ptr = ips;
+				continue;
 			default:
 				k = 0;
 			}
@@ -291,6 +308,9 @@ ipsec_process(struct ipsec_ctx *ctx, struct ipsec_traffic *trf)
 		if (k != pg->cnt)
 			free_pkts(pg->m + k, pg->cnt - k);
 	}
+
+	if (nc != 0)
+		ipsec_process_cpu_groups(trf, cpu_grp, nc);
 }
 
 static inline uint32_t
@@ -9,6 +9,7 @@
 
 #include <rte_eal.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_ethdev.h>
 #include <rte_lcore.h>
@@ -36,11 +37,14 @@ enum {
 	OPT_DISABLE_REORDER_NUM = 256,
 #define OPT_INSIGHT_WORKER  "insight-worker"
 	OPT_INSIGHT_WORKER_NUM,
+#define OPT_REORDER_MP      "reorder-mp"
+	OPT_REORDER_MP_NUM,
 };
 
 unsigned int portmask;
 unsigned int disable_reorder;
 unsigned int insight_worker;
+unsigned int reorder_mp;
 volatile uint8_t quit_signal;
 
 static struct rte_mempool *mbuf_pool;
@@ -50,11 +54,13 @@ static struct rte_eth_conf port_conf_default;
 struct worker_thread_args {
 	struct rte_ring *ring_in;
 	struct rte_ring *ring_out;
+	struct rte_reorder_mp *buffer_mp;
 };
 
 struct send_thread_args {
 	struct rte_ring *ring_in;
 	struct rte_reorder_buffer *buffer;
+	struct rte_reorder_mp *buffer_mp;
 };
 
 volatile struct app_stats {
@@ -138,8 +144,11 @@ pktmbuf_free_bulk(struct rte_mbuf *mbuf_table[], unsigned n)
 static void
 print_usage(const char *prgname)
 {
-	printf("%s [EAL options] -- -p PORTMASK\n"
-			"  -p PORTMASK: hexadecimal bitmask of ports to configure\n",
+	printf("%s [EAL options] -- -p PORTMASK [--disable-reorder|--reorder-mp]\n"
+			"  -p PORTMASK: hexadecimal bitmask of ports to configure\n"
+			"  --disable-reorder: forward packets without reordering\n"
+			"  --reorder-mp: let the workers release packets in order\n"
+			"      concurrently instead of reordering on the TX core\n",
 			prgname);
 }
 
@@ -168,6 +177,7 @@ parse_args(int argc, char **argv)
 	static struct option lgopts[] = {
 		{OPT_DISABLE_REORDER, 0, NULL, OPT_DISABLE_REORDER_NUM},
 		{OPT_INSIGHT_WORKER,  0, NULL, OPT_INSIGHT_WORKER_NUM },
+		{OPT_REORDER_MP,      0, NULL, OPT_REORDER_MP_NUM     },
 		{NULL,                0, 0,    0                      }
 	};
 
@@ -197,11 +207,21 @@ parse_args(int argc, char **argv)
 			insight_worker = 1;
 			break;
 
+		case OPT_REORDER_MP_NUM:
+			printf("multi-producer reorder enabled\n");
+			reorder_mp = 1;
+			break;
+
 		default:
 			print_usage(prgname);
 			return -1;
 		}
 	}
+	if (disable_reorder && reorder_mp) {
+		printf("%s and %s are exclusive\n", OPT_DISABLE_REORDER, OPT_REORDER_MP);
+		print_usage(prgname);
+		return -1;
+	}
 	if (optind <= 1) {
 		print_usage(prgname);
 		return -1;
@@ -347,7 +367,7 @@ configure_eth_port(uint16_t port_id)
 }
 
 static void
-print_stats(void)
+print_stats(uint64_t tsc)
 {
 	uint16_t i;
 	struct rte_eth_stats eth_stats;
@@ -402,6 +422,9 @@ print_stats(void)
 						app_stats.tx.early_pkts_txtd_woro);
 	printf(" - Pkts tx failed w/o reorder:		%"PRIu64"\n",
 						app_stats.tx.early_pkts_tx_failed_woro);
+	if (tsc != 0)
+		printf(" - Ro Pkts tx rate:			%.2f Mpps\n",
+			(double)app_stats.tx.ro_tx_pkts * rte_get_tsc_hz() / tsc / 1e6);
 
 	RTE_ETH_FOREACH_DEV(i) {
 		rte_eth_stats_get(i, &eth_stats);
@@ -488,6 +511,50 @@ rx_thread_reorder_disabled(struct rte_ring *ring_out)
 	return rx_thread(ring_out, true);
 }
 
+/**
+ * Same as rx_thread(), but the packets are enqueued to the multi-producer
+ * reorder buffer, which gives them their sequence number.
+ */
+static __rte_noinline int
+rx_thread_reorder_mp(struct rte_reorder_mp *buffer)
+{
+	uint16_t ret = 0;
+	uint16_t nb_rx_pkts;
+	uint16_t port_id;
+	struct rte_mbuf *pkts[MAX_PKTS_BURST];
+
+	RTE_LOG(INFO, REORDERAPP, "%s() started on lcore %u\n", __func__,
+							rte_lcore_id());
+
+	while (!quit_signal) {
+
+		RTE_ETH_FOREACH_DEV(port_id) {
+			if ((portmask & (1 << port_id)) != 0) {
+
+				/* receive packets */
+				nb_rx_pkts = rte_eth_rx_burst(port_id, 0,
+								pkts, MAX_PKTS_BURST);
+				if (nb_rx_pkts == 0) {
+					RTE_LOG_DP(DEBUG, REORDERAPP,
+					"%s():Received zero packets\n",	__func__);
+					continue;
+				}
+				app_stats.rx.rx_pkts += nb_rx_pkts;
+
+				/* enqueue to the reorder buffer */
+				ret = rte_reorder_mp_enqueue(buffer, pkts, nb_rx_pkts);
+				app_stats.rx.enqueue_pkts += ret;
+				if (unlikely(ret < nb_rx_pkts)) {
+					app_stats.rx.enqueue_failed_pkts +=
+									(nb_rx_pkts-ret);
+					pktmbuf_free_bulk(&pkts[ret], nb_rx_pkts - ret);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
 /**
  * This thread takes bursts of packets from the rx_to_workers ring and
  * Changes the input port value to output port value. And feds it to
@@ -539,6 +606,48 @@ worker_thread(void *args_ptr)
 	return 0;
 }
 
+/**
+ * Same as worker_thread(), but the packets are acquired from the
+ * multi-producer reorder buffer and released back to it in place,
+ * concurrently with the other workers.
+ */
+static int
+worker_thread_mp(void *args_ptr)
+{
+	const uint16_t nb_ports = rte_eth_dev_count_avail();
+	uint16_t i, burst_size = 0;
+	struct worker_thread_args *args;
+	struct rte_mbuf *burst_buffer[MAX_PKTS_BURST] = { NULL };
+	const unsigned xor_val = (nb_ports > 1);
+	unsigned int core_id = rte_lcore_id();
+	uint32_t token;
+
+	args = (struct worker_thread_args *) args_ptr;
+
+	RTE_LOG(INFO, REORDERAPP, "%s() started on lcore %u\n", __func__,
+							core_id);
+
+	while (!quit_signal) {
+
+		/* acquire the mbufs from the reorder buffer */
+		burst_size = rte_reorder_mp_acquire(args->buffer_mp, burst_buffer,
+				MAX_PKTS_BURST, &token);
+		if (unlikely(burst_size == 0))
+			continue;
+
+		wkr_stats[core_id].deq_pkts += burst_size;
+
+		/* just do some operation on mbuf */
+		for (i = 0; i < burst_size;)
+			burst_buffer[i++]->port ^= xor_val;
+
+		/* the mbufs are not modified in place, nothing to write back */
+		rte_reorder_mp_release(args->buffer_mp, NULL, burst_size, token);
+		wkr_stats[core_id].enq_pkts += burst_size;
+	}
+	return 0;
+}
+
 /**
  * Dequeue mbufs from the workers_to_tx ring and reorder them before
  * transmitting.
@@ -626,6 +735,52 @@ send_thread(struct send_thread_args *args)
 	return 0;
 }
 
+/**
+ * Drain the mbufs released by the workers from the multi-producer reorder
+ * buffer and transmit them.
+ */
+static int
+send_thread_mp(struct send_thread_args *args)
+{
+	unsigned int i, dret;
+	unsigned sent;
+	uint8_t outp;
+	struct rte_mbuf *rombufs[MAX_PKTS_BURST] = {NULL};
+	struct rte_eth_dev_tx_buffer *outbuf;
+	static struct rte_eth_dev_tx_buffer *tx_buffer[RTE_MAX_ETHPORTS];
+
+	RTE_LOG(INFO, REORDERAPP, "%s() started on lcore %u\n", __func__, rte_lcore_id());
+
+	configure_tx_buffers(tx_buffer);
+
+	while (!quit_signal) {
+
+		dret = rte_reorder_mp_drain(args->buffer_mp, rombufs, MAX_PKTS_BURST);
+		if (unlikely(dret == 0))
+			continue;
+
+		app_stats.tx.dequeue_pkts += dret;
+
+		for (i = 0; i < dret; i++) {
+			outp = rombufs[i]->port;
+			/* skip ports that are not enabled */
+			if ((portmask & (1 << outp)) == 0) {
+				rte_pktmbuf_free(rombufs[i]);
+				continue;
+			}
+
+			outbuf = tx_buffer[outp];
+			sent = rte_eth_tx_buffer(outp, 0, outbuf, rombufs[i]);
+			if (sent)
+				app_stats.tx.ro_tx_pkts += sent;
+		}
+	}
+
+	free_tx_buffers(tx_buffer);
+
+	return 0;
+}
+
 /**
  * Dequeue mbufs from the workers_to_tx ring and transmit them
  */
@@ -681,8 +836,10 @@ main(int argc, char **argv)
 	unsigned int lcore_id, last_lcore_id, main_lcore_id;
 	uint16_t port_id;
 	uint16_t nb_ports_available;
-	struct worker_thread_args worker_args = {NULL, NULL};
-	struct send_thread_args send_args = {NULL, NULL};
+	struct worker_thread_args worker_args = {NULL, NULL, NULL};
+	struct send_thread_args send_args = {NULL, NULL, NULL};
+	lcore_function_t *worker_fn = worker_thread;
+	uint64_t start_tsc;
 	struct rte_ring *rx_to_workers;
 	struct rte_ring *workers_to_tx;
 
@@ -757,7 +914,14 @@ main(int argc, char **argv)
 	if (workers_to_tx == NULL)
 		rte_exit(EXIT_FAILURE, "%s\n", rte_strerror(rte_errno));
 
-	if (!disable_reorder) {
+	if (reorder_mp) {
+		send_args.buffer_mp = rte_reorder_mp_create("PKT_RO_MP", rte_socket_id(),
+				REORDER_BUFFER_SIZE);
+		if (send_args.buffer_mp == NULL)
+			rte_exit(EXIT_FAILURE, "%s\n", rte_strerror(rte_errno));
+		worker_args.buffer_mp = send_args.buffer_mp;
+		worker_fn = worker_thread_mp;
+	} else if (!disable_reorder) {
 		send_args.buffer = rte_reorder_create("PKT_RO", rte_socket_id(),
 				REORDER_BUFFER_SIZE);
 		if (send_args.buffer == NULL)
@@ -773,10 +937,14 @@ main(int argc, char **argv)
 	/* Start worker_thread() on all the available worker cores but the last 1 */
 	for (lcore_id = 0; lcore_id <= get_previous_lcore_id(last_lcore_id); lcore_id++)
 		if (rte_lcore_is_enabled(lcore_id) && lcore_id != main_lcore_id)
-			rte_eal_remote_launch(worker_thread, (void *)&worker_args,
+			rte_eal_remote_launch(worker_fn, (void *)&worker_args,
 					lcore_id);
 
-	if (disable_reorder) {
+	if (reorder_mp) {
+		/* Start send_thread_mp() on the last worker core */
+		rte_eal_remote_launch((lcore_function_t *)send_thread_mp,
+				(void *)&send_args, last_lcore_id);
+	} else if (disable_reorder) {
 		/* Start tx_thread() on the last worker core */
 		rte_eal_remote_launch((lcore_function_t *)tx_thread, workers_to_tx,
 				last_lcore_id);
@@ -787,8 +955,12 @@ main(int argc, char **argv)
 				(void *)&send_args, last_lcore_id);
 	}
 
+	start_tsc = rte_rdtsc();
+
 	/* Start rx_thread_xxx() on the main core */
-	if (disable_reorder)
+	if (reorder_mp)
+		rx_thread_reorder_mp(send_args.buffer_mp);
+	else if (disable_reorder)
 		rx_thread_reorder_disabled(rx_to_workers);
 	else
 		rx_thread_reorder(rx_to_workers);
@@ -798,7 +970,9 @@ main(int argc, char **argv)
 			return -1;
 	}
 
-	print_stats();
+	print_stats(rte_rdtsc() - start_tsc);
+
+	rte_reorder_mp_free(send_args.buffer_mp);
 
 	/* clean up the EAL */
 	rte_eal_cleanup();
@@ -58,6 +58,36 @@ get_pkt_sched(struct rte_mbuf *m, uint32_t *subport, uint32_t *pipe,
 	return 0;
 }
 
+/* Send the packets to the ring of the shard scheduling their subport */
+static inline void
+app_rx_shards_enqueue(struct thread_conf *conf, struct rte_mbuf **mbufs,
+		uint32_t nb_rx)
+{
+	struct rte_mbuf *shard_mbufs[MAX_SCHED_SHARDS][nb_rx];
+	uint32_t nb_shard[MAX_SCHED_SHARDS] = { 0 };
+	uint32_t n_subports = port_params.n_subports_per_port / conf->n_shards;
+	uint32_t i, s, subport, pipe, traffic_class, queue;
+
+	for (i = 0; i < nb_rx; i++) {
+		rte_sched_port_pkt_read_tree_path(conf->sched_port, mbufs[i],
+				&subport, &pipe, &traffic_class, &queue);
+		s = subport / n_subports;
+		shard_mbufs[s][nb_shard[s]++] = mbufs[i];
+	}
+
+	for (s = 0; s < conf->n_shards; s++) {
+		if (nb_shard[s] == 0)
+			continue;
+
+		if (unlikely(rte_ring_sp_enqueue_bulk(conf->shard_rings[s],
+				(void **)shard_mbufs[s], nb_shard[s], NULL) == 0)) {
+			rte_pktmbuf_free_bulk(shard_mbufs[s], nb_shard[s]);
+
+			APP_STATS_ADD(conf->stat.nb_drop, nb_shard[s]);
+		}
+	}
+}
+
 void
 app_rx_thread(struct thread_conf **confs)
 {
@@ -89,7 +119,9 @@ app_rx_thread(struct thread_conf **confs)
 						(enum rte_color) color);
 			}
 
-			if (unlikely(rte_ring_sp_enqueue_bulk(conf->rx_ring,
+			if (conf->n_shards > 1)
+				app_rx_shards_enqueue(conf, rx_mbufs, nb_rx);
+			else if (unlikely(rte_ring_sp_enqueue_bulk(conf->rx_ring,
 					(void **)rx_mbufs, nb_rx, NULL) == 0)) {
 				for(i = 0; i < nb_rx; i++) {
 					rte_pktmbuf_free(rx_mbufs[i]);
@@ -152,7 +184,7 @@ app_worker_thread(struct thread_conf **confs)
 		nb_pkt = rte_sched_port_dequeue(conf->sched_port, mbufs,
 					burst_conf.qos_dequeue);
 		if (likely(nb_pkt > 0))
-			while (rte_ring_sp_enqueue_bulk(conf->tx_ring,
+			while (rte_ring_enqueue_bulk(conf->tx_ring,
 					(void **)mbufs, nb_pkt, NULL) == 0)
 				; /* empty body */
 
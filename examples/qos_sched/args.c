@@ -65,6 +65,9 @@ static const char usage[] =
 	"           B = TX host threshold (default value is %u)                         \n"
 	"           C = TX write-back threshold (default value is %u)                   \n"
 	"    --cfg FILE : profile configuration to load                                 \n"
+	"    --shd N : Number of scheduler shards per pfc (default value is 1), each    \n"
+	"           one scheduling its own subports on lcore WT LCORE + shard index,    \n"
+	"           requires a separate TX LCORE                                        \n"
 ;
 
 /* display usage */
@@ -265,6 +268,8 @@ enum {
 	OPT_TTH_NUM,
 #define OPT_CFG "cfg"
 	OPT_CFG_NUM,
+#define OPT_SHD "shd"
+	OPT_SHD_NUM,
 };
 
 /*
@@ -277,7 +282,7 @@ app_parse_args(int argc, char **argv)
 	int opt, ret;
 	int option_index;
 	char *prgname = argv[0];
-	uint32_t i;
+	uint32_t i, s;
 
 	static struct option lgopts[] = {
 		{OPT_PFC, 1, NULL, OPT_PFC_NUM},
@@ -288,6 +293,7 @@ app_parse_args(int argc, char **argv)
 		{OPT_RTH, 1, NULL, OPT_RTH_NUM},
 		{OPT_TTH, 1, NULL, OPT_TTH_NUM},
 		{OPT_CFG, 1, NULL, OPT_CFG_NUM},
+		{OPT_SHD, 1, NULL, OPT_SHD_NUM},
 		{NULL,    0, 0,    0          }
 	};
 
@@ -374,6 +380,15 @@ app_parse_args(int argc, char **argv)
 				cfg_profile = optarg;
 				break;
 
+			case OPT_SHD_NUM:
+				nb_shards = (uint32_t)atoi(optarg);
+				if (nb_shards == 0 || nb_shards > MAX_SCHED_SHARDS) {
+					RTE_LOG(ERR, APP, "Invalid number of shards %s\n",
+							optarg);
+					return -1;
+				}
+				break;
+
 			default:
 				app_usage(prgname);
 				return -1;
@@ -404,6 +419,22 @@ app_parse_args(int argc, char **argv)
 			RTE_LOG(ERR, APP, "pfc %u: RX and WT must be on the same socket\n", i + 1);
 			return -1;
 		}
+		if (nb_shards > 1 && qos_conf[i].tx_core == qos_conf[i].wt_core) {
+			RTE_LOG(ERR, APP, "pfc %u: shards require a separate TX lcore\n", i + 1);
+			return -1;
+		}
+		for (s = 0; s < nb_shards; s++) {
+			uint32_t wt_core = qos_conf[i].wt_core + s;
+
+			if (wt_core >= RTE_MAX_LCORE || !rte_lcore_is_enabled(wt_core) ||
+			    wt_core == qos_conf[i].rx_core || wt_core == qos_conf[i].tx_core ||
+			    rte_lcore_to_socket_id(wt_core) != rx_sock) {
+				RTE_LOG(ERR, APP, "pfc %u: invalid WT lcore %u for shard %u\n",
+						i + 1, wt_core, s);
+				return -1;
+			}
+			qos_conf[i].shard_wt_core[s] = wt_core;
+		}
 		app_numa_mask |= 1 << rte_lcore_to_socket_id(qos_conf[i].rx_core);
 	}
 
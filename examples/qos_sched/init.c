@@ -52,6 +52,7 @@ struct ring_thresh tx_thresh = {
 };
 
 uint32_t nb_pfc;
+uint32_t nb_shards = 1;
 const char *cfg_profile = NULL;
 int mp_size = NB_MBUF;
 struct flow_conf qos_conf[MAX_DATA_STREAMS];
@@ -320,7 +321,7 @@ app_load_cfg_profile(const char *profile)
 
 int app_init(void)
 {
-	uint32_t i;
+	uint32_t i, s;
 	char ring_name[MAX_NAME_LEN];
 	char pool_name[MAX_NAME_LEN];
 	int ret;
@@ -347,14 +348,24 @@ int app_init(void)
 		else
 			qos_conf[i].rx_ring = ring;
 
+		/* All the shard workers write to the same TX ring */
 		snprintf(ring_name, MAX_NAME_LEN, "ring-%u-%u", i, qos_conf[i].tx_core);
 		ring = rte_ring_lookup(ring_name);
 		if (ring == NULL)
 			qos_conf[i].tx_ring = rte_ring_create(ring_name, ring_conf.ring_size,
-				socket, RING_F_SP_ENQ | RING_F_SC_DEQ);
+				socket, nb_shards > 1 ? RING_F_SC_DEQ :
+				RING_F_SP_ENQ | RING_F_SC_DEQ);
 		else
 			qos_conf[i].tx_ring = ring;
 
+		for (s = 0; nb_shards > 1 && s < nb_shards; s++) {
+			snprintf(ring_name, MAX_NAME_LEN, "shard-ring-%u-%u", i, s);
+			qos_conf[i].shard_rx_ring[s] = rte_ring_create(ring_name,
+				ring_conf.ring_size, socket, RING_F_SP_ENQ | RING_F_SC_DEQ);
+			if (qos_conf[i].shard_rx_ring[s] == NULL)
+				rte_exit(EXIT_FAILURE, "Cannot create ring for shard %u\n", s);
+		}
+
 
 		/* create the mbuf pools for each RX Port */
 		snprintf(pool_name, MAX_NAME_LEN, "mbuf_pool%u", i);
@@ -386,6 +397,22 @@ int app_init(void)
 		}
 
 		qos_conf[i].sched_port = app_init_sched_port(qos_conf[i].tx_port, socket);
+
+		/* Each shard schedules the same number of contiguous subports */
+		if (nb_shards > 1) {
+			uint32_t n_subports = port_params.n_subports_per_port / nb_shards;
+
+			if (port_params.n_subports_per_port % nb_shards != 0)
+				rte_exit(EXIT_FAILURE, "%u subports can not be split in %u shards\n",
+					port_params.n_subports_per_port, nb_shards);
+
+			for (s = 0; s < nb_shards; s++) {
+				qos_conf[i].shard_port[s] = rte_sched_port_shard_create(
+					qos_conf[i].sched_port, s * n_subports, n_subports);
+				if (qos_conf[i].shard_port[s] == NULL)
+					rte_exit(EXIT_FAILURE, "Unable to create shard %u\n", s);
+			}
+		}
 	}
 
 	RTE_LOG(INFO, APP, "time stamp clock running at %" PRIu64 " Hz\n",
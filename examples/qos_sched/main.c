@@ -32,7 +32,7 @@ static int
 app_main_loop(__rte_unused void *dummy)
 {
 	uint32_t lcore_id;
-	uint32_t i, mode;
+	uint32_t i, j, mode;
 	uint32_t rx_idx = 0;
 	uint32_t wt_idx = 0;
 	uint32_t tx_idx = 0;
@@ -56,6 +56,9 @@ app_main_loop(__rte_unused void *dummy)
 			flow->rx_thread.rx_ring =  flow->rx_ring;
 			flow->rx_thread.rx_queue = flow->rx_queue;
 			flow->rx_thread.sched_port = flow->sched_port;
+			flow->rx_thread.n_shards = nb_shards;
+			for (j = 0; nb_shards > 1 && j < nb_shards; j++)
+				flow->rx_thread.shard_rings[j] = flow->shard_rx_ring[j];
 
 			rx_confs[rx_idx++] = &flow->rx_thread;
 
@@ -70,7 +73,22 @@ app_main_loop(__rte_unused void *dummy)
 
 			mode |= APP_TX_MODE;
 		}
-		if (flow->wt_core == lcore_id) {
+		for (j = 0; nb_shards > 1 && j < nb_shards; j++) {
+			struct thread_conf *wt_thread = &flow->shard_wt_thread[j];
+
+			if (flow->shard_wt_core[j] != lcore_id)
+				continue;
+
+			wt_thread->rx_ring = flow->shard_rx_ring[j];
+			wt_thread->tx_ring = flow->tx_ring;
+			wt_thread->tx_port = flow->tx_port;
+			wt_thread->sched_port = flow->shard_port[j];
+
+			wt_confs[wt_idx++] = wt_thread;
+
+			mode |= APP_WT_MODE;
+		}
+		if (nb_shards == 1 && flow->wt_core == lcore_id) {
 			flow->wt_thread.rx_ring =  flow->rx_ring;
 			flow->wt_thread.tx_ring =  flow->tx_ring;
 			flow->wt_thread.tx_port =  flow->tx_port;
@@ -166,10 +184,18 @@ app_stat(void)
 		printf("  RX   | %10" PRIu64 " | %10" PRIu64 " |\n",
 			flow->rx_thread.stat.nb_rx,
 			flow->rx_thread.stat.nb_drop);
-		printf("QOS+TX | %10" PRIu64 " | %10" PRIu64 " |   pps: %"PRIu64 " \n",
-			flow->wt_thread.stat.nb_rx,
-			flow->wt_thread.stat.nb_drop,
-			flow->wt_thread.stat.nb_rx - flow->wt_thread.stat.nb_drop);
+		if (nb_shards == 1)
+			printf("QOS+TX | %10" PRIu64 " | %10" PRIu64 " |   pps: %"PRIu64 " \n",
+				flow->wt_thread.stat.nb_rx,
+				flow->wt_thread.stat.nb_drop,
+				flow->wt_thread.stat.nb_rx - flow->wt_thread.stat.nb_drop);
+		for (uint32_t j = 0; nb_shards > 1 && j < nb_shards; j++) {
+			struct thread_stat *stat = &flow->shard_wt_thread[j].stat;
+
+			printf("QOS %2u | %10" PRIu64 " | %10" PRIu64 " |   pps: %"PRIu64 " \n",
+				j, stat->nb_rx, stat->nb_drop, stat->nb_rx - stat->nb_drop);
+			memset(stat, 0, sizeof(struct thread_stat));
+		}
 		printf("-------+------------+------------+\n");
 
 		memset(&flow->rx_thread.stat, 0, sizeof(struct thread_stat));
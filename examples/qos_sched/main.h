@@ -42,6 +42,7 @@ extern "C" {
 #define MAX_SCHED_PIPES		4096
 #define MAX_SCHED_PIPE_PROFILES		256
 #define MAX_SCHED_SUBPORT_PROFILES	8
+#define MAX_SCHED_SHARDS		MAX_SCHED_SUBPORTS
 
 #ifndef APP_COLLECT_STAT
 #define APP_COLLECT_STAT		1
@@ -73,6 +74,10 @@ struct __rte_cache_aligned thread_conf
 	struct rte_ring *tx_ring;
 	struct rte_sched_port *sched_port;
 
+	/* RX thread: one ring per scheduler shard */
+	uint32_t n_shards;
+	struct rte_ring *shard_rings[MAX_SCHED_SHARDS];
+
 #if APP_COLLECT_STAT
 	struct thread_stat stat;
 #endif
@@ -96,6 +101,12 @@ struct flow_conf
 	struct thread_conf rx_thread;
 	struct thread_conf wt_thread;
 	struct thread_conf tx_thread;
+
+	/* Scheduler shards, each one run by its own worker lcore */
+	uint32_t shard_wt_core[MAX_SCHED_SHARDS];
+	struct rte_ring *shard_rx_ring[MAX_SCHED_SHARDS];
+	struct rte_sched_port *shard_port[MAX_SCHED_SHARDS];
+	struct thread_conf shard_wt_thread[MAX_SCHED_SHARDS];
 };
 
 
@@ -125,6 +136,7 @@ extern uint8_t interactive;
 extern uint32_t qavg_period;
 extern uint32_t qavg_ntimes;
 extern uint32_t nb_pfc;
+extern uint32_t nb_shards;
 extern const char *cfg_profile;
 extern int mp_size;
 extern struct flow_conf qos_conf[];
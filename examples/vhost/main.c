@@ -75,6 +75,8 @@ static int total_num_mbufs = NUM_MBUFS_DEFAULT;
 struct dma_for_vhost dma_bind[RTE_MAX_VHOST_DEVICE];
 int16_t dmas_id[RTE_DMADEV_DEFAULT_MAX];
 static int dma_count;
+/* DMA copies accumulated across vhost devices before ringing the doorbell */
+static uint16_t dma_batch;
 
 /* mask of enabled ports */
 static uint32_t enabled_port_mask = 0;
@@ -653,6 +655,7 @@ us_vhost_usage(const char *prgname)
 	"		--tso [0|1]: disable/enable TCP segment offload.\n"
 	"		--client: register a vhost-user socket as client mode.\n"
 	"		--dmas: register dma channel for specific vhost device.\n"
+	"		--dma-batch [0-N]: number of DMA copies from all vhost devices submitted at once, 0 to submit every burst.\n"
 	"		--total-num-mbufs [0-N]: set the number of mbufs to be allocated in mbuf pools, the default value is 147456.\n"
 	"		--builtin-net-driver: enable simple vhost-user net driver\n",
 	       prgname);
@@ -685,6 +688,8 @@ enum {
 	OPT_DMAS_NUM,
 #define OPT_NUM_MBUFS           "total-num-mbufs"
 	OPT_NUM_MBUFS_NUM,
+#define OPT_DMA_BATCH           "dma-batch"
+	OPT_DMA_BATCH_NUM,
 };
 
 /*
@@ -724,6 +729,8 @@ us_vhost_parse_args(int argc, char **argv)
 				NULL, OPT_DMAS_NUM},
 		{OPT_NUM_MBUFS, required_argument,
 				NULL, OPT_NUM_MBUFS_NUM},
+		{OPT_DMA_BATCH, required_argument,
+				NULL, OPT_DMA_BATCH_NUM},
 		{NULL, 0, 0, 0},
 	};
 
@@ -864,6 +871,17 @@ us_vhost_parse_args(int argc, char **argv)
 				total_num_mbufs = ret;
 			break;
 
+		case OPT_DMA_BATCH_NUM:
+			ret = parse_num_opt(optarg, UINT16_MAX);
+			if (ret == -1) {
+				RTE_LOG(INFO, VHOST_CONFIG,
+					"Invalid argument for dma-batch [0..N]\n");
+				us_vhost_usage(prgname);
+				return -1;
+			}
+			dma_batch = ret;
+			break;
+
 		case OPT_CLIENT_NUM:
 			client_mode = 1;
 			break;
@@ -1522,6 +1540,10 @@ switch_worker(void *arg __rte_unused)
 			if (likely(!vdev->remove))
 				drain_virtio_tx(vdev);
 		}
+
+		/* Ring the DMA doorbells once for all the vhost devices. */
+		for (i = 0; dma_batch && i < (unsigned int)dma_count; i++)
+			rte_vhost_async_dma_submit(dmas_id[i], 0);
 	}
 
 	return 0;
@@ -2009,6 +2031,9 @@ main(int argc, char *argv[])
 			RTE_LOG(ERR, VHOST_PORT, "Failed to configure DMA in vhost.\n");
 			rte_exit(EXIT_FAILURE, "Cannot use given DMA device\n");
 		}
+		if (dma_batch &&
+		    rte_vhost_async_dma_batch_configure(dmas_id[i], 0, dma_batch) < 0)
+			rte_exit(EXIT_FAILURE, "Cannot batch given DMA device\n");
 	}
 
 	/* Register vhost user driver to handle vhost messages. */
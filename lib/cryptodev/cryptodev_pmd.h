@@ -412,6 +412,22 @@ typedef uint32_t (*cryptodev_sym_cpu_crypto_process_t)
 	(struct rte_cryptodev *dev, struct rte_cryptodev_sym_session *sess,
 	union rte_crypto_sym_ofs ofs, struct rte_crypto_sym_vec *vec);
 
+/**
+ * Perform actual crypto processing (encrypt/digest or auth/decrypt)
+ * on user provided data, each element with its own session.
+ *
+ * @param	dev	Crypto device pointer
+ * @param	sess	Array of cryptodev sessions, one per element
+ * @param	ofs	Array of start and stop offsets, one per element
+ * @param	vec	Vectorized operation descriptor
+ *
+ * @return
+ *  - Returns number of successfully processed packets.
+ */
+typedef uint32_t (*cryptodev_sym_cpu_crypto_process_multi_t)
+	(struct rte_cryptodev *dev, struct rte_cryptodev_sym_session *sess[],
+	const union rte_crypto_sym_ofs ofs[], struct rte_crypto_sym_vec *vec);
+
 /**
  * Typedef that the driver provided to get service context private date size.
  *
@@ -524,6 +540,8 @@ struct rte_cryptodev_ops {
 	/**< Set a Crypto or Security session even meta data. */
 	cryptodev_queue_pair_event_error_query_t queue_pair_event_error_query;
 	/**< Query queue error interrupt event */
+	cryptodev_sym_cpu_crypto_process_multi_t sym_cpu_process_multi;
+	/**< process input data of many sessions synchronously (cpu-crypto). */
 };
 
 
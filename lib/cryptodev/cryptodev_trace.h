@@ -408,6 +408,13 @@ RTE_TRACE_POINT(
 	rte_trace_point_emit_ptr(sess);
 )
 
+RTE_TRACE_POINT(
+	rte_cryptodev_trace_sym_cpu_crypto_process_multi,
+	RTE_TRACE_POINT_ARGS(uint8_t dev_id, uint32_t num),
+	rte_trace_point_emit_u8(dev_id);
+	rte_trace_point_emit_u32(num);
+)
+
 RTE_TRACE_POINT(
 	rte_cryptodev_trace_sym_session_get_user_data,
 	RTE_TRACE_POINT_ARGS(const void *sess, const void *data),
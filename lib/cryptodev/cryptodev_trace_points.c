@@ -153,6 +153,9 @@ RTE_TRACE_POINT_REGISTER(rte_cryptodev_trace_asym_xform_capability_check_hash,
 RTE_TRACE_POINT_REGISTER(rte_cryptodev_trace_sym_cpu_crypto_process,
 	lib.cryptodev.sym.cpu.crypto.process)
 
+RTE_TRACE_POINT_REGISTER(rte_cryptodev_trace_sym_cpu_crypto_process_multi,
+	lib.cryptodev.sym.cpu.crypto.process.multi)
+
 RTE_TRACE_POINT_REGISTER(rte_cryptodev_trace_sym_session_get_user_data,
 	lib.cryptodev.sym.session.get.user.data)
 
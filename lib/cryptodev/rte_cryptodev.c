@@ -2485,6 +2485,55 @@ rte_cryptodev_sym_cpu_crypto_process(uint8_t dev_id,
 	return dev->dev_ops->sym_cpu_process(dev, sess, ofs, vec);
 }
 
+uint32_t
+rte_cryptodev_sym_cpu_crypto_process_multi(uint8_t dev_id,
+	void *sess[], const union rte_crypto_sym_ofs ofs[],
+	struct rte_crypto_sym_vec *vec)
+{
+	struct rte_cryptodev *dev;
+	struct rte_crypto_sym_vec sub;
+	uint32_t i, j, n;
+
+	if (!rte_cryptodev_is_valid_dev(dev_id)) {
+		sym_crypto_fill_status(vec, EINVAL);
+		return 0;
+	}
+
+	dev = rte_cryptodev_pmd_get_dev(dev_id);
+
+	if (*dev->dev_ops->sym_cpu_process == NULL ||
+		!(dev->feature_flags & RTE_CRYPTODEV_FF_SYM_CPU_CRYPTO)) {
+		sym_crypto_fill_status(vec, ENOTSUP);
+		return 0;
+	}
+
+	rte_cryptodev_trace_sym_cpu_crypto_process_multi(dev_id, vec->num);
+
+	if (dev->dev_ops->sym_cpu_process_multi != NULL)
+		return dev->dev_ops->sym_cpu_process_multi(dev,
+			(struct rte_cryptodev_sym_session **)sess, ofs, vec);
+
+	/* process runs of elements with the same session and offsets */
+	n = 0;
+	for (i = 0; i != vec->num; i = j) {
+		for (j = i + 1; j != vec->num && sess[j] == sess[i] &&
+				ofs[j].raw == ofs[i].raw; j++)
+			;
+
+		sub.num = j - i;
+		sub.src_sgl = vec->src_sgl + i;
+		sub.dest_sgl = (vec->dest_sgl != NULL) ? vec->dest_sgl + i : NULL;
+		sub.iv = vec->iv + i;
+		sub.digest = vec->digest + i;
+		sub.aad = vec->aad + i;
+		sub.status = vec->status + i;
+
+		n += dev->dev_ops->sym_cpu_process(dev, sess[i], ofs[i], &sub);
+	}
+
+	return n;
+}
+
 int
 rte_cryptodev_get_raw_dp_ctx_size(uint8_t dev_id)
 {
@@ -1371,6 +1371,32 @@ rte_cryptodev_sym_cpu_crypto_process(uint8_t dev_id,
 	void *sess, union rte_crypto_sym_ofs ofs,
 	struct rte_crypto_sym_vec *vec);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Same as *rte_cryptodev_sym_cpu_crypto_process*, but each element of
+ * the vectorized operation descriptor can belong to a different session.
+ * It lets the device process elements of many sessions in parallel,
+ * instead of one session per call.
+ * Devices without a native implementation process the runs of elements
+ * sharing the same session and offsets one after another.
+ *
+ * @param	dev_id	The device identifier.
+ * @param	sess	Array of *vec->num* cryptodev sessions, one per element.
+ * @param	ofs	Array of *vec->num* start and stop offsets for auth and
+ *			cipher operations, one per element.
+ * @param	vec	Vectorized operation descriptor
+ *
+ * @return
+ *  - Returns number of successfully processed packets.
+ */
+__rte_experimental
+uint32_t
+rte_cryptodev_sym_cpu_crypto_process_multi(uint8_t dev_id,
+	void *sess[], const union rte_crypto_sym_ofs ofs[],
+	struct rte_crypto_sym_vec *vec);
+
 /**
  * Get the size of the raw data-path context buffer.
  *
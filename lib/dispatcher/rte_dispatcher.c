@@ -8,6 +8,7 @@
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
 #include <rte_lcore.h>
+#include <rte_malloc.h>
 #include <rte_random.h>
 #include <rte_service_component.h>
 
@@ -21,6 +22,26 @@
 #define EVD_AVG_PRIO_INTERVAL 2000
 #define EVD_SERVICE_NAME "dispatcher"
 
+/*
+ * Declarative matches are compiled into a lookup table indexed by
+ * queue id. A queue entry either holds the handler index directly, or,
+ * if any handler applicable to that queue also matches on the event
+ * type or sub event type, refers to a second level table indexed by
+ * event type and sub event type. Queues with the same set of
+ * applicable handlers share the second level table.
+ */
+#define EVD_NUM_QUEUE_IDS (UINT8_MAX + 1)
+#define EVD_SUB_LUT_SIZE (RTE_EVENT_TYPE_MAX * (UINT8_MAX + 1))
+/*
+ * The handler set of a queue is the handlers not matching on queue
+ * id, plus the ones matching that particular queue, so there can be
+ * at most one distinct set per handler plus one.
+ */
+#define EVD_MAX_SUB_LUTS (EVD_MAX_HANDLERS + 1)
+#define EVD_LUT_MISS 0x7f
+#define EVD_LUT_SUB 0x80
+#define EVD_NO_HANDLER UINT8_MAX
+
 struct rte_dispatcher_lcore_port {
 	uint8_t port_id;
 	uint16_t batch_size;
@@ -35,6 +56,11 @@ struct rte_dispatcher_handler {
 	void *process_data;
 };
 
+struct evd_match_table {
+	uint8_t queue_lut[EVD_NUM_QUEUE_IDS];
+	alignas(RTE_CACHE_LINE_SIZE) uint8_t sub_luts[EVD_MAX_SUB_LUTS][EVD_SUB_LUT_SIZE];
+};
+
 struct rte_dispatcher_finalizer {
 	int id;
 	rte_dispatcher_finalize_t finalize_fun;
@@ -58,8 +84,25 @@ struct rte_dispatcher {
 	struct rte_dispatcher_lcore lcores[RTE_MAX_LCORE];
 	uint16_t num_finalizers;
 	struct rte_dispatcher_finalizer finalizers[EVD_MAX_FINALIZERS];
+	uint16_t num_match_handlers;
+	struct rte_dispatcher_handler match_handlers[EVD_MAX_HANDLERS];
+	struct rte_dispatcher_match matches[EVD_MAX_HANDLERS];
+	struct evd_match_table *match_table;
 };
 
+static __rte_always_inline uint8_t
+evd_lookup_match_idx(const struct evd_match_table *table,
+	const struct rte_event *event)
+{
+	uint8_t entry = table->queue_lut[event->queue_id];
+
+	if (likely(!(entry & EVD_LUT_SUB)))
+		return entry;
+
+	return table->sub_luts[entry & ~EVD_LUT_SUB]
+		[event->event_type << 8 | event->sub_event_type];
+}
+
 static int
 evd_lookup_handler_idx(struct rte_dispatcher_lcore *lcore,
 	const struct rte_event *event)
@@ -119,40 +162,99 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	struct rte_event *events, uint16_t num_events)
 {
 	int i;
-	struct rte_event bursts[EVD_MAX_HANDLERS][num_events];
-	uint16_t burst_lens[EVD_MAX_HANDLERS] = { 0 };
+	uint16_t num_match_handlers = dispatcher->num_match_handlers;
+	const struct evd_match_table *table = dispatcher->match_table;
+	/*
+	 * Declarative match handlers use burst slots [0, num_match_handlers),
+	 * match function handlers start at EVD_MAX_HANDLERS.
+	 */
+	uint16_t burst_lens[2 * EVD_MAX_HANDLERS];
+	uint16_t burst_ends[2 * EVD_MAX_HANDLERS];
+	uint8_t handler_idxs[num_events];
+	struct rte_event bursts[num_events];
 	uint16_t drop_count = 0;
 	uint16_t dispatch_count;
 	uint16_t dispatched = 0;
+	uint16_t offset = 0;
+
+	memset(burst_lens, 0, sizeof(burst_lens[0]) * num_match_handlers);
+	memset(&burst_lens[EVD_MAX_HANDLERS], 0,
+	       sizeof(burst_lens[0]) * lcore->num_handlers);
 
 	for (i = 0; i < num_events; i++) {
 		struct rte_event *event = &events[i];
-		int handler_idx;
+		int handler_idx = EVD_LUT_MISS;
 
-		handler_idx = evd_lookup_handler_idx(lcore, event);
+		if (num_match_handlers > 0)
+			handler_idx = evd_lookup_match_idx(table, event);
 
-		if (unlikely(handler_idx < 0)) {
-			drop_count++;
-			continue;
+		if (handler_idx == EVD_LUT_MISS) {
+			handler_idx = evd_lookup_handler_idx(lcore, event);
+
+			if (unlikely(handler_idx < 0)) {
+				handler_idxs[i] = EVD_NO_HANDLER;
+				drop_count++;
+				continue;
+			}
+
+			handler_idx += EVD_MAX_HANDLERS;
 		}
 
-		bursts[handler_idx][burst_lens[handler_idx]] = *event;
+		handler_idxs[i] = handler_idx;
 		burst_lens[handler_idx]++;
 	}
 
 	dispatch_count = num_events - drop_count;
 
+	/*
+	 * Group the events per handler in a single pass, keeping their
+	 * relative order, so each handler is handed all its events of the
+	 * batch at once.
+	 */
+	for (i = 0; i < num_match_handlers; i++) {
+		offset += burst_lens[i];
+		burst_ends[i] = offset;
+	}
+	for (i = EVD_MAX_HANDLERS; i < EVD_MAX_HANDLERS + lcore->num_handlers;
+	     i++) {
+		offset += burst_lens[i];
+		burst_ends[i] = offset;
+	}
+	for (i = num_events - 1; i >= 0; i--) {
+		uint8_t handler_idx = handler_idxs[i];
+
+		if (handler_idx != EVD_NO_HANDLER)
+			bursts[--burst_ends[handler_idx]] = events[i];
+	}
+
+	for (i = 0; i < num_match_handlers &&
+		 dispatched < dispatch_count; i++) {
+		struct rte_dispatcher_handler *handler =
+			&dispatcher->match_handlers[i];
+		uint16_t len = burst_lens[i];
+
+		if (len == 0)
+			continue;
+
+		handler->process_fun(dispatcher->event_dev_id, port->port_id,
+				     &bursts[burst_ends[i]], len,
+				     handler->process_data);
+
+		dispatched += len;
+	}
+
 	for (i = 0; i < lcore->num_handlers &&
 		 dispatched < dispatch_count; i++) {
 		struct rte_dispatcher_handler *handler =
 			&lcore->handlers[i];
-		uint16_t len = burst_lens[i];
+		uint16_t len = burst_lens[EVD_MAX_HANDLERS + i];
 
 		if (len == 0)
 			continue;
 
 		handler->process_fun(dispatcher->event_dev_id, port->port_id,
-				     bursts[i], len, handler->process_data);
+				     &bursts[burst_ends[EVD_MAX_HANDLERS + i]],
+				     len, handler->process_data);
 
 		dispatched += len;
 
@@ -312,6 +414,7 @@ rte_dispatcher_free(struct rte_dispatcher *dispatcher)
 	if (rc != 0)
 		return rc;
 
+	rte_free(dispatcher->match_table);
 	rte_free(dispatcher);
 
 	return 0;
@@ -412,6 +515,18 @@ evd_lcore_get_handler_by_id(struct rte_dispatcher_lcore *lcore, int handler_id)
 	return NULL;
 }
 
+static int
+evd_get_match_handler_idx(struct rte_dispatcher *dispatcher, int handler_id)
+{
+	uint16_t i;
+
+	for (i = 0; i < dispatcher->num_match_handlers; i++)
+		if (dispatcher->match_handlers[i].id == handler_id)
+			return i;
+
+	return -1;
+}
+
 static int
 evd_alloc_handler_id(struct rte_dispatcher *dispatcher)
 {
@@ -419,10 +534,8 @@ evd_alloc_handler_id(struct rte_dispatcher *dispatcher)
 	struct rte_dispatcher_lcore *reference_lcore =
 		&dispatcher->lcores[0];
 
-	if (reference_lcore->num_handlers == EVD_MAX_HANDLERS)
-		return -1;
-
-	while (evd_lcore_get_handler_by_id(reference_lcore, handler_id) != NULL)
+	while (evd_lcore_get_handler_by_id(reference_lcore, handler_id) != NULL ||
+	       evd_get_match_handler_idx(dispatcher, handler_id) >= 0)
 		handler_id++;
 
 	return handler_id;
@@ -463,16 +576,170 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
 		.process_data = process_data
 	};
 
-	handler.id = evd_alloc_handler_id(dispatcher);
-
-	if (handler.id < 0)
+	if (dispatcher->lcores[0].num_handlers == EVD_MAX_HANDLERS)
 		return -ENOMEM;
 
+	handler.id = evd_alloc_handler_id(dispatcher);
+
 	evd_install_handler(dispatcher, &handler);
 
 	return handler.id;
 }
 
+static bool
+evd_match_queue(const struct rte_dispatcher_match *match, uint8_t queue_id)
+{
+	return !(match->flags & RTE_DISPATCHER_MATCH_QUEUE_ID) ||
+		match->queue_id == queue_id;
+}
+
+static bool
+evd_match_type(const struct rte_dispatcher_match *match, uint8_t event_type,
+	uint8_t sub_event_type)
+{
+	if ((match->flags & RTE_DISPATCHER_MATCH_EVENT_TYPE) &&
+	    match->event_type != event_type)
+		return false;
+
+	return !(match->flags & RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE) ||
+		match->sub_event_type == sub_event_type;
+}
+
+static void
+evd_build_sub_lut(const struct rte_dispatcher *dispatcher, uint32_t handlers,
+	uint8_t *sub_lut)
+{
+	unsigned int event_type;
+	unsigned int sub_event_type;
+
+	for (event_type = 0; event_type < RTE_EVENT_TYPE_MAX; event_type++) {
+		for (sub_event_type = 0; sub_event_type <= UINT8_MAX;
+		     sub_event_type++) {
+			uint8_t handler_idx = EVD_LUT_MISS;
+			uint32_t left = handlers;
+
+			/* lowest index is the earliest registration */
+			while (left != 0) {
+				unsigned int i = rte_ctz32(left);
+
+				if (evd_match_type(&dispatcher->matches[i],
+						   event_type,
+						   sub_event_type)) {
+					handler_idx = i;
+					break;
+				}
+
+				left &= left - 1;
+			}
+
+			sub_lut[event_type << 8 | sub_event_type] =
+				handler_idx;
+		}
+	}
+}
+
+static void
+evd_build_match_table(struct rte_dispatcher *dispatcher)
+{
+	struct evd_match_table *table = dispatcher->match_table;
+	uint32_t sub_lut_handlers[EVD_MAX_SUB_LUTS];
+	uint16_t num_sub_luts = 0;
+	uint32_t type_handlers = 0;
+	unsigned int queue_id;
+	uint16_t i;
+
+	for (i = 0; i < dispatcher->num_match_handlers; i++)
+		if (dispatcher->matches[i].flags &
+		    (RTE_DISPATCHER_MATCH_EVENT_TYPE |
+		     RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE))
+			type_handlers |= RTE_BIT32(i);
+
+	for (queue_id = 0; queue_id < EVD_NUM_QUEUE_IDS; queue_id++) {
+		uint32_t handlers = 0;
+
+		for (i = 0; i < dispatcher->num_match_handlers; i++)
+			if (evd_match_queue(&dispatcher->matches[i], queue_id))
+				handlers |= RTE_BIT32(i);
+
+		if (handlers == 0) {
+			table->queue_lut[queue_id] = EVD_LUT_MISS;
+			continue;
+		}
+
+		/* the earliest handler does not care about the type */
+		if (!(type_handlers & RTE_BIT32(rte_ctz32(handlers)))) {
+			table->queue_lut[queue_id] = rte_ctz32(handlers);
+			continue;
+		}
+
+		for (i = 0; i < num_sub_luts; i++)
+			if (sub_lut_handlers[i] == handlers)
+				break;
+
+		if (i == num_sub_luts) {
+			RTE_VERIFY(num_sub_luts < EVD_MAX_SUB_LUTS);
+			sub_lut_handlers[num_sub_luts++] = handlers;
+			evd_build_sub_lut(dispatcher, handlers,
+					  table->sub_luts[i]);
+		}
+
+		table->queue_lut[queue_id] = EVD_LUT_SUB | i;
+	}
+}
+
+int
+rte_dispatcher_register_match(struct rte_dispatcher *dispatcher,
+	const struct rte_dispatcher_match *match,
+	rte_dispatcher_process_t process_fun, void *process_data)
+{
+	struct rte_dispatcher_handler *handler;
+	uint16_t handler_idx;
+
+	RTE_BUILD_BUG_ON(EVD_MAX_HANDLERS >= EVD_LUT_MISS);
+	RTE_BUILD_BUG_ON(EVD_MAX_SUB_LUTS > EVD_LUT_SUB);
+
+	if (match == NULL || process_fun == NULL)
+		return -EINVAL;
+
+	if ((match->flags & ~(RTE_DISPATCHER_MATCH_QUEUE_ID |
+			      RTE_DISPATCHER_MATCH_EVENT_TYPE |
+			      RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE)) != 0 ||
+	    match->event_type >= RTE_EVENT_TYPE_MAX)
+		return -EINVAL;
+
+	if (dispatcher->num_match_handlers == EVD_MAX_HANDLERS)
+		return -ENOMEM;
+
+	if (dispatcher->match_table == NULL) {
+		dispatcher->match_table =
+			rte_zmalloc_socket("dispatcher_match_table",
+					   sizeof(struct evd_match_table),
+					   RTE_CACHE_LINE_SIZE,
+					   dispatcher->socket_id);
+		if (dispatcher->match_table == NULL) {
+			RTE_EDEV_LOG_ERR("Unable to allocate memory for "
+					 "dispatcher match table");
+			return -ENOMEM;
+		}
+	}
+
+	handler_idx = dispatcher->num_match_handlers;
+	handler = &dispatcher->match_handlers[handler_idx];
+
+	*handler = (struct rte_dispatcher_handler) {
+		.id = evd_alloc_handler_id(dispatcher),
+		.process_fun = process_fun,
+		.process_data = process_data
+	};
+	dispatcher->matches[handler_idx] = *match;
+
+	dispatcher->num_match_handlers++;
+
+	evd_build_match_table(dispatcher);
+
+	return handler->id;
+}
+
 static int
 evd_lcore_uninstall_handler(struct rte_dispatcher_lcore *lcore,
 	int handler_id)
@@ -522,9 +789,40 @@ evd_uninstall_handler(struct rte_dispatcher *dispatcher, int handler_id)
 	return 0;
 }
 
+static void
+evd_uninstall_match_handler(struct rte_dispatcher *dispatcher,
+	int handler_idx)
+{
+	uint16_t last_idx = dispatcher->num_match_handlers - 1;
+
+	if (handler_idx != last_idx) {
+		/* move all handlers to maintain registration order */
+		int n = last_idx - handler_idx;
+		memmove(&dispatcher->match_handlers[handler_idx],
+			&dispatcher->match_handlers[handler_idx + 1],
+			sizeof(struct rte_dispatcher_handler) * n);
+		memmove(&dispatcher->matches[handler_idx],
+			&dispatcher->matches[handler_idx + 1],
+			sizeof(struct rte_dispatcher_match) * n);
+	}
+
+	dispatcher->num_match_handlers--;
+
+	evd_build_match_table(dispatcher);
+}
+
 int
 rte_dispatcher_unregister(struct rte_dispatcher *dispatcher, int handler_id)
 {
+	int match_idx;
+
+	match_idx = evd_get_match_handler_idx(dispatcher, handler_id);
+
+	if (match_idx >= 0) {
+		evd_uninstall_match_handler(dispatcher, match_idx);
+		return 0;
+	}
+
 	return evd_uninstall_handler(dispatcher, handler_id);
 }
 
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <rte_bitops.h>
 #include <rte_compat.h>
 #include <rte_eventdev.h>
 
@@ -102,6 +103,30 @@ typedef void (*rte_dispatcher_process_t)(uint8_t event_dev_id,
 typedef void (*rte_dispatcher_finalize_t)(uint8_t event_dev_id,
 	uint8_t event_port_id, void *cb_data);
 
+/** Match on the event queue id. */
+#define RTE_DISPATCHER_MATCH_QUEUE_ID RTE_BIT32(0)
+/** Match on the event type. */
+#define RTE_DISPATCHER_MATCH_EVENT_TYPE RTE_BIT32(1)
+/** Match on the event sub event type. */
+#define RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE RTE_BIT32(2)
+
+/**
+ * Declarative event match specification.
+ *
+ * Only the fields selected in @c flags are compared with the event. A
+ * specification with no flag set matches all events.
+ */
+struct rte_dispatcher_match {
+	/** Fields to match, a combination of RTE_DISPATCHER_MATCH_* flags. */
+	uint32_t flags;
+	/** Event queue id, see struct rte_event::queue_id. */
+	uint8_t queue_id;
+	/** Event type, see struct rte_event::event_type. */
+	uint8_t event_type;
+	/** Event sub event type, see struct rte_event::sub_event_type. */
+	uint8_t sub_event_type;
+};
+
 /**
  * Dispatcher statistics
  */
@@ -295,6 +320,52 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
 	rte_dispatcher_match_t match_fun, void *match_cb_data,
 	rte_dispatcher_process_t process_fun, void *process_cb_data);
 
+/**
+ * Register an event handler selected by a declarative match.
+ *
+ * This function behaves like rte_dispatcher_register(), except the
+ * events delivered to the handler are selected by comparing the event
+ * queue id, event type and sub event type with @p match, rather than
+ * by calling a match function.
+ *
+ * All declarative matches are compiled into a lookup table, so the
+ * cost of finding the handler of an event does not depend on the
+ * number of handlers registered.
+ *
+ * Declarative matches take precedence over match functions. In case
+ * several declarative matches apply to an event, the event is
+ * delivered to the handler registered first. Events for which no
+ * declarative match applies are passed to the match functions.
+ *
+ * rte_dispatcher_register_match() may be called by any thread
+ * (including unregistered non-EAL threads), but not while the event
+ * dispatcher is running on any service lcore.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @param match
+ *  The match specification.
+ *
+ * @param process_fun
+ *  The process callback function.
+ *
+ * @param process_cb_data
+ *  A pointer to some application-specific opaque data (or NULL),
+ *  which is supplied back to the application when process_fun is
+ *  called.
+ *
+ * @return
+ *  - >= 0: The identifier for this registration.
+ *  - -ENOMEM: Unable to allocate sufficient resources.
+ *  - -EINVAL: Invalid match specification.
+ */
+__rte_experimental
+int
+rte_dispatcher_register_match(struct rte_dispatcher *dispatcher,
+	const struct rte_dispatcher_match *match,
+	rte_dispatcher_process_t process_fun, void *process_cb_data);
+
 /**
  * Unregister an event handler.
  *
@@ -307,7 +378,7 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
  *
  * @param handler_id
  *  The handler registration id returned by the original
- *  rte_dispatcher_register() call.
+ *  rte_dispatcher_register() or rte_dispatcher_register_match() call.
  *
  * @return
  *  - 0: Success
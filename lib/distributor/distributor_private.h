@@ -103,6 +103,7 @@ struct rte_distributor_single {
 enum rte_distributor_match_function {
 	RTE_DIST_MATCH_SCALAR = 0,
 	RTE_DIST_MATCH_VECTOR,
+	RTE_DIST_MATCH_AVX512,
 	RTE_DIST_NUM_MATCH_FNS
 };
 
@@ -168,4 +169,9 @@ find_match_vec(struct rte_distributor *d,
 			uint16_t *data_ptr,
 			uint16_t *output_ptr);
 
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr);
+
 #endif /* _DIST_PRIV_H_ */
@@ -8,6 +8,7 @@
 #include <sys/queue.h>
 #include <string.h>
 #include <rte_mbuf.h>
+#include <rte_cpuflags.h>
 #include <rte_cycles.h>
 #include <rte_memzone.h>
 #include <rte_errno.h>
@@ -438,6 +439,93 @@ release(struct rte_distributor *d, unsigned int wkr)
 }
 
 
+/* Flush out all non-full cache-lines to workers. */
+static void
+release_all(struct rte_distributor *d)
+{
+	unsigned int wid;
+
+	for (wid = 0 ; wid < d->num_workers; wid++)
+		/* Sync with worker on GET_BUF flag. */
+		if ((rte_atomic_load_explicit(&(d->bufs[wid].bufptr64[0]),
+			rte_memory_order_acquire) & RTE_DISTRIB_GET_BUF)) {
+			d->bufs[wid].count = 0;
+			release(d, wid);
+		}
+}
+
+/*
+ * Pick the worker of a flow with a jump consistent hash over all the workers.
+ * When the worker picked is not active, the hash is jumped again from where it
+ * stopped, so that the flows of the active workers never move when another
+ * worker leaves or joins, only the flows of that worker do.
+ */
+static unsigned int
+flow_worker_get(const struct rte_distributor *d, uint32_t tag)
+{
+	uint64_t key = tag;
+	int64_t b, j;
+	unsigned int n;
+
+	for (n = 0; n < d->num_workers; n++) {
+		b = -1;
+		j = 0;
+		while (j < d->num_workers) {
+			b = j;
+			key = key * 2862933555777941757ULL + 1;
+			j = (b + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1));
+		}
+		if (d->active[b])
+			return b;
+	}
+
+	/* Unlikely to get there with a single worker left */
+	for (n = tag % d->num_workers; !d->active[n]; n = (n + 1) % d->num_workers)
+		;
+	return n;
+}
+
+/*
+ * Distribute packets with flow affinity: each flow is always given to the same
+ * worker, as long as the set of workers does not change, so packets of a flow
+ * are processed in order without looking for the flow among the in-flight
+ * and backlog tags of all the workers.
+ */
+static int
+process_flow_hash(struct rte_distributor *d,
+		struct rte_mbuf **mbufs, unsigned int num_mbufs)
+{
+	struct rte_distributor_backlog *bl;
+	unsigned int i = 0, idx, wkr;
+	struct rte_mbuf *mb;
+
+	while (i < num_mbufs) {
+		if (unlikely(!d->activesum))
+			return i;
+
+		mb = mbufs[i];
+		wkr = flow_worker_get(d, mb->hash.usr);
+		bl = &d->backlog[wkr];
+
+		if (unlikely(bl->count == RTE_DIST_BURST_SIZE)) {
+			release(d, wkr);
+			/* The flows of a worker leaving move to the others */
+			if (!d->active[wkr])
+				continue;
+		}
+
+		idx = bl->count++;
+		/* flows MUST be non-zero */
+		bl->tags[idx] = (uint16_t)(mb->hash.usr) | 1;
+		bl->pkts[idx] = ((int64_t)(uintptr_t)mb) << RTE_DISTRIB_FLAG_BITS;
+		i++;
+	}
+
+	release_all(d);
+
+	return num_mbufs;
+}
+
 /* process a set of packets to distribute them to workers */
 int
 rte_distributor_process(struct rte_distributor *d,
@@ -477,6 +565,9 @@ rte_distributor_process(struct rte_distributor *d,
 	if (unlikely(!d->activesum))
 		return 0;
 
+	if (d->alg_type == RTE_DIST_ALG_BURST_HASH)
+		return process_flow_hash(d, mbufs, num_mbufs);
+
 	while (next_idx < num_mbufs) {
 		alignas(128) uint16_t matches[RTE_DIST_BURST_SIZE];
 		unsigned int pkts;
@@ -508,6 +599,12 @@ rte_distributor_process(struct rte_distributor *d,
 					find_match_vec(d, &flows[0],
 						&matches[0]);
 					break;
+#ifdef CC_AVX512_SUPPORT
+				case RTE_DIST_MATCH_AVX512:
+					find_match_avx512(d, &flows[0],
+						&matches[0]);
+					break;
+#endif
 				default:
 					find_match_scalar(d, &flows[0],
 						&matches[0]);
@@ -596,14 +693,7 @@ rte_distributor_process(struct rte_distributor *d,
 		wkr = (wkr + 1) % d->num_workers;
 	}
 
-	/* Flush out all non-full cache-lines to workers. */
-	for (wid = 0 ; wid < d->num_workers; wid++)
-		/* Sync with worker on GET_BUF flag. */
-		if ((rte_atomic_load_explicit(&(d->bufs[wid].bufptr64[0]),
-			rte_memory_order_acquire) & RTE_DISTRIB_GET_BUF)) {
-			d->bufs[wid].count = 0;
-			release(d, wid);
-		}
+	release_all(d);
 
 	return num_mbufs;
 }
@@ -726,7 +816,7 @@ rte_distributor_create(const char *name,
 	RTE_BUILD_BUG_ON((sizeof(*d) & RTE_CACHE_LINE_MASK) != 0);
 	RTE_BUILD_BUG_ON((RTE_DISTRIB_MAX_WORKERS & 7) != 0);
 
-	if (name == NULL || num_workers >=
+	if (name == NULL || alg_type >= RTE_DIST_NUM_ALG_TYPES || num_workers >=
 		(unsigned int)RTE_MIN(RTE_DISTRIB_MAX_WORKERS, RTE_MAX_LCORE)) {
 		rte_errno = EINVAL;
 		return NULL;
@@ -765,6 +855,12 @@ rte_distributor_create(const char *name,
 #if defined(RTE_ARCH_X86)
 	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128)
 		d->dist_match_fn = RTE_DIST_MATCH_VECTOR;
+#ifdef CC_AVX512_SUPPORT
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) == 1)
+		d->dist_match_fn = RTE_DIST_MATCH_AVX512;
+#endif
 #endif
 
 	/*
@@ -17,10 +17,17 @@
 extern "C" {
 #endif
 
-/* Type of distribution (burst/single) */
+/* Type of distribution (burst/single/burst with flow hash) */
 enum rte_distributor_alg_type {
 	RTE_DIST_ALG_BURST = 0,
 	RTE_DIST_ALG_SINGLE,
+	/**
+	 * Burst API, with each flow given to the worker picked by a consistent
+	 * hash of its tag, instead of the worker already processing the flow.
+	 * No tags are compared, and the flows only move when workers join or
+	 * leave.
+	 */
+	RTE_DIST_ALG_BURST_HASH,
 	RTE_DIST_NUM_ALG_TYPES
 };
 
@@ -44,6 +51,7 @@ struct rte_mbuf;
  *   Call the legacy API, or use the new burst API. legacy uses 32-bit
  *   flow ID, and works on a single packet at a time. Latest uses 15-
  *   bit flow ID and works on up to 8 packets at a time to workers.
+ *   The burst API with flow hash uses 32-bit flow ID.
  * @return
  *   The newly created distributor instance
  */
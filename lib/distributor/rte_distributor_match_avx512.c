@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <rte_mbuf.h>
+#include <rte_vect.h>
+#include "distributor_private.h"
+
+
+/* Number of worker pairs compared with each flow per iteration */
+#define MATCH_PAIRS 4
+
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr)
+{
+	/* Setup */
+	__m512i incoming_fids[RTE_DIST_BURST_SIZE];
+	__m512i worker_fids[MATCH_PAIRS];
+	__mmask32 valid[MATCH_PAIRS], mask[MATCH_PAIRS];
+	uint32_t pending;
+	uint64_t hi, lo, hit;
+	uint16_t j, k, p, w;
+
+	/*
+	 * Function overview:
+	 * 1. Broadcast each incoming flow id into its own zmm reg
+	 * 2. Loop through the worker pairs MATCH_PAIRS at a time, from the
+	 *    last one, each pair having the inflights and backlog of both
+	 *    workers adjacent in memory
+	 *  2a. Compare each flow id with all of them, with one compare
+	 *      per pair
+	 *  2b. For each flow not matched yet, add the match of the latest
+	 *      worker to the output, the upper half of a mask belonging
+	 *      to the second worker of the pair
+	 * 3. Stop once every flow is matched
+	 *
+	 * Going backwards, the first match of a flow is the one the scalar
+	 * version keeps. The compares stay linear in the number of workers:
+	 * only the burst pinned to the latest workers finishes early.
+	 */
+
+	for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+		incoming_fids[j] = _mm512_set1_epi16(data_ptr[j]);
+		output_ptr[j] = 0;
+	}
+
+	pending = (1U << RTE_DIST_BURST_SIZE) - 1;
+
+	for (p = (d->num_workers + 1) / 2; p != 0 && pending != 0;
+			p -= RTE_MIN(p, MATCH_PAIRS)) {
+
+		for (k = 0; k < MATCH_PAIRS; k++) {
+			if (k >= p) {
+				worker_fids[k] = _mm512_setzero_si512();
+				valid[k] = 0;
+				continue;
+			}
+
+			w = (p - 1 - k) * 2;
+			worker_fids[k] = _mm512_load_si512(&d->in_flight_tags[w][0]);
+
+			/* Ignore the tags past the last worker */
+			valid[k] = (w + 1U < d->num_workers) ?
+					UINT32_MAX : UINT16_MAX;
+		}
+
+		for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+			for (k = 0; k < MATCH_PAIRS; k++)
+				mask[k] = _mm512_mask_cmpeq_epi16_mask(valid[k],
+						worker_fids[k], incoming_fids[j]);
+
+			/* Latest pair in the upper bits, latest worker first */
+			hi = (uint64_t)mask[0] << 32 | mask[1];
+			lo = (uint64_t)mask[2] << 32 | mask[3];
+			w = (hi != 0) ? p - 1 : p - 3;
+			hit = (hi != 0) ? hi : lo;
+
+			/* Only keep the first match of the flow */
+			if (hit == 0 || (pending & (1U << j)) == 0)
+				continue;
+
+			k = 63 - rte_clz64(hit);
+			output_ptr[j] = (w - 1 + (k >> 5)) * 2 + 1 +
+					((k >> 4) & 1);
+			pending &= ~(1U << j);
+		}
+	}
+
+	/*
+	 * At this stage, the output contains 8 16-bit values, with
+	 * each non-zero value containing the worker ID on which the
+	 * corresponding flow is pinned to.
+	 */
+}
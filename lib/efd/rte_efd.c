@@ -19,6 +19,7 @@
 #include <rte_branch_prediction.h>
 #include <rte_memcpy.h>
 #include <rte_ring.h>
+#include <rte_stdatomic.h>
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
 #include <rte_tailq.h>
@@ -253,9 +254,12 @@ struct rte_efd_table {
 	enum efd_lookup_internal_function lookup_fn;
 	/**< Indicates which lookup function to use. */
 
-	struct efd_online_chunk *chunks[RTE_MAX_NUMA_NODES];
+	RTE_ATOMIC(struct efd_online_chunk *) chunks[RTE_MAX_NUMA_NODES];
 	/**< Dynamic array of size num_chunks of chunk records. */
 
+	struct efd_online_chunk *standby[RTE_MAX_NUMA_NODES];
+	/**< With RCU, copies of the online tables, updated while not looked up. */
+
 	struct efd_offline_chunk_rules *offline_chunks;
 	/**< Dynamic array of size num_chunks of key-value pairs. */
 
@@ -263,6 +267,22 @@ struct rte_efd_table {
 	/**< Ring that stores all indexes of the free slots in the key table */
 
 	uint8_t *keys; /**< Dynamic array of size max_num_rules of keys */
+
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable, NULL if not used. */
+
+	enum rte_efd_qsbr_mode rcu_mode; /**< Mode of RCU QSBR. */
+
+	uint64_t rcu_token;
+	/**< Token of the last online tables swap, to wait for their readers. */
+
+	uint32_t num_dirty;
+	/**< Number of chunks differing between online and standby tables. */
+
+	uint32_t *dirty_chunks;
+	/**< Dynamic array of size num_chunks of the differing chunk IDs. */
+
+	uint8_t *chunk_dirty;
+	/**< Dynamic array of size num_chunks, set for the differing chunks. */
 };
 
 /**
@@ -303,10 +323,8 @@ efd_get_bin_id(const struct rte_efd_table * const table,
 /**
  * Looks up the current permutation choice for a particular bin in the online table
  *
- * @param table
- *  EFD table to reference
- * @param socket_id
- *   Socket ID to use to look up existing values (ideally caller's socket id)
+ * @param chunks
+ *   Online table to reference
  * @param chunk_id
  *   Chunk ID of bin to look up
  * @param bin_id
@@ -316,11 +334,10 @@ efd_get_bin_id(const struct rte_efd_table * const table,
  *   Currently active permutation choice in the online table
  */
 static inline uint8_t
-efd_get_choice(const struct rte_efd_table * const table,
-		const unsigned int socket_id, const uint32_t chunk_id,
-		const uint32_t bin_id)
+efd_get_choice(const struct efd_online_chunk * const chunks,
+		const uint32_t chunk_id, const uint32_t bin_id)
 {
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
+	const struct efd_online_chunk *chunk = &chunks[chunk_id];
 
 	/*
 	 * Grab the chunk (byte) that contains the choices
@@ -339,6 +356,28 @@ efd_get_choice(const struct rte_efd_table * const table,
 	return (uint8_t) ((choice_chunk >> offset) & 0x3);
 }
 
+/**
+ * Returns the online table to apply updates to, which is only looked up
+ * once the updates are complete when RCU is used.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID of the online table
+ *
+ * @return
+ *   Online table to update
+ */
+static inline struct efd_online_chunk *
+efd_writer_chunks(const struct rte_efd_table * const table,
+		const unsigned int socket_id)
+{
+	if (table->v != NULL)
+		return table->standby[socket_id];
+
+	return table->chunks[socket_id];
+}
+
 /**
  * Compute the chunk_id and bin_id for a given key
  *
@@ -756,8 +795,10 @@ rte_efd_free(struct rte_efd_table *table)
 	if (table == NULL)
 		return;
 
-	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
 		rte_free(table->chunks[socket_id]);
+		rte_free(table->standby[socket_id]);
+	}
 
 	efd_list = RTE_TAILQ_CAST(rte_efd_tailq.head, rte_efd_list);
 	rte_mcfg_tailq_write_lock();
@@ -774,12 +815,14 @@ rte_efd_free(struct rte_efd_table *table)
 	rte_ring_free(table->free_slots);
 	rte_free(table->offline_chunks);
 	rte_free(table->keys);
+	rte_free(table->dirty_chunks);
+	rte_free(table->chunk_dirty);
 	rte_free(table);
 }
 
 /**
  * Applies a previously computed table entry to the specified table for all
- * socket-local copies of the online table.
+ * socket-local copies of the online table, or of the standby table with RCU.
  * Intended to apply an update for only a single change
  * to a key/value pair at a time
  *
@@ -805,7 +848,9 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 		const struct efd_online_group_entry * const new_group_entry)
 {
 	int i;
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
+	struct efd_online_chunk *chunks;
+	struct efd_online_chunk *chunk =
+			&efd_writer_chunks(table, socket_id)[chunk_id];
 	uint8_t bin_index = bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
 
 	/*
@@ -825,14 +870,21 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 
 	/* Update the online table with the new data across all sockets */
 	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
-		if (table->chunks[i] != NULL) {
-			memcpy(&(table->chunks[i][chunk_id].groups[group_id]),
+		chunks = efd_writer_chunks(table, i);
+		if (chunks != NULL) {
+			memcpy(&(chunks[chunk_id].groups[group_id]),
 					new_group_entry,
 					sizeof(struct efd_online_group_entry));
-			table->chunks[i][chunk_id].bin_choice_list[bin_index] =
+			chunks[chunk_id].bin_choice_list[bin_index] =
 					choice_chunk;
 		}
 	}
+
+	/* Standby chunk to copy again once published */
+	if (table->v != NULL && table->chunk_dirty[chunk_id] == 0) {
+		table->chunk_dirty[chunk_id] = 1;
+		table->dirty_chunks[table->num_dirty++] = chunk_id;
+	}
 }
 
 /*
@@ -980,8 +1032,8 @@ efd_compute_update(struct rte_efd_table * const table,
 			&table->offline_chunks[*chunk_id];
 	struct efd_offline_group_rules *new_group;
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
-			*chunk_id, *bin_id);
+	uint8_t current_choice = efd_get_choice(
+			efd_writer_chunks(table, socket_id), *chunk_id, *bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][*bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
@@ -1162,8 +1214,65 @@ efd_compute_update(struct rte_efd_table * const table,
 	return RTE_EFD_UPDATE_FAILED;
 }
 
-int
-rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+/*
+ * Wait for the lookups of the online tables replaced by the last update to
+ * complete, then copy the updated chunks to them.
+ */
+static void
+efd_rcu_sync(struct rte_efd_table * const table)
+{
+	uint32_t i, chunk_id;
+	int socket_id;
+
+	if (table->num_dirty == 0)
+		return;
+
+	rte_rcu_qsbr_check(table->v, table->rcu_token, true);
+
+	for (i = 0; i < table->num_dirty; i++) {
+		chunk_id = table->dirty_chunks[i];
+		for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+			if (table->standby[socket_id] == NULL)
+				continue;
+			memcpy(&table->standby[socket_id][chunk_id],
+					&table->chunks[socket_id][chunk_id],
+					sizeof(struct efd_online_chunk));
+		}
+		table->chunk_dirty[chunk_id] = 0;
+	}
+	table->num_dirty = 0;
+}
+
+/*
+ * Swap the online tables with the updated standby ones. Lookups started
+ * before keep using the previous tables, which are not modified until then.
+ */
+static void
+efd_rcu_publish(struct rte_efd_table * const table)
+{
+	struct efd_online_chunk *chunks;
+	int socket_id;
+
+	if (table->num_dirty == 0)
+		return;
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		if (table->standby[socket_id] == NULL)
+			continue;
+		chunks = table->chunks[socket_id];
+		rte_atomic_store_explicit(&table->chunks[socket_id],
+				table->standby[socket_id], rte_memory_order_release);
+		table->standby[socket_id] = chunks;
+	}
+
+	table->rcu_token = rte_rcu_qsbr_start(table->v);
+
+	if (table->rcu_mode == RTE_EFD_QSBR_MODE_SYNC)
+		efd_rcu_sync(table);
+}
+
+static int
+efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 		const void *key, const efd_value_t value)
 {
 	uint32_t chunk_id = 0, group_id = 0, bin_id = 0;
@@ -1185,6 +1294,43 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 	return status;
 }
 
+int
+rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+		const void *key, const efd_value_t value)
+{
+	int status;
+
+	rte_efd_update_bulk(table, socket_id, 1, &key, &value, &status);
+
+	return status;
+}
+
+int
+rte_efd_update_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const int num_keys,
+		const void **key_list, const efd_value_t *value_list,
+		int * const status)
+{
+	int i, ret, num_failed = 0;
+
+	/* Groups are rebuilt in the standby tables, then published at once */
+	if (table->v != NULL)
+		efd_rcu_sync(table);
+
+	for (i = 0; i < num_keys; i++) {
+		ret = efd_update(table, socket_id, key_list[i], value_list[i]);
+		if (status != NULL)
+			status[i] = ret;
+		if (ret == RTE_EFD_UPDATE_FAILED)
+			num_failed++;
+	}
+
+	if (table->v != NULL)
+		efd_rcu_publish(table);
+
+	return num_failed;
+}
+
 int
 rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 		const void *key, efd_value_t * const prev_value)
@@ -1198,7 +1344,8 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	struct efd_offline_chunk_rules * const chunk =
 			&table->offline_chunks[chunk_id];
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
+	/* Deletes leave the online tables unchanged */
+	uint8_t current_choice = efd_get_choice(table->chunks[socket_id],
 			chunk_id, bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
 	struct efd_offline_group_rules * const current_group =
@@ -1308,11 +1455,12 @@ rte_efd_lookup(const struct rte_efd_table * const table,
 	uint32_t chunk_id, group_id, bin_id;
 	uint8_t bin_choice;
 	const struct efd_online_group_entry *group;
-	const struct efd_online_chunk * const chunks = table->chunks[socket_id];
+	const struct efd_online_chunk * const chunks = rte_atomic_load_explicit(
+			&table->chunks[socket_id], rte_memory_order_acquire);
 
 	/* Determine the chunk and group location for the given key */
 	efd_compute_ids(table, key, &chunk_id, &bin_id);
-	bin_choice = efd_get_choice(table, socket_id, chunk_id, bin_id);
+	bin_choice = efd_get_choice(chunks, chunk_id, bin_id);
 	group_id = efd_bin_to_group[bin_choice][bin_id];
 	group = &chunks[chunk_id].groups[group_id];
 
@@ -1331,9 +1479,10 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	uint32_t bin_id_list[RTE_EFD_BURST_MAX];
 	uint8_t bin_choice_list[RTE_EFD_BURST_MAX];
 	uint32_t group_id_list[RTE_EFD_BURST_MAX];
-	struct efd_online_group_entry *group;
+	const struct efd_online_group_entry *group;
 
-	struct efd_online_chunk *chunks = table->chunks[socket_id];
+	const struct efd_online_chunk * const chunks = rte_atomic_load_explicit(
+			&table->chunks[socket_id], rte_memory_order_acquire);
 
 	for (i = 0; i < num_keys; i++) {
 		efd_compute_ids(table, key_list[i], &chunk_id_list[i],
@@ -1342,7 +1491,7 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	}
 
 	for (i = 0; i < num_keys; i++) {
-		bin_choice_list[i] = efd_get_choice(table, socket_id,
+		bin_choice_list[i] = efd_get_choice(chunks,
 				chunk_id_list[i], bin_id_list[i]);
 		group_id_list[i] =
 				efd_bin_to_group[bin_choice_list[i]][bin_id_list[i]];
@@ -1358,3 +1507,64 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 				table->lookup_fn);
 	}
 }
+
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+		struct rte_efd_rcu_config *cfg)
+{
+	uint64_t online_table_size;
+	int socket_id;
+
+	if (table == NULL || cfg == NULL || cfg->v == NULL)
+		return -EINVAL;
+
+	if (table->v != NULL)
+		return -EEXIST;
+
+	if (cfg->mode != RTE_EFD_QSBR_MODE_DQ &&
+			cfg->mode != RTE_EFD_QSBR_MODE_SYNC)
+		return -EINVAL;
+
+	table->dirty_chunks = rte_zmalloc(NULL,
+			table->num_chunks * sizeof(uint32_t), 0);
+	table->chunk_dirty = rte_zmalloc(NULL, table->num_chunks, 0);
+	if (table->dirty_chunks == NULL || table->chunk_dirty == NULL)
+		goto error;
+
+	/* Standby copy of each online table, on the same socket */
+	online_table_size = table->num_chunks * sizeof(struct efd_online_chunk) +
+			EFD_NUM_CHUNK_PADDING_BYTES;
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		if (table->chunks[socket_id] == NULL)
+			continue;
+
+		table->standby[socket_id] = rte_zmalloc_socket(NULL,
+				online_table_size, RTE_CACHE_LINE_SIZE, socket_id);
+		if (table->standby[socket_id] == NULL) {
+			EFD_LOG(ERR, "Allocating EFD standby table on "
+					"socket %u failed", socket_id);
+			goto error;
+		}
+		memcpy(table->standby[socket_id], table->chunks[socket_id],
+				online_table_size);
+	}
+
+	table->num_dirty = 0;
+	table->rcu_mode = cfg->mode;
+	table->v = cfg->v;
+
+	return 0;
+
+error:
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		rte_free(table->standby[socket_id]);
+		table->standby[socket_id] = NULL;
+	}
+	rte_free(table->dirty_chunks);
+	rte_free(table->chunk_dirty);
+	table->dirty_chunks = NULL;
+	table->chunk_dirty = NULL;
+
+	return -ENOMEM;
+}
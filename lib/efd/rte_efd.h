@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -116,6 +119,24 @@ typedef uint32_t efd_value_t;
 typedef uint16_t efd_lookuptbl_t;
 typedef uint16_t efd_hashfunc_t;
 
+/** RCU reclamation modes */
+enum rte_efd_qsbr_mode {
+	/** Wait for the readers of the previous online tables on next update. */
+	RTE_EFD_QSBR_MODE_DQ = 0,
+	/** Wait for the readers of the previous online tables on each update. */
+	RTE_EFD_QSBR_MODE_SYNC
+};
+
+/** EFD RCU QSBR configuration structure. */
+struct rte_efd_rcu_config {
+	/** RCU QSBR variable. */
+	struct rte_rcu_qsbr *v;
+	/** Mode of RCU QSBR. See RTE_EFD_QSBR_MODE_xxx.
+	 * Default: RTE_EFD_QSBR_MODE_DQ.
+	 */
+	enum rte_efd_qsbr_mode mode;
+};
+
 /**
  * Creates an EFD table with a single offline region and multiple per-socket
  * internally-managed copies of the online table used for lookups
@@ -174,6 +195,8 @@ rte_efd_find_existing(const char *name);
  * all socket-local copies of the chunks are updated.
  * This operation is not multi-thread safe
  * and should only be called one from thread.
+ * Lookups done concurrently may return wrong values for other keys,
+ * unless a RCU QSBR variable is associated with the table.
  *
  * @param table
  *   EFD table to reference
@@ -201,6 +224,40 @@ int
 rte_efd_update(struct rte_efd_table *table, unsigned int socket_id,
 	const void *key, efd_value_t value);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Computes updated table entries for several key/value pairs, and applies
+ * them to all socket-local copies of the chunks.
+ * When a RCU QSBR variable is associated with the table, the updates are
+ * applied to other copies of the online tables, which replace the ones being
+ * looked up once all the keys are processed.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread.
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID to use to lookup existing value (ideally caller's socket id)
+ * @param num_keys
+ *   Number of keys in the key_list and value_list arrays
+ * @param key_list
+ *   Array of num_keys pointers to the keys to modify
+ * @param value_list
+ *   Array of num_keys values to associate with the keys
+ * @param status
+ *   Array of num_keys statuses, as returned by rte_efd_update() for each key.
+ *   Can be NULL.
+ * @return
+ *   Number of keys which could not be updated, i.e. with
+ *   RTE_EFD_UPDATE_FAILED status.
+ */
+__rte_experimental
+int
+rte_efd_update_bulk(struct rte_efd_table *table, unsigned int socket_id,
+	int num_keys, const void **key_list, const efd_value_t *value_list,
+	int *status);
+
 /**
  * Removes any value currently associated with the specified key from the table
  * This operation is not multi-thread safe
@@ -273,6 +330,35 @@ rte_efd_lookup_bulk(const struct rte_efd_table *table, unsigned int socket_id,
 		int num_keys, const void **key_list,
 		efd_value_t *value_list);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU QSBR variable with an EFD table.
+ *
+ * Updates are then done on a second copy of each online table, allocated on
+ * the same socket, and published once complete. Lookups done concurrently
+ * see the table either before or after the update, the lookup threads
+ * reporting their quiescent state to the RCU QSBR variable.
+ * This operation is not multi-thread safe with updates.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EEXIST - already added QSBR
+ *   - -ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+	struct rte_efd_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
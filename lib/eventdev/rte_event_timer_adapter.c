@@ -16,6 +16,7 @@
 #include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_common.h>
+#include <rte_spinlock.h>
 #include <rte_timer.h>
 #include <rte_service_component.h>
 #include <rte_telemetry.h>
@@ -40,6 +41,7 @@ RTE_LOG_REGISTER_SUFFIX(evtim_svc_logtype, adapter.timer.svc, NOTICE);
 static struct rte_event_timer_adapter *adapters;
 
 static const struct event_timer_adapter_ops swtim_ops;
+static const struct event_timer_adapter_ops swtw_ops;
 
 #define EVTIM_LOG(level, logtype, ...) \
 	RTE_LOG_LINE_PREFIX(level, logtype, \
@@ -238,7 +240,9 @@ rte_event_timer_adapter_create_ext(
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = (adapter->data->conf.flags &
+				RTE_EVENT_TIMER_ADAPTER_F_TIMING_WHEEL) ?
+				&swtw_ops : &swtim_ops;
 
 	/* Allow driver to do some setup */
 	FUNC_PTR_OR_NULL_RET_WITH_ERRNO(adapter->ops->init, ENOTSUP);
@@ -383,7 +387,9 @@ rte_event_timer_adapter_lookup(uint16_t adapter_id)
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = (adapter->data->conf.flags &
+				RTE_EVENT_TIMER_ADAPTER_F_TIMING_WHEEL) ?
+				&swtw_ops : &swtim_ops;
 
 	/* Set fast-path function pointers */
 	adapter->arm_burst = adapter->ops->arm_burst;
@@ -1384,6 +1390,785 @@ static const struct event_timer_adapter_ops swtim_ops = {
 	.remaining_ticks_get = swtim_remaining_ticks_get,
 };
 
+/*
+ * Timing wheel software event timer adapter implementation
+ *
+ * Each arming lcore owns a hierarchical timing wheel of SWTW_LEVELS levels of
+ * SWTW_SLOTS slots, where level L slots cover SWTW_SLOTS^L adapter ticks. A
+ * timer is linked in the slot of the lowest level able to tell its expiry
+ * tick apart from the current one, and moved down a level each time the
+ * wheel reaches the start of its slot, until it expires from level 0. The
+ * wheel lock is only contended between the owner lcore and the service core,
+ * or by lcores cancelling timers armed on another lcore.
+ */
+#define SWTW_LEVELS 4
+#define SWTW_SLOT_BITS 8
+#define SWTW_SLOTS (1 << SWTW_SLOT_BITS)
+#define SWTW_SLOT_MASK (SWTW_SLOTS - 1)
+#define SWTW_RANGE_TICKS (UINT64_C(1) << (SWTW_LEVELS * SWTW_SLOT_BITS))
+/* Wheel shared by all non-EAL threads */
+#define SWTW_NON_EAL_WHEEL (RTE_MAX_LCORE - 1)
+
+struct swtw_wheel;
+
+struct swtw_timer {
+	struct swtw_timer *next;
+	struct swtw_timer **pprev;
+	/* Adapter tick at which the timer expires */
+	uint64_t expiry_tick;
+	/* Period in adapter ticks of a periodic timer */
+	uint64_t period_ticks;
+	struct rte_event_timer *evtim;
+	struct swtw_wheel *wheel;
+};
+
+struct __rte_cache_aligned swtw_wheel {
+	rte_spinlock_t lock;
+	/* The last adapter tick processed */
+	uint64_t cur_tick;
+	uint32_t nb_timers;
+	struct swtw_timer *slots[SWTW_LEVELS][SWTW_SLOTS];
+};
+
+struct swtw {
+	/* Identifier of service executing timer management logic. */
+	uint32_t service_id;
+	/* The tick resolution used by adapter instance. */
+	uint64_t timer_tick_ns;
+	/* Maximum timeout in nanoseconds allowed by adapter instance. */
+	uint64_t max_tmo_ns;
+	/* Adapter tick 0 in timer cycles */
+	uint64_t start_cycles;
+	uint64_t cycles_per_tick;
+	struct rte_reciprocal_u64 cycles_per_tick_inverse;
+	/* The last adapter tick the service function processed */
+	uint64_t last_tick;
+	bool periodic;
+	/* Buffered timer expiry events to be enqueued to an event device. */
+	struct event_buffer buffer;
+	/* Statistics */
+	struct rte_event_timer_adapter_stats stats;
+	/* Mempool of timer objects */
+	struct rte_mempool *tim_pool;
+	/* Back pointer for convenience */
+	struct rte_event_timer_adapter *adapter;
+	/* Timing wheel of each lcore, allocated when it first arms a timer */
+	RTE_ATOMIC(struct swtw_wheel *) wheels[RTE_MAX_LCORE];
+	/* Track which cores' wheels should be polled */
+	RTE_ATOMIC(unsigned int) poll_lcores[RTE_MAX_LCORE];
+	/* The number of wheels that should be polled */
+	RTE_ATOMIC(int) n_poll_lcores;
+	/* Timers which have expired and can be returned to a mempool */
+	struct swtw_timer *expired_timers[EXP_TIM_BUF_SZ];
+	/* The number of timers that can be returned to a mempool */
+	size_t n_expired_timers;
+};
+
+static inline struct swtw *
+swtw_pmd_priv(const struct rte_event_timer_adapter *adapter)
+{
+	return adapter->data->adapter_priv;
+}
+
+static inline uint64_t
+swtw_now_tick(const struct swtw *sw)
+{
+	return rte_reciprocal_divide_u64(rte_get_timer_cycles() -
+					 sw->start_cycles,
+					 &sw->cycles_per_tick_inverse);
+}
+
+/* Link a timer expiring at or after base, the first tick yet to process. */
+static void
+swtw_wheel_link(struct swtw_wheel *wheel, struct swtw_timer *tim,
+		uint64_t base)
+{
+	uint64_t expiry = RTE_MAX(tim->expiry_tick, base);
+	uint64_t delta = expiry - base;
+	struct swtw_timer **head;
+	unsigned int level;
+	unsigned int slot;
+
+	if (unlikely(delta >= SWTW_RANGE_TICKS)) {
+		/* Park it in the top level slot reached last, it is linked
+		 * again from there once within range.
+		 */
+		level = SWTW_LEVELS - 1;
+		slot = ((base >> (level * SWTW_SLOT_BITS)) - 1) &
+			SWTW_SLOT_MASK;
+	} else {
+		level = delta == 0 ? 0 :
+			(rte_fls_u64(delta) - 1) / SWTW_SLOT_BITS;
+		slot = (expiry >> (level * SWTW_SLOT_BITS)) & SWTW_SLOT_MASK;
+	}
+
+	head = &wheel->slots[level][slot];
+	tim->next = *head;
+	if (tim->next != NULL)
+		tim->next->pprev = &tim->next;
+	tim->pprev = head;
+	*head = tim;
+
+	wheel->nb_timers++;
+}
+
+static void
+swtw_wheel_unlink(struct swtw_wheel *wheel, struct swtw_timer *tim)
+{
+	*tim->pprev = tim->next;
+	if (tim->next != NULL)
+		tim->next->pprev = tim->pprev;
+
+	wheel->nb_timers--;
+}
+
+static inline struct swtw_timer *
+swtw_wheel_detach_slot(struct swtw_wheel *wheel, unsigned int level,
+		       unsigned int slot)
+{
+	struct swtw_timer *list = wheel->slots[level][slot];
+
+	wheel->slots[level][slot] = NULL;
+
+	return list;
+}
+
+static void
+swtw_expire_timer(struct swtw *sw, struct swtw_wheel *wheel,
+		  struct swtw_timer *tim, uint64_t tick)
+{
+	struct rte_event_timer *evtim = tim->evtim;
+
+	if (unlikely(event_buffer_add(&sw->buffer, &evtim->ev) < 0)) {
+		if (!sw->periodic) {
+			/* Retry on the next tick, once the buffer has been
+			 * flushed.
+			 */
+			tim->expiry_tick = tick + 1;
+			swtw_wheel_link(wheel, tim, tick + 1);
+			sw->stats.evtim_retry_count++;
+			return;
+		}
+		sw->stats.evtim_drop_count++;
+	} else {
+		sw->stats.evtim_exp_count++;
+	}
+
+	if (sw->periodic) {
+		tim->expiry_tick += tim->period_ticks;
+		swtw_wheel_link(wheel, tim, tick + 1);
+		return;
+	}
+
+	if (unlikely(sw->n_expired_timers == EXP_TIM_BUF_SZ)) {
+		rte_mempool_put_bulk(sw->tim_pool, (void **)sw->expired_timers,
+				     sw->n_expired_timers);
+		sw->n_expired_timers = 0;
+	}
+	sw->expired_timers[sw->n_expired_timers++] = tim;
+
+	rte_atomic_store_explicit(&evtim->state, RTE_EVENT_TIMER_NOT_ARMED,
+				  rte_memory_order_release);
+}
+
+/* Process the wheel ticks up to now_tick, returns false if it had to stop
+ * early because the event buffer is full.
+ */
+static bool
+swtw_wheel_advance(struct swtw *sw, struct swtw_wheel *wheel,
+		   uint64_t now_tick)
+{
+	while (wheel->cur_tick < now_tick) {
+		uint64_t tick = wheel->cur_tick + 1;
+		struct swtw_timer *tim, *next;
+		int level;
+
+		if (wheel->nb_timers == 0) {
+			wheel->cur_tick = now_tick;
+			break;
+		}
+
+		/* Move the timers of the slots starting at this tick down */
+		for (level = SWTW_LEVELS - 1; level > 0; level--) {
+			unsigned int shift = level * SWTW_SLOT_BITS;
+
+			if ((tick & ((UINT64_C(1) << shift) - 1)) != 0)
+				continue;
+
+			tim = swtw_wheel_detach_slot(wheel, level,
+					(tick >> shift) & SWTW_SLOT_MASK);
+			for (; tim != NULL; tim = next) {
+				next = tim->next;
+				wheel->nb_timers--;
+				swtw_wheel_link(wheel, tim, tick);
+			}
+		}
+
+		tim = swtw_wheel_detach_slot(wheel, 0, tick & SWTW_SLOT_MASK);
+		for (; tim != NULL; tim = next) {
+			next = tim->next;
+			wheel->nb_timers--;
+			swtw_expire_timer(sw, wheel, tim, tick);
+		}
+
+		wheel->cur_tick = tick;
+
+		if (event_buffer_full(&sw->buffer))
+			return false;
+	}
+
+	return true;
+}
+
+static void
+swtw_buffer_flush(struct swtw *sw)
+{
+	struct rte_event_timer_adapter *adapter = sw->adapter;
+	uint16_t nb_evs_flushed;
+	uint16_t nb_evs_invalid;
+
+	/* Enqueue the expiry events in bursts until the buffer is empty or
+	 * the event device does not take any more.
+	 */
+	do {
+		nb_evs_flushed = 0;
+		nb_evs_invalid = 0;
+
+		event_buffer_flush(&sw->buffer,
+				   adapter->data->event_dev_id,
+				   adapter->data->event_port_id,
+				   &nb_evs_flushed,
+				   &nb_evs_invalid);
+
+		sw->stats.ev_enq_count += nb_evs_flushed;
+		sw->stats.ev_inv_count += nb_evs_invalid;
+	} while (nb_evs_flushed + nb_evs_invalid > 0);
+}
+
+static int
+swtw_service_func(void *arg)
+{
+	struct rte_event_timer_adapter *adapter = arg;
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	const uint64_t prior_enq_count = sw->stats.ev_enq_count;
+	uint64_t now_tick = swtw_now_tick(sw);
+	int n_lcores;
+	int i;
+
+	if (now_tick != sw->last_tick) {
+		bool done = true;
+
+		n_lcores = rte_atomic_load_explicit(&sw->n_poll_lcores,
+						    rte_memory_order_acquire);
+
+		for (i = 0; i < n_lcores; i++) {
+			unsigned int lcore_id;
+			struct swtw_wheel *wheel;
+
+			lcore_id = rte_atomic_load_explicit(&sw->poll_lcores[i],
+						rte_memory_order_relaxed);
+			wheel = rte_atomic_load_explicit(&sw->wheels[lcore_id],
+						rte_memory_order_acquire);
+			if (wheel == NULL)
+				continue;
+
+			rte_spinlock_lock(&wheel->lock);
+			if (!swtw_wheel_advance(sw, wheel, now_tick))
+				done = false;
+			rte_spinlock_unlock(&wheel->lock);
+
+			/* Enqueue outside of the lock to not hold up arming */
+			swtw_buffer_flush(sw);
+		}
+
+		/* Return expired timer objects back to mempool */
+		rte_mempool_put_bulk(sw->tim_pool, (void **)sw->expired_timers,
+				     sw->n_expired_timers);
+		sw->n_expired_timers = 0;
+
+		/* Wheels stopped early are advanced again on the next call */
+		if (done) {
+			sw->last_tick = now_tick;
+			sw->stats.adapter_tick_count++;
+		}
+	}
+
+	swtw_buffer_flush(sw);
+
+	rte_event_maintain(adapter->data->event_dev_id,
+			   adapter->data->event_port_id, 0);
+
+	return prior_enq_count == sw->stats.ev_enq_count ? -EAGAIN : 0;
+}
+
+static struct swtw_wheel *
+swtw_wheel_get(struct swtw *sw, unsigned int lcore_id)
+{
+	struct swtw_wheel *wheel, *expected = NULL;
+	int n_lcores;
+
+	wheel = rte_atomic_load_explicit(&sw->wheels[lcore_id],
+					 rte_memory_order_acquire);
+	if (likely(wheel != NULL))
+		return wheel;
+
+	wheel = rte_zmalloc_socket("swtw_wheel", sizeof(*wheel),
+				   RTE_CACHE_LINE_SIZE,
+				   sw->adapter->data->socket_id);
+	if (wheel == NULL)
+		return NULL;
+
+	rte_spinlock_init(&wheel->lock);
+	wheel->cur_tick = swtw_now_tick(sw);
+
+	/* Non-EAL threads share a wheel and may race to allocate it. */
+	if (!rte_atomic_compare_exchange_strong_explicit(&sw->wheels[lcore_id],
+			&expected, wheel, rte_memory_order_release,
+			rte_memory_order_acquire)) {
+		rte_free(wheel);
+		return expected;
+	}
+
+	EVTIM_LOG_DBG("Adding lcore id = %u to list of lcores to poll",
+		      lcore_id);
+	n_lcores = rte_atomic_fetch_add_explicit(&sw->n_poll_lcores, 1,
+						 rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&sw->poll_lcores[n_lcores], lcore_id,
+				  rte_memory_order_relaxed);
+
+	return wheel;
+}
+
+static int
+swtw_init(struct rte_event_timer_adapter *adapter)
+{
+	int ret;
+	struct swtw *sw;
+	struct rte_service_spec service;
+	char swtw_name[SWTIM_NAMESIZE];
+
+	snprintf(swtw_name, SWTIM_NAMESIZE, "swtw_%"PRIu8, adapter->data->id);
+	sw = rte_zmalloc_socket(swtw_name, sizeof(*sw), RTE_CACHE_LINE_SIZE,
+			adapter->data->socket_id);
+	if (sw == NULL) {
+		EVTIM_LOG_ERR("failed to allocate space for private data");
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	adapter->data->adapter_priv = sw;
+	sw->adapter = adapter;
+
+	sw->timer_tick_ns = adapter->data->conf.timer_tick_ns;
+	sw->max_tmo_ns = adapter->data->conf.max_tmo_ns;
+	sw->periodic = get_timer_type(adapter) == PERIODICAL;
+	sw->cycles_per_tick = RTE_MAX((uint64_t)(sw->timer_tick_ns *
+					(rte_get_timer_hz() / NSECPERSEC)),
+				      UINT64_C(1));
+	sw->cycles_per_tick_inverse =
+		rte_reciprocal_value_u64(sw->cycles_per_tick);
+	sw->start_cycles = rte_get_timer_cycles();
+
+	char pool_name[SWTIM_NAMESIZE];
+	snprintf(pool_name, SWTIM_NAMESIZE, "swtw_pool_%"PRIu8,
+		 adapter->data->id);
+	/* Optimal mempool size is a power of 2 minus one */
+	uint64_t nb_timers = rte_align64pow2(adapter->data->conf.nb_timers);
+	int pool_size = nb_timers - 1;
+	int cache_size = compute_msg_mempool_cache_size(
+				adapter->data->conf.nb_timers, nb_timers);
+	sw->tim_pool = rte_mempool_create(pool_name, pool_size,
+			sizeof(struct swtw_timer), cache_size, 0, NULL, NULL,
+			NULL, NULL, adapter->data->socket_id, 0);
+	if (sw->tim_pool == NULL) {
+		EVTIM_LOG_ERR("failed to create timer object mempool");
+		rte_errno = ENOMEM;
+		goto free_alloc;
+	}
+
+	event_buffer_init(&sw->buffer);
+
+	memset(&service, 0, sizeof(service));
+	snprintf(service.name, RTE_SERVICE_NAME_MAX,
+		 "swtim_svc_%"PRIu8, adapter->data->id);
+	service.socket_id = adapter->data->socket_id;
+	service.callback = swtw_service_func;
+	service.callback_userdata = adapter;
+	service.capabilities &= ~(RTE_SERVICE_CAP_MT_SAFE);
+	ret = rte_service_component_register(&service, &sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to register service %s with id %"PRIu32
+			      ": err = %d", service.name, sw->service_id,
+			      ret);
+
+		rte_errno = ENOSPC;
+		goto free_mempool;
+	}
+
+	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
+		      sw->service_id);
+
+	adapter->data->service_id = sw->service_id;
+	adapter->data->service_inited = 1;
+
+	return 0;
+free_mempool:
+	rte_mempool_free(sw->tim_pool);
+free_alloc:
+	rte_free(sw);
+	return -1;
+}
+
+static int
+swtw_uninit(struct rte_event_timer_adapter *adapter)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	unsigned int lcore_id;
+	int ret;
+
+	ret = rte_service_component_unregister(sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to unregister service component");
+		return ret;
+	}
+
+	/* Free outstanding timers */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct swtw_wheel *wheel = sw->wheels[lcore_id];
+		unsigned int level, slot;
+
+		if (wheel == NULL)
+			continue;
+
+		for (level = 0; level < SWTW_LEVELS; level++) {
+			for (slot = 0; slot < SWTW_SLOTS; slot++) {
+				struct swtw_timer *tim, *next;
+
+				tim = wheel->slots[level][slot];
+				for (; tim != NULL; tim = next) {
+					next = tim->next;
+					rte_mempool_put(sw->tim_pool, tim);
+				}
+			}
+		}
+
+		rte_free(wheel);
+	}
+
+	rte_mempool_free(sw->tim_pool);
+	rte_free(sw);
+	adapter->data->adapter_priv = NULL;
+
+	return 0;
+}
+
+static int
+swtw_start(const struct rte_event_timer_adapter *adapter)
+{
+	int mapped_count;
+	struct swtw *sw = swtw_pmd_priv(adapter);
+
+	/* As for the rte_timer based implementation, only one service core
+	 * may expire the timers.
+	 */
+	mapped_count = get_mapped_count_for_service(sw->service_id);
+
+	if (mapped_count != 1)
+		return mapped_count < 1 ? -ENOENT : -ENOTSUP;
+
+	return rte_service_component_runstate_set(sw->service_id, 1);
+}
+
+static int
+swtw_stop(const struct rte_event_timer_adapter *adapter)
+{
+	int ret;
+	struct swtw *sw = swtw_pmd_priv(adapter);
+
+	ret = rte_service_component_runstate_set(sw->service_id, 0);
+	if (ret < 0)
+		return ret;
+
+	/* Wait for the service to complete its final iteration */
+	while (rte_service_may_be_active(sw->service_id))
+		rte_pause();
+
+	return 0;
+}
+
+static void
+swtw_get_info(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer_adapter_info *adapter_info)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	adapter_info->min_resolution_ns = sw->timer_tick_ns;
+	adapter_info->max_tmo_ns = sw->max_tmo_ns;
+}
+
+static int
+swtw_stats_get(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer_adapter_stats *stats)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	*stats = sw->stats; /* structure copy */
+	return 0;
+}
+
+static int
+swtw_stats_reset(const struct rte_event_timer_adapter *adapter)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	memset(&sw->stats, 0, sizeof(sw->stats));
+	return 0;
+}
+
+static int
+swtw_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
+			 const struct rte_event_timer *evtim,
+			 uint64_t *ticks_remaining)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	enum rte_event_timer_state n_state;
+	struct swtw_timer *tim;
+	uint64_t now_tick;
+
+	/* Check that timer is armed */
+	n_state = rte_atomic_load_explicit(&evtim->state, rte_memory_order_acquire);
+	if (n_state != RTE_EVENT_TIMER_ARMED)
+		return -EINVAL;
+
+	tim = (struct swtw_timer *)(uintptr_t)evtim->impl_opaque[0];
+	now_tick = swtw_now_tick(sw);
+
+	/* The expiry tick is one past the timeout, as the current tick is
+	 * partly elapsed already.
+	 */
+	*ticks_remaining = tim->expiry_tick > now_tick + 1 ?
+		tim->expiry_tick - now_tick - 1 : 0;
+
+	return 0;
+}
+
+static uint16_t
+swtw_arm_burst(const struct rte_event_timer_adapter *adapter,
+	       struct rte_event_timer **evtims,
+	       uint16_t nb_evtims)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	unsigned int lcore_id = rte_lcore_id();
+	struct swtw_timer *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	struct swtw_wheel *wheel;
+	uint64_t now_tick;
+	int i, n, ret;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	if (lcore_id == LCORE_ID_ANY)
+		lcore_id = SWTW_NON_EAL_WHEEL;
+
+	wheel = swtw_wheel_get(sw, lcore_id);
+	if (unlikely(wheel == NULL)) {
+		rte_errno = ENOMEM;
+		return 0;
+	}
+
+	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims, nb_evtims);
+	if (ret < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	now_tick = swtw_now_tick(sw);
+
+	for (i = 0; i < nb_evtims; i++) {
+		struct rte_event_timer *evtim = evtims[i];
+
+		n_state = rte_atomic_load_explicit(&evtim->state,
+						   rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtim,
+							   adapter) < 0)) {
+			rte_atomic_store_explicit(&evtim->state,
+					RTE_EVENT_TIMER_ERROR,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(evtim->timeout_ticks * sw->timer_tick_ns >
+			     sw->max_tmo_ns)) {
+			rte_atomic_store_explicit(&evtim->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(evtim->timeout_ticks == 0)) {
+			rte_atomic_store_explicit(&evtim->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		/* Expire on the tick boundary following the timeout, the
+		 * current tick being partly elapsed.
+		 */
+		*tims[i] = (struct swtw_timer) {
+			.expiry_tick = now_tick + evtim->timeout_ticks + 1,
+			.period_ticks = evtim->timeout_ticks,
+			.evtim = evtim,
+			.wheel = wheel
+		};
+
+		evtim->impl_opaque[0] = (uintptr_t)tims[i];
+		evtim->impl_opaque[1] = (uintptr_t)adapter;
+	}
+
+	n = i;
+
+	/* Link the whole burst under a single lock acquisition */
+	rte_spinlock_lock(&wheel->lock);
+	for (i = 0; i < n; i++) {
+		swtw_wheel_link(wheel, tims[i], wheel->cur_tick + 1);
+
+		/* RELEASE ordering guarantees the adapter specific value
+		 * changes observed before the update of state.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state,
+					  RTE_EVENT_TIMER_ARMED,
+					  rte_memory_order_release);
+	}
+	rte_spinlock_unlock(&wheel->lock);
+
+	EVTIM_LOG_DBG("armed %d event timers", n);
+
+	if (n < nb_evtims)
+		rte_mempool_put_bulk(sw->tim_pool, (void **)&tims[n],
+				     nb_evtims - n);
+
+	return n;
+}
+
+static uint16_t
+swtw_cancel_burst(const struct rte_event_timer_adapter *adapter,
+		  struct rte_event_timer **evtims,
+		  uint16_t nb_evtims)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	struct swtw_timer *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	struct swtw_wheel *locked = NULL;
+	int i;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	for (i = 0; i < nb_evtims; i++) {
+		struct rte_event_timer *evtim = evtims[i];
+		struct swtw_timer *tim;
+
+		/* ACQUIRE ordering guarantees the access of implementation
+		 * specific opaque data under the correct state.
+		 */
+		n_state = rte_atomic_load_explicit(&evtim->state,
+						   rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = (struct swtw_timer *)(uintptr_t)evtim->impl_opaque[0];
+		RTE_ASSERT(tim != NULL);
+
+		/* Timers armed on the same lcore are cancelled under a single
+		 * lock acquisition.
+		 */
+		if (tim->wheel != locked) {
+			if (locked != NULL)
+				rte_spinlock_unlock(&locked->lock);
+			locked = tim->wheel;
+			rte_spinlock_lock(&locked->lock);
+		}
+
+		/* The timer may have expired since its state was read */
+		if (rte_atomic_load_explicit(&evtim->state,
+				rte_memory_order_relaxed) != RTE_EVENT_TIMER_ARMED ||
+		    tim->evtim != evtim) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		swtw_wheel_unlink(locked, tim);
+		tims[i] = tim;
+
+		/* The RELEASE ordering here pairs with atomic ordering
+		 * to make sure the state update data observed between
+		 * threads.
+		 */
+		rte_atomic_store_explicit(&evtim->state, RTE_EVENT_TIMER_CANCELED,
+					  rte_memory_order_release);
+	}
+
+	if (locked != NULL)
+		rte_spinlock_unlock(&locked->lock);
+
+	if (i > 0)
+		rte_mempool_put_bulk(sw->tim_pool, (void **)tims, i);
+
+	return i;
+}
+
+static uint16_t
+swtw_arm_tmo_tick_burst(const struct rte_event_timer_adapter *adapter,
+			struct rte_event_timer **evtims,
+			uint64_t timeout_ticks,
+			uint16_t nb_evtims)
+{
+	int i;
+
+	for (i = 0; i < nb_evtims; i++)
+		evtims[i]->timeout_ticks = timeout_ticks;
+
+	return swtw_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static const struct event_timer_adapter_ops swtw_ops = {
+	.init = swtw_init,
+	.uninit = swtw_uninit,
+	.start = swtw_start,
+	.stop = swtw_stop,
+	.get_info = swtw_get_info,
+	.stats_get = swtw_stats_get,
+	.stats_reset = swtw_stats_reset,
+	.arm_burst = swtw_arm_burst,
+	.arm_tmo_tick_burst = swtw_arm_tmo_tick_burst,
+	.cancel_burst = swtw_cancel_burst,
+	.remaining_ticks_get = swtw_remaining_ticks_get,
+};
+
 static int
 handle_ta_info(const char *cmd __rte_unused, const char *params,
 		struct rte_tel_data *d)
@@ -157,6 +157,16 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMING_WHEEL	(1ULL << 3)
+/**< Flag to select the timing wheel based software implementation, when the
+ * event device does not provide a timer adapter of its own. Event timers are
+ * kept in per lcore hierarchical timing wheels, armed and cancelled in bulk,
+ * rather than in the timer library skiplists. It suits adapters arming large
+ * numbers of timers per second.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
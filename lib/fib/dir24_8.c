@@ -191,6 +191,9 @@ tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
 	if (unlikely(tbl8_idx == -ENOSPC && dp->dq &&
 			!rte_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL)))
 		tbl8_idx = tbl8_get_idx(dp);
+	else if (unlikely(tbl8_idx == -ENOSPC && dp->ebr_dq &&
+			!rte_rcu_ebr_dq_reclaim(dp->ebr_dq, 1, NULL, NULL, NULL)))
+		tbl8_idx = tbl8_get_idx(dp);
 
 	if (tbl8_idx < 0)
 		return tbl8_idx;
@@ -281,11 +284,17 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		break;
 	}
 
-	if (dp->v == NULL) {
+	if (dp->v == NULL && dp->ebr == NULL) {
 		tbl8_cleanup_and_free(dp, tbl8_idx);
 	} else if (dp->rcu_mode == RTE_FIB_QSBR_MODE_SYNC) {
-		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+		if (dp->ebr != NULL)
+			rte_rcu_ebr_synchronize(dp->ebr);
+		else
+			rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
 		tbl8_cleanup_and_free(dp, tbl8_idx);
+	} else if (dp->ebr != NULL) { /* RTE_FIB_QSBR_MODE_DQ */
+		if (rte_rcu_ebr_dq_enqueue(dp->ebr_dq, &tbl8_idx))
+			FIB_LOG(ERR, "Failed to push EBR FIFO");
 	} else { /* RTE_FIB_QSBR_MODE_DQ */
 		if (rte_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx))
 			FIB_LOG(ERR, "Failed to push QSBR FIFO");
@@ -605,14 +614,15 @@ dir24_8_free(void *p)
 	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
 
 	rte_rcu_qsbr_dq_delete(dp->dq);
+	rte_rcu_ebr_dq_delete(dp->ebr_dq);
 	rte_free(dp->tbl8_idxes);
 	rte_free(dp->tbl8);
 	rte_free(dp);
 }
 
 int
-dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
-	const char *name)
+dir24_8_rcu_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
+	struct rte_rcu_ebr *ebr, const char *name)
 {
 	struct rte_rcu_qsbr_dq_parameters params = {0};
 	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
@@ -620,7 +630,7 @@ dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 	if (dp == NULL || cfg == NULL)
 		return -EINVAL;
 
-	if (dp->v != NULL)
+	if (dp->v != NULL || dp->ebr != NULL)
 		return -EEXIST;
 
 	if (cfg->mode == RTE_FIB_QSBR_MODE_SYNC) {
@@ -641,8 +651,22 @@ dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 		params.free_fn = __rcu_qsbr_free_resource;
 		params.p = dp;
 		params.v = cfg->v;
-		dp->dq = rte_rcu_qsbr_dq_create(&params);
-		if (dp->dq == NULL) {
+		if (ebr != NULL) {
+			struct rte_rcu_ebr_dq_parameters ebr_params = {
+				.name = params.name,
+				.size = params.size,
+				.esize = params.esize,
+				.trigger_reclaim_limit = params.trigger_reclaim_limit,
+				.max_reclaim_size = params.max_reclaim_size,
+				.free_fn = params.free_fn,
+				.p = params.p,
+				.v = ebr,
+			};
+
+			dp->ebr_dq = rte_rcu_ebr_dq_create(&ebr_params);
+		} else
+			dp->dq = rte_rcu_qsbr_dq_create(&params);
+		if (dp->dq == NULL && dp->ebr_dq == NULL) {
 			FIB_LOG(ERR, "LPM defer queue creation failed");
 			return -rte_errno;
 		}
@@ -652,6 +676,7 @@ dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 
 	dp->rcu_mode = cfg->mode;
 	dp->v = cfg->v;
+	dp->ebr = ebr;
 
 	return 0;
 }
@@ -12,6 +12,7 @@
 #include <rte_byteorder.h>
 #include <rte_prefetch.h>
 #include <rte_branch_prediction.h>
+#include <rte_rcu_ebr.h>
 #include <rte_rcu_qsbr.h>
 
 /**
@@ -37,6 +38,8 @@ struct dir24_8_tbl {
 	enum rte_fib_qsbr_mode rcu_mode;/* Blocking, defer queue. */
 	struct rte_rcu_qsbr *v;		/* RCU QSBR variable. */
 	struct rte_rcu_qsbr_dq *dq;	/* RCU QSBR defer queue. */
+	struct rte_rcu_ebr *ebr;	/* RCU EBR variable, instead of QSBR. */
+	struct rte_rcu_ebr_dq *ebr_dq;	/* RCU EBR defer queue. */
 	uint64_t	def_nh;		/**< Default next hop */
 	uint64_t	*tbl8;		/**< tbl8 table. */
 	uint64_t	*tbl8_idxes;	/**< bitmap containing free tbl8 idxes*/
@@ -300,7 +303,7 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	uint64_t next_hop, int op);
 
 int
-dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
-	const char *name);
+dir24_8_rcu_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
+	struct rte_rcu_ebr *ebr, const char *name);
 
 #endif /* _DIR24_8_H_ */
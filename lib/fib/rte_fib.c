@@ -351,7 +351,22 @@ rte_fib_rcu_qsbr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg)
 
 	switch (fib->type) {
 	case RTE_FIB_DIR24_8:
-		return dir24_8_rcu_qsbr_add(fib->dp, cfg, fib->name);
+		return dir24_8_rcu_add(fib->dp, cfg, NULL, fib->name);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+int
+rte_fib_rcu_ebr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg,
+	struct rte_rcu_ebr *v)
+{
+	if (fib == NULL || cfg == NULL || cfg->v != NULL || v == NULL)
+		return -EINVAL;
+
+	switch (fib->type) {
+	case RTE_FIB_DIR24_8:
+		return dir24_8_rcu_add(fib->dp, cfg, v, fib->name);
 	default:
 		return -ENOTSUP;
 	}
@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_rcu_ebr.h>
 #include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
@@ -280,6 +281,35 @@ __rte_experimental
 int
 rte_fib_rcu_qsbr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU EBR variable with a FIB object.
+ * This is the same as rte_fib_rcu_qsbr_add, with grace periods tracked by
+ * an epoch based reclamation variable. The readers enclose their lookups
+ * in rte_rcu_ebr_read_lock and rte_rcu_ebr_read_unlock.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param cfg
+ *   RCU configuration. Its QSBR variable must be NULL.
+ * @param v
+ *   RCU EBR variable
+ * @return
+ *   0 on success
+ *   Negative otherwise
+ *   Possible error codes are:
+ *   - -EINVAL - invalid parameters
+ *   - -EEXIST - already added RCU
+ *   - -ENOMEM - memory allocation failure
+ *   - -ENOTSUP - not supported by configured dataplane algorithm
+ */
+__rte_experimental
+int
+rte_fib_rcu_ebr_add(struct rte_fib *fib, struct rte_fib_rcu_config *cfg,
+	struct rte_rcu_ebr *v);
+
 #ifdef __cplusplus
 }
 #endif
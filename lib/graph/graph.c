@@ -15,6 +15,7 @@
 #include <rte_string_fns.h>
 
 #include "graph_private.h"
+#include "graph_lat_private.h"
 #include "graph_pcap_private.h"
 
 static struct graph_head graph_list = STAILQ_HEAD_INITIALIZER(graph_list);
@@ -284,6 +285,9 @@ graph_mem_fixup_node_ctx(struct rte_graph *graph)
 			node->original_process = node_db->process;
 		} else
 			node->process = node_db->process;
+
+		if (graph->lat_trace_sample_rate)
+			graph_lat_node_fixup(node);
 	}
 
 	return graph;
@@ -457,6 +461,9 @@ rte_graph_create(const char *name, struct rte_graph_param *prm)
 	graph->num_pkt_to_capture = prm->num_pkt_to_capture;
 	if (prm->pcap_filename)
 		rte_strscpy(graph->pcap_filename, prm->pcap_filename, RTE_GRAPH_PCAP_FILE_SZ);
+	if (prm->lat_trace_enable)
+		graph->lat_trace_sample_rate = prm->lat_trace_sample_rate ?
+			prm->lat_trace_sample_rate : RTE_GRAPH_LAT_TRACE_SAMPLE_DEFAULT;
 
 	/* Allocate the Graph fast path memory and populate the data */
 	if (graph_fp_mem_create(graph))
@@ -563,6 +570,7 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 	graph->parent_id = parent_graph->id;
 	graph->lcore_id = parent_graph->lcore_id;
 	graph->socket = parent_graph->socket;
+	graph->lat_trace_sample_rate = parent_graph->lat_trace_sample_rate;
 	graph->id = graph_next_free_id();
 
 	/* Allocate the Graph fast path memory and populate the data */
@@ -0,0 +1,138 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <errno.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include "rte_graph_worker.h"
+
+#include "graph_lat_private.h"
+#include "graph_pcap_private.h"
+
+size_t
+graph_lat_mem_size(const struct graph *graph)
+{
+	if (graph->lat_trace_sample_rate == 0)
+		return 0;
+
+	return sizeof(struct graph_node_lat) * graph->node_count;
+}
+
+void
+graph_lat_node_reset(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct graph_node_lat *lat = RTE_PTR_ADD(node, node->lat_off);
+
+	memset(lat, 0, sizeof(*lat));
+	lat->countdown = graph->lat_trace_sample_rate;
+	lat->stats.min_cycles = UINT64_MAX;
+}
+
+void
+graph_lat_node_fixup(struct rte_node *node)
+{
+	if (node->process != graph_pcap_dispatch)
+		node->original_process = node->process;
+	node->process = graph_lat_dispatch;
+}
+
+uint16_t
+graph_lat_dispatch(struct rte_graph *graph, struct rte_node *node,
+		   void **objs, uint16_t nb_objs)
+{
+	struct graph_node_lat *lat = RTE_PTR_ADD(node, node->lat_off);
+	struct rte_graph_node_lat_stats *stats = &lat->stats;
+	rte_node_process_t process;
+	uint64_t start, cycles;
+	uint32_t bucket;
+	uint16_t rc;
+
+	/* Pcap trace, when enabled, sits between this and the node. */
+	process = graph->pcap_enable ? graph_pcap_dispatch : node->original_process;
+
+	if (likely(--lat->countdown != 0))
+		return process(graph, node, objs, nb_objs);
+
+	lat->countdown = graph->lat_trace_sample_rate;
+
+	start = rte_rdtsc();
+	rc = process(graph, node, objs, nb_objs);
+	cycles = rte_rdtsc() - start;
+
+	bucket = RTE_MIN(rte_fls_u64(cycles), RTE_GRAPH_LAT_HIST_BUCKETS - 1U);
+	stats->hist[bucket]++;
+	stats->samples++;
+	stats->objs += rc;
+	stats->cycles += cycles;
+	if (cycles < stats->min_cycles)
+		stats->min_cycles = cycles;
+	if (cycles > stats->max_cycles)
+		stats->max_cycles = cycles;
+
+	return rc;
+}
+
+int
+rte_graph_node_lat_stats_get(rte_graph_t graph_id, rte_node_t node_id,
+			     struct rte_graph_node_lat_stats *stats)
+{
+	const struct graph_node_lat *lat;
+	struct graph_head *graph_head;
+	struct rte_node *node;
+	struct graph *graph;
+	int rc = -ENOENT;
+
+	if (stats == NULL)
+		return -EINVAL;
+
+	graph_spinlock_lock();
+	graph_head = graph_list_head_get();
+	STAILQ_FOREACH(graph, graph_head, next) {
+		if (graph->id != graph_id)
+			continue;
+
+		if (graph->lat_trace_sample_rate == 0) {
+			rc = -ENOTSUP;
+			break;
+		}
+
+		node = graph_node_id_to_ptr(graph->graph, node_id);
+		if (node == NULL)
+			break;
+
+		lat = RTE_PTR_ADD(node, node->lat_off);
+		memcpy(stats, &lat->stats, sizeof(*stats));
+		rc = 0;
+		break;
+	}
+	graph_spinlock_unlock();
+
+	return rc;
+}
+
+uint64_t
+rte_graph_node_lat_percentile(const struct rte_graph_node_lat_stats *stats,
+			      double percentile)
+{
+	uint64_t target, count = 0;
+	uint32_t i;
+
+	if (stats == NULL || stats->samples == 0)
+		return 0;
+
+	percentile = RTE_MAX(RTE_MIN(percentile, 100.0), 0.0);
+	target = (uint64_t)(stats->samples * percentile / 100.0);
+	target = RTE_MAX(target, UINT64_C(1));
+
+	for (i = 0; i < RTE_GRAPH_LAT_HIST_BUCKETS - 1; i++) {
+		count += stats->hist[i];
+		if (count >= target)
+			return RTE_MIN(UINT64_C(1) << i, stats->max_cycles);
+	}
+
+	return stats->max_cycles;
+}
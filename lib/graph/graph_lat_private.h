@@ -0,0 +1,88 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#ifndef _RTE_GRAPH_LAT_PRIVATE_H_
+#define _RTE_GRAPH_LAT_PRIVATE_H_
+
+#include <stdint.h>
+
+#include "graph_private.h"
+
+/**
+ * @internal
+ *
+ * Per node latency trace data kept in the graph reel.
+ */
+struct __rte_cache_aligned graph_node_lat {
+	uint32_t countdown; /**< Invocations left before the next sample. */
+	struct rte_graph_node_lat_stats stats; /**< Sampled latency data. */
+};
+
+/**
+ * @internal
+ *
+ * Size of the latency trace area needed by a graph in the graph reel.
+ *
+ * @param graph
+ *   Pointer to internal graph object.
+ *
+ * @return
+ *   Number of bytes to reserve, 0 when latency trace is disabled.
+ */
+size_t graph_lat_mem_size(const struct graph *graph);
+
+/**
+ * @internal
+ *
+ * Reset the latency trace data of a node.
+ *
+ * The function is called while populating the graph reel in the primary
+ * process, once the node latency trace offset is known.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ */
+void graph_lat_node_reset(const struct rte_graph *graph, struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Install the latency trace dispatch function on a node.
+ *
+ * The function is called once the node process function has been set, in
+ * both the primary and secondary processes. The current process function is
+ * kept as the original one, unless pcap trace already did it.
+ *
+ * @param node
+ *   Pointer to the node object.
+ */
+void graph_lat_node_fixup(struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Measure the node process function and record it in the node histogram.
+ *
+ * When graph latency trace is enabled, this function is installed as the
+ * node process function. One out of every sample rate invocations is timed,
+ * the other ones are passed through to the original process function.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ * @param objs
+ *   Pointer to an array of objects to be processed.
+ * @param nb_objs
+ *   Number of objects in the array.
+ *
+ * @return
+ *   Number of objects processed.
+ */
+uint16_t graph_lat_dispatch(struct rte_graph *graph, struct rte_node *node,
+			    void **objs, uint16_t nb_objs);
+
+#endif /* _RTE_GRAPH_LAT_PRIVATE_H_ */
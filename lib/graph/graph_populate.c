@@ -9,6 +9,7 @@
 #include <rte_memzone.h>
 
 #include "graph_private.h"
+#include "graph_lat_private.h"
 #include "graph_pcap_private.h"
 
 static size_t
@@ -48,6 +49,10 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 		sz += sizeof(uint64_t) * graph_node->node->xstats->nb_xstats;
 	}
+	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+	graph->lat_start = sz;
+	/* For 0..N node objects with latency trace */
+	sz += graph_lat_mem_size(graph);
 
 	graph->mem_sz = sz;
 	return sz;
@@ -66,6 +71,7 @@ graph_header_popluate(struct graph *_graph)
 	graph->nodes_start = _graph->nodes_start;
 	graph->socket = _graph->socket;
 	graph->id = _graph->id;
+	graph->lat_trace_sample_rate = _graph->lat_trace_sample_rate;
 	memcpy(graph->name, _graph->name, RTE_GRAPH_NAMESIZE);
 	graph->fence = RTE_GRAPH_FENCE;
 }
@@ -74,6 +80,7 @@ static void
 graph_nodes_populate(struct graph *_graph)
 {
 	rte_graph_off_t xstat_off = _graph->xstats_start;
+	rte_graph_off_t lat_off = _graph->lat_start;
 	rte_graph_off_t off = _graph->nodes_start;
 	struct rte_graph *graph = _graph->graph;
 	struct graph_node *graph_node;
@@ -115,6 +122,13 @@ graph_nodes_populate(struct graph *_graph)
 			xstat_off = RTE_ALIGN(xstat_off, RTE_CACHE_LINE_SIZE);
 		}
 
+		if (graph->lat_trace_sample_rate) {
+			node->lat_off = lat_off - node->off;
+			lat_off += sizeof(struct graph_node_lat);
+			graph_lat_node_reset(graph, node);
+			graph_lat_node_fixup(node);
+		}
+
 		off += sizeof(struct rte_node *) * nb_edges;
 		off = RTE_ALIGN(off, RTE_CACHE_LINE_SIZE);
 		node->next = off;
@@ -105,6 +105,8 @@ struct graph {
 	/**< Node memory start offset in graph reel. */
 	rte_graph_off_t xstats_start;
 	/**< Node xstats memory start offset in graph reel. */
+	rte_graph_off_t lat_start;
+	/**< Node latency trace memory start offset in graph reel. */
 	rte_node_t src_node_count;
 	/**< Number of source nodes in a graph. */
 	struct rte_graph *graph;
@@ -129,6 +131,8 @@ struct graph {
 	/**< Number of packets to be captured per core. */
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];
 	/**< pcap file name/path. */
+	uint32_t lat_trace_sample_rate;
+	/**< Latency trace sample rate, 0 when latency trace is disabled. */
 	STAILQ_HEAD(gnode_list, graph_node) node_list;
 	/**< Nodes in a graph. */
 };
@@ -11,6 +11,7 @@
 #include <rte_malloc.h>
 
 #include "graph_private.h"
+#include "graph_lat_private.h"
 
 /* Capture all graphs of cluster */
 struct cluster {
@@ -140,6 +141,18 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+static inline void
+print_lat(FILE *f, const struct rte_graph_cluster_node_stats *stat)
+{
+	const struct rte_graph_node_lat_stats *lat = stat->lat;
+
+	fprintf(f,
+		"|\t%-24s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64 "|\n",
+		"lat samples/p50/p99/max", lat->samples,
+		rte_graph_node_lat_percentile(lat, 50),
+		rte_graph_node_lat_percentile(lat, 99), lat->max_cycles);
+}
+
 static int
 graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
@@ -152,6 +165,8 @@ graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		print_node(f, stat, dispatch);
 		if (stat->xstat_cntrs)
 			print_xstat(f, stat, dispatch);
+		if (stat->lat && stat->lat->samples)
+			print_lat(f, stat);
 	}
 	if (unlikely(is_last)) {
 		if (dispatch)
@@ -216,6 +231,20 @@ stats_mem_init(struct cluster *cluster,
 	return stats;
 }
 
+static int
+stats_lat_alloc(struct cluster_node *cluster, struct rte_graph *graph, int socket_id)
+{
+	if (graph->lat_trace_sample_rate == 0 || cluster->stat.lat != NULL)
+		return 0;
+
+	cluster->stat.lat = rte_zmalloc_socket(NULL, sizeof(*cluster->stat.lat),
+					       RTE_CACHE_LINE_SIZE, socket_id);
+	if (cluster->stat.lat == NULL)
+		return -ENOMEM;
+
+	return 0;
+}
+
 static int
 stats_mem_populate(struct rte_graph_cluster_stats **stats_in,
 		   struct rte_graph *graph, struct graph_node *graph_node)
@@ -240,6 +269,11 @@ stats_mem_populate(struct rte_graph_cluster_stats **stats_in,
 					"Failed to find node %s in graph %s",
 					graph_node->node->name, graph->name);
 
+			if (stats_lat_alloc(cluster, graph, stats->socket_id))
+				SET_ERR_JMP(ENOMEM, err,
+					    "Failed to allocate memory node %s graph %s",
+					    graph_node->node->name, graph->name);
+
 			cluster->nodes[cluster->nb_nodes++] = node;
 			return 0;
 		}
@@ -263,20 +297,26 @@ stats_mem_populate(struct rte_graph_cluster_stats **stats_in,
 		SET_ERR_JMP(ENOENT, free, "Failed to find node %s in graph %s",
 			    graph_node->node->name, graph->name);
 	cluster->nodes[cluster->nb_nodes++] = node;
+	if (stats_lat_alloc(cluster, graph, stats->socket_id))
+		SET_ERR_JMP(ENOMEM, free, "Failed to allocate memory node %s graph %s",
+			    graph_node->node->name, graph->name);
 	if (graph_node->node->xstats) {
 		cluster->stat.xstat_cntrs = graph_node->node->xstats->nb_xstats;
 		cluster->stat.xstat_count = rte_zmalloc_socket(NULL,
 			sizeof(uint64_t) * graph_node->node->xstats->nb_xstats,
 			RTE_CACHE_LINE_SIZE, stats->socket_id);
-		if (cluster->stat.xstat_count == NULL)
+		if (cluster->stat.xstat_count == NULL) {
+			rte_free(cluster->stat.lat);
 			SET_ERR_JMP(ENOMEM, free, "Failed to allocate memory node %s graph %s",
 				    graph_node->node->name, graph->name);
+		}
 
 		cluster->stat.xstat_desc = rte_zmalloc_socket(NULL,
 			sizeof(RTE_NODE_XSTAT_DESC_SIZE) * graph_node->node->xstats->nb_xstats,
 			RTE_CACHE_LINE_SIZE, stats->socket_id);
 		if (cluster->stat.xstat_desc == NULL) {
 			rte_free(cluster->stat.xstat_count);
+			rte_free(cluster->stat.lat);
 			SET_ERR_JMP(ENOMEM, free, "Failed to allocate memory node %s graph %s",
 				    graph_node->node->name, graph->name);
 		}
@@ -287,6 +327,7 @@ stats_mem_populate(struct rte_graph_cluster_stats **stats_in,
 					RTE_NODE_XSTAT_DESC_SIZE) < 0) {
 				rte_free(cluster->stat.xstat_count);
 				rte_free(cluster->stat.xstat_desc);
+				rte_free(cluster->stat.lat);
 				SET_ERR_JMP(E2BIG, free,
 					    "Error description overflow node %s graph %s",
 					    graph_node->node->name, graph->name);
@@ -450,12 +491,29 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 			rte_free(cluster->stat.xstat_count);
 			rte_free(cluster->stat.xstat_desc);
 		}
+		rte_free(cluster->stat.lat);
 
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 	return rte_free(stat);
 }
 
+static inline void
+cluster_node_aggregate_lat(struct rte_graph_node_lat_stats *stat,
+			   const struct rte_node *node)
+{
+	const struct graph_node_lat *lat = RTE_PTR_ADD(node, node->lat_off);
+	uint32_t i;
+
+	stat->samples += lat->stats.samples;
+	stat->objs += lat->stats.objs;
+	stat->cycles += lat->stats.cycles;
+	stat->min_cycles = RTE_MIN(stat->min_cycles, lat->stats.min_cycles);
+	stat->max_cycles = RTE_MAX(stat->max_cycles, lat->stats.max_cycles);
+	for (i = 0; i < RTE_GRAPH_LAT_HIST_BUCKETS; i++)
+		stat->hist[i] += lat->stats.hist[i];
+}
+
 static inline void
 cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 {
@@ -468,9 +526,16 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	uint8_t i;
 
 	memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	if (stat->lat) {
+		memset(stat->lat, 0, sizeof(*stat->lat));
+		stat->lat->min_cycles = UINT64_MAX;
+	}
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
+		if (stat->lat && node->lat_off)
+			cluster_node_aggregate_lat(stat->lat, node);
+
 		if (dispatch) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
@@ -556,6 +621,8 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->realloc_count = 0;
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
+		if (node->lat)
+			memset(node->lat, 0, sizeof(*node->lat));
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 }
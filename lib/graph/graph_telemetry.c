@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+
+#include "graph_private.h"
+#include "graph_lat_private.h"
+
+static int
+handle_graph_list(const char *cmd __rte_unused, const char *params __rte_unused,
+		  struct rte_tel_data *d)
+{
+	struct graph_head *graph_head;
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	graph_spinlock_lock();
+	graph_head = graph_list_head_get();
+	STAILQ_FOREACH(graph, graph_head, next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+/*
+ * Parse "graph" or, when node_name is given, "graph,node". Each part is
+ * checked against its own buffer, so a long valid pair is not truncated.
+ */
+static int
+graph_from_params(const char *params, struct graph **graphp,
+		  char *node_name, size_t node_name_sz)
+{
+	char name[RTE_GRAPH_NAMESIZE];
+	struct graph_head *graph_head;
+	struct graph *graph;
+	const char *sep;
+	size_t len;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	sep = strchr(params, ',');
+	if (sep == NULL) {
+		if (node_name != NULL)
+			return -EINVAL;
+		len = strlen(params);
+	} else {
+		if (node_name == NULL)
+			return -EINVAL;
+		len = sep - params;
+		if (rte_strscpy(node_name, sep + 1, node_name_sz) < 0)
+			return -EINVAL;
+	}
+
+	if (len >= sizeof(name))
+		return -EINVAL;
+	memcpy(name, params, len);
+	name[len] = '\0';
+
+	graph_head = graph_list_head_get();
+	STAILQ_FOREACH(graph, graph_head, next) {
+		if (strncmp(graph->name, name, RTE_GRAPH_NAMESIZE) == 0) {
+			*graphp = graph;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/*
+ * Return dict of nodes with dict of latency counters in cycles
+ *
+ * {
+ *     "node_a": {"samples": 0, "objs": 0, "avg": 0, "min": 0, "max": 0,
+ *                "p50": 0, "p99": 0, "p999": 0},
+ *     ...
+ * }
+ */
+static int
+handle_graph_node_lat(const char *cmd __rte_unused, const char *params,
+		      struct rte_tel_data *d)
+{
+	const struct rte_graph_node_lat_stats *stats;
+	const struct graph_node_lat *lat;
+	struct rte_tel_data *node_data;
+	struct rte_graph *graph_fp;
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = 0;
+
+	graph_spinlock_lock();
+	rc = graph_from_params(params, &graph, NULL, 0);
+	if (rc != 0)
+		goto unlock;
+	if (graph->lat_trace_sample_rate == 0) {
+		rc = -EINVAL;
+		goto unlock;
+	}
+
+	rte_tel_data_start_dict(d);
+	graph_fp = graph->graph;
+	rte_graph_foreach_node(count, off, graph_fp, node) {
+		lat = RTE_PTR_ADD(node, node->lat_off);
+		stats = &lat->stats;
+
+		node_data = rte_tel_data_alloc();
+		if (node_data == NULL) {
+			rc = -ENOMEM;
+			goto unlock;
+		}
+
+		rte_tel_data_start_dict(node_data);
+		rte_tel_data_add_dict_uint(node_data, "samples", stats->samples);
+		rte_tel_data_add_dict_uint(node_data, "objs", stats->objs);
+		rte_tel_data_add_dict_uint(node_data, "avg",
+			stats->samples ? stats->cycles / stats->samples : 0);
+		rte_tel_data_add_dict_uint(node_data, "min",
+			stats->samples ? stats->min_cycles : 0);
+		rte_tel_data_add_dict_uint(node_data, "max", stats->max_cycles);
+		rte_tel_data_add_dict_uint(node_data, "p50",
+			rte_graph_node_lat_percentile(stats, 50));
+		rte_tel_data_add_dict_uint(node_data, "p99",
+			rte_graph_node_lat_percentile(stats, 99));
+		rte_tel_data_add_dict_uint(node_data, "p999",
+			rte_graph_node_lat_percentile(stats, 99.9));
+		rte_tel_data_add_dict_container(d, node->name, node_data, 0);
+	}
+
+unlock:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+static int
+handle_graph_node_lat_hist(const char *cmd __rte_unused, const char *params,
+			   struct rte_tel_data *d)
+{
+	char node_name[RTE_NODE_NAMESIZE];
+	const struct graph_node_lat *lat;
+	struct rte_node *node;
+	struct graph *graph;
+	int rc = 0;
+	uint32_t i;
+
+	graph_spinlock_lock();
+	rc = graph_from_params(params, &graph, node_name, sizeof(node_name));
+	if (rc != 0)
+		goto unlock;
+	if (graph->lat_trace_sample_rate == 0) {
+		rc = -EINVAL;
+		goto unlock;
+	}
+
+	node = graph_node_name_to_ptr(graph->graph, node_name);
+	if (node == NULL) {
+		rc = -EINVAL;
+		goto unlock;
+	}
+
+	lat = RTE_PTR_ADD(node, node->lat_off);
+	rte_tel_data_start_array(d, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_LAT_HIST_BUCKETS; i++)
+		rte_tel_data_add_array_uint(d, lat->stats.hist[i]);
+
+unlock:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_INIT(graph_telemetry_init)
+{
+	rte_telemetry_register_cmd("/graph/list", handle_graph_list,
+		"Returns list of graph names.");
+	rte_telemetry_register_cmd("/graph/node_lat", handle_graph_node_lat,
+		"Returns per node latency in cycles. Parameters: graph_name");
+	rte_telemetry_register_cmd("/graph/node_lat_hist", handle_graph_node_lat_hist,
+		"Returns node latency log2 histogram. Parameters: graph_name,node_name");
+}
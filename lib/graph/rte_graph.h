@@ -22,6 +22,7 @@
 #include <stdio.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,8 @@ extern "C" {
 #define RTE_NODE_NAMESIZE 64  /**< Max length of node name. */
 #define RTE_NODE_XSTAT_DESC_SIZE 64  /**< Max length of node xstat description. */
 #define RTE_GRAPH_PCAP_FILE_SZ 64 /**< Max length of pcap file name. */
+#define RTE_GRAPH_LAT_HIST_BUCKETS 32 /**< Number of node latency histogram buckets. */
+#define RTE_GRAPH_LAT_TRACE_SAMPLE_DEFAULT 64 /**< Default latency trace sample rate. */
 #define RTE_GRAPH_OFF_INVALID UINT32_MAX /**< Invalid graph offset. */
 #define RTE_NODE_ID_INVALID UINT32_MAX   /**< Invalid node id. */
 #define RTE_EDGE_ID_INVALID UINT16_MAX   /**< Invalid edge id. */
@@ -173,6 +176,12 @@ struct rte_graph_param {
 			uint32_t mp_capacity; /**< Capacity of memory pool for dispatch model. */
 		} dispatch;
 	};
+
+	bool lat_trace_enable; /**< Per node latency trace enable. */
+	uint32_t lat_trace_sample_rate;
+	/**< Trace one out of every lat_trace_sample_rate invocations of a node.
+	 *   0 selects RTE_GRAPH_LAT_TRACE_SAMPLE_DEFAULT.
+	 */
 };
 
 /**
@@ -196,6 +205,29 @@ struct rte_graph_cluster_stats_param {
 	/**< Array of graph patterns based on shell pattern. */
 };
 
+/**
+ * Node latency trace data.
+ *
+ * Filled by the sampled latency trace when the graph is created with
+ * rte_graph_param::lat_trace_enable set. Each sample covers one invocation
+ * of the node process function, i.e. the time between the node picking up
+ * its pending stream and returning from it.
+ *
+ * @see rte_graph_node_lat_stats_get()
+ */
+struct rte_graph_node_lat_stats {
+	uint64_t samples;    /**< Number of sampled node invocations. */
+	uint64_t objs;       /**< Objects processed by the sampled invocations. */
+	uint64_t cycles;     /**< Cycles spent in the sampled invocations. */
+	uint64_t min_cycles; /**< Shortest sampled invocation. */
+	uint64_t max_cycles; /**< Longest sampled invocation. */
+	uint64_t hist[RTE_GRAPH_LAT_HIST_BUCKETS];
+	/**< Log2 histogram of cycles per invocation. Bucket 0 counts zero cycle
+	 *   samples, bucket n counts samples in [2^(n-1), 2^n) cycles and the
+	 *   last bucket also counts everything above.
+	 */
+};
+
 /**
  * Node cluster stats data structure.
  *
@@ -226,6 +258,7 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 	uint8_t xstat_cntrs;			      /**< Number of Node xstat counters. */
 	char (*xstat_desc)[RTE_NODE_XSTAT_DESC_SIZE]; /**< Names of the Node xstat counters. */
 	uint64_t *xstat_count;			      /**< Total stat count per each xstat. */
+	struct rte_graph_node_lat_stats *lat; /**< Latency trace, NULL if not traced. */
 
 	rte_node_t id;	/**< Node identifier of stats. */
 	uint64_t hz;	/**< Cycles per seconds. */
@@ -465,6 +498,46 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
  */
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the latency trace data of a node in a graph.
+ *
+ * @param graph_id
+ *   Graph id created with rte_graph_param::lat_trace_enable set.
+ * @param node_id
+ *   Node id of the node in the graph.
+ * @param[out] stats
+ *   Latency trace data of the node.
+ *
+ * @return
+ *   0 on success, -EINVAL on invalid arguments, -ENOENT if the graph or the
+ *   node is not found, -ENOTSUP if the graph has latency trace disabled.
+ */
+__rte_experimental
+int rte_graph_node_lat_stats_get(rte_graph_t graph_id, rte_node_t node_id,
+				 struct rte_graph_node_lat_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Estimate a latency percentile from a node latency histogram.
+ *
+ * @param stats
+ *   Latency trace data of a node.
+ * @param percentile
+ *   Percentile to compute in the range [0, 100].
+ *
+ * @return
+ *   Upper bound in cycles of the histogram bucket holding the requested
+ *   percentile, clamped to the observed maximum. 0 if there are no samples.
+ */
+__rte_experimental
+uint64_t rte_graph_node_lat_percentile(const struct rte_graph_node_lat_stats *stats,
+				       double percentile);
+
 /**
  * Structure defines the number of xstats a given node has and each xstat
  * description.
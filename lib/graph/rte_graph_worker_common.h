@@ -81,6 +81,8 @@ struct __rte_cache_aligned rte_graph {
 	/** Number of packets to capture per core. */
 	uint64_t nb_pkt_to_capture;
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];  /**< Pcap filename. */
+	/** Latency trace sample rate, 0 when latency trace is disabled. */
+	uint32_t lat_trace_sample_rate;
 	uint64_t fence;			/**< Fence. */
 };
 
@@ -101,8 +103,9 @@ struct __rte_cache_aligned rte_node {
 	char parent[RTE_NODE_NAMESIZE];	/**< Parent node name. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
 
-	/** Original process function when pcap is enabled. */
+	/** Original process function when pcap or latency trace is enabled. */
 	rte_node_process_t original_process;
+	rte_graph_off_t lat_off; /**< Offset to latency trace data. */
 
 	/** Fast schedule area for mcore dispatch model. */
 	union {
@@ -554,6 +554,8 @@ rte_hash_free(struct rte_hash *h)
 
 	if (h->dq)
 		rte_rcu_qsbr_dq_delete(h->dq);
+	if (h->ebr_dq)
+		rte_rcu_ebr_dq_delete(h->ebr_dq);
 
 	if (h->use_local_cache)
 		rte_free(h->local_free_slots);
@@ -662,6 +664,19 @@ __hash_rw_reader_unlock(const struct rte_hash *h)
 		rte_rwlock_read_unlock(h->readwrite_lock);
 }
 
+/* Reclaim resources from the defer queue of either RCU flavor */
+static inline int
+__hash_rcu_dq_reclaim(const struct rte_hash *h, unsigned int n,
+		      unsigned int *freed, unsigned int *pending,
+		      unsigned int *available)
+{
+	if (h->ebr_dq != NULL)
+		return rte_rcu_ebr_dq_reclaim(h->ebr_dq, n, freed, pending,
+					      available);
+
+	return rte_rcu_qsbr_dq_reclaim(h->dq, n, freed, pending, available);
+}
+
 void
 rte_hash_reset(struct rte_hash *h)
 {
@@ -673,9 +688,9 @@ rte_hash_reset(struct rte_hash *h)
 
 	__hash_rw_writer_lock(h);
 
-	if (h->dq) {
+	if (h->dq || h->ebr_dq) {
 		/* Reclaim all the resources */
-		rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+		__hash_rcu_dq_reclaim(h, ~0, NULL, &pending, NULL);
 		if (pending != 0)
 			HASH_LOG(ERR, "RCU reclaim all resources failed");
 	}
@@ -1103,9 +1118,9 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	}
 	slot_id = alloc_slot(h, cached_free_slots);
 	if (slot_id == EMPTY_SLOT) {
-		if (h->dq) {
+		if (h->dq || h->ebr_dq) {
 			__hash_rw_writer_lock(h);
-			ret = rte_rcu_qsbr_dq_reclaim(h->dq,
+			ret = __hash_rcu_dq_reclaim(h,
 					h->hash_rcu_cfg->max_reclaim_size,
 					NULL, NULL, NULL);
 			__hash_rw_writer_unlock(h);
@@ -1209,8 +1224,8 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	if (rte_ring_sc_dequeue_elem(h->free_ext_bkts, &ext_bkt_id,
 						sizeof(uint32_t)) != 0 ||
 					ext_bkt_id == 0) {
-		if (h->dq) {
-			if (rte_rcu_qsbr_dq_reclaim(h->dq,
+		if (h->dq || h->ebr_dq) {
+			if (__hash_rcu_dq_reclaim(h,
 					h->hash_rcu_cfg->max_reclaim_size,
 					NULL, NULL, NULL) == 0) {
 				rte_ring_sc_dequeue_elem(h->free_ext_bkts,
@@ -1557,18 +1572,14 @@ __hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n)
 	}
 }
 
-int
-rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
+static int
+__hash_rcu_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg,
+	       struct rte_rcu_ebr *ebr)
 {
 	struct rte_rcu_qsbr_dq_parameters params = {0};
 	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
 	struct rte_hash_rcu_config *hash_rcu_cfg = NULL;
 
-	if (h == NULL || cfg == NULL || cfg->v == NULL) {
-		rte_errno = EINVAL;
-		return 1;
-	}
-
 	const uint32_t total_entries = h->use_local_cache ?
 		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
 							: h->entries + 1;
@@ -1602,8 +1613,22 @@ rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
 		params.free_fn = __hash_rcu_qsbr_free_resource;
 		params.p = h;
 		params.v = cfg->v;
-		h->dq = rte_rcu_qsbr_dq_create(&params);
-		if (h->dq == NULL) {
+		if (ebr != NULL) {
+			struct rte_rcu_ebr_dq_parameters ebr_params = {
+				.name = params.name,
+				.size = params.size,
+				.esize = params.esize,
+				.trigger_reclaim_limit = params.trigger_reclaim_limit,
+				.max_reclaim_size = params.max_reclaim_size,
+				.free_fn = params.free_fn,
+				.p = params.p,
+				.v = ebr,
+			};
+
+			h->ebr_dq = rte_rcu_ebr_dq_create(&ebr_params);
+		} else
+			h->dq = rte_rcu_qsbr_dq_create(&params);
+		if (h->dq == NULL && h->ebr_dq == NULL) {
 			rte_free(hash_rcu_cfg);
 			HASH_LOG(ERR, "HASH defer queue creation failed");
 			return 1;
@@ -1622,11 +1647,35 @@ rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
 	hash_rcu_cfg->free_key_data_func = cfg->free_key_data_func;
 	hash_rcu_cfg->key_data_ptr = cfg->key_data_ptr;
 
+	h->ebr = ebr;
 	h->hash_rcu_cfg = hash_rcu_cfg;
 
 	return 0;
 }
 
+int
+rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
+{
+	if (h == NULL || cfg == NULL || cfg->v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	return __hash_rcu_add(h, cfg, NULL);
+}
+
+int
+rte_hash_rcu_ebr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg,
+		     struct rte_rcu_ebr *v)
+{
+	if (h == NULL || cfg == NULL || cfg->v != NULL || v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	return __hash_rcu_add(h, cfg, v);
+}
+
 int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed, unsigned int *pending,
 				 unsigned int *available)
 {
@@ -1638,8 +1687,8 @@ int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed, unsign
 		return 1;
 	}
 
-	ret = rte_rcu_qsbr_dq_reclaim(h->dq, h->hash_rcu_cfg->max_reclaim_size, freed, pending,
-				      available);
+	ret = __hash_rcu_dq_reclaim(h, h->hash_rcu_cfg->max_reclaim_size, freed, pending,
+				    available);
 	if (ret != 0) {
 		HASH_LOG(ERR, "%s: could not reclaim the defer queue in hash table", __func__);
 		return 1;
@@ -1834,18 +1883,23 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 		/* Key index where key is stored, adding the first dummy index */
 		rcu_dq_entry.key_idx = ret + 1;
 		rcu_dq_entry.ext_bkt_idx = index;
-		if (h->dq == NULL) {
+		if (h->dq == NULL && h->ebr_dq == NULL) {
 			/* Wait for quiescent state change if using
 			 * RTE_HASH_QSBR_MODE_SYNC
 			 */
-			rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
-						 RTE_QSBR_THRID_INVALID);
+			if (h->ebr != NULL)
+				rte_rcu_ebr_synchronize(h->ebr);
+			else
+				rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
+							 RTE_QSBR_THRID_INVALID);
 			__hash_rcu_qsbr_free_resource((void *)((uintptr_t)h),
 						      &rcu_dq_entry, 1);
-		} else if (h->dq)
+		} else if (h->dq) {
 			/* Push into QSBR FIFO if using RTE_HASH_QSBR_MODE_DQ */
 			if (rte_rcu_qsbr_dq_enqueue(h->dq, &rcu_dq_entry) != 0)
 				HASH_LOG(ERR, "Failed to push QSBR FIFO");
+		} else if (rte_rcu_ebr_dq_enqueue(h->ebr_dq, &rcu_dq_entry) != 0)
+			HASH_LOG(ERR, "Failed to push EBR FIFO");
 	}
 	__hash_rw_writer_unlock(h);
 	return ret;
@@ -161,6 +161,8 @@ struct __rte_cache_aligned rte_hash {
 	struct rte_hash_rcu_config *hash_rcu_cfg;
 	/**< HASH RCU QSBR configuration structure */
 	struct rte_rcu_qsbr_dq *dq;	/**< RCU QSBR defer queue. */
+	struct rte_rcu_ebr *ebr;	/**< RCU EBR variable, instead of QSBR. */
+	struct rte_rcu_ebr_dq *ebr_dq;	/**< RCU EBR defer queue. */
 
 	/* Fields used in lookup */
 
@@ -15,6 +15,8 @@
 #include <stddef.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_rcu_ebr.h>
 #include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
@@ -676,6 +678,34 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
  */
 int rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU EBR variable with a Hash object.
+ * This is the same as rte_hash_rcu_qsbr_add, with grace periods tracked by
+ * an epoch based reclamation variable instead of a QSBR variable.
+ * The readers enclose their lookups in rte_rcu_ebr_read_lock and
+ * rte_rcu_ebr_read_unlock, instead of reporting quiescent states.
+ *
+ * @param h
+ *   the hash object to add RCU EBR
+ * @param cfg
+ *   RCU configuration. Its QSBR variable must be NULL.
+ * @param v
+ *   RCU EBR variable
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid pointer
+ *   - EEXIST - already added RCU
+ *   - ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int rte_hash_rcu_ebr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg,
+			 struct rte_rcu_ebr *v);
+
 /**
  * Reclaim resources from the defer queue.
  * This API reclaim the resources from the defer queue if rcu is enabled.
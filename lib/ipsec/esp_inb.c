@@ -265,7 +265,8 @@ inb_get_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn,
 	 */
 	sqn = rte_be_to_cpu_32(esph->seq);
 	if (IS_ESN(sa))
-		sqn = reconstruct_esn(rsn->sqn, sqn, sa->replay.win_sz);
+		sqn = reconstruct_esn(rsn_last_sqn(sa, rsn), sqn,
+			sa->replay.win_sz);
 	*sqc = rte_cpu_to_be_64(sqn);
 
 	/* check IPsec window */
@@ -702,16 +703,22 @@ esp_inb_rsn_update(struct rte_ipsec_sa *sa, const uint32_t sqn[],
 	if (sa->replay.win_sz == 0)
 		return num;
 
-	rsn = rsn_update_start(sa);
-
-	k = 0;
-	for (i = 0; i != num; i++) {
-		if (esn_inb_update_sqn(rsn, sa, rte_be_to_cpu_32(sqn[i])) == 0)
-			k++;
-		else
-			dr[i - k] = i;
+	/* lock-free SA, window shared by all lcores */
+	if (SQN_LF(sa)) {
+		rsn = sa->sqn.inb.rsn[0];
+		k = 0;
+		for (i = 0; i != num; i++) {
+			if (esn_inb_update_sqn_lf(rsn, sa,
+					rte_be_to_cpu_32(sqn[i])) == 0)
+				k++;
+			else
+				dr[i - k] = i;
+		}
+		return k;
 	}
 
+	rsn = rsn_update_start(sa);
+	k = esn_inb_update_sqn_bulk(rsn, sa, sqn, dr, num);
 	rsn_update_finish(sa, rsn);
 	return k;
 }
@@ -748,25 +755,25 @@ esp_inb_pkt_process(struct rte_ipsec_sa *sa, struct rte_mbuf *mb[],
 }
 
 /*
- * Prepare (plus actual crypto/auth) routine for inbound CPU-CRYPTO
- * (synchronous mode).
+ * Prepare routine for inbound CPU-CRYPTO (synchronous mode),
+ * fills *req* with the parameters for actual crypto/auth processing.
  */
 uint16_t
-cpu_inb_pkt_prepare(const struct rte_ipsec_session *ss,
-	struct rte_mbuf *mb[], uint16_t num)
+cpu_inb_pkt_setup(const struct rte_ipsec_session *ss,
+	struct rte_mbuf *mb[], uint16_t num, const struct cpu_crypto_req *req)
 {
 	int32_t rc;
 	uint32_t i, k;
 	struct rte_ipsec_sa *sa;
 	struct replay_sqn *rsn;
 	union sym_op_data icv;
-	struct rte_crypto_va_iova_ptr iv[num];
-	struct rte_crypto_va_iova_ptr aad[num];
-	struct rte_crypto_va_iova_ptr dgst[num];
+	struct rte_crypto_va_iova_ptr *iv = req->iv;
+	struct rte_crypto_va_iova_ptr *aad = req->aad;
+	struct rte_crypto_va_iova_ptr *dgst = req->dgst;
+	uint32_t *l4ofs = req->l4ofs;
+	uint32_t *clen = req->clen;
+	uint64_t (*ivbuf)[IPSEC_MAX_IV_QWORD] = req->ivbuf;
 	uint32_t dr[num];
-	uint32_t l4ofs[num];
-	uint32_t clen[num];
-	uint64_t ivbuf[num][IPSEC_MAX_IV_QWORD];
 
 	sa = ss->sa;
 
@@ -803,9 +810,38 @@ cpu_inb_pkt_prepare(const struct rte_ipsec_session *ss,
 	if (k != num && k != 0)
 		move_bad_mbufs(mb, dr, num, num - k);
 
+	return k;
+}
+
+/*
+ * Prepare (plus actual crypto/auth) routine for inbound CPU-CRYPTO
+ * (synchronous mode).
+ */
+uint16_t
+cpu_inb_pkt_prepare(const struct rte_ipsec_session *ss,
+	struct rte_mbuf *mb[], uint16_t num)
+{
+	uint32_t k;
+	struct rte_crypto_va_iova_ptr iv[num];
+	struct rte_crypto_va_iova_ptr aad[num];
+	struct rte_crypto_va_iova_ptr dgst[num];
+	uint32_t l4ofs[num];
+	uint32_t clen[num];
+	uint64_t ivbuf[num][IPSEC_MAX_IV_QWORD];
+	const struct cpu_crypto_req req = {
+		.iv = iv,
+		.aad = aad,
+		.dgst = dgst,
+		.l4ofs = l4ofs,
+		.clen = clen,
+		.ivbuf = ivbuf,
+	};
+
+	k = cpu_inb_pkt_setup(ss, mb, num, &req);
+
 	/* convert mbufs to iovecs and do actual crypto/auth processing */
 	if (k != 0)
-		cpu_crypto_bulk(ss, sa->cofs, mb, iv, aad, dgst,
+		cpu_crypto_bulk(ss, ss->sa->cofs, mb, iv, aad, dgst,
 			l4ofs, clen, k);
 	return k;
 }
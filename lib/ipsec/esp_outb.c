@@ -548,9 +548,10 @@ outb_cpu_crypto_prepare(const struct rte_ipsec_sa *sa, uint32_t *pofs,
 }
 
 static inline uint16_t
-cpu_outb_pkt_prepare_helper(const struct rte_ipsec_session *ss,
+cpu_outb_pkt_setup_helper(const struct rte_ipsec_session *ss,
 		struct rte_mbuf *mb[], uint16_t n, esp_outb_prepare_t prepare,
-		uint32_t cofs_mask,	uint64_t sqn)
+		uint32_t cofs_mask, uint64_t sqn,
+		const struct cpu_crypto_req *req)
 {
 	int32_t rc;
 	rte_be64_t sqc;
@@ -558,13 +559,13 @@ cpu_outb_pkt_prepare_helper(const struct rte_ipsec_session *ss,
 	uint32_t i, k;
 	uint32_t l2, l3;
 	union sym_op_data icv;
-	struct rte_crypto_va_iova_ptr iv[n];
-	struct rte_crypto_va_iova_ptr aad[n];
-	struct rte_crypto_va_iova_ptr dgst[n];
+	struct rte_crypto_va_iova_ptr *iv = req->iv;
+	struct rte_crypto_va_iova_ptr *aad = req->aad;
+	struct rte_crypto_va_iova_ptr *dgst = req->dgst;
+	uint32_t *l4ofs = req->l4ofs;
+	uint32_t *clen = req->clen;
+	uint64_t (*ivbuf)[IPSEC_MAX_IV_QWORD] = req->ivbuf;
 	uint32_t dr[n];
-	uint32_t l4ofs[n];
-	uint32_t clen[n];
-	uint64_t ivbuf[n][IPSEC_MAX_IV_QWORD];
 
 	sa = ss->sa;
 
@@ -605,9 +606,36 @@ cpu_outb_pkt_prepare_helper(const struct rte_ipsec_session *ss,
 	if (k != n && k != 0)
 		move_bad_mbufs(mb, dr, n, n - k);
 
+	return k;
+}
+
+static inline uint16_t
+cpu_outb_pkt_prepare_helper(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t n, esp_outb_prepare_t prepare,
+		uint32_t cofs_mask,	uint64_t sqn)
+{
+	uint32_t k;
+	struct rte_crypto_va_iova_ptr iv[n];
+	struct rte_crypto_va_iova_ptr aad[n];
+	struct rte_crypto_va_iova_ptr dgst[n];
+	uint32_t l4ofs[n];
+	uint32_t clen[n];
+	uint64_t ivbuf[n][IPSEC_MAX_IV_QWORD];
+	const struct cpu_crypto_req req = {
+		.iv = iv,
+		.aad = aad,
+		.dgst = dgst,
+		.l4ofs = l4ofs,
+		.clen = clen,
+		.ivbuf = ivbuf,
+	};
+
+	k = cpu_outb_pkt_setup_helper(ss, mb, n, prepare, cofs_mask, sqn,
+		&req);
+
 	/* convert mbufs to iovecs and do actual crypto/auth processing */
 	if (k != 0)
-		cpu_crypto_bulk(ss, sa->cofs, mb, iv, aad, dgst,
+		cpu_crypto_bulk(ss, ss->sa->cofs, mb, iv, aad, dgst,
 			l4ofs, clen, k);
 	return k;
 }
@@ -652,6 +680,44 @@ cpu_outb_trs_pkt_prepare(const struct rte_ipsec_session *ss,
 		UINT32_MAX, sqn);
 }
 
+/*
+ * Same as cpu_outb_tun_pkt_prepare() and cpu_outb_trs_pkt_prepare(),
+ * but leave actual crypto/auth processing to the caller.
+ */
+uint16_t
+cpu_outb_tun_pkt_setup(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t num,
+		const struct cpu_crypto_req *req)
+{
+	uint64_t sqn;
+	uint32_t n;
+
+	n = num;
+	sqn = esn_outb_update_sqn(ss->sa, &n);
+	if (n != num)
+		rte_errno = EOVERFLOW;
+
+	return cpu_outb_pkt_setup_helper(ss, mb, n, outb_tun_pkt_prepare, 0,
+		sqn, req);
+}
+
+uint16_t
+cpu_outb_trs_pkt_setup(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t num,
+		const struct cpu_crypto_req *req)
+{
+	uint64_t sqn;
+	uint32_t n;
+
+	n = num;
+	sqn = esn_outb_update_sqn(ss->sa, &n);
+	if (n != num)
+		rte_errno = EOVERFLOW;
+
+	return cpu_outb_pkt_setup_helper(ss, mb, n, outb_trs_pkt_prepare,
+		UINT32_MAX, sqn, req);
+}
+
 /*
  * process outbound packets for SA with ESN support,
  * for algorithms that require SQN.hibits to be implicitly included
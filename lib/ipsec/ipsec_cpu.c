@@ -0,0 +1,198 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <rte_ipsec.h>
+#include <rte_errno.h>
+#include <rte_cryptodev.h>
+
+#include "sa.h"
+#include "misc.h"
+
+typedef uint16_t (*cpu_pkt_setup_t)(const struct rte_ipsec_session *ss,
+	struct rte_mbuf *mb[], uint16_t num, const struct cpu_crypto_req *req);
+
+static cpu_pkt_setup_t
+cpu_pkt_setup_select(const struct rte_ipsec_session *ss)
+{
+	static const uint64_t msk = RTE_IPSEC_SATP_DIR_MASK |
+			RTE_IPSEC_SATP_MODE_MASK;
+
+	if (ss == NULL || ss->sa == NULL ||
+			ss->type != RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO ||
+			ss->crypto.ses == NULL)
+		return NULL;
+
+	switch (ss->sa->type & msk) {
+	case (RTE_IPSEC_SATP_DIR_IB | RTE_IPSEC_SATP_MODE_TUNLV4):
+	case (RTE_IPSEC_SATP_DIR_IB | RTE_IPSEC_SATP_MODE_TUNLV6):
+	case (RTE_IPSEC_SATP_DIR_IB | RTE_IPSEC_SATP_MODE_TRANS):
+		return cpu_inb_pkt_setup;
+	case (RTE_IPSEC_SATP_DIR_OB | RTE_IPSEC_SATP_MODE_TUNLV4):
+	case (RTE_IPSEC_SATP_DIR_OB | RTE_IPSEC_SATP_MODE_TUNLV6):
+		return cpu_outb_tun_pkt_setup;
+	case (RTE_IPSEC_SATP_DIR_OB | RTE_IPSEC_SATP_MODE_TRANS):
+		return cpu_outb_trs_pkt_setup;
+	default:
+		return NULL;
+	}
+}
+
+/* Maximum number of packets handed to the crypto device at once */
+#define CPU_PKT_BURST_MAX	128
+
+/* Part of a group processed within one burst */
+struct cpu_pkt_chunk {
+	struct rte_ipsec_group *pg;
+	uint32_t ofs;
+	uint32_t cnt;
+};
+
+static void
+mbuf_reverse(struct rte_mbuf *mb[], uint32_t num)
+{
+	struct rte_mbuf *t;
+	uint32_t i;
+
+	for (i = 0; i < num / 2; i++) {
+		t = mb[i];
+		mb[i] = mb[num - i - 1];
+		mb[num - i - 1] = t;
+	}
+}
+
+/*
+ * Append the good packets of a processed part of the group after its
+ * previous good ones, moving the bad ones of the previous parts beyond.
+ */
+static void
+cpu_pkt_chunk_merge(const struct cpu_pkt_chunk *ch, uint32_t rc)
+{
+	struct rte_ipsec_group *pg = ch->pg;
+	uint32_t nb_bad = ch->ofs - pg->rc;
+
+	if (nb_bad != 0 && rc != 0) {
+		mbuf_reverse(pg->m + pg->rc, nb_bad);
+		mbuf_reverse(pg->m + ch->ofs, rc);
+		mbuf_reverse(pg->m + pg->rc, nb_bad + rc);
+	}
+
+	pg->rc += rc;
+}
+
+static uint32_t
+cpu_pkt_chunk_burst(const struct cpu_pkt_chunk ch[], uint32_t num)
+{
+	uint32_t i, j, k, n, s;
+	const struct rte_ipsec_session *ss;
+	struct cpu_crypto_req req;
+	cpu_pkt_setup_t setup;
+	struct rte_crypto_va_iova_ptr iv[CPU_PKT_BURST_MAX];
+	struct rte_crypto_va_iova_ptr aad[CPU_PKT_BURST_MAX];
+	struct rte_crypto_va_iova_ptr dgst[CPU_PKT_BURST_MAX];
+	uint32_t l4ofs[CPU_PKT_BURST_MAX];
+	uint32_t clen[CPU_PKT_BURST_MAX];
+	uint64_t ivbuf[CPU_PKT_BURST_MAX][IPSEC_MAX_IV_QWORD];
+	union rte_crypto_sym_ofs ofs[CPU_PKT_BURST_MAX];
+	void *ses[CPU_PKT_BURST_MAX];
+	struct rte_mbuf *mb[CPU_PKT_BURST_MAX];
+	uint8_t dev_id[CPU_PKT_BURST_MAX];
+	uint32_t rc[CPU_PKT_BURST_MAX];
+
+	/* prepare packets of all groups, collect the crypto parameters */
+	for (i = 0, n = 0; i != num; i++) {
+
+		ss = ch[i].pg->id.ptr;
+
+		rc[i] = 0;
+		setup = cpu_pkt_setup_select(ss);
+		if (setup == NULL) {
+			rte_errno = EINVAL;
+			continue;
+		}
+
+		req.iv = iv + n;
+		req.aad = aad + n;
+		req.dgst = dgst + n;
+		req.l4ofs = l4ofs + n;
+		req.clen = clen + n;
+		req.ivbuf = ivbuf + n;
+
+		k = setup(ss, ch[i].pg->m + ch[i].ofs, ch[i].cnt, &req);
+		for (j = 0; j != k; j++) {
+			mb[n + j] = ch[i].pg->m[ch[i].ofs + j];
+			ses[n + j] = ss->crypto.ses;
+			ofs[n + j] = ss->sa->cofs;
+			dev_id[n + j] = ss->crypto.dev_id;
+		}
+
+		rc[i] = k;
+		n += k;
+	}
+
+	/* hand packets of all sessions on the same device at once */
+	for (s = 0; s != n; s = i) {
+		for (i = s + 1; i != n && dev_id[i] == dev_id[s]; i++)
+			;
+		cpu_crypto_bulk_multi(dev_id[s], ses + s, ofs + s, mb + s,
+			iv + s, aad + s, dgst + s, l4ofs + s, clen + s, i - s);
+	}
+
+	/* finalise processing, failed crypto is flagged in the mbufs */
+	for (i = 0, n = 0; i != num; i++) {
+
+		if (rc[i] != 0) {
+			ss = ch[i].pg->id.ptr;
+			rc[i] = ss->pkt_func.process(ss,
+				ch[i].pg->m + ch[i].ofs, rc[i]);
+		}
+
+		cpu_pkt_chunk_merge(ch + i, rc[i]);
+		n += rc[i];
+	}
+
+	return n;
+}
+
+/*
+ * Process the groups in bursts of at most CPU_PKT_BURST_MAX packets,
+ * splitting the groups which do not fit in the current burst.
+ */
+uint32_t
+rte_ipsec_pkt_cpu_burst(struct rte_ipsec_group *grp, uint16_t num)
+{
+	struct cpu_pkt_chunk ch[CPU_PKT_BURST_MAX];
+	uint32_t i, k, n, nb_ch, nb_pkt, ofs;
+
+	for (i = 0; i != num; i++)
+		grp[i].rc = 0;
+
+	i = 0;
+	ofs = 0;
+	n = 0;
+	while (i != num) {
+
+		/* fill the next burst */
+		for (nb_ch = 0, nb_pkt = 0; i != num &&
+				nb_pkt != CPU_PKT_BURST_MAX; ) {
+			k = RTE_MIN(grp[i].cnt - ofs,
+				CPU_PKT_BURST_MAX - nb_pkt);
+			if (k != 0) {
+				ch[nb_ch].pg = grp + i;
+				ch[nb_ch].ofs = ofs;
+				ch[nb_ch].cnt = k;
+				nb_ch++;
+				nb_pkt += k;
+				ofs += k;
+			}
+			if (ofs == grp[i].cnt) {
+				i++;
+				ofs = 0;
+			}
+		}
+
+		n += cpu_pkt_chunk_burst(ch, nb_ch);
+	}
+
+	return n;
+}
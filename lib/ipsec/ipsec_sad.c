@@ -10,6 +10,7 @@
 #include <rte_hash_crc.h>
 #include <rte_malloc.h>
 #include <rte_random.h>
+#include <rte_stdatomic.h>
 #include <rte_tailq.h>
 
 #include "rte_ipsec_sad.h"
@@ -19,6 +20,13 @@
  * Each rule will also be stored in SPI_ONLY table.
  * for each data entry within this table last two bits are reserved to
  * indicate presence of entries with the same SPI in DIP and DIP+SIP tables.
+ *
+ * With RTE_IPSEC_SAD_FLAG_COMBINED all rules are stored in a single hash
+ * table, hash[RTE_IPSEC_SAD_SPI_ONLY], keyed by the rule type and by the
+ * fields this type matches on, the remaining fields being zeroed.
+ * A lookup then issues independent probes for all rule types present
+ * in the SAD and keeps the most specific match, instead of a chain of
+ * dependent probes into three tables.
  */
 
 #define SAD_PREFIX		"SAD_"
@@ -33,11 +41,33 @@ struct hash_cnt {
 	uint32_t cnt_dip_sip;
 };
 
+struct sad_comb_key_v4 {
+	uint32_t spi;
+	uint32_t dip;
+	uint32_t sip;
+	uint32_t type;
+};
+
+struct sad_comb_key_v6 {
+	uint32_t spi;
+	struct rte_ipv6_addr dip;
+	struct rte_ipv6_addr sip;
+	uint32_t type;
+};
+
+union sad_comb_key {
+	struct sad_comb_key_v4 v4;
+	struct sad_comb_key_v6 v6;
+};
+
 struct rte_ipsec_sad {
 	char name[RTE_IPSEC_SAD_NAMESIZE];
 	struct rte_hash	*hash[RTE_IPSEC_SAD_KEY_TYPE_MASK];
 	uint32_t keysize[RTE_IPSEC_SAD_KEY_TYPE_MASK];
 	uint32_t init_val;
+	uint32_t flags;
+	/* Number of rules of each type, combined layout only. */
+	RTE_ATOMIC(uint32_t) nb_rules[RTE_IPSEC_SAD_KEY_TYPE_MASK];
 	/* Array to track number of more specific rules
 	 * (spi_dip or spi_dip_sip). Used only in add/delete
 	 * as a helper struct.
@@ -113,6 +143,83 @@ add_specific(struct rte_ipsec_sad *sad, const void *key,
 	return 0;
 }
 
+/*
+ * @internal helper function
+ * Build a combined layout key for a given rule type.
+ */
+static inline void
+comb_key_fill(const struct rte_ipsec_sad *sad, union sad_comb_key *ck,
+		const union rte_ipsec_sad_key *key, uint32_t key_type)
+{
+	memset(ck, 0, sizeof(*ck));
+	if (sad->flags & RTE_IPSEC_SAD_FLAG_IPV6) {
+		ck->v6.spi = key->v6.spi;
+		if (key_type != RTE_IPSEC_SAD_SPI_ONLY)
+			ck->v6.dip = key->v6.dip;
+		if (key_type == RTE_IPSEC_SAD_SPI_DIP_SIP)
+			ck->v6.sip = key->v6.sip;
+		ck->v6.type = key_type;
+	} else {
+		ck->v4.spi = key->v4.spi;
+		if (key_type != RTE_IPSEC_SAD_SPI_ONLY)
+			ck->v4.dip = key->v4.dip;
+		if (key_type == RTE_IPSEC_SAD_SPI_DIP_SIP)
+			ck->v4.sip = key->v4.sip;
+		ck->v4.type = key_type;
+	}
+}
+
+/*
+ * @internal helper function
+ * Add a rule of any type into the combined table.
+ */
+static int
+add_comb(struct rte_ipsec_sad *sad, const union rte_ipsec_sad_key *key,
+		int key_type, void *sa)
+{
+	struct rte_hash *h = sad->hash[RTE_IPSEC_SAD_SPI_ONLY];
+	union sad_comb_key ck;
+	hash_sig_t sig;
+	int ret, notexist;
+
+	comb_key_fill(sad, &ck, key, key_type);
+	sig = rte_hash_crc(&ck, sad->keysize[RTE_IPSEC_SAD_SPI_ONLY],
+		sad->init_val);
+
+	notexist = (rte_hash_lookup_with_hash(h, &ck, sig) == -ENOENT);
+	ret = rte_hash_add_key_with_hash_data(h, &ck, sig, sa);
+	if (ret != 0)
+		return ret;
+
+	if (notexist)
+		rte_atomic_fetch_add_explicit(&sad->nb_rules[key_type], 1,
+			rte_memory_order_release);
+	return 0;
+}
+
+/*
+ * @internal helper function
+ * Delete a rule of any type from the combined table.
+ */
+static int
+del_comb(struct rte_ipsec_sad *sad, const union rte_ipsec_sad_key *key,
+		int key_type)
+{
+	union sad_comb_key ck;
+	int ret;
+
+	comb_key_fill(sad, &ck, key, key_type);
+	ret = rte_hash_del_key_with_hash(sad->hash[RTE_IPSEC_SAD_SPI_ONLY],
+		&ck, rte_hash_crc(&ck, sad->keysize[RTE_IPSEC_SAD_SPI_ONLY],
+		sad->init_val));
+	if (ret < 0)
+		return ret;
+
+	rte_atomic_fetch_sub_explicit(&sad->nb_rules[key_type], 1,
+		rte_memory_order_release);
+	return 0;
+}
+
 int
 rte_ipsec_sad_add(struct rte_ipsec_sad *sad,
 		const union rte_ipsec_sad_key *key,
@@ -126,6 +233,13 @@ rte_ipsec_sad_add(struct rte_ipsec_sad *sad,
 			(GET_BIT(sa, RTE_IPSEC_SAD_KEY_TYPE_MASK) != 0))
 		return -EINVAL;
 
+	if (sad->flags & RTE_IPSEC_SAD_FLAG_COMBINED) {
+		if (key_type < RTE_IPSEC_SAD_SPI_ONLY ||
+				key_type > RTE_IPSEC_SAD_SPI_DIP_SIP)
+			return -EINVAL;
+		return add_comb(sad, key, key_type, sa);
+	}
+
 	/*
 	 * Rules are stored in three hash tables depending on key_type.
 	 * All rules will also have an entry in SPI_ONLY table, with entry
@@ -222,6 +336,14 @@ rte_ipsec_sad_del(struct rte_ipsec_sad *sad,
 
 	if ((sad == NULL) || (key == NULL))
 		return -EINVAL;
+
+	if (sad->flags & RTE_IPSEC_SAD_FLAG_COMBINED) {
+		if (key_type < RTE_IPSEC_SAD_SPI_ONLY ||
+				key_type > RTE_IPSEC_SAD_SPI_DIP_SIP)
+			return -EINVAL;
+		return del_comb(sad, key, key_type);
+	}
+
 	switch (key_type) {
 	case(RTE_IPSEC_SAD_SPI_ONLY):
 		ret = rte_hash_lookup_with_hash_data(sad->hash[key_type],
@@ -286,14 +408,17 @@ rte_ipsec_sad_create(const char *name, const struct rte_ipsec_sad_conf *conf)
 		conf->max_sa[RTE_IPSEC_SAD_SPI_DIP]) +
 		RTE_MAX(MIN_HASH_ENTRIES,
 		conf->max_sa[RTE_IPSEC_SAD_SPI_DIP_SIP]);
+	/* cnt_arr is not needed by the combined layout */
 	sad = rte_zmalloc_socket(NULL, sizeof(*sad) +
-		(sizeof(struct hash_cnt) * sa_sum),
+		((conf->flags & RTE_IPSEC_SAD_FLAG_COMBINED) ? 0 :
+		(sizeof(struct hash_cnt) * sa_sum)),
 		RTE_CACHE_LINE_SIZE, conf->socket_id);
 	if (sad == NULL) {
 		rte_errno = ENOMEM;
 		return NULL;
 	}
 	memcpy(sad->name, sad_name, sizeof(sad_name));
+	sad->flags = conf->flags;
 
 	hash_params.hash_func = DEFAULT_HASH_FUNC;
 	hash_params.hash_func_init_val = rte_rand();
@@ -303,6 +428,24 @@ rte_ipsec_sad_create(const char *name, const struct rte_ipsec_sad_conf *conf)
 	if (conf->flags & RTE_IPSEC_SAD_FLAG_RW_CONCURRENCY)
 		hash_params.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY;
 
+	if (conf->flags & RTE_IPSEC_SAD_FLAG_COMBINED) {
+		/** Init hash[RTE_IPSEC_SAD_SPI_ONLY] for all rule types */
+		snprintf(hash_name, sizeof(hash_name), "sad_c_%p", sad);
+		if (conf->flags & RTE_IPSEC_SAD_FLAG_IPV6)
+			hash_params.key_len = sizeof(struct sad_comb_key_v6);
+		else
+			hash_params.key_len = sizeof(struct sad_comb_key_v4);
+		sad->keysize[RTE_IPSEC_SAD_SPI_ONLY] = hash_params.key_len;
+		hash_params.entries = sa_sum;
+		sad->hash[RTE_IPSEC_SAD_SPI_ONLY] =
+			rte_hash_create(&hash_params);
+		if (sad->hash[RTE_IPSEC_SAD_SPI_ONLY] == NULL) {
+			rte_ipsec_sad_destroy(sad);
+			return NULL;
+		}
+		goto register_sad;
+	}
+
 	/** Init hash[RTE_IPSEC_SAD_SPI_ONLY] for SPI only */
 	snprintf(hash_name, sizeof(hash_name), "sad_1_%p", sad);
 	hash_params.key_len = sizeof(((struct rte_ipsec_sadv4_key *)0)->spi);
@@ -348,6 +491,7 @@ rte_ipsec_sad_create(const char *name, const struct rte_ipsec_sad_conf *conf)
 		return NULL;
 	}
 
+register_sad:
 	sad_list = RTE_TAILQ_CAST(rte_ipsec_sad_tailq.head,
 			rte_ipsec_sad_list);
 	rte_mcfg_tailq_write_lock();
@@ -536,6 +680,74 @@ __ipsec_sad_lookup(const struct rte_ipsec_sad *sad,
 	return found;
 }
 
+/*
+ * @internal helper function
+ * Lookup a batch of keys in the combined table.
+ * Keys for all rule types present in the SAD are built up front,
+ * most specific type first, and probed with independent bulk lookups
+ * so that the hash library can overlap their cache misses.
+ * The first hit in that order wins for each key.
+ */
+static int
+__ipsec_sad_lookup_comb(const struct rte_ipsec_sad *sad,
+		const union rte_ipsec_sad_key *keys[], void *sa[], uint32_t n)
+{
+	union sad_comb_key ck[RTE_IPSEC_SAD_KEY_TYPE_MASK *
+		RTE_HASH_LOOKUP_BULK_MAX];
+	const void *ckp[RTE_IPSEC_SAD_KEY_TYPE_MASK *
+		RTE_HASH_LOOKUP_BULK_MAX];
+	void *vals[RTE_IPSEC_SAD_KEY_TYPE_MASK * RTE_HASH_LOOKUP_BULK_MAX];
+	hash_sig_t sig[RTE_IPSEC_SAD_KEY_TYPE_MASK * RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t hit[RTE_IPSEC_SAD_KEY_TYPE_MASK];
+	uint32_t types[RTE_IPSEC_SAD_KEY_TYPE_MASK];
+	uint32_t i, k, m, np, nt;
+	uint64_t mask, map;
+	int t, found = 0;
+
+	nt = 0;
+	for (t = RTE_IPSEC_SAD_SPI_DIP_SIP; t >= RTE_IPSEC_SAD_SPI_ONLY; t--) {
+		if (rte_atomic_load_explicit(&sad->nb_rules[t],
+				rte_memory_order_acquire) != 0)
+			types[nt++] = t;
+	}
+
+	np = 0;
+	for (k = 0; k != nt; k++) {
+		for (i = 0; i != n; i++, np++) {
+			comb_key_fill(sad, &ck[np], keys[i], types[k]);
+			ckp[np] = &ck[np];
+			sig[np] = rte_hash_crc(&ck[np],
+				sad->keysize[RTE_IPSEC_SAD_SPI_ONLY],
+				sad->init_val);
+		}
+	}
+
+	/* probes for one rule type never depend on another one */
+	for (k = 0; k != nt; k++) {
+		rte_hash_lookup_with_hash_bulk_data(
+			sad->hash[RTE_IPSEC_SAD_SPI_ONLY],
+			&ckp[k * n], &sig[k * n], n, &hit[k], &vals[k * n]);
+	}
+
+	for (i = 0; i != n; i++)
+		sa[i] = NULL;
+
+	/* resolve from the most specific rule type */
+	mask = 0;
+	for (k = 0; k != nt; k++) {
+		for (map = hit[k] & ~mask; map; map &= (map - 1)) {
+			m = rte_bsf64(map);
+			sa[m] = vals[k * n + m];
+		}
+		mask |= hit[k];
+	}
+
+	for (i = 0; i < n; i++)
+		found += (sa[i] != NULL);
+
+	return found;
+}
+
 int
 rte_ipsec_sad_lookup(const struct rte_ipsec_sad *sad,
 		const union rte_ipsec_sad_key *keys[], void *sa[], uint32_t n)
@@ -548,8 +760,12 @@ rte_ipsec_sad_lookup(const struct rte_ipsec_sad *sad,
 
 	do {
 		num = RTE_MIN(n - i, (uint32_t)RTE_HASH_LOOKUP_BULK_MAX);
-		found += __ipsec_sad_lookup(sad,
-			&keys[i], &sa[i], num);
+		if (sad->flags & RTE_IPSEC_SAD_FLAG_COMBINED)
+			found += __ipsec_sad_lookup_comb(sad,
+				&keys[i], &sa[i], num);
+		else
+			found += __ipsec_sad_lookup(sad,
+				&keys[i], &sa[i], num);
 		i += num;
 	} while (i != n);
 
@@ -5,6 +5,10 @@
 #ifndef _IPSEC_SQN_H_
 #define _IPSEC_SQN_H_
 
+#if defined(RTE_ARCH_X86) && defined(__AVX2__)
+#include <rte_vect.h>
+#endif
+
 #define WINDOW_BUCKET_BITS		6 /* uint64_t */
 #define WINDOW_BUCKET_SIZE		(1 << WINDOW_BUCKET_BITS)
 #define WINDOW_BIT_LOC_MASK		(WINDOW_BUCKET_SIZE - 1)
@@ -13,10 +17,21 @@
 #define WINDOW_BUCKET_MIN		2
 #define WINDOW_BUCKET_MAX		(INT16_MAX + 1)
 
+/*
+ * Lock-free replay window buckets are 64 bit words, with the bucket
+ * number tag in the upper 32 bits and a 32 bit bitmap in the lower ones.
+ */
+#define WINDOW_LF_BUCKET_BITS		5 /* uint32_t */
+#define WINDOW_LF_BUCKET_SIZE		(1 << WINDOW_LF_BUCKET_BITS)
+#define WINDOW_LF_BIT_LOC_MASK		(WINDOW_LF_BUCKET_SIZE - 1)
+#define WINDOW_LF_TAG_SHIFT		32
+
 #define IS_ESN(sa)	((sa)->sqn_mask == UINT64_MAX)
 
 #define	SQN_ATOMIC(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_ATOM)
 
+#define	SQN_LF(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_LF_ENABLE)
+
 /*
  * gets SQN.hi32 bits, SQN supposed to be in network byte order.
  */
@@ -80,6 +95,65 @@ reconstruct_esn(uint64_t t, uint32_t sqn, uint32_t w)
 	return (uint64_t)th << 32 | sqn;
 }
 
+/**
+ * Get the highest SQN accepted so far.
+ * For lock-free SA it is updated concurrently by multiple lcores.
+ */
+static inline uint64_t
+rsn_last_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn)
+{
+	if (SQN_LF(sa))
+		return rte_atomic_load_explicit(
+			(const uint64_t __rte_atomic *)&rsn->sqn,
+			rte_memory_order_acquire);
+	return rsn->sqn;
+}
+
+/**
+ * Perform the replay checking for lock-free SA.
+ * Same as esn_inb_check_sqn(), with a bucket that could be reused by
+ * a more recent SQN considered to be outside of the window.
+ */
+static inline int32_t
+esn_inb_check_sqn_lf(const struct replay_sqn *rsn,
+	const struct rte_ipsec_sa *sa, uint64_t sqn)
+{
+	uint64_t last, v;
+	uint32_t bit, bucket, tag;
+
+	last = rsn_last_sqn(sa, rsn);
+
+	/* seq is larger than lastseq */
+	if (sqn > last)
+		return 0;
+
+	/* seq is outside window */
+	if (sqn == 0 || sqn + sa->replay.win_sz < last)
+		return -EINVAL;
+
+	bit = 1U << (sqn & WINDOW_LF_BIT_LOC_MASK);
+	bucket = (sqn >> WINDOW_LF_BUCKET_BITS) & sa->replay.bucket_index_mask;
+	tag = sqn >> WINDOW_LF_BUCKET_BITS;
+
+	v = rte_atomic_load_explicit(
+		(const uint64_t __rte_atomic *)&rsn->window[bucket],
+		rte_memory_order_relaxed);
+
+	/* empty bucket */
+	if ((uint32_t)v == 0)
+		return 0;
+
+	/* bucket reused by a more recent SQN */
+	if ((int32_t)((uint32_t)(v >> WINDOW_LF_TAG_SHIFT) - tag) > 0)
+		return -EINVAL;
+
+	/* already seen packet */
+	if ((v >> WINDOW_LF_TAG_SHIFT) == tag && (v & bit) != 0)
+		return -EINVAL;
+
+	return 0;
+}
+
 /**
  * Perform the replay checking.
  *
@@ -99,6 +173,9 @@ esn_inb_check_sqn(const struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	if (sa->replay.win_sz == 0)
 		return 0;
 
+	if (SQN_LF(sa))
+		return esn_inb_check_sqn_lf(rsn, sa, sqn);
+
 	/* seq is larger than lastseq */
 	if (sqn > rsn->sqn)
 		return 0;
@@ -127,7 +204,7 @@ esn_outb_update_sqn(struct rte_ipsec_sa *sa, uint32_t *num)
 	uint64_t n, s, sqn;
 
 	n = *num;
-	if (SQN_ATOMIC(sa))
+	if (SQN_ATOMIC(sa) || SQN_LF(sa))
 		sqn = rte_atomic_fetch_add_explicit(&sa->sqn.outb, n, rte_memory_order_relaxed) + n;
 	else {
 		sqn = sa->sqn.outb + n;
@@ -150,7 +227,8 @@ static inline int32_t
 esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	uint64_t sqn)
 {
-	uint32_t bit, bucket, last_bucket, new_bucket, diff, i;
+	uint32_t bucket, last_bucket, new_bucket, diff, i;
+	uint64_t bit;
 
 	/* handle ESN */
 	if (IS_ESN(sa))
@@ -190,6 +268,240 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	return 0;
 }
 
+/**
+ * Move the replay window forward to the new highest SQN,
+ * clearing all buckets in between with at most two memset() calls.
+ */
+static inline void
+rsn_window_move(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	uint64_t sqn)
+{
+	uint32_t diff, first, n;
+
+	diff = (sqn >> WINDOW_BUCKET_BITS) - (rsn->sqn >> WINDOW_BUCKET_BITS);
+	n = sa->replay.nb_bucket;
+
+	if (diff >= n) {
+		memset(rsn->window, 0, n * sizeof(rsn->window[0]));
+	} else if (diff != 0) {
+		first = ((rsn->sqn >> WINDOW_BUCKET_BITS) + 1) &
+			sa->replay.bucket_index_mask;
+		if (first + diff <= n) {
+			memset(&rsn->window[first], 0,
+				diff * sizeof(rsn->window[0]));
+		} else {
+			memset(&rsn->window[first], 0,
+				(n - first) * sizeof(rsn->window[0]));
+			memset(rsn->window, 0,
+				(first + diff - n) * sizeof(rsn->window[0]));
+		}
+	}
+
+	rsn->sqn = sqn;
+}
+
+#if defined(RTE_ARCH_X86) && defined(__AVX2__)
+/**
+ * Check and set the window bits of four reconstructed SQNs, for the
+ * common case of in order traffic where they all fall in the same bucket.
+ * A SQN is rejected when zero, already set in the window, or equal to
+ * one of the previous three.
+ * Returns the mask of the rejected SQNs, or -1 when they span several
+ * buckets and have to be handled one by one.
+ */
+static inline int
+rsn_window_update_x4(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	const uint64_t s[])
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i sv, bkt, bit, acc;
+	__m128i acc2;
+	uint32_t b;
+	uint64_t w;
+	int dup, rej;
+
+	sv = _mm256_loadu_si256((const __m256i *)s);
+	bkt = _mm256_srli_epi64(sv, WINDOW_BUCKET_BITS);
+	if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(bkt,
+			_mm256_permute4x64_epi64(bkt, 0))) != -1)
+		return -1;
+
+	b = (s[0] >> WINDOW_BUCKET_BITS) & sa->replay.bucket_index_mask;
+	w = rsn->window[b];
+
+	bit = _mm256_sllv_epi64(_mm256_set1_epi64x(1), _mm256_and_si256(sv,
+		_mm256_set1_epi64x(WINDOW_BIT_LOC_MASK)));
+
+	/* same bit as one of the previous lanes */
+	dup = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(bit,
+		_mm256_permute4x64_epi64(bit, 0x90)))) & 0xe;
+	dup |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(bit,
+		_mm256_permute4x64_epi64(bit, 0x40)))) & 0xc;
+	dup |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(bit,
+		_mm256_permute4x64_epi64(bit, 0)))) & 0x8;
+
+	/* already seen packets and SQNs outside of the window */
+	rej = ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(
+		_mm256_and_si256(bit, _mm256_set1_epi64x(w)), zero))) & 0xf;
+	rej |= _mm256_movemask_pd(_mm256_castsi256_pd(
+		_mm256_cmpeq_epi64(sv, zero)));
+	rej |= dup;
+
+	/* set the bits of the accepted ones */
+	acc = _mm256_andnot_si256(_mm256_cmpeq_epi64(sv, zero), bit);
+	acc2 = _mm_or_si128(_mm256_castsi256_si128(acc),
+		_mm256_extracti128_si256(acc, 1));
+	rsn->window[b] = w | (uint64_t)_mm_extract_epi64(acc2, 0) |
+		(uint64_t)_mm_extract_epi64(acc2, 1);
+
+	return rej;
+}
+#endif
+
+/**
+ * For inbound SA perform the sequence number and replay window update
+ * for a burst of SQNs in network byte order, with the same result as
+ * esn_inb_update_sqn() invoked for each of them in order.
+ * When all accepted SQNs stay within the window ring, it is moved
+ * only once to the highest SQN of the burst, and then the bits of
+ * all packets are checked and set, four at a time with AVX2.
+ * Returns number of accepted SQNs, indexes of rejected ones
+ * are stored in dr[].
+ */
+static inline uint32_t
+esn_inb_update_sqn_bulk(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	const uint32_t sqn[], uint32_t dr[], uint32_t num)
+{
+	uint32_t bkt, i, k, tb;
+	uint64_t bit, last;
+	uint64_t s[num];
+#if defined(RTE_ARCH_X86) && defined(__AVX2__)
+	uint32_t j;
+	int rej;
+#endif
+
+	/* reconstruct SQNs and check them against the window as moved
+	 * by the previous packets of the burst
+	 */
+	last = rsn->sqn;
+	for (i = 0; i != num; i++) {
+		s[i] = rte_be_to_cpu_32(sqn[i]);
+		if (IS_ESN(sa))
+			s[i] = reconstruct_esn(last, s[i], sa->replay.win_sz);
+		if (s[i] == 0 || s[i] + sa->replay.win_sz < last)
+			s[i] = 0;
+		else if (s[i] > last)
+			last = s[i];
+	}
+
+	/* the burst spans more than the window ring, keep the packet order */
+	tb = last >> WINDOW_BUCKET_BITS;
+	for (i = 0; i != num; i++) {
+		if (s[i] != 0 && tb - (uint32_t)(s[i] >> WINDOW_BUCKET_BITS) >=
+				sa->replay.nb_bucket)
+			break;
+	}
+
+	if (i != num) {
+		for (i = 0, k = 0; i != num; i++) {
+			if (esn_inb_update_sqn(rsn, sa,
+					rte_be_to_cpu_32(sqn[i])) == 0)
+				k++;
+			else
+				dr[i - k] = i;
+		}
+		return k;
+	}
+
+	if (last > rsn->sqn)
+		rsn_window_move(rsn, sa, last);
+
+	for (i = 0, k = 0; i != num; i++) {
+#if defined(RTE_ARCH_X86) && defined(__AVX2__)
+		if (num - i >= 4) {
+			rej = rsn_window_update_x4(rsn, sa, &s[i]);
+			if (rej >= 0) {
+				for (j = 0; j != 4; j++) {
+					if (rej & (1 << j))
+						dr[i + j - k] = i + j;
+					else
+						k++;
+				}
+				i += 3;
+				continue;
+			}
+		}
+#endif
+		bit = (uint64_t)1 << (s[i] & WINDOW_BIT_LOC_MASK);
+		bkt = (s[i] >> WINDOW_BUCKET_BITS) &
+			sa->replay.bucket_index_mask;
+		if (s[i] == 0 || (rsn->window[bkt] & bit) != 0) {
+			dr[i - k] = i;
+			continue;
+		}
+		rsn->window[bkt] |= bit;
+		k++;
+	}
+
+	return k;
+}
+
+/**
+ * For inbound lock-free SA perform the sequence number and replay
+ * window update. Could be invoked concurrently by multiple lcores
+ * for the same SA.
+ * Each bucket is tagged with its bucket number, so a bucket is reset
+ * by the first SQN of a more recent bucket that maps to it, and a SQN
+ * which bucket was reused is rejected as outside of the window.
+ */
+static inline int32_t
+esn_inb_update_sqn_lf(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	uint64_t sqn)
+{
+	uint64_t __rte_atomic *w;
+	uint64_t last, nv, v;
+	uint32_t bit, tag;
+
+	last = rsn_last_sqn(sa, rsn);
+
+	/* handle ESN */
+	if (IS_ESN(sa))
+		sqn = reconstruct_esn(last, sqn, sa->replay.win_sz);
+
+	/* seq is outside window*/
+	if (sqn == 0 || sqn + sa->replay.win_sz < last)
+		return -EINVAL;
+
+	bit = 1U << (sqn & WINDOW_LF_BIT_LOC_MASK);
+	tag = sqn >> WINDOW_LF_BUCKET_BITS;
+	w = (uint64_t __rte_atomic *)&rsn->window[(sqn >> WINDOW_LF_BUCKET_BITS) &
+		sa->replay.bucket_index_mask];
+
+	v = rte_atomic_load_explicit(w, rte_memory_order_relaxed);
+	do {
+		if ((uint32_t)v == 0 ||
+				(int32_t)((uint32_t)(v >> WINDOW_LF_TAG_SHIFT) -
+				tag) < 0)
+			/* empty or stale bucket, take it over */
+			nv = (uint64_t)tag << WINDOW_LF_TAG_SHIFT | bit;
+		else if ((v >> WINDOW_LF_TAG_SHIFT) != tag || (v & bit) != 0)
+			/* bucket reused by a more recent SQN or seen packet */
+			return -EINVAL;
+		else
+			nv = v | bit;
+	} while (rte_atomic_compare_exchange_weak_explicit(w, &v, nv,
+			rte_memory_order_relaxed, rte_memory_order_relaxed) == 0);
+
+	/* move the window top forward */
+	while (sqn > last && rte_atomic_compare_exchange_weak_explicit(
+			(uint64_t __rte_atomic *)&rsn->sqn, &last, sqn,
+			rte_memory_order_release,
+			rte_memory_order_acquire) == 0)
+		;
+
+	return 0;
+}
+
 /**
  * To achieve ability to do multiple readers single writer for
  * SA replay window information and sequence number (RSN)
@@ -209,7 +521,7 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 static inline void
 rsn_copy(const struct rte_ipsec_sa *sa, uint32_t dst, uint32_t src)
 {
-	uint32_t i, n;
+	uint32_t n;
 	struct replay_sqn *d;
 	const struct replay_sqn *s;
 
@@ -219,8 +531,7 @@ rsn_copy(const struct rte_ipsec_sa *sa, uint32_t dst, uint32_t src)
 	n = sa->replay.nb_bucket;
 
 	d->sqn = s->sqn;
-	for (i = 0; i != n; i++)
-		d->window[i] = s->window[i];
+	memcpy(d->window, s->window, n * sizeof(d->window[0]));
 }
 
 /**
@@ -18,6 +18,7 @@
 #include <rte_mbuf.h>
 
 struct rte_ipsec_session;
+struct rte_ipsec_group;
 
 /**
  * IPsec state for stateless processing of a batch of IPsec packets.
@@ -238,6 +239,35 @@ rte_ipsec_pkt_process(const struct rte_ipsec_session *ss, struct rte_mbuf *mb[],
 	return ss->pkt_func.process(ss, mb, num);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Prepare, process with the CPU crypto engine and finalise in one call
+ * the packets of multiple RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO sessions.
+ * It is equivalent to calling *rte_ipsec_pkt_cpu_prepare* and
+ * *rte_ipsec_pkt_process* for each group, except that the packets of all
+ * groups are handed together to the crypto device with
+ * *rte_cryptodev_sym_cpu_crypto_process_multi*, so that a multi-buffer
+ * device can process packets of different SAs in parallel.
+ * Expects that for each input packet:
+ *      - l2_len, l3_len are setup correctly
+ * Note that erroneous mbufs are not freed by the function,
+ * but are placed beyond last valid mbuf of their group.
+ * It is a user responsibility to handle them further.
+ * @param grp
+ *   The address of an array of *num* *rte_ipsec_group* structures,
+ *   with *id.ptr* pointing to the *rte_ipsec_session* object the packets
+ *   of the group belong to. On return, *rc* of each group is set to the
+ *   number of its packets successfully processed.
+ * @param num
+ *   The number of groups to process.
+ * @return
+ *   Number of successfully processed packets, with error code set in rte_errno.
+ */
+__rte_experimental
+uint32_t
+rte_ipsec_pkt_cpu_burst(struct rte_ipsec_group *grp, uint16_t num);
 
 /**
  * Enable per SA telemetry for a specific SA.
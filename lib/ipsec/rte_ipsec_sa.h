@@ -69,6 +69,17 @@ struct rte_ipsec_sa_prm {
  */
 #define	RTE_IPSEC_SAFLAG_SQN_ATOM	(1ULL << 0)
 
+/**
+ * Indicates that SA sequence number and replay window are updated
+ * with lock-free atomic operations, so that for inbound SA
+ * rte_ipsec_pkt_process() can be invoked concurrently by multiple
+ * threads for the same SA, without serialization by the caller.
+ * Replay window buckets are tagged with the range of sequence numbers
+ * they hold, so the window takes about twice the memory of the default one.
+ * Cannot be combined with RTE_IPSEC_SAFLAG_SQN_ATOM.
+ */
+#define	RTE_IPSEC_SAFLAG_SQN_LOCKFREE	(1ULL << 1)
+
 /**
  * SA type is an 64-bit value that contain the following information:
  * - IP version (IPv4/IPv6)
@@ -79,6 +90,7 @@ struct rte_ipsec_sa_prm {
  * - are SA SQN operations 'atomic'
  * - ESN enabled/disabled
  * - NAT-T UDP encapsulated (TUNNEL mode only)
+ * - are SA SQN operations lock-free
  * ...
  */
 
@@ -91,7 +103,8 @@ enum {
 	RTE_SATP_LOG2_ESN,
 	RTE_SATP_LOG2_ECN,
 	RTE_SATP_LOG2_DSCP,
-	RTE_SATP_LOG2_NATT
+	RTE_SATP_LOG2_NATT,
+	RTE_SATP_LOG2_SQN_LF
 };
 
 #define RTE_IPSEC_SATP_IPV_MASK		(1ULL << RTE_SATP_LOG2_IPV)
@@ -131,6 +144,10 @@ enum {
 #define RTE_IPSEC_SATP_NATT_DISABLE	(0ULL << RTE_SATP_LOG2_NATT)
 #define RTE_IPSEC_SATP_NATT_ENABLE	(1ULL << RTE_SATP_LOG2_NATT)
 
+#define RTE_IPSEC_SATP_SQN_LF_MASK	(1ULL << RTE_SATP_LOG2_SQN_LF)
+#define RTE_IPSEC_SATP_SQN_LF_DISABLE	(0ULL << RTE_SATP_LOG2_SQN_LF)
+#define RTE_IPSEC_SATP_SQN_LF_ENABLE	(1ULL << RTE_SATP_LOG2_SQN_LF)
+
 
 /**
  * get type of given SA
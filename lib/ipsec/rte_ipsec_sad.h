@@ -54,6 +54,13 @@ union rte_ipsec_sad_key {
 #define RTE_IPSEC_SAD_FLAG_IPV6			0x1
 /** Flag to support reader writer concurrency */
 #define RTE_IPSEC_SAD_FLAG_RW_CONCURRENCY	0x2
+/**
+ * Flag to store rules of all types in a single hash table.
+ * A lookup probes it once per rule type present in the SAD,
+ * without the dependent probes of the default layout.
+ * max_sa[] of all types are summed to size the table.
+ */
+#define RTE_IPSEC_SAD_FLAG_COMBINED		0x4
 
 /** IPsec SAD configuration structure */
 struct rte_ipsec_sad_conf {
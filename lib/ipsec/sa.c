@@ -120,6 +120,23 @@ replay_num_bucket(uint32_t wsz)
 	return nb;
 }
 
+/*
+ * for given size, calculate required number of lock-free buckets.
+ * One extra bucket is reserved for the one being taken over by
+ * the most recent SQN, while the oldest ones are still inside the window.
+ */
+static uint32_t
+replay_num_bucket_lf(uint32_t wsz)
+{
+	uint32_t nb;
+
+	nb = rte_align32pow2(RTE_ALIGN_MUL_CEIL(wsz, WINDOW_LF_BUCKET_SIZE) /
+		WINDOW_LF_BUCKET_SIZE + 1);
+	nb = RTE_MAX(nb, (uint32_t)WINDOW_BUCKET_MIN);
+
+	return nb;
+}
+
 static int32_t
 ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 {
@@ -138,7 +155,10 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 		wsz = ((type & RTE_IPSEC_SATP_ESN_MASK) ==
 			RTE_IPSEC_SATP_ESN_DISABLE) ?
 			wsz : RTE_MAX(wsz, (uint32_t)WINDOW_BUCKET_SIZE);
-		if (wsz != 0)
+		if (wsz != 0 && (type & RTE_IPSEC_SATP_SQN_LF_MASK) ==
+				RTE_IPSEC_SATP_SQN_LF_ENABLE)
+			n = replay_num_bucket_lf(wsz);
+		else if (wsz != 0)
 			n = replay_num_bucket(wsz);
 	}
 
@@ -238,11 +258,20 @@ fill_sa_type(const struct rte_ipsec_sa_prm *prm, uint64_t *type)
 		tp |= RTE_IPSEC_SATP_DSCP_ENABLE;
 
 	/* interpret flags */
+	if ((prm->flags & RTE_IPSEC_SAFLAG_SQN_ATOM) &&
+			(prm->flags & RTE_IPSEC_SAFLAG_SQN_LOCKFREE))
+		return -EINVAL;
+
 	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_ATOM)
 		tp |= RTE_IPSEC_SATP_SQN_ATOM;
 	else
 		tp |= RTE_IPSEC_SATP_SQN_RAW;
 
+	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_LOCKFREE)
+		tp |= RTE_IPSEC_SATP_SQN_LF_ENABLE;
+	else
+		tp |= RTE_IPSEC_SATP_SQN_LF_DISABLE;
+
 	*type = tp;
 	return 0;
 }
@@ -143,6 +143,19 @@ struct __rte_cache_aligned rte_ipsec_sa {
 
 };
 
+/*
+ * Per packet parameters for the CPU crypto engine,
+ * filled by the prepare stage of CPU_CRYPTO sessions.
+ */
+struct cpu_crypto_req {
+	struct rte_crypto_va_iova_ptr *iv;
+	struct rte_crypto_va_iova_ptr *aad;
+	struct rte_crypto_va_iova_ptr *dgst;
+	uint32_t *l4ofs;
+	uint32_t *clen;
+	uint64_t (*ivbuf)[IPSEC_MAX_IV_QWORD];
+};
+
 int
 ipsec_sa_pkt_func_select(const struct rte_ipsec_session *ss,
 	const struct rte_ipsec_sa *sa, struct rte_ipsec_sa_pkt_func *pf);
@@ -173,6 +186,11 @@ uint16_t
 cpu_inb_pkt_prepare(const struct rte_ipsec_session *ss,
 		struct rte_mbuf *mb[], uint16_t num);
 
+uint16_t
+cpu_inb_pkt_setup(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t num,
+		const struct cpu_crypto_req *req);
+
 /* outbound processing */
 
 uint16_t
@@ -218,4 +236,14 @@ uint16_t
 cpu_outb_trs_pkt_prepare(const struct rte_ipsec_session *ss,
 		struct rte_mbuf *mb[], uint16_t num);
 
+uint16_t
+cpu_outb_tun_pkt_setup(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t num,
+		const struct cpu_crypto_req *req);
+
+uint16_t
+cpu_outb_trs_pkt_setup(const struct rte_ipsec_session *ss,
+		struct rte_mbuf *mb[], uint16_t num,
+		const struct cpu_crypto_req *req);
+
 #endif /* _SA_H_ */
@@ -9,6 +9,7 @@
 #include <rte_malloc.h>
 #include <rte_errno.h>
 #include <rte_tailq.h>
+#include <rte_telemetry.h>
 #include <rte_ring_elem.h>
 
 #include "member.h"
@@ -16,6 +17,8 @@
 #include "rte_member_ht.h"
 #include "rte_member_vbf.h"
 #include "rte_member_sketch.h"
+#include "rte_member_cuckoo.h"
+#include "rte_member_bbf.h"
 
 TAILQ_HEAD(rte_member_list, rte_tailq_entry);
 static struct rte_tailq_elem rte_member_tailq = {
@@ -78,6 +81,12 @@ rte_member_free(struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_free_sketch(setsum);
 		break;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		rte_member_free_cuckoo(setsum);
+		break;
+	case RTE_MEMBER_TYPE_BBF:
+		rte_member_free_bbf(setsum);
+		break;
 	default:
 		break;
 	}
@@ -166,6 +175,12 @@ rte_member_create(const struct rte_member_parameters *params)
 	case RTE_MEMBER_TYPE_SKETCH:
 		ret = rte_member_create_sketch(setsum, params, sketch_key_ring);
 		break;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		ret = rte_member_create_cuckoo(setsum, params);
+		break;
+	case RTE_MEMBER_TYPE_BBF:
+		ret = rte_member_create_bbf(setsum, params);
+		break;
 	default:
 		goto error_unlock_exit;
 	}
@@ -202,6 +217,10 @@ rte_member_add(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_add_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_add_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_add_cuckoo(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_add_bbf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -236,6 +255,10 @@ rte_member_lookup(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_lookup_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_lookup_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_cuckoo(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_bbf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -256,6 +279,12 @@ rte_member_lookup_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_bulk_vbf(setsum, keys, num_keys,
 				set_ids);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_bulk_cuckoo(setsum, keys, num_keys,
+				set_ids);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_bulk_bbf(setsum, keys, num_keys,
+				set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -275,6 +304,12 @@ rte_member_lookup_multi(const struct rte_member_setsum *setsum, const void *key,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_multi_vbf(setsum, key, match_per_key,
 				set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_multi_cuckoo(setsum, key,
+				match_per_key, set_id);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_multi_bbf(setsum, key, match_per_key,
+				set_id);
 	default:
 		return -EINVAL;
 	}
@@ -297,6 +332,13 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_multi_bulk_vbf(setsum, keys, num_keys,
 				max_match_per_key, match_count, set_ids);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_multi_bulk_cuckoo(setsum, keys,
+				num_keys, max_match_per_key, match_count,
+				set_ids);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_multi_bulk_bbf(setsum, keys, num_keys,
+				max_match_per_key, match_count, set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -342,10 +384,13 @@ rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
 	switch (setsum->type) {
 	case RTE_MEMBER_TYPE_HT:
 		return rte_member_delete_ht(setsum, key, set_id);
-	/* current vBF implementation does not support delete function */
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_delete_cuckoo(setsum, key, set_id);
+	/* vBF and blocked bloom filter do not support delete function */
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_delete_sketch(setsum, key);
 	case RTE_MEMBER_TYPE_VBF:
+	case RTE_MEMBER_TYPE_BBF:
 	default:
 		return -EINVAL;
 	}
@@ -366,9 +411,87 @@ rte_member_reset(const struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_reset_sketch(setsum);
 		return;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		rte_member_reset_cuckoo(setsum);
+		return;
+	case RTE_MEMBER_TYPE_BBF:
+		rte_member_reset_bbf(setsum);
+		return;
 	default:
 		return;
 	}
 }
 
+int
+rte_member_sketch_merge(const struct rte_member_setsum *setsum, float decay)
+{
+	if (setsum == NULL || setsum->type != RTE_MEMBER_TYPE_SKETCH)
+		return -EINVAL;
+
+	return rte_member_merge_sketch(setsum, decay);
+}
+
+static int
+member_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	struct rte_member_list *member_list;
+	struct rte_tailq_entry *te;
+
+	member_list = RTE_TAILQ_CAST(rte_member_tailq.head, rte_member_list);
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	rte_mcfg_tailq_read_lock();
+	TAILQ_FOREACH(te, member_list, next) {
+		struct rte_member_setsum *setsum = te->data;
+
+		rte_tel_data_add_array_string(d, setsum->name);
+	}
+	rte_mcfg_tailq_read_unlock();
+
+	return 0;
+}
+
+static int
+member_handle_topk(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_member_list *member_list;
+	struct rte_tailq_entry *te;
+	int ret = -ENOENT;
+
+	if (params == NULL || strlen(params) == 0 ||
+			strlen(params) >= RTE_MEMBER_NAMESIZE)
+		return -EINVAL;
+
+	member_list = RTE_TAILQ_CAST(rte_member_tailq.head, rte_member_list);
+
+	/* Set-summary cannot be freed while being reported */
+	rte_mcfg_tailq_read_lock();
+	TAILQ_FOREACH(te, member_list, next) {
+		struct rte_member_setsum *setsum = te->data;
+
+		if (strncmp(params, setsum->name, RTE_MEMBER_NAMESIZE) != 0)
+			continue;
+
+		if (setsum->type == RTE_MEMBER_TYPE_SKETCH)
+			ret = rte_member_tel_topk_sketch(setsum, d);
+		else
+			ret = -ENOTSUP;
+		break;
+	}
+	rte_mcfg_tailq_read_unlock();
+
+	return ret;
+}
+
+RTE_INIT(member_init_telemetry)
+{
+	rte_telemetry_register_cmd("/member/list", member_handle_list,
+		"Returns list of available set-summaries. Takes no parameters");
+	rte_telemetry_register_cmd("/member/topk", member_handle_topk,
+		"Returns heavy hitters of a per lcore sketch. Parameters: setsum name.");
+}
+
 RTE_LOG_REGISTER_DEFAULT(librte_member_logtype, DEBUG);
@@ -48,6 +48,20 @@
  * |properties| used for heavy hitter       |
  * |          | detection.                  |
  * +----------+-----------------------------+
+ * +==========+=====================+=======================+
+ * |   type   |      cuckoo         |   blocked bloom (bbf) |
+ * +==========+=====================+=======================+
+ * |structure | 16-bit fingerprints | bloom filter split in |
+ * |          | in two buckets      | cache line blocks     |
+ * +----------+---------------------+-----------------------+
+ * |set id    | 1 only              | 1 only                |
+ * +----------+---------------------+-----------------------+
+ * |usages &  | large single set,   | large single set,     |
+ * |properties| can delete, fixed   | user-specified false- |
+ * |          | false-positive rate,| positive rate, one    |
+ * |          | no false-negative.  | cache line per lookup,|
+ * |          |                     | no deletion support.  |
+ * +----------+---------------------+-----------------------+
  * -->
  */
 
@@ -59,6 +73,7 @@
 #include <inttypes.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 /** The set ID type that stored internally in hash table based set summary. */
 typedef uint16_t member_set_t;
@@ -86,6 +101,13 @@ typedef uint16_t member_set_t;
 #define RTE_MEMBER_SKETCH_ALWAYS_BOUNDED 0x01
 /** For sketch, use the flag if to count packet size instead of packet count */
 #define RTE_MEMBER_SKETCH_COUNT_BYTE 0x02
+/**
+ * For sketch, use the flag to keep one sketch per lcore. Each lcore adds into
+ * its own sketch without any synchronization, the sketches being merged into
+ * the set-summary by rte_member_sketch_merge(). Queries and reports return the
+ * results of the last merge, top-k keys are also available through telemetry.
+ */
+#define RTE_MEMBER_SKETCH_PER_LCORE 0x04
 
 /** @internal Hash function used by membership library. */
 #if defined(RTE_ARCH_X86) || defined(__ARM_FEATURE_CRC32)
@@ -115,6 +137,8 @@ enum rte_member_setsum_type {
 	RTE_MEMBER_TYPE_HT = 0,  /**< Hash table based set summary. */
 	RTE_MEMBER_TYPE_VBF,     /**< Vector of bloom filters. */
 	RTE_MEMBER_TYPE_SKETCH,
+	RTE_MEMBER_TYPE_CUCKOO,  /**< Cuckoo filter, single set with deletion. */
+	RTE_MEMBER_TYPE_BBF,     /**< Blocked bloom filter, single set. */
 	RTE_MEMBER_NUM_TYPE
 };
 
@@ -122,6 +146,7 @@ enum rte_member_setsum_type {
 enum rte_member_sig_compare_function {
 	RTE_MEMBER_COMPARE_SCALAR = 0,
 	RTE_MEMBER_COMPARE_AVX2,
+	RTE_MEMBER_COMPARE_AVX512,
 	RTE_MEMBER_COMPARE_NUM
 };
 
@@ -204,6 +229,11 @@ struct __rte_cache_aligned rte_member_parameters {
 	 *
 	 * vBF setsummary is a vector of bloom filters. It is used when number
 	 * of sets is not big (less than 32 for current implementation).
+	 *
+	 * Cuckoo and blocked bloom filter setsummaries only test if a key is
+	 * in a single set, whose set id is 1. They are used for a large number
+	 * of keys: the cuckoo filter supports deletion, the blocked bloom
+	 * filter has the fastest lookup.
 	 */
 	enum rte_member_setsum_type type;
 
@@ -237,8 +267,11 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * likely to become full before the number of inserted keys equal to the
 	 * total number of entries.
 	 *
-	 * For vBF, num_keys equal to the expected number of keys that will
-	 * be inserted into the vBF. The implementation assumes the keys are
+	 * For cuckoo filter, num_keys is the number of keys the table is sized
+	 * for, insertions may fail with -ENOSPC beyond it.
+	 *
+	 * For vBF and blocked bloom filter, num_keys equal to the expected
+	 * number of keys that will be inserted into the filter. The implementation assumes the keys are
 	 * evenly distributed to each BF in vBF. This is used to calculate the
 	 * number of bits we need for each BF. User does not specify the size of
 	 * each BF directly because the optimal size depends on the num_keys
@@ -260,6 +293,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * summary. If other number of sets are needed, for example 5, the user
 	 * should allocate the minimum available value that larger than 5,
 	 * which is 8.
+	 *
+	 * Cuckoo and blocked bloom filter setsummaries ignore it, they hold a
+	 * single set.
 	 */
 	uint32_t num_set;
 
@@ -267,6 +303,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * false_positive_rate is only used for vBF, but not used for HT
 	 * setsummary.
 	 *
+	 * It is also used for blocked bloom filter, sized the same way as a
+	 * single BF, rounded up to a power of 2 count of 256-bit blocks.
+	 *
 	 * For vBF, false_positive_rate is the user-defined false positive rate
 	 * given expected number of inserted keys (num_keys). It is used to
 	 * calculate the total number of bits for each BF, and the number of
@@ -472,18 +511,21 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   RTE_MEMBER_NO_MATCH by default is set as 0.
  *   For HT mode, the set_id has range as [1, 0x7FFF], MSB is reserved.
  *   For vBF mode the set id is limited by the num_set parameter when create
- *   the set-summary. For sketch mode, this id is ignored.
+ *   the set-summary. For sketch mode, this id is ignored. For cuckoo and
+ *   blocked bloom filter modes, the set id must be 1.
  * @return
  *   HT (cache mode) and vBF should never fail unless the set_id is not in the
  *   valid range. In such case -EINVAL is returned.
  *   For HT (non-cache mode) it could fail with -ENOSPC error code when table is
- *   full.
+ *   full, and so could the cuckoo filter, which keeps all the keys inserted
+ *   before.
  *   For success it returns different values for different modes to provide
  *   extra information for users.
  *   Return 0 for HT (cache mode) if the add does not cause
  *   eviction, return 1 otherwise. Return 0 for non-cache mode if success,
  *   -ENOSPC for full, and 1 if cuckoo eviction happens.
- *   Always returns 0 for vBF mode and sketch.
+ *   Always returns 0 for vBF, cuckoo filter, blocked bloom filter and
+ *   sketch modes.
  */
 int
 rte_member_add(const struct rte_member_setsum *setsum, const void *key,
@@ -550,8 +592,39 @@ void
 rte_member_reset(const struct rte_member_setsum *setsum);
 
 /**
- * Delete items from the set-summary. Note that vBF does not support deletion
- * in current implementation. For vBF, error code of -EINVAL will be returned.
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Merge the per lcore sketches into a sketch set-summary created with
+ * RTE_MEMBER_SKETCH_PER_LCORE. Lcores may keep adding keys during the merge,
+ * which is expected to be called periodically by a single control thread.
+ *
+ * The counts merged before are first multiplied by the decay factor: 1 keeps
+ * counting since the creation, 0 only keeps the counts of the last period and
+ * values in between give an exponential decay of the older periods.
+ * Heavy hitter candidates are the keys seen by the lcores since the previous
+ * merge and the heavy hitters already known.
+ *
+ * Keys returned by rte_member_report_heavyhitter() are only valid until the
+ * next merge.
+ *
+ * @param setsum
+ *   Pointer to the set-summary.
+ * @param decay
+ *   Factor applied to the counts merged before, between 0 and 1.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters or if the set-summary is not
+ *   a per lcore sketch.
+ */
+__rte_experimental
+int
+rte_member_sketch_merge(const struct rte_member_setsum *setsum, float decay);
+
+/**
+ * Delete items from the set-summary. Note that vBF and blocked bloom filter
+ * do not support deletion in current implementation. For them, error code of
+ * -EINVAL will be returned. The cuckoo filter may delete the fingerprint of
+ * another key, so only keys known to be inserted should be deleted.
  *
  * @param setsum
  *   Pointer to the set-summary.
@@ -563,6 +636,7 @@ rte_member_reset(const struct rte_member_setsum *setsum);
  *   same signature.
  * @return
  *   If no entry found to delete, an error code of -ENOENT could be returned.
+ *   Per lcore sketches return -ENOTSUP.
  */
 int
 rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
@@ -0,0 +1,265 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_log.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_bbf.h"
+
+#if defined(RTE_ARCH_X86)
+#include "rte_member_filter_x86.h"
+#endif
+
+/*
+ * Blocked bloom filter, a single set summary where the first hash of a key
+ * selects one 256-bit block and the second hash sets one bit in each of the 8
+ * words of the block. A lookup touches a single cache line, where the vBF
+ * touches one per hash function, for a slightly higher false positive rate at
+ * the same size. The 8 bits of a key are tested at once in a 256-bit vector.
+ */
+
+static const uint32_t bbf_salts[RTE_MEMBER_BBF_BLOCK_WORDS] = {
+	RTE_MEMBER_BBF_SALTS
+};
+
+static inline void
+bbf_hash(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *blk, uint32_t *hash)
+{
+	uint32_t h1 = MEMBER_HASH_FUNC(key, ss->key_len, ss->prim_hash_seed);
+
+	*blk = h1 & ss->bucket_mask;
+	*hash = MEMBER_HASH_FUNC(&h1, sizeof(uint32_t), ss->sec_hash_seed);
+}
+
+static inline uint32_t
+bbf_bit(uint32_t hash, uint32_t i)
+{
+	return 1U << ((hash * bbf_salts[i]) >> 27);
+}
+
+static inline int
+bbf_block_test(const struct member_bbf_block *block, uint32_t hash)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_BBF_BLOCK_WORDS; i++)
+		if ((block->words[i] & bbf_bit(hash, i)) == 0)
+			return 0;
+	return 1;
+}
+
+static uint64_t
+bbf_test_bulk_scalar(const struct member_bbf_block *blocks,
+		const uint32_t *blk, const uint32_t *hash, uint32_t num_keys)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++)
+		if (bbf_block_test(&blocks[blk[i]], hash[i]))
+			hits |= 1ULL << i;
+	return hits;
+}
+
+/* Hash the keys and prefetch their blocks, then test them. */
+static uint64_t
+bbf_lookup_bulk(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys)
+{
+	const struct member_bbf_block *blocks = ss->table;
+	uint32_t blk[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t hash[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		bbf_hash(ss, keys[i], &blk[i], &hash[i]);
+		rte_prefetch0(&blocks[blk[i]]);
+	}
+
+	switch (ss->sig_cmp_fn) {
+#if defined(RTE_ARCH_X86) && defined(CC_FILTER_AVX512_SUPPORT)
+	case RTE_MEMBER_COMPARE_AVX512:
+		return member_bbf_test_bulk_avx512(blocks, blk, hash, num_keys);
+#endif
+#if defined(RTE_ARCH_X86) && defined(CC_FILTER_AVX2_SUPPORT)
+	case RTE_MEMBER_COMPARE_AVX2:
+		return member_bbf_test_bulk_avx2(blocks, blk, hash, num_keys);
+#endif
+	default:
+		return bbf_test_bulk_scalar(blocks, blk, hash, num_keys);
+	}
+}
+
+int
+rte_member_create_bbf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint32_t block_bits = RTE_MEMBER_BBF_BLOCK_WORDS * 32;
+
+	if (params->num_keys == 0 ||
+			params->false_positive_rate <= 0 ||
+			params->false_positive_rate >= 1) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR, "Membership BBF create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/* Bits of a plain bloom filter for the requested rate */
+	double bits = ceil(params->num_keys * log(params->false_positive_rate) /
+			log(1.0 / (pow(2.0, log(2.0)))));
+	double num_blocks = ceil(bits / block_bits);
+
+	if (num_blocks > RTE_MEMBER_ENTRIES_MAX / RTE_MEMBER_BBF_BLOCK_WORDS) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR, "Membership BBF false positive rate is too small");
+		return -EINVAL;
+	}
+
+	/* We round to power of 2 for performance during lookup */
+	ss->bucket_cnt = rte_align32pow2((uint32_t)num_blocks);
+	ss->bucket_mask = ss->bucket_cnt - 1;
+	ss->num_hashes = RTE_MEMBER_BBF_BLOCK_WORDS;
+	ss->num_set = 1;
+
+	/*
+	 * Keys spread over blocks as a Poisson distribution of mean l, each
+	 * block being a bloom filter with a 32-bit range per hash.
+	 * fp = sum(P(k keys in block) * (1 - (1 - 1/32)^k)^8)
+	 */
+	double l = (double)params->num_keys / ss->bucket_cnt;
+	double pk = exp(-l);
+	double new_fp = 0;
+	uint32_t k;
+
+	for (k = 0; k < l + 10 * sqrt(l) + 10; k++) {
+		new_fp += pk * pow(1 - pow(1 - 1.0 / 32, k),
+				RTE_MEMBER_BBF_BLOCK_WORDS);
+		pk = pk * l / (k + 1);
+	}
+
+	MEMBER_LOG(DEBUG, "blocked bloom filter created, "
+		"expects %u keys, needs %u blocks of %u bits, "
+		"with false positive rate set as %.5f, "
+		"The new calculated BBF false positive rate is %.5f",
+		params->num_keys, ss->bucket_cnt, block_bits,
+		params->false_positive_rate, new_fp);
+
+	ss->table = rte_zmalloc_socket(NULL,
+			ss->bucket_cnt * sizeof(struct member_bbf_block),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL)
+		return -ENOMEM;
+
+#if defined(RTE_ARCH_X86)
+	ss->sig_cmp_fn = member_filter_cmp_fn_select();
+#else
+	ss->sig_cmp_fn = RTE_MEMBER_COMPARE_SCALAR;
+#endif
+
+	return 0;
+}
+
+int
+rte_member_lookup_bbf(const struct rte_member_setsum *ss, const void *key,
+		member_set_t *set_id)
+{
+	const struct member_bbf_block *blocks = ss->table;
+	uint32_t blk, hash;
+
+	bbf_hash(ss, key, &blk, &hash);
+
+	if (bbf_block_test(&blocks[blk], hash)) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_bbf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	uint64_t hits = bbf_lookup_bulk(ss, keys, num_keys);
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++)
+		set_ids[i] = (hits >> i) & 1;
+
+	return rte_popcount64(hits);
+}
+
+uint32_t
+rte_member_lookup_multi_bbf(const struct rte_member_setsum *ss,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id)
+{
+	member_set_t tmp_set;
+
+	if (match_per_key == 0 ||
+			rte_member_lookup_bbf(ss, key, &tmp_set) == 0)
+		return 0;
+
+	set_id[0] = tmp_set;
+	return 1;
+}
+
+uint32_t
+rte_member_lookup_multi_bulk_bbf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	if (match_per_key != 0)
+		hits = bbf_lookup_bulk(ss, keys, num_keys);
+
+	for (i = 0; i < num_keys; i++) {
+		match_count[i] = (hits >> i) & 1;
+		if (match_count[i] != 0)
+			set_ids[i * match_per_key] = 1;
+	}
+
+	return rte_popcount64(hits);
+}
+
+int
+rte_member_add_bbf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	struct member_bbf_block *blocks = ss->table;
+	uint32_t i, blk, hash;
+
+	if (set_id > ss->num_set || set_id == RTE_MEMBER_NO_MATCH)
+		return -EINVAL;
+
+	bbf_hash(ss, key, &blk, &hash);
+
+	for (i = 0; i < RTE_MEMBER_BBF_BLOCK_WORDS; i++)
+		blocks[blk].words[i] |= bbf_bit(hash, i);
+	return 0;
+}
+
+void
+rte_member_free_bbf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+void
+rte_member_reset_bbf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, ss->bucket_cnt * sizeof(struct member_bbf_block));
+}
@@ -0,0 +1,348 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_random.h>
+#include <rte_log.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cuckoo.h"
+
+#if defined(RTE_ARCH_X86)
+#include "rte_member_filter_x86.h"
+#endif
+
+/*
+ * Cuckoo filter, a single set summary storing a 16-bit fingerprint of each key
+ * in one of two candidate buckets. The alternative bucket is derived from the
+ * current bucket and the fingerprint only, so that fingerprints can be
+ * relocated without the key, and deleted.
+ *
+ * A bucket holds 8 fingerprints in 16 bytes, so that both candidate buckets of
+ * a key are compared at once in a 256-bit vector. For a load factor of 95%, the
+ * false positive rate is about 2 * 8 * 0.95 / 2^16 = 0.023%, for 16.8 bits per
+ * key. A vBF with a single bloom filter needs 17.5 bits per key for the same
+ * rate, and cannot delete.
+ */
+
+/* Multiplier spreading the fingerprint over the bucket index bits. */
+#define MEMBER_CUCKOO_ALT_MUL 0x5bd1e995
+
+static inline member_fp_t
+cuckoo_fp(uint32_t h1)
+{
+	member_fp_t fp = h1 >> 16;
+
+	/* 0 is reserved for empty entries */
+	return fp != 0 ? fp : 1;
+}
+
+static inline uint32_t
+cuckoo_alt_bucket(const struct rte_member_setsum *ss, uint32_t bkt,
+		member_fp_t fp)
+{
+	return (bkt ^ ((uint32_t)fp * MEMBER_CUCKOO_ALT_MUL)) & ss->bucket_mask;
+}
+
+static inline void
+cuckoo_hash(const struct rte_member_setsum *ss, const void *key,
+		member_fp_t *fp, uint32_t *prim_bkt, uint32_t *sec_bkt)
+{
+	uint32_t h1 = MEMBER_HASH_FUNC(key, ss->key_len, ss->prim_hash_seed);
+	uint32_t h2 = MEMBER_HASH_FUNC(&h1, sizeof(uint32_t),
+						ss->sec_hash_seed);
+
+	*fp = cuckoo_fp(h1);
+	*prim_bkt = h2 & ss->bucket_mask;
+	*sec_bkt = cuckoo_alt_bucket(ss, *prim_bkt, *fp);
+}
+
+static inline int
+cuckoo_bucket_search(const struct member_cuckoo_bucket *bkt, member_fp_t fp)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_CUCKOO_BUCKET_ENTRIES; i++)
+		if (bkt->fps[i] == fp)
+			return i;
+	return -1;
+}
+
+static uint64_t
+cuckoo_search_bulk_scalar(const struct member_cuckoo_bucket *buckets,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++)
+		if (cuckoo_bucket_search(&buckets[prim_bkt[i]], fps[i]) >= 0 ||
+				cuckoo_bucket_search(&buckets[sec_bkt[i]],
+					fps[i]) >= 0)
+			hits |= 1ULL << i;
+	return hits;
+}
+
+static inline uint64_t
+cuckoo_search_bulk(const struct rte_member_setsum *ss,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys)
+{
+	switch (ss->sig_cmp_fn) {
+#if defined(RTE_ARCH_X86) && defined(CC_FILTER_AVX512_SUPPORT)
+	case RTE_MEMBER_COMPARE_AVX512:
+		return member_cuckoo_search_bulk_avx512(ss->table, fps,
+				prim_bkt, sec_bkt, num_keys);
+#endif
+#if defined(RTE_ARCH_X86) && defined(CC_FILTER_AVX2_SUPPORT)
+	case RTE_MEMBER_COMPARE_AVX2:
+		return member_cuckoo_search_bulk_avx2(ss->table, fps,
+				prim_bkt, sec_bkt, num_keys);
+#endif
+	default:
+		return cuckoo_search_bulk_scalar(ss->table, fps,
+				prim_bkt, sec_bkt, num_keys);
+	}
+}
+
+/* Hash the keys and prefetch their buckets, then search them. */
+static uint64_t
+cuckoo_lookup_bulk(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys)
+{
+	const struct member_cuckoo_bucket *buckets = ss->table;
+	uint32_t prim_bkt[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t sec_bkt[RTE_MEMBER_LOOKUP_BULK_MAX];
+	member_fp_t fps[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		cuckoo_hash(ss, keys[i], &fps[i], &prim_bkt[i], &sec_bkt[i]);
+		rte_prefetch0(&buckets[prim_bkt[i]]);
+		rte_prefetch0(&buckets[sec_bkt[i]]);
+	}
+
+	return cuckoo_search_bulk(ss, fps, prim_bkt, sec_bkt, num_keys);
+}
+
+int
+rte_member_create_cuckoo(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	/* Size for a load factor below 95%, where insertions start to fail */
+	uint64_t num_entries = rte_align64pow2(params->num_keys +
+			params->num_keys / 16);
+
+	if (params->num_keys == 0 ||
+			num_entries > RTE_MEMBER_ENTRIES_MAX) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership cuckoo filter create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/* Two candidate buckets must differ */
+	uint32_t num_buckets = RTE_MAX(num_entries /
+			RTE_MEMBER_CUCKOO_BUCKET_ENTRIES, (uint64_t)2);
+
+	ss->table = rte_zmalloc_socket(NULL,
+			num_buckets * sizeof(struct member_cuckoo_bucket),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for cuckoo filter "
+						"setsummary");
+		return -ENOMEM;
+	}
+
+	ss->num_set = 1;
+	ss->bucket_cnt = num_buckets;
+	ss->bucket_mask = num_buckets - 1;
+#if defined(RTE_ARCH_X86)
+	ss->sig_cmp_fn = member_filter_cmp_fn_select();
+#else
+	ss->sig_cmp_fn = RTE_MEMBER_COMPARE_SCALAR;
+#endif
+
+	MEMBER_LOG(DEBUG, "cuckoo filter created, "
+			"the table has %u buckets of %u fingerprints",
+			num_buckets, RTE_MEMBER_CUCKOO_BUCKET_ENTRIES);
+	return 0;
+}
+
+int
+rte_member_lookup_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t *set_id)
+{
+	const struct member_cuckoo_bucket *buckets = ss->table;
+	uint32_t prim_bkt, sec_bkt;
+	member_fp_t fp;
+
+	cuckoo_hash(ss, key, &fp, &prim_bkt, &sec_bkt);
+
+	if (cuckoo_bucket_search(&buckets[prim_bkt], fp) >= 0 ||
+			cuckoo_bucket_search(&buckets[sec_bkt], fp) >= 0) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_cuckoo(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	uint64_t hits = cuckoo_lookup_bulk(ss, keys, num_keys);
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++)
+		set_ids[i] = (hits >> i) & 1;
+
+	return rte_popcount64(hits);
+}
+
+uint32_t
+rte_member_lookup_multi_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id)
+{
+	member_set_t tmp_set;
+
+	if (match_per_key == 0 ||
+			rte_member_lookup_cuckoo(ss, key, &tmp_set) == 0)
+		return 0;
+
+	set_id[0] = tmp_set;
+	return 1;
+}
+
+uint32_t
+rte_member_lookup_multi_bulk_cuckoo(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	if (match_per_key != 0)
+		hits = cuckoo_lookup_bulk(ss, keys, num_keys);
+
+	for (i = 0; i < num_keys; i++) {
+		match_count[i] = (hits >> i) & 1;
+		if (match_count[i] != 0)
+			set_ids[i * match_per_key] = 1;
+	}
+
+	return rte_popcount64(hits);
+}
+
+static inline int
+cuckoo_bucket_insert(struct member_cuckoo_bucket *bkt, member_fp_t fp)
+{
+	int slot = cuckoo_bucket_search(bkt, 0);
+
+	if (slot >= 0)
+		bkt->fps[slot] = fp;
+	return slot;
+}
+
+int
+rte_member_add_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	struct member_cuckoo_bucket *buckets = ss->table;
+	uint32_t path_bkt[RTE_MEMBER_CUCKOO_MAX_KICKS];
+	uint8_t path_slot[RTE_MEMBER_CUCKOO_MAX_KICKS];
+	uint32_t prim_bkt, sec_bkt, bkt, slot, n;
+	member_fp_t fp, victim;
+
+	if (set_id > ss->num_set || set_id == RTE_MEMBER_NO_MATCH)
+		return -EINVAL;
+
+	cuckoo_hash(ss, key, &fp, &prim_bkt, &sec_bkt);
+
+	if (cuckoo_bucket_insert(&buckets[prim_bkt], fp) >= 0 ||
+			cuckoo_bucket_insert(&buckets[sec_bkt], fp) >= 0)
+		return 0;
+
+	/*
+	 * Both buckets are full: move a random fingerprint to its alternative
+	 * bucket, until one has room. The path is recorded to put every
+	 * fingerprint back if none is found, so that no key gets lost.
+	 */
+	bkt = (rte_rand() & 1) ? prim_bkt : sec_bkt;
+	for (n = 0; n < RTE_MEMBER_CUCKOO_MAX_KICKS; n++) {
+		slot = rte_rand() & (RTE_MEMBER_CUCKOO_BUCKET_ENTRIES - 1);
+		path_bkt[n] = bkt;
+		path_slot[n] = slot;
+
+		victim = buckets[bkt].fps[slot];
+		buckets[bkt].fps[slot] = fp;
+		fp = victim;
+
+		bkt = cuckoo_alt_bucket(ss, bkt, fp);
+		if (cuckoo_bucket_insert(&buckets[bkt], fp) >= 0)
+			return 0;
+	}
+
+	while (n-- > 0) {
+		bkt = path_bkt[n];
+		slot = path_slot[n];
+		victim = buckets[bkt].fps[slot];
+		buckets[bkt].fps[slot] = fp;
+		fp = victim;
+	}
+
+	return -ENOSPC;
+}
+
+void
+rte_member_free_cuckoo(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+int
+rte_member_delete_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	struct member_cuckoo_bucket *buckets = ss->table;
+	uint32_t prim_bkt, sec_bkt;
+	member_fp_t fp;
+	int slot;
+
+	if (set_id > ss->num_set || set_id == RTE_MEMBER_NO_MATCH)
+		return -EINVAL;
+
+	cuckoo_hash(ss, key, &fp, &prim_bkt, &sec_bkt);
+
+	slot = cuckoo_bucket_search(&buckets[prim_bkt], fp);
+	if (slot >= 0) {
+		buckets[prim_bkt].fps[slot] = 0;
+		return 0;
+	}
+
+	slot = cuckoo_bucket_search(&buckets[sec_bkt], fp);
+	if (slot >= 0) {
+		buckets[sec_bkt].fps[slot] = 0;
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+void
+rte_member_reset_cuckoo(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0,
+		ss->bucket_cnt * sizeof(struct member_cuckoo_bucket));
+}
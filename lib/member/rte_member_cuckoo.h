@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#ifndef _RTE_MEMBER_CUCKOO_H_
+#define _RTE_MEMBER_CUCKOO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fingerprint count per bucket, two buckets fit in a 256-bit vector. */
+#define RTE_MEMBER_CUCKOO_BUCKET_ENTRIES 8
+/* Maximum number of relocations when inserting into a full bucket pair. */
+#define RTE_MEMBER_CUCKOO_MAX_KICKS 500
+
+typedef uint16_t member_fp_t;		/* fingerprint size is 16 bit */
+
+/* The bucket struct for cuckoo filter setsum, 0 is an empty entry */
+struct __rte_aligned(16) member_cuckoo_bucket {
+	member_fp_t fps[RTE_MEMBER_CUCKOO_BUCKET_ENTRIES];
+};
+
+int
+rte_member_create_cuckoo(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_cuckoo(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+uint32_t
+rte_member_lookup_multi_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_multi_bulk_cuckoo(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids);
+
+int
+rte_member_add_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_free_cuckoo(struct rte_member_setsum *setsum);
+
+int
+rte_member_delete_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_reset_cuckoo(const struct rte_member_setsum *setsum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CUCKOO_H_ */
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <x86intrin.h>
+
+#include "rte_member.h"
+#include "rte_member_filter_x86.h"
+
+/* Both candidate buckets of a key fill one 256-bit vector. */
+uint64_t
+member_cuckoo_search_bulk_avx2(const struct member_cuckoo_bucket *buckets,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		__m256i bkts = _mm256_inserti128_si256(_mm256_castsi128_si256(
+				_mm_load_si128((const __m128i *)
+					buckets[prim_bkt[i]].fps)),
+				_mm_load_si128((const __m128i *)
+					buckets[sec_bkt[i]].fps), 1);
+		__m256i cmp = _mm256_cmpeq_epi16(bkts,
+				_mm256_set1_epi16(fps[i]));
+
+		if (_mm256_movemask_epi8(cmp) != 0)
+			hits |= 1ULL << i;
+	}
+	return hits;
+}
+
+/* The bits of a key in the 8 words of its block are tested at once. */
+uint64_t
+member_bbf_test_bulk_avx2(const struct member_bbf_block *blocks,
+		const uint32_t *blk, const uint32_t *hash, uint32_t num_keys)
+{
+	const __m256i salts = _mm256_setr_epi32(RTE_MEMBER_BBF_SALTS);
+	const __m256i one = _mm256_set1_epi32(1);
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		__m256i bits = _mm256_sllv_epi32(one, _mm256_srli_epi32(
+				_mm256_mullo_epi32(_mm256_set1_epi32(hash[i]),
+					salts), 27));
+		__m256i block = _mm256_load_si256((const __m256i *)
+				blocks[blk[i]].words);
+
+		/* All bits set in the block */
+		if (_mm256_testc_si256(block, bits))
+			hits |= 1ULL << i;
+	}
+	return hits;
+}
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <x86intrin.h>
+
+#include "rte_member.h"
+#include "rte_member_filter_x86.h"
+
+static inline __m512i
+cuckoo_buckets_load(const struct member_cuckoo_bucket *buckets,
+		uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3)
+{
+	__m512i v = _mm512_castsi128_si512(
+			_mm_load_si128((const __m128i *)buckets[b0].fps));
+
+	v = _mm512_inserti32x4(v,
+			_mm_load_si128((const __m128i *)buckets[b1].fps), 1);
+	v = _mm512_inserti32x4(v,
+			_mm_load_si128((const __m128i *)buckets[b2].fps), 2);
+	return _mm512_inserti32x4(v,
+			_mm_load_si128((const __m128i *)buckets[b3].fps), 3);
+}
+
+/* The candidate buckets of two keys fill one 512-bit vector. */
+uint64_t
+member_cuckoo_search_bulk_avx512(const struct member_cuckoo_bucket *buckets,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys)
+{
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i + 1 < num_keys; i += 2) {
+		__m512i bkts = cuckoo_buckets_load(buckets,
+				prim_bkt[i], sec_bkt[i],
+				prim_bkt[i + 1], sec_bkt[i + 1]);
+		__m512i fp = _mm512_inserti64x4(_mm512_castsi256_si512(
+				_mm256_set1_epi16(fps[i])),
+				_mm256_set1_epi16(fps[i + 1]), 1);
+		__mmask32 m = _mm512_cmpeq_epi16_mask(bkts, fp);
+
+		hits |= (uint64_t)((m & 0xffff) != 0) << i;
+		hits |= (uint64_t)((m >> 16) != 0) << (i + 1);
+	}
+
+	/* Odd key: only the lower half of the compare mask is used */
+	if (i < num_keys) {
+		__m512i bkts = cuckoo_buckets_load(buckets,
+				prim_bkt[i], sec_bkt[i],
+				prim_bkt[i], sec_bkt[i]);
+		__mmask32 m = _mm512_cmpeq_epi16_mask(bkts,
+				_mm512_set1_epi16(fps[i]));
+
+		hits |= (uint64_t)((m & 0xffff) != 0) << i;
+	}
+	return hits;
+}
+
+/* The blocks of two keys fill one 512-bit vector. */
+uint64_t
+member_bbf_test_bulk_avx512(const struct member_bbf_block *blocks,
+		const uint32_t *blk, const uint32_t *hash, uint32_t num_keys)
+{
+	const __m512i salts = _mm512_broadcast_i64x4(
+			_mm256_setr_epi32(RTE_MEMBER_BBF_SALTS));
+	const __m512i one = _mm512_set1_epi32(1);
+	uint64_t hits = 0;
+	uint32_t i;
+
+	for (i = 0; i + 1 < num_keys; i += 2) {
+		__m512i h = _mm512_inserti64x4(_mm512_castsi256_si512(
+				_mm256_set1_epi32(hash[i])),
+				_mm256_set1_epi32(hash[i + 1]), 1);
+		__m512i bits = _mm512_sllv_epi32(one, _mm512_srli_epi32(
+				_mm512_mullo_epi32(h, salts), 27));
+		__m512i block = _mm512_inserti64x4(_mm512_castsi256_si512(
+				_mm256_load_si256((const __m256i *)
+					blocks[blk[i]].words)),
+				_mm256_load_si256((const __m256i *)
+					blocks[blk[i + 1]].words), 1);
+		/* Words missing one of the key bits */
+		__mmask16 m = _mm512_cmpneq_epi32_mask(
+				_mm512_and_si512(block, bits), bits);
+
+		hits |= (uint64_t)((m & 0xff) == 0) << i;
+		hits |= (uint64_t)((m >> 8) == 0) << (i + 1);
+	}
+
+	if (i < num_keys) {
+		__m256i bits = _mm256_sllv_epi32(_mm512_castsi512_si256(one),
+				_mm256_srli_epi32(_mm256_mullo_epi32(
+					_mm256_set1_epi32(hash[i]),
+					_mm512_castsi512_si256(salts)), 27));
+		__m256i block = _mm256_load_si256((const __m256i *)
+				blocks[blk[i]].words);
+
+		hits |= (uint64_t)_mm256_testc_si256(block, bits) << i;
+	}
+	return hits;
+}
@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#ifndef _RTE_MEMBER_FILTER_X86_H_
+#define _RTE_MEMBER_FILTER_X86_H_
+
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
+
+#include "rte_member_bbf.h"
+#include "rte_member_cuckoo.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bulk lookups of the cuckoo and blocked bloom filters, on hashes computed
+ * beforehand. They return the bit mask of the keys found in the filter.
+ */
+
+uint64_t
+member_cuckoo_search_bulk_avx2(const struct member_cuckoo_bucket *buckets,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys);
+
+uint64_t
+member_bbf_test_bulk_avx2(const struct member_bbf_block *blocks,
+		const uint32_t *blk, const uint32_t *hash, uint32_t num_keys);
+
+uint64_t
+member_cuckoo_search_bulk_avx512(const struct member_cuckoo_bucket *buckets,
+		const member_fp_t *fps, const uint32_t *prim_bkt,
+		const uint32_t *sec_bkt, uint32_t num_keys);
+
+uint64_t
+member_bbf_test_bulk_avx512(const struct member_bbf_block *blocks,
+		const uint32_t *blk, const uint32_t *hash, uint32_t num_keys);
+
+/* Select the widest vector bulk lookup built and supported */
+static inline enum rte_member_sig_compare_function
+member_filter_cmp_fn_select(void)
+{
+#ifdef CC_FILTER_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512)
+		return RTE_MEMBER_COMPARE_AVX512;
+#endif
+#ifdef CC_FILTER_AVX2_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256)
+		return RTE_MEMBER_COMPARE_AVX2;
+#endif
+	return RTE_MEMBER_COMPARE_SCALAR;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_FILTER_X86_H_ */
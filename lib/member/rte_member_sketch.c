@@ -9,10 +9,15 @@
 #include <rte_malloc.h>
 #include <rte_memory.h>
 #include <rte_errno.h>
+#include <rte_lcore.h>
 #include <rte_log.h>
 #include <rte_random.h>
 #include <rte_prefetch.h>
 #include <rte_ring_elem.h>
+#include <rte_seqcount.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+#include <rte_telemetry.h>
 
 #include "member.h"
 #include "rte_member.h"
@@ -23,6 +28,12 @@
 #include "rte_member_sketch_avx512.h"
 #endif /* CC_AVX512_SUPPORT */
 
+/* Sketch of an lcore, in per lcore mode */
+struct sketch_lcore {
+	struct rte_member_setsum *ss;	/* Updated by the lcore only. */
+	uint64_t *merged;		/* Counters of ss already merged. */
+};
+
 struct __rte_cache_aligned sketch_runtime {
 	uint64_t pkt_cnt;
 	uint32_t until_next;
@@ -31,6 +42,17 @@ struct __rte_cache_aligned sketch_runtime {
 	struct node *report_array;
 	void *key_slots;
 	struct rte_ring *free_key_slots;
+
+	/* Per lcore mode, merged sketch */
+	struct sketch_lcore *lcores;	/* Indexed by lcore id. */
+	void *merge_keys;		/* Heavy hitters copied from an lcore. */
+	rte_spinlock_t merge_lock;	/* Merge against report. */
+	RTE_ATOMIC(uint32_t) merge_epoch;
+
+	/* Per lcore mode, sketch of an lcore */
+	rte_seqcount_t heap_sc;		/* Heap changes against merge. */
+	const RTE_ATOMIC(uint32_t) *shared_epoch;
+	uint32_t heap_epoch;
 };
 
 /*
@@ -108,6 +130,156 @@ medianof5(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e)
 		return b > c ? c : b;
 }
 
+static void
+sketch_lcore_free(struct sketch_lcore *lc)
+{
+	struct rte_member_setsum *lss = lc->ss;
+	struct sketch_runtime *runtime_var;
+
+	rte_free(lc->merged);
+	if (lss == NULL)
+		return;
+
+	/* The key slots ring is not in a memzone */
+	runtime_var = lss->runtime_var;
+	rte_free(lss->table);
+	rte_free(lss->hash_seeds);
+	rte_member_minheap_free(&runtime_var->heap);
+	rte_free(runtime_var->report_array);
+	rte_free(runtime_var->key_slots);
+	rte_free(runtime_var->free_key_slots);
+	rte_free(runtime_var);
+	rte_free(lss);
+}
+
+static void
+sketch_lcores_free(struct sketch_runtime *runtime_var)
+{
+	uint32_t lcore_id;
+
+	if (runtime_var->lcores == NULL)
+		return;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		sketch_lcore_free(&runtime_var->lcores[lcore_id]);
+
+	rte_free(runtime_var->merge_keys);
+	rte_free(runtime_var->lcores);
+	runtime_var->lcores = NULL;
+}
+
+static int
+sketch_lcore_create(struct rte_member_setsum *ss,
+		    const struct rte_member_parameters *params,
+		    uint32_t lcore_id)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	struct sketch_lcore *lc = &runtime_var->lcores[lcore_id];
+	struct rte_member_parameters lparams = *params;
+	struct sketch_runtime *lruntime;
+	struct rte_member_setsum *lss;
+	uint32_t ring_size;
+	struct rte_ring *r;
+	ssize_t ring_mem;
+
+	lc->merged = rte_zmalloc_socket(NULL,
+			sizeof(uint64_t) * ss->num_col * ss->num_row,
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (lc->merged == NULL)
+		return -ENOMEM;
+
+	/* Memory of the sketch is local to the lcore updating it */
+	lparams.socket_id = rte_lcore_to_socket_id(lcore_id);
+	lparams.extra_flag &= ~RTE_MEMBER_SKETCH_PER_LCORE;
+
+	/*
+	 * Ring names must be unique, but this ring is not looked up, so it
+	 * does not need to be in a memzone.
+	 */
+	ring_size = rte_align32pow2(params->top_k + 1);
+	ring_mem = rte_ring_get_memsize_elem(sizeof(uint32_t), ring_size);
+	if (ring_mem < 0)
+		return ring_mem;
+
+	r = rte_zmalloc_socket(NULL, ring_mem, RTE_CACHE_LINE_SIZE,
+			lparams.socket_id);
+	if (r == NULL)
+		return -ENOMEM;
+
+	if (rte_ring_init(r, "sketch_lcore", ring_size, 0) < 0) {
+		rte_free(r);
+		return -EINVAL;
+	}
+
+	lss = rte_zmalloc_socket(NULL, sizeof(*lss), RTE_CACHE_LINE_SIZE,
+			lparams.socket_id);
+	if (lss == NULL) {
+		rte_free(r);
+		return -ENOMEM;
+	}
+
+	lss->type = ss->type;
+	lss->key_len = ss->key_len;
+	lss->num_set = ss->num_set;
+	if (rte_member_create_sketch(lss, &lparams, r) < 0) {
+		rte_free(lss);
+		rte_free(r);
+		return -ENOMEM;
+	}
+	lc->ss = lss;
+
+	/* Same counters for the same key in all the sketches */
+	memcpy(lss->hash_seeds, ss->hash_seeds, sizeof(uint64_t) * ss->num_row);
+
+	lruntime = lss->runtime_var;
+	rte_seqcount_init(&lruntime->heap_sc);
+	lruntime->shared_epoch = &runtime_var->merge_epoch;
+
+	return 0;
+}
+
+/*
+ * Per lcore mode: each lcore adds to a sketch of its own, without any lock
+ * or atomic operation. They are merged on request into the sketch created,
+ * which serves the queries.
+ */
+static int
+sketch_lcores_create(struct rte_member_setsum *ss,
+		     const struct rte_member_parameters *params)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	uint32_t lcore_id;
+
+	runtime_var->lcores = rte_zmalloc_socket(NULL,
+			sizeof(struct sketch_lcore) * RTE_MAX_LCORE,
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	runtime_var->merge_keys = rte_zmalloc_socket(NULL,
+			ss->key_len * ss->topk, RTE_CACHE_LINE_SIZE,
+			ss->socket_id);
+	if (runtime_var->lcores == NULL || runtime_var->merge_keys == NULL)
+		goto error;
+
+	rte_spinlock_init(&runtime_var->merge_lock);
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (rte_eal_lcore_role(lcore_id) == ROLE_OFF)
+			continue;
+
+		if (sketch_lcore_create(ss, params, lcore_id) < 0)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	if (runtime_var->lcores != NULL)
+		sketch_lcores_free(runtime_var);
+	else
+		rte_free(runtime_var->merge_keys);
+	runtime_var->merge_keys = NULL;
+	return -ENOMEM;
+}
+
 int
 rte_member_create_sketch(struct rte_member_setsum *ss,
 			 const struct rte_member_parameters *params,
@@ -182,15 +354,14 @@ rte_member_create_sketch(struct rte_member_setsum *ss,
 			RTE_CACHE_LINE_SIZE, ss->socket_id);
 	if (ss->hash_seeds == NULL) {
 		MEMBER_LOG(ERR, "Sketch Hashseeds memory allocation failed");
-		return -ENOMEM;
+		goto error;
 	}
 
 	ss->runtime_var = rte_zmalloc_socket(NULL, sizeof(struct sketch_runtime),
 					RTE_CACHE_LINE_SIZE, ss->socket_id);
 	if (ss->runtime_var == NULL) {
 		MEMBER_LOG(ERR, "Sketch Runtime memory allocation failed");
-		rte_free(ss);
-		return -ENOMEM;
+		goto error;
 	}
 	runtime = ss->runtime_var;
 
@@ -218,14 +389,14 @@ rte_member_create_sketch(struct rte_member_setsum *ss,
 	if (rte_member_minheap_init(&(runtime->heap), params->top_k,
 			ss->socket_id, params->prim_hash_seed) < 0) {
 		MEMBER_LOG(ERR, "Sketch Minheap allocation failed");
-		goto error_runtime;
+		goto error_key_slots;
 	}
 
 	runtime->report_array = rte_zmalloc_socket(NULL, sizeof(struct node) * ss->topk,
 					RTE_CACHE_LINE_SIZE, ss->socket_id);
 	if (runtime->report_array == NULL) {
 		MEMBER_LOG(ERR, "Sketch Runtime Report Array allocation failed");
-		goto error_runtime;
+		goto error_heap;
 	}
 
 	for (i = 0; i < ss->num_row; i++)
@@ -240,18 +411,29 @@ rte_member_create_sketch(struct rte_member_setsum *ss,
 		ss->converge_thresh = 10 * pow(ss->error_rate, -2.0) * sqrt(log(1 / delta));
 	}
 
+	if ((params->extra_flag & RTE_MEMBER_SKETCH_PER_LCORE) &&
+			sketch_lcores_create(ss, params) < 0) {
+		MEMBER_LOG(ERR, "Sketch per lcore allocation failed");
+		goto error_report;
+	}
+
 	MEMBER_LOG(DEBUG, "Sketch created, "
 		"the total memory required is %u Bytes",  ss->num_col * ss->num_row * 8);
 
 	return 0;
 
-error_runtime:
+	/* The key slots ring is freed by the caller */
+error_report:
+	rte_free(runtime->report_array);
+error_heap:
 	rte_member_minheap_free(&runtime->heap);
-	rte_ring_free(runtime->free_key_slots);
+error_key_slots:
 	rte_free(runtime->key_slots);
 error:
-	rte_free(runtime);
-	rte_free(ss);
+	rte_free(ss->runtime_var);
+	rte_free(ss->hash_seeds);
+	rte_free(ss->table);
+	ss->runtime_var = NULL;
 
 	return -ENOMEM;
 }
@@ -346,7 +528,12 @@ rte_member_report_heavyhitter_sketch(const struct rte_member_setsum *setsum,
 	uint32_t i;
 	struct sketch_runtime *runtime_var = setsum->runtime_var;
 
-	rte_member_update_heap(setsum);
+	/* Merged sketch, heap and counts are up to date from the merge */
+	if (runtime_var->lcores != NULL)
+		rte_spinlock_lock(&runtime_var->merge_lock);
+	else
+		rte_member_update_heap(setsum);
+
 	rte_member_heapsort(&(runtime_var->heap), runtime_var->report_array);
 
 	for (i = 0; i < runtime_var->heap.size; i++) {
@@ -354,6 +541,9 @@ rte_member_report_heavyhitter_sketch(const struct rte_member_setsum *setsum,
 		count[i] = runtime_var->report_array[i].count;
 	}
 
+	if (runtime_var->lcores != NULL)
+		rte_spinlock_unlock(&runtime_var->merge_lock);
+
 	return runtime_var->heap.size;
 }
 
@@ -419,7 +609,7 @@ sketch_update_scalar(const struct rte_member_setsum *ss,
 }
 
 static void
-heap_update(const struct rte_member_setsum *ss, const void *key)
+topk_update(const struct rte_member_setsum *ss, const void *key)
 {
 	struct sketch_runtime *runtime_var = ss->runtime_var;
 	uint64_t key_cnt = 0;
@@ -454,6 +644,63 @@ heap_update(const struct rte_member_setsum *ss, const void *key)
 	}
 }
 
+static void
+heap_reset(const struct rte_member_setsum *ss)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	uint32_t i;
+
+	rte_member_minheap_reset(&runtime_var->heap);
+	rte_ring_reset(runtime_var->free_key_slots);
+
+	for (i = 0; i < ss->topk; i++)
+		rte_ring_sp_enqueue_elem(runtime_var->free_key_slots, &i, sizeof(uint32_t));
+}
+
+static void
+heap_update(const struct rte_member_setsum *ss, const void *key)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	uint32_t epoch;
+
+	if (likely(runtime_var->shared_epoch == NULL)) {
+		topk_update(ss, key);
+		return;
+	}
+
+	/* Sketch of an lcore, its heap is read by the merge */
+	epoch = rte_atomic_load_explicit(runtime_var->shared_epoch,
+			rte_memory_order_relaxed);
+
+	rte_seqcount_write_begin(&runtime_var->heap_sc);
+
+	/* Candidates of a merge are the keys seen since the previous one */
+	if (unlikely(epoch != runtime_var->heap_epoch)) {
+		heap_reset(ss);
+		runtime_var->heap_epoch = epoch;
+	}
+	topk_update(ss, key);
+
+	rte_seqcount_write_end(&runtime_var->heap_sc);
+}
+
+/* In per lcore mode, sketch updated by the calling lcore */
+static inline const struct rte_member_setsum *
+sketch_lcore_get(const struct rte_member_setsum *ss)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	uint32_t lcore_id;
+
+	if (likely(runtime_var->lcores == NULL))
+		return ss;
+
+	lcore_id = rte_lcore_id();
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return NULL;
+
+	return runtime_var->lcores[lcore_id].ss;
+}
+
 /*
  * Add a single packet into the sketch.
  * Sketch value is meatured by packet numbers in this mode.
@@ -464,8 +711,14 @@ rte_member_add_sketch(const struct rte_member_setsum *ss,
 		      __rte_unused member_set_t set_id)
 {
 	uint32_t cur_row;
-	struct sketch_runtime *runtime_var = ss->runtime_var;
-	uint32_t *until_next = &(runtime_var->until_next);
+	struct sketch_runtime *runtime_var;
+	uint32_t *until_next;
+
+	ss = sketch_lcore_get(ss);
+	if (unlikely(ss == NULL))
+		return -EINVAL;
+	runtime_var = ss->runtime_var;
+	until_next = &(runtime_var->until_next);
 
 	/*
 	 * If sketch is measured by byte count,
@@ -524,8 +777,14 @@ rte_member_add_sketch_byte_count(const struct rte_member_setsum *ss,
 				 const void *key,
 				 uint32_t byte_count)
 {
-	struct sketch_runtime *runtime_var = ss->runtime_var;
-	uint32_t *until_next = &(runtime_var->until_next);
+	struct sketch_runtime *runtime_var;
+	uint32_t *until_next;
+
+	ss = sketch_lcore_get(ss);
+	if (unlikely(ss == NULL))
+		return -EINVAL;
+	runtime_var = ss->runtime_var;
+	until_next = &(runtime_var->until_next);
 
 	/* should not call this API if not in count byte mode */
 	if (ss->count_byte == 0) {
@@ -556,6 +815,10 @@ rte_member_delete_sketch(const struct rte_member_setsum *ss,
 	struct sketch_runtime *runtime_var = ss->runtime_var;
 	int found;
 
+	/* Sketches of the lcores cannot be updated from here */
+	if (runtime_var->lcores != NULL)
+		return -ENOTSUP;
+
 	found = rte_member_minheap_find(&runtime_var->heap, key);
 	if (found < 0)
 		return -1;
@@ -571,7 +834,10 @@ rte_member_free_sketch(struct rte_member_setsum *ss)
 {
 	struct sketch_runtime *runtime_var = ss->runtime_var;
 
+	sketch_lcores_free(runtime_var);
 	rte_free(ss->table);
+	rte_free(ss->hash_seeds);
+	rte_free(runtime_var->report_array);
 	rte_member_minheap_free(&runtime_var->heap);
 	rte_free(runtime_var->key_slots);
 	rte_ring_free(runtime_var->free_key_slots);
@@ -583,12 +849,157 @@ rte_member_reset_sketch(const struct rte_member_setsum *ss)
 {
 	struct sketch_runtime *runtime_var = ss->runtime_var;
 	uint64_t *sketch = ss->table;
-	uint32_t i;
+	uint32_t lcore_id;
 
 	memset(sketch, 0, sizeof(uint64_t) * ss->num_col * ss->num_row);
-	rte_member_minheap_reset(&runtime_var->heap);
-	rte_ring_reset(runtime_var->free_key_slots);
+	heap_reset(ss);
 
-	for (i = 0; i < ss->topk; i++)
-		rte_ring_sp_enqueue_elem(runtime_var->free_key_slots, &i, sizeof(uint32_t));
+	if (runtime_var->lcores == NULL)
+		return;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct sketch_lcore *lc = &runtime_var->lcores[lcore_id];
+
+		if (lc->ss == NULL)
+			continue;
+
+		rte_member_reset_sketch(lc->ss);
+		memset(lc->merged, 0,
+			sizeof(uint64_t) * ss->num_col * ss->num_row);
+	}
+}
+
+/*
+ * Merge the sketches of the lcores, while they keep adding to them. The
+ * counters are written by a single lcore, so the merge only reads them and
+ * adds the difference with the previous merge. Heavy hitters of an lcore are
+ * copied under a sequence counter, taken by the lcore when it changes them.
+ */
+int
+rte_member_merge_sketch(const struct rte_member_setsum *ss, float decay)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	uint32_t num_cnt = ss->num_col * ss->num_row;
+	uint64_t *count_array = ss->table;
+	uint32_t i, j, n, lcore_id, sn;
+
+	if (runtime_var->lcores == NULL || !(decay >= 0 && decay <= 1))
+		return -EINVAL;
+
+	rte_spinlock_lock(&runtime_var->merge_lock);
+
+	/* Exponential decay of the counts merged before */
+	if (decay != 1) {
+		for (i = 0; i < num_cnt; i++)
+			count_array[i] = count_array[i] * decay;
+	}
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct sketch_lcore *lc = &runtime_var->lcores[lcore_id];
+		const volatile uint64_t *lcore_cnt;
+
+		if (lc->ss == NULL)
+			continue;
+
+		lcore_cnt = lc->ss->table;
+		for (i = 0; i < num_cnt; i++) {
+			uint64_t cnt = lcore_cnt[i];
+
+			count_array[i] += cnt - lc->merged[i];
+			lc->merged[i] = cnt;
+		}
+	}
+
+	/* Counts of the heavy hitters changed, restore the heap order */
+	rte_member_update_heap(ss);
+	for (i = runtime_var->heap.size / 2; i-- > 0; )
+		rte_member_heapify(&runtime_var->heap, i, true);
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct sketch_lcore *lc = &runtime_var->lcores[lcore_id];
+		struct sketch_runtime *lruntime;
+
+		if (lc->ss == NULL)
+			continue;
+
+		lruntime = lc->ss->runtime_var;
+		do {
+			sn = rte_seqcount_read_begin(&lruntime->heap_sc);
+
+			n = RTE_MIN(lruntime->heap.size, ss->topk);
+			for (j = 0; j < n; j++) {
+				const void *key = lruntime->heap.elem[j].key;
+
+				/* Reset by the lcore, read again */
+				if (key == NULL)
+					continue;
+				memcpy(RTE_PTR_ADD(runtime_var->merge_keys,
+						j * ss->key_len), key, ss->key_len);
+			}
+		} while (rte_seqcount_read_retry(&lruntime->heap_sc, sn));
+
+		for (j = 0; j < n; j++)
+			topk_update(ss, RTE_PTR_ADD(runtime_var->merge_keys,
+					j * ss->key_len));
+	}
+
+	/* Let the lcores gather new candidates */
+	rte_atomic_fetch_add_explicit(&runtime_var->merge_epoch, 1,
+			rte_memory_order_relaxed);
+
+	rte_spinlock_unlock(&runtime_var->merge_lock);
+
+	return 0;
+}
+
+int
+rte_member_tel_topk_sketch(const struct rte_member_setsum *ss,
+			   struct rte_tel_data *d)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	char key_str[RTE_TEL_MAX_STRING_LEN];
+	struct rte_tel_data *counts, *keys;
+	uint32_t i, j, n;
+
+	/* Only the merged sketch is safe to read while packets are added */
+	if (runtime_var->lcores == NULL)
+		return -ENOTSUP;
+
+	keys = rte_tel_data_alloc();
+	counts = rte_tel_data_alloc();
+	if (keys == NULL || counts == NULL) {
+		rte_tel_data_free(keys);
+		rte_tel_data_free(counts);
+		return -ENOMEM;
+	}
+	rte_tel_data_start_array(keys, RTE_TEL_STRING_VAL);
+	rte_tel_data_start_array(counts, RTE_TEL_UINT_VAL);
+
+	rte_spinlock_lock(&runtime_var->merge_lock);
+
+	rte_member_heapsort(&runtime_var->heap, runtime_var->report_array);
+
+	n = RTE_MIN(runtime_var->heap.size, (uint32_t)RTE_TEL_MAX_ARRAY_ENTRIES);
+	for (i = 0; i < n; i++) {
+		const uint8_t *key = runtime_var->report_array[i].key;
+
+		/* Keys too long for a string are truncated */
+		for (j = 0; j < ss->key_len && 2 * j + 2 < sizeof(key_str); j++)
+			snprintf(&key_str[2 * j], 3, "%02x", key[j]);
+		key_str[2 * j] = '\0';
+
+		rte_tel_data_add_array_string(keys, key_str);
+		rte_tel_data_add_array_uint(counts,
+				runtime_var->report_array[i].count);
+	}
+
+	rte_spinlock_unlock(&runtime_var->merge_lock);
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "key_len", ss->key_len);
+	rte_tel_data_add_dict_uint(d, "top_k", ss->topk);
+	rte_tel_data_add_dict_container(d, "keys", keys, 0);
+	rte_tel_data_add_dict_container(d, "counts", counts, 0);
+
+	return 0;
 }
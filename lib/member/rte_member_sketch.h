@@ -7,6 +7,7 @@
 
 #include <rte_vect.h>
 #include <rte_ring_elem.h>
+#include <rte_telemetry.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +72,13 @@ rte_member_report_heavyhitter_sketch(const struct rte_member_setsum *setsum,
 void
 rte_member_update_heap(const struct rte_member_setsum *ss);
 
+int
+rte_member_merge_sketch(const struct rte_member_setsum *ss, float decay);
+
+int
+rte_member_tel_topk_sketch(const struct rte_member_setsum *ss,
+			   struct rte_tel_data *d);
+
 static __rte_always_inline uint64_t
 count_min(const struct rte_member_setsum *ss, const uint32_t *hash_results)
 {
@@ -6,7 +6,10 @@
 #include <stdio.h>
 #include <math.h>
 
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
 #include <rte_cycles.h>
+#include <rte_prefetch.h>
 
 #include "rte_meter.h"
 
@@ -158,3 +161,353 @@ rte_meter_trtcm_rfc4115_config(
 
 	return 0;
 }
+
+/*
+ * Burst metering.
+ *
+ * Packets are metered in chunks. For each chunk, the number of elapsed token
+ * bucket periods is computed first for all the packets, in double precision.
+ * This avoids one integer division per packet and lets the compiler use SIMD
+ * instructions. Then the color logic is applied packet by packet, in order,
+ * so that a meter found several times in a burst is updated as with the per
+ * packet API.
+ */
+
+#define METER_BURST_CHUNK	32U
+
+/* Largest time difference the double precision period count is exact for */
+#define METER_TIME_DIFF_MAX	(UINT64_C(1) << 53)
+
+/* Compute floor(td / period), exact for td < METER_TIME_DIFF_MAX. */
+static inline void
+meter_periods_get(const uint64_t td[], const uint64_t period[],
+	uint64_t n_periods[], uint32_t n)
+{
+	uint32_t i;
+
+	for (i = 0; i != n; i++) {
+		uint64_t q = (uint64_t)((double)td[i] / (double)period[i]);
+		int64_t r = (int64_t)(td[i] - q * period[i]);
+
+		/* Rounded quotient is off by one at most */
+		q -= (r < 0);
+		q += (r >= (int64_t)period[i]);
+		n_periods[i] = q;
+	}
+}
+
+/*
+ * Periods to credit a bucket with: none when an earlier packet of the burst
+ * has already updated the bucket time.
+ */
+static inline uint64_t
+meter_periods_fixup(uint64_t time_last, uint64_t time_now, uint64_t time,
+	uint64_t period, uint64_t n_periods)
+{
+	if (time_now != time_last)
+		return 0;
+
+	if (unlikely(time - time_last >= METER_TIME_DIFF_MAX))
+		return (time - time_last) / period;
+
+	return n_periods;
+}
+
+static inline void
+meter_prefetch(void * const obj[], void * const prof[], uint32_t n)
+{
+	uint32_t i;
+
+	for (i = 0; i != n; i++) {
+		rte_prefetch0(obj[i]);
+		rte_prefetch0(prof[i]);
+	}
+}
+
+static void
+srtcm_check_burst(struct rte_meter_srtcm *m[], struct rte_meter_srtcm_profile *p[],
+	uint64_t time, const uint32_t pkt_len[], const enum rte_color pkt_color[],
+	enum rte_color color[], uint32_t n)
+{
+	uint64_t td[METER_BURST_CHUNK], period[METER_BURST_CHUNK];
+	uint64_t time_last[METER_BURST_CHUNK], n_periods[METER_BURST_CHUNK];
+	uint64_t np, tc, te;
+	uint32_t i, k, num;
+	enum rte_color c;
+
+	meter_prefetch((void * const *)m, (void * const *)p, RTE_MIN(n, METER_BURST_CHUNK));
+
+	for (k = 0; k < n; k += num) {
+		num = RTE_MIN(n - k, METER_BURST_CHUNK);
+
+		for (i = 0; i != num; i++) {
+			time_last[i] = m[k + i]->time;
+			td[i] = time - time_last[i];
+			period[i] = p[k + i]->cir_period;
+		}
+
+		if (n - k > num)
+			meter_prefetch((void * const *)&m[k + num], (void * const *)&p[k + num],
+				RTE_MIN(n - k - num, METER_BURST_CHUNK));
+
+		meter_periods_get(td, period, n_periods, num);
+
+		for (i = 0; i != num; i++) {
+			struct rte_meter_srtcm *mi = m[k + i];
+			struct rte_meter_srtcm_profile *pi = p[k + i];
+			uint32_t len = pkt_len[k + i];
+
+			np = meter_periods_fixup(time_last[i], mi->time, time, period[i],
+				n_periods[i]);
+			mi->time += np * pi->cir_period;
+
+			/* Put the tokens overflowing from tc into te bucket */
+			tc = mi->tc + np * pi->cir_bytes_per_period;
+			te = mi->te;
+			if (tc > pi->cbs) {
+				te += (tc - pi->cbs);
+				if (te > pi->ebs)
+					te = pi->ebs;
+				tc = pi->cbs;
+			}
+
+			c = (pkt_color != NULL) ? pkt_color[k + i] : RTE_COLOR_GREEN;
+
+			/* Color logic */
+			if (c == RTE_COLOR_GREEN && tc >= len) {
+				tc -= len;
+				c = RTE_COLOR_GREEN;
+			} else if (c != RTE_COLOR_RED && te >= len) {
+				te -= len;
+				c = RTE_COLOR_YELLOW;
+			} else {
+				c = RTE_COLOR_RED;
+			}
+
+			mi->tc = tc;
+			mi->te = te;
+			color[k + i] = c;
+		}
+	}
+}
+
+void
+rte_meter_srtcm_color_blind_check_burst(struct rte_meter_srtcm *m[],
+	struct rte_meter_srtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	srtcm_check_burst(m, p, time, pkt_len, NULL, color, n);
+}
+
+void
+rte_meter_srtcm_color_aware_check_burst(struct rte_meter_srtcm *m[],
+	struct rte_meter_srtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	srtcm_check_burst(m, p, time, pkt_len, pkt_color, color, n);
+}
+
+static void
+trtcm_check_burst(struct rte_meter_trtcm *m[], struct rte_meter_trtcm_profile *p[],
+	uint64_t time, const uint32_t pkt_len[], const enum rte_color pkt_color[],
+	enum rte_color color[], uint32_t n)
+{
+	uint64_t td_c[METER_BURST_CHUNK], period_c[METER_BURST_CHUNK];
+	uint64_t td_p[METER_BURST_CHUNK], period_p[METER_BURST_CHUNK];
+	uint64_t time_last_c[METER_BURST_CHUNK], n_periods_c[METER_BURST_CHUNK];
+	uint64_t time_last_p[METER_BURST_CHUNK], n_periods_p[METER_BURST_CHUNK];
+	uint64_t np_c, np_p, tc, tp;
+	uint32_t i, k, num;
+	enum rte_color c;
+
+	meter_prefetch((void * const *)m, (void * const *)p, RTE_MIN(n, METER_BURST_CHUNK));
+
+	for (k = 0; k < n; k += num) {
+		num = RTE_MIN(n - k, METER_BURST_CHUNK);
+
+		for (i = 0; i != num; i++) {
+			time_last_c[i] = m[k + i]->time_tc;
+			time_last_p[i] = m[k + i]->time_tp;
+			td_c[i] = time - time_last_c[i];
+			td_p[i] = time - time_last_p[i];
+			period_c[i] = p[k + i]->cir_period;
+			period_p[i] = p[k + i]->pir_period;
+		}
+
+		if (n - k > num)
+			meter_prefetch((void * const *)&m[k + num], (void * const *)&p[k + num],
+				RTE_MIN(n - k - num, METER_BURST_CHUNK));
+
+		meter_periods_get(td_c, period_c, n_periods_c, num);
+		meter_periods_get(td_p, period_p, n_periods_p, num);
+
+		for (i = 0; i != num; i++) {
+			struct rte_meter_trtcm *mi = m[k + i];
+			struct rte_meter_trtcm_profile *pi = p[k + i];
+			uint32_t len = pkt_len[k + i];
+
+			np_c = meter_periods_fixup(time_last_c[i], mi->time_tc, time,
+				period_c[i], n_periods_c[i]);
+			np_p = meter_periods_fixup(time_last_p[i], mi->time_tp, time,
+				period_p[i], n_periods_p[i]);
+			mi->time_tc += np_c * pi->cir_period;
+			mi->time_tp += np_p * pi->pir_period;
+
+			tc = mi->tc + np_c * pi->cir_bytes_per_period;
+			if (tc > pi->cbs)
+				tc = pi->cbs;
+
+			tp = mi->tp + np_p * pi->pir_bytes_per_period;
+			if (tp > pi->pbs)
+				tp = pi->pbs;
+
+			c = (pkt_color != NULL) ? pkt_color[k + i] : RTE_COLOR_GREEN;
+
+			/* Color logic */
+			if (c == RTE_COLOR_RED || tp < len) {
+				c = RTE_COLOR_RED;
+			} else if (c == RTE_COLOR_YELLOW || tc < len) {
+				tp -= len;
+				c = RTE_COLOR_YELLOW;
+			} else {
+				tc -= len;
+				tp -= len;
+				c = RTE_COLOR_GREEN;
+			}
+
+			mi->tc = tc;
+			mi->tp = tp;
+			color[k + i] = c;
+		}
+	}
+}
+
+void
+rte_meter_trtcm_color_blind_check_burst(struct rte_meter_trtcm *m[],
+	struct rte_meter_trtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	trtcm_check_burst(m, p, time, pkt_len, NULL, color, n);
+}
+
+void
+rte_meter_trtcm_color_aware_check_burst(struct rte_meter_trtcm *m[],
+	struct rte_meter_trtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	trtcm_check_burst(m, p, time, pkt_len, pkt_color, color, n);
+}
+
+static void
+trtcm_rfc4115_check_burst(struct rte_meter_trtcm_rfc4115 *m[],
+	struct rte_meter_trtcm_rfc4115_profile *p[], uint64_t time,
+	const uint32_t pkt_len[], const enum rte_color pkt_color[],
+	enum rte_color color[], uint32_t n)
+{
+	uint64_t td_c[METER_BURST_CHUNK], period_c[METER_BURST_CHUNK];
+	uint64_t td_e[METER_BURST_CHUNK], period_e[METER_BURST_CHUNK];
+	uint64_t time_last_c[METER_BURST_CHUNK], n_periods_c[METER_BURST_CHUNK];
+	uint64_t time_last_e[METER_BURST_CHUNK], n_periods_e[METER_BURST_CHUNK];
+	uint64_t np_c, np_e, tc, te;
+	uint32_t i, k, num;
+	enum rte_color c;
+
+	meter_prefetch((void * const *)m, (void * const *)p, RTE_MIN(n, METER_BURST_CHUNK));
+
+	for (k = 0; k < n; k += num) {
+		num = RTE_MIN(n - k, METER_BURST_CHUNK);
+
+		for (i = 0; i != num; i++) {
+			time_last_c[i] = m[k + i]->time_tc;
+			time_last_e[i] = m[k + i]->time_te;
+			td_c[i] = time - time_last_c[i];
+			td_e[i] = time - time_last_e[i];
+			period_c[i] = p[k + i]->cir_period;
+			period_e[i] = p[k + i]->eir_period;
+		}
+
+		if (n - k > num)
+			meter_prefetch((void * const *)&m[k + num], (void * const *)&p[k + num],
+				RTE_MIN(n - k - num, METER_BURST_CHUNK));
+
+		meter_periods_get(td_c, period_c, n_periods_c, num);
+		meter_periods_get(td_e, period_e, n_periods_e, num);
+
+		for (i = 0; i != num; i++) {
+			struct rte_meter_trtcm_rfc4115 *mi = m[k + i];
+			struct rte_meter_trtcm_rfc4115_profile *pi = p[k + i];
+			uint32_t len = pkt_len[k + i];
+
+			np_c = meter_periods_fixup(time_last_c[i], mi->time_tc, time,
+				period_c[i], n_periods_c[i]);
+			np_e = meter_periods_fixup(time_last_e[i], mi->time_te, time,
+				period_e[i], n_periods_e[i]);
+			mi->time_tc += np_c * pi->cir_period;
+			mi->time_te += np_e * pi->eir_period;
+
+			tc = mi->tc + np_c * pi->cir_bytes_per_period;
+			if (tc > pi->cbs)
+				tc = pi->cbs;
+
+			te = mi->te + np_e * pi->eir_bytes_per_period;
+			if (te > pi->ebs)
+				te = pi->ebs;
+
+			c = (pkt_color != NULL) ? pkt_color[k + i] : RTE_COLOR_GREEN;
+
+			/* Color logic */
+			if (c == RTE_COLOR_GREEN && tc >= len) {
+				tc -= len;
+				c = RTE_COLOR_GREEN;
+			} else if (c != RTE_COLOR_RED && te >= len) {
+				te -= len;
+				c = RTE_COLOR_YELLOW;
+			} else {
+				c = RTE_COLOR_RED;
+			}
+
+			mi->tc = tc;
+			mi->te = te;
+			color[k + i] = c;
+		}
+	}
+}
+
+void
+rte_meter_trtcm_rfc4115_color_blind_check_burst(
+	struct rte_meter_trtcm_rfc4115 *m[],
+	struct rte_meter_trtcm_rfc4115_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	trtcm_rfc4115_check_burst(m, p, time, pkt_len, NULL, color, n);
+}
+
+void
+rte_meter_trtcm_rfc4115_color_aware_check_burst(
+	struct rte_meter_trtcm_rfc4115 *m[],
+	struct rte_meter_trtcm_rfc4115_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n)
+{
+	trtcm_rfc4115_check_burst(m, p, time, pkt_len, pkt_color, color, n);
+}
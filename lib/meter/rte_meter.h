@@ -18,6 +18,8 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -311,6 +313,209 @@ rte_meter_trtcm_rfc4115_color_aware_check(
 	uint32_t pkt_len,
 	enum rte_color pkt_color);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * srTCM color blind traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_srtcm_color_blind_check() for each packet
+ * in order, with the same time stamp. A meter object may be present several
+ * times in the burst.
+ *
+ * @param m
+ *    Array of handles to the srTCM instance of each packet
+ * @param p
+ *    Array of srTCM profiles specified at srTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param color
+ *    Array to store the color assigned to each packet
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_srtcm_color_blind_check_burst(struct rte_meter_srtcm *m[],
+	struct rte_meter_srtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * srTCM color aware traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_srtcm_color_aware_check() for each packet
+ * in order, with the same time stamp. A meter object may be present several
+ * times in the burst.
+ *
+ * @param m
+ *    Array of handles to the srTCM instance of each packet
+ * @param p
+ *    Array of srTCM profiles specified at srTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param pkt_color
+ *    Array of input colors of the IP packets
+ * @param color
+ *    Array to store the color assigned to each packet, may be *pkt_color*
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_srtcm_color_aware_check_burst(struct rte_meter_srtcm *m[],
+	struct rte_meter_srtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * trTCM color blind traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_trtcm_color_blind_check() for each packet
+ * in order, with the same time stamp. A meter object may be present several
+ * times in the burst.
+ *
+ * @param m
+ *    Array of handles to the trTCM instance of each packet
+ * @param p
+ *    Array of trTCM profiles specified at trTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param color
+ *    Array to store the color assigned to each packet
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_trtcm_color_blind_check_burst(struct rte_meter_trtcm *m[],
+	struct rte_meter_trtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * trTCM color aware traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_trtcm_color_aware_check() for each packet
+ * in order, with the same time stamp. A meter object may be present several
+ * times in the burst.
+ *
+ * @param m
+ *    Array of handles to the trTCM instance of each packet
+ * @param p
+ *    Array of trTCM profiles specified at trTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param pkt_color
+ *    Array of input colors of the IP packets
+ * @param color
+ *    Array to store the color assigned to each packet, may be *pkt_color*
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_trtcm_color_aware_check_burst(struct rte_meter_trtcm *m[],
+	struct rte_meter_trtcm_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * trTCM RFC4115 color blind traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_trtcm_rfc4115_color_blind_check() for each
+ * packet in order, with the same time stamp. A meter object may be present
+ * several times in the burst.
+ *
+ * @param m
+ *    Array of handles to the trTCM instance of each packet
+ * @param p
+ *    Array of trTCM profiles specified at trTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param color
+ *    Array to store the color assigned to each packet
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_trtcm_rfc4115_color_blind_check_burst(
+	struct rte_meter_trtcm_rfc4115 *m[],
+	struct rte_meter_trtcm_rfc4115_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	enum rte_color color[],
+	uint32_t n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * trTCM RFC4115 color aware traffic metering of a burst of packets
+ *
+ * Equivalent to calling rte_meter_trtcm_rfc4115_color_aware_check() for each
+ * packet in order, with the same time stamp. A meter object may be present
+ * several times in the burst.
+ *
+ * @param m
+ *    Array of handles to the trTCM instance of each packet
+ * @param p
+ *    Array of trTCM profiles specified at trTCM object creation time
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles)
+ * @param pkt_len
+ *    Array of lengths of the IP packets (measured in bytes)
+ * @param pkt_color
+ *    Array of input colors of the IP packets
+ * @param color
+ *    Array to store the color assigned to each packet, may be *pkt_color*
+ * @param n
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_trtcm_rfc4115_color_aware_check_burst(
+	struct rte_meter_trtcm_rfc4115 *m[],
+	struct rte_meter_trtcm_rfc4115_profile *p[],
+	uint64_t time,
+	const uint32_t pkt_len[],
+	const enum rte_color pkt_color[],
+	enum rte_color color[],
+	uint32_t n);
+
 /*
  * Inline implementation of run-time methods
  */
@@ -162,6 +162,8 @@ struct entity_priv {
 		uint64_t is_status_report_required : 1;
 		/** Is out-of-order delivery enabled */
 		uint64_t is_out_of_order_delivery : 1;
+		/** Is attached to a parallel processing context. */
+		uint64_t is_parallel : 1;
 	} flags;
 	/** Crypto op pool. */
 	struct rte_mempool *cop_pool;
@@ -0,0 +1,212 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <rte_cryptodev.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_pause.h>
+#include <rte_pdcp.h>
+#include <rte_soring.h>
+
+#include "pdcp_entity.h"
+#include "pdcp_process.h"
+
+/*
+ * Parallel processing context of one PDCP entity.
+ *
+ * Packets are kept in a single stage soring: the distributor enqueues them in
+ * COUNT order, any number of workers acquire and process them concurrently and
+ * the merge point dequeues them in the original order, once every worker
+ * preceding in the ring has released its packets.
+ */
+struct __rte_cache_aligned rte_pdcp_parallel {
+	/** PDCP entity being processed. */
+	struct rte_pdcp_entity *entity;
+	/** Crypto op pool of the entity. */
+	struct rte_mempool *cop_pool;
+	/** Ordering ring, follows this structure in memory. */
+	struct rte_soring *sor;
+	/** Crypto device of the entity session. */
+	uint8_t dev_id;
+};
+
+struct rte_pdcp_parallel *
+rte_pdcp_parallel_create(const struct rte_pdcp_parallel_conf *conf)
+{
+	struct rte_soring_param prm = { 0 };
+	struct rte_pdcp_parallel *par;
+	struct entity_priv *en_priv;
+	size_t par_sz;
+	ssize_t sz;
+	int ret;
+
+	if (conf == NULL || conf->name == NULL || conf->entity == NULL) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	/*
+	 * Receiving workers derive COUNT from a RX_DELIV which may lag behind by up
+	 * to the number of in-flight packets. Keep that below the smallest reception
+	 * window, so that HFN is never estimated wrong.
+	 */
+	if (conf->nb_elem == 0 ||
+	    conf->nb_elem > pdcp_window_size_get(RTE_SECURITY_PDCP_SN_SIZE_12)) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	en_priv = entity_priv_get(conf->entity);
+	if (en_priv->flags.is_parallel) {
+		rte_errno = EEXIST;
+		return NULL;
+	}
+
+	prm.name = conf->name;
+	prm.elems = conf->nb_elem;
+	prm.elem_size = sizeof(struct rte_mbuf *);
+	prm.stages = 1;
+	prm.prod_synt = RTE_RING_SYNC_ST;
+	prm.cons_synt = RTE_RING_SYNC_ST;
+
+	sz = rte_soring_get_memsize(&prm);
+	if (sz < 0) {
+		rte_errno = -sz;
+		return NULL;
+	}
+
+	par_sz = RTE_CACHE_LINE_ROUNDUP(sizeof(*par));
+	par = rte_zmalloc_socket("pdcp_parallel", par_sz + sz, RTE_CACHE_LINE_SIZE,
+				 conf->socket_id);
+	if (par == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	par->sor = RTE_PTR_ADD(par, par_sz);
+	ret = rte_soring_init(par->sor, &prm);
+	if (ret != 0) {
+		rte_free(par);
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	par->entity = conf->entity;
+	par->cop_pool = en_priv->cop_pool;
+	par->dev_id = en_priv->dev_id;
+	en_priv->flags.is_parallel = 1;
+
+	return par;
+}
+
+void
+rte_pdcp_parallel_free(struct rte_pdcp_parallel *par)
+{
+	struct entity_priv *en_priv;
+
+	if (par == NULL)
+		return;
+
+	en_priv = entity_priv_get(par->entity);
+	en_priv->flags.is_parallel = 0;
+
+	rte_free(par);
+}
+
+uint16_t
+rte_pdcp_parallel_enqueue(struct rte_pdcp_parallel *par, struct rte_mbuf *mb[], uint16_t num)
+{
+	struct entity_priv *en_priv = entity_priv_get(par->entity);
+	uint32_t i, n;
+
+	/* Single producer, so all the free space seen here can be filled. */
+	n = RTE_MIN((uint32_t)num, rte_soring_free_count(par->sor));
+	if (n == 0)
+		return 0;
+
+	/* Assign COUNT before the packets get visible to the workers. */
+	if (en_priv->flags.is_ul_entity) {
+		for (i = 0; i != n; i++)
+			*pdcp_dynfield(mb[i]) = en_priv->state.tx_next++;
+	}
+
+	return rte_soring_enqueue_bulk(par->sor, mb, n, NULL);
+}
+
+uint16_t
+rte_pdcp_parallel_process(struct rte_pdcp_parallel *par, uint16_t qp_id, uint16_t num)
+{
+	struct rte_crypto_op *cop[RTE_PDCP_PARALLEL_BURST_MAX];
+	struct rte_mbuf *mb[RTE_PDCP_PARALLEL_BURST_MAX];
+	uint16_t i, k, n, nb_cop, nb_enq, nb_deq, nb_err;
+	struct rte_mbuf *m;
+	uint32_t ftoken;
+
+	num = RTE_MIN(num, RTE_PDCP_PARALLEL_BURST_MAX);
+	n = rte_soring_acquire_burst(par->sor, mb, 0, num, &ftoken, NULL);
+	if (n == 0)
+		return 0;
+
+	/*
+	 * Packets failing in pre-process or crypto stay flagged and get reported as
+	 * errors by the merge point, in order with the rest of the packets.
+	 */
+	for (i = 0; i != n; i++)
+		mb[i]->ol_flags |= RTE_MBUF_F_RX_SEC_OFFLOAD_FAILED;
+
+	nb_cop = rte_pdcp_pkt_pre_process(par->entity, mb, cop, n, &nb_err);
+
+	/* Submit the whole batch at once to the queue pair owned by the worker */
+	nb_enq = 0;
+	while (nb_enq != nb_cop) {
+		k = rte_cryptodev_enqueue_burst(par->dev_id, qp_id, cop + nb_enq,
+						nb_cop - nb_enq);
+		if (unlikely(k == 0))
+			break;
+		nb_enq += k;
+	}
+
+	if (unlikely(nb_enq != nb_cop))
+		rte_mempool_put_bulk(par->cop_pool, (void *)&cop[nb_enq], nb_cop - nb_enq);
+
+	nb_deq = 0;
+	while (nb_deq != nb_enq) {
+		k = rte_cryptodev_dequeue_burst(par->dev_id, qp_id, cop, nb_enq - nb_deq);
+		if (k == 0) {
+			rte_pause();
+			continue;
+		}
+
+		for (i = 0; i != k; i++) {
+			m = cop[i]->sym[0].m_src;
+			m->ol_flags |= RTE_MBUF_F_RX_SEC_OFFLOAD;
+			if (likely(cop[i]->status == RTE_CRYPTO_OP_STATUS_SUCCESS))
+				m->ol_flags &= ~RTE_MBUF_F_RX_SEC_OFFLOAD_FAILED;
+		}
+
+		/* Using mempool API since crypto API is not providing bulk free */
+		rte_mempool_put_bulk(par->cop_pool, (void *)cop, k);
+		nb_deq += k;
+	}
+
+	rte_soring_release(par->sor, NULL, 0, n, ftoken);
+
+	return n;
+}
+
+uint16_t
+rte_pdcp_parallel_dequeue(struct rte_pdcp_parallel *par, struct rte_mbuf *out_mb[],
+			  uint16_t num, uint16_t *nb_err)
+{
+	struct rte_mbuf *mb[num];
+	uint16_t n;
+
+	n = rte_soring_dequeue_burst(par->sor, mb, num, NULL);
+	if (n == 0) {
+		*nb_err = 0;
+		return 0;
+	}
+
+	return rte_pdcp_pkt_post_process(par->entity, mb, out_mb, n, nb_err);
+}
@@ -356,6 +356,19 @@ cop_prepare(const struct entity_priv *en_priv, struct rte_mbuf *mb, struct rte_c
 	__rte_crypto_sym_op_attach_sym_session(op, en_priv->crypto_sess);
 }
 
+/*
+ * In parallel mode COUNT is assigned by the distributor in arrival order and
+ * carried in the mbuf dynfield, so that workers need not share TX_NEXT.
+ */
+static inline uint32_t
+pdcp_tx_count_get(struct entity_priv *en_priv, struct rte_mbuf *mb)
+{
+	if (en_priv->flags.is_parallel)
+		return *pdcp_dynfield(mb);
+
+	return en_priv->state.tx_next++;
+}
+
 static inline bool
 pdcp_pre_process_uplane_sn_12_ul_set_sn(struct entity_priv *en_priv, struct rte_mbuf *mb,
 					uint32_t *count)
@@ -370,7 +383,7 @@ pdcp_pre_process_uplane_sn_12_ul_set_sn(struct entity_priv *en_priv, struct rte_
 		return false;
 
 	/* Update sequence num in the PDU header */
-	*count = en_priv->state.tx_next++;
+	*count = pdcp_tx_count_get(en_priv, mb);
 	sn = pdcp_sn_from_count_get(*count, RTE_SECURITY_PDCP_SN_SIZE_12);
 
 	pdu_hdr->d_c = RTE_PDCP_PDU_TYPE_DATA;
@@ -454,7 +467,7 @@ pdcp_pre_process_uplane_sn_18_ul_set_sn(struct entity_priv *en_priv, struct rte_
 		return false;
 
 	/* Update sequence num in the PDU header */
-	*count = en_priv->state.tx_next++;
+	*count = pdcp_tx_count_get(en_priv, mb);
 	sn = pdcp_sn_from_count_get(*count, RTE_SECURITY_PDCP_SN_SIZE_18);
 
 	pdu_hdr->d_c = RTE_PDCP_PDU_TYPE_DATA;
@@ -566,7 +579,7 @@ pdcp_pre_process_cplane_sn_12_ul(const struct rte_pdcp_entity *entity, struct rt
 			memset(mac_i, 0, RTE_PDCP_MAC_I_LEN);
 
 		/* Update sequence number in the PDU header */
-		count = en_priv->state.tx_next++;
+		count = pdcp_tx_count_get(en_priv, mb);
 		sn = pdcp_sn_from_count_get(count, RTE_SECURITY_PDCP_SN_SIZE_12);
 
 		pdu_hdr->sn_11_8 = ((sn & 0xf00) >> 8);
@@ -363,6 +363,143 @@ uint16_t
 rte_pdcp_t_reordering_expiry_handle(const struct rte_pdcp_entity *entity,
 				    struct rte_mbuf *out_mb[]);
 
+/** Maximum number of packets processed by one ``rte_pdcp_parallel_process`` call. */
+#define RTE_PDCP_PARALLEL_BURST_MAX 64
+
+/* Forward declaration. */
+struct rte_pdcp_parallel;
+
+/**
+ * PDCP parallel processing context configuration.
+ */
+struct rte_pdcp_parallel_conf {
+	/** Name of the context, used to name the ordering ring. */
+	const char *name;
+	/** PDCP entity to be processed in parallel. */
+	struct rte_pdcp_entity *entity;
+	/**
+	 * Maximum number of packets in flight, between
+	 * ``rte_pdcp_parallel_enqueue`` and ``rte_pdcp_parallel_dequeue``.
+	 * Must not exceed the reception window of 12 bit SN (2048).
+	 */
+	uint32_t nb_elem;
+	/** Socket to allocate memory on. */
+	int socket_id;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a parallel processing context for a PDCP entity.
+ *
+ * The traffic of the entity is split as follows:
+ * - one distributor lcore calls ``rte_pdcp_parallel_enqueue``, which assigns
+ *   COUNT for transmitting entities;
+ * - any number of worker lcores call ``rte_pdcp_parallel_process``, each with
+ *   its own queue pair of the crypto device of the entity;
+ * - one merge lcore calls ``rte_pdcp_parallel_dequeue``, which returns the
+ *   packets post-processed and in their enqueue order.
+ *
+ * While the context exists, the entity must not be used with
+ * ``rte_pdcp_pkt_pre_process``.
+ *
+ * @param conf
+ *   Parameters of the parallel processing context.
+ * @return
+ *   - Valid handle if success
+ *   - NULL in case of failure. rte_errno will be set to error code.
+ */
+__rte_experimental
+struct rte_pdcp_parallel *
+rte_pdcp_parallel_create(const struct rte_pdcp_parallel_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a parallel processing context. The entity is reverted to the regular
+ * processing. All enqueued packets must have been dequeued beforehand.
+ *
+ * @param par
+ *   Pointer to the parallel processing context. If NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_pdcp_parallel_free(struct rte_pdcp_parallel *par);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Distribute packets of the entity for parallel processing.
+ * Must not be called concurrently for the same context.
+ *
+ * @param par
+ *   Pointer to the parallel processing context.
+ * @param mb
+ *   The address of an array of *num* pointers to *rte_mbuf* structures.
+ * @param num
+ *   The number of packets to enqueue.
+ * @return
+ *   Number of packets enqueued, the first ones of *mb*.
+ */
+__rte_experimental
+uint16_t
+rte_pdcp_parallel_enqueue(struct rte_pdcp_parallel *par, struct rte_mbuf *mb[],
+			  uint16_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Pre-process up to *num* distributed packets, submit them as one batch to
+ * the given queue pair and wait for their completion. Packets failing
+ * pre-processing or crypto are flagged with *RTE_MBUF_F_RX_SEC_OFFLOAD_FAILED*
+ * and returned as errors by ``rte_pdcp_parallel_dequeue``.
+ *
+ * Can be called concurrently for the same context, each caller using a
+ * different queue pair.
+ *
+ * @param par
+ *   Pointer to the parallel processing context.
+ * @param qp_id
+ *   Queue pair of the crypto device of the entity, owned by the caller.
+ * @param num
+ *   The maximum number of packets to process, up to RTE_PDCP_PARALLEL_BURST_MAX.
+ * @return
+ *   Number of packets processed.
+ */
+__rte_experimental
+uint16_t
+rte_pdcp_parallel_process(struct rte_pdcp_parallel *par, uint16_t qp_id, uint16_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Collect processed packets in their enqueue order and post-process them.
+ * Must not be called concurrently for the same context.
+ *
+ * @param par
+ *   Pointer to the parallel processing context.
+ * @param[out] out_mb
+ *   The address of an array that can hold up to *rte_pdcp_entity.max_pkt_cache*
+ *   pointers to *rte_mbuf* structures to output packets after PDCP post-processing.
+ * @param num
+ *   The maximum number of packets to collect.
+ * @param[out] nb_err
+ *   The number of error packets returned in *out_mb* buffer.
+ * @return
+ *   Count of packets returned in *out_mb* buffer.
+ *
+ * @see rte_pdcp_pkt_post_process()
+ */
+__rte_experimental
+uint16_t
+rte_pdcp_parallel_dequeue(struct rte_pdcp_parallel *par, struct rte_mbuf *out_mb[],
+			  uint16_t num, uint16_t *nb_err);
+
 /**
  * The header 'rte_pdcp_group.h' depends on defines in 'rte_pdcp.h'.
  * So include in the end.
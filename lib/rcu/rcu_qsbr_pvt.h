@@ -14,6 +14,7 @@
 #include <rte_ring_elem.h>
 
 #include "rte_rcu_qsbr.h"
+#include "rte_rcu_ebr.h"
 
 /* Defer queue structure.
  * This structure holds the defer queue. The defer queue is used to
@@ -22,6 +23,8 @@
  */
 struct rte_rcu_qsbr_dq {
 	struct rte_rcu_qsbr *v; /**< RCU QSBR variable used by this queue.*/
+	struct rte_rcu_ebr *ebr;
+	/**< RCU EBR variable used by this queue, instead of 'v' when set. */
 	struct rte_ring *r;     /**< RCU QSBR defer queue. */
 	uint32_t size;
 	/**< Number of elements in the defer queue */
@@ -46,6 +49,20 @@ struct rte_rcu_qsbr_dq {
 	 */
 };
 
+/* EBR defer queue structure.
+ * It shares the QSBR defer queue implementation.
+ */
+struct rte_rcu_ebr_dq {
+	struct rte_rcu_qsbr_dq dq;
+};
+
+/* Create a defer queue whose grace periods are tracked by 'ebr',
+ * or by the QSBR variable in 'params' if 'ebr' is NULL.
+ */
+struct rte_rcu_qsbr_dq *
+__rte_rcu_dq_create(const struct rte_rcu_qsbr_dq_parameters *params,
+		struct rte_rcu_ebr *ebr);
+
 /* Internal structure to represent the element on the defer queue.
  * Use alias as a character array is type casted to a variable
  * of this structure type.
@@ -0,0 +1,318 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_errno.h>
+#include <rte_pause.h>
+
+#include "rte_rcu_ebr.h"
+#include "rcu_qsbr_pvt.h"
+
+#define RCU_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, RCU, "%s(): ", __func__, __VA_ARGS__)
+
+/* Get the memory size of EBR variable */
+size_t
+rte_rcu_ebr_get_memsize(uint32_t max_threads)
+{
+	size_t sz;
+
+	if (max_threads == 0) {
+		RCU_LOG(ERR, "Invalid max_threads %u", max_threads);
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	sz = sizeof(struct rte_rcu_ebr);
+
+	/* Add the size of reader state array */
+	sz += sizeof(struct rte_rcu_ebr_cnt) * max_threads;
+
+	/* Add the size of the registered thread ID bitmap array */
+	sz += __RTE_QSBR_THRID_ARRAY_SIZE(max_threads);
+
+	return sz;
+}
+
+/* Initialize an EBR variable */
+int
+rte_rcu_ebr_init(struct rte_rcu_ebr *v, uint32_t max_threads)
+{
+	size_t sz;
+
+	if (v == NULL) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	sz = rte_rcu_ebr_get_memsize(max_threads);
+	if (sz == 1)
+		return 1;
+
+	/* No thread is in a critical section */
+	memset(v, 0, sz);
+	v->max_threads = max_threads;
+	v->num_elems = RTE_ALIGN_MUL_CEIL(max_threads,
+			__RTE_QSBR_THRID_ARRAY_ELM_SIZE) /
+			__RTE_QSBR_THRID_ARRAY_ELM_SIZE;
+	v->epoch = __RTE_EBR_EPOCH_INIT;
+	v->acked_epoch = __RTE_EBR_EPOCH_INIT - 1;
+
+	return 0;
+}
+
+/* Register a reader thread on an EBR variable. */
+int
+rte_rcu_ebr_thread_register(struct rte_rcu_ebr *v, unsigned int thread_id)
+{
+	unsigned int i, id;
+	uint64_t old_bmap;
+
+	if (v == NULL || thread_id >= v->max_threads) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	id = thread_id & __RTE_QSBR_THRID_MASK;
+	i = thread_id >> __RTE_QSBR_THRID_INDEX_SHIFT;
+
+	old_bmap = rte_atomic_fetch_or_explicit(__RTE_EBR_THRID_ARRAY_ELM(v, i),
+						RTE_BIT64(id), rte_memory_order_release);
+	if (!(old_bmap & RTE_BIT64(id)))
+		rte_atomic_fetch_add_explicit(&v->num_threads, 1, rte_memory_order_relaxed);
+
+	return 0;
+}
+
+/* Remove a reader thread from an EBR variable. */
+int
+rte_rcu_ebr_thread_unregister(struct rte_rcu_ebr *v, unsigned int thread_id)
+{
+	unsigned int i, id;
+	uint64_t old_bmap;
+
+	if (v == NULL || thread_id >= v->max_threads) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	if (v->ebr_cnt[thread_id].nest != 0)
+		RCU_LOG(ERR, "Thread %u unregistered in a critical section", thread_id);
+
+	id = thread_id & __RTE_QSBR_THRID_MASK;
+	i = thread_id >> __RTE_QSBR_THRID_INDEX_SHIFT;
+
+	old_bmap = rte_atomic_fetch_and_explicit(__RTE_EBR_THRID_ARRAY_ELM(v, i),
+						 ~RTE_BIT64(id), rte_memory_order_release);
+	if (old_bmap & RTE_BIT64(id))
+		rte_atomic_fetch_sub_explicit(&v->num_threads, 1, rte_memory_order_relaxed);
+
+	return 0;
+}
+
+/* Start a grace period. */
+uint64_t
+rte_rcu_ebr_start(struct rte_rcu_ebr *v)
+{
+	uint64_t t;
+
+	RTE_ASSERT(v != NULL);
+
+	/* Release the changes to the shared data structure. */
+	t = rte_atomic_fetch_add_explicit(&v->epoch, 1, rte_memory_order_release) + 1;
+
+	/* The loads of the reader epochs must not move above the removal
+	 * of the elements from the data structure. Pairs with the barrier
+	 * in rte_rcu_ebr_read_lock: either the reader is seen in its
+	 * critical section, or it does not see the removed elements.
+	 */
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+
+	return t;
+}
+
+/* Check if a grace period is over. */
+int
+rte_rcu_ebr_check(struct rte_rcu_ebr *v, uint64_t t, bool wait)
+{
+	RTE_ATOMIC(uint64_t) *reg_thread_id;
+	uint32_t i, j, id;
+	uint64_t bmap;
+	uint64_t c;
+
+	RTE_ASSERT(v != NULL);
+
+	/* Check if a later grace period is already over */
+	if (likely(t <= rte_atomic_load_explicit(&v->acked_epoch,
+				rte_memory_order_acquire)))
+		return 1;
+
+	for (i = 0, reg_thread_id = __RTE_EBR_THRID_ARRAY_ELM(v, 0);
+		i < v->num_elems;
+		i++, reg_thread_id++) {
+		bmap = rte_atomic_load_explicit(reg_thread_id, rte_memory_order_acquire);
+		id = i << __RTE_QSBR_THRID_INDEX_SHIFT;
+
+		while (bmap) {
+			j = rte_ctz64(bmap);
+			c = rte_atomic_load_explicit(&v->ebr_cnt[id + j].epoch,
+					rte_memory_order_acquire);
+
+			/* Epoch is not checked for wrap-around condition
+			 * as it is a 64b counter.
+			 */
+			if (unlikely(c != __RTE_EBR_EPOCH_INACTIVE && c < t)) {
+				/* Reader in a critical section entered before
+				 * the grace period started.
+				 */
+				if (!wait)
+					return 0;
+
+				rte_pause();
+				/* This thread might have unregistered.
+				 * Re-read the bitmap.
+				 */
+				bmap = rte_atomic_load_explicit(reg_thread_id,
+						rte_memory_order_acquire);
+
+				continue;
+			}
+
+			bmap &= ~RTE_BIT64(j);
+		}
+	}
+
+	/* Readers entering a critical section from now on use an epoch
+	 * not older than 't', so all the grace periods up to 't' are over.
+	 * There might be multiple writers trying to update this. There is
+	 * no need to update this accurately using compare-and-swap.
+	 */
+	if (t > rte_atomic_load_explicit(&v->acked_epoch, rte_memory_order_relaxed))
+		rte_atomic_store_explicit(&v->acked_epoch, t, rte_memory_order_release);
+
+	return 1;
+}
+
+/* Wait for a full grace period. */
+void
+rte_rcu_ebr_synchronize(struct rte_rcu_ebr *v)
+{
+	uint64_t t;
+
+	RTE_ASSERT(v != NULL);
+
+	t = rte_rcu_ebr_start(v);
+	rte_rcu_ebr_check(v, t, true);
+}
+
+/* Dump the details of an EBR variable to a file. */
+int
+rte_rcu_ebr_dump(FILE *f, struct rte_rcu_ebr *v)
+{
+	uint64_t bmap;
+	uint32_t i, t, id;
+
+	if (v == NULL || f == NULL) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	fprintf(f, "\nEBR Variable @%p\n", v);
+
+	fprintf(f, "  EBR variable memory size = %zu\n",
+				rte_rcu_ebr_get_memsize(v->max_threads));
+	fprintf(f, "  Given # max threads = %u\n", v->max_threads);
+	fprintf(f, "  Current # threads = %u\n", v->num_threads);
+
+	fprintf(f, "  Epoch = %" PRIu64 "\n",
+			rte_atomic_load_explicit(&v->epoch, rte_memory_order_acquire));
+	fprintf(f, "  Latest Acknowledged Epoch = %" PRIu64 "\n",
+			rte_atomic_load_explicit(&v->acked_epoch, rte_memory_order_acquire));
+
+	fprintf(f, "Epochs of readers:\n");
+	for (i = 0; i < v->num_elems; i++) {
+		bmap = rte_atomic_load_explicit(__RTE_EBR_THRID_ARRAY_ELM(v, i),
+					rte_memory_order_acquire);
+		id = i << __RTE_QSBR_THRID_INDEX_SHIFT;
+		while (bmap) {
+			t = rte_ctz64(bmap);
+			fprintf(f, "thread ID = %u, epoch = %" PRIu64 "\n", id + t,
+				rte_atomic_load_explicit(&v->ebr_cnt[id + t].epoch,
+					rte_memory_order_relaxed));
+			bmap &= ~RTE_BIT64(t);
+		}
+	}
+
+	return 0;
+}
+
+/* Create a defer queue. The QSBR defer queue is used, with its grace
+ * periods tracked on the EBR variable.
+ */
+struct rte_rcu_ebr_dq *
+rte_rcu_ebr_dq_create(const struct rte_rcu_ebr_dq_parameters *params)
+{
+	struct rte_rcu_qsbr_dq_parameters qparams = {0};
+
+	if (params == NULL || params->v == NULL) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return NULL;
+	}
+
+	qparams.name = params->name;
+	qparams.flags = params->flags;
+	qparams.size = params->size;
+	qparams.esize = params->esize;
+	qparams.trigger_reclaim_limit = params->trigger_reclaim_limit;
+	qparams.max_reclaim_size = params->max_reclaim_size;
+	qparams.free_fn = params->free_fn;
+	qparams.p = params->p;
+
+	RTE_BUILD_BUG_ON(sizeof(struct rte_rcu_ebr_dq) !=
+			sizeof(struct rte_rcu_qsbr_dq));
+
+	return (struct rte_rcu_ebr_dq *)__rte_rcu_dq_create(&qparams, params->v);
+}
+
+/* Enqueue one resource to the defer queue. */
+int
+rte_rcu_ebr_dq_enqueue(struct rte_rcu_ebr_dq *dq, void *e)
+{
+	return rte_rcu_qsbr_dq_enqueue(dq == NULL ? NULL : &dq->dq, e);
+}
+
+/* Reclaim resources from the defer queue. */
+int
+rte_rcu_ebr_dq_reclaim(struct rte_rcu_ebr_dq *dq, unsigned int n,
+			unsigned int *freed, unsigned int *pending,
+			unsigned int *available)
+{
+	return rte_rcu_qsbr_dq_reclaim(dq == NULL ? NULL : &dq->dq, n,
+			freed, pending, available);
+}
+
+/* Delete a defer queue. */
+int
+rte_rcu_ebr_dq_delete(struct rte_rcu_ebr_dq *dq)
+{
+	return rte_rcu_qsbr_dq_delete(dq == NULL ? NULL : &dq->dq);
+}
@@ -0,0 +1,448 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#ifndef _RTE_RCU_EBR_H_
+#define _RTE_RCU_EBR_H_
+
+/**
+ * @file
+ *
+ * RTE Epoch Based Reclamation (EBR).
+ *
+ * Readers enclose their accesses to a shared data structure in explicit
+ * read-side critical sections. On entering a critical section, a reader
+ * publishes the current epoch. The writer starts a grace period by
+ * advancing the epoch, and the grace period is over once no reader is
+ * in a critical section entered in an older epoch.
+ *
+ * Contrary to QSBR, readers do not have to report quiescent states
+ * regularly: a thread outside of a critical section never delays the
+ * writer, whatever it does. This suits control threads and service
+ * lcores which block, at the cost of a full barrier on each entry
+ * in a critical section.
+ *
+ * The defer queue API is the same as the QSBR one.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_debug.h>
+#include <rte_atomic.h>
+#include <rte_rcu_qsbr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Registered thread IDs are stored in a bitmap, as for QSBR. */
+#define __RTE_EBR_THRID_ARRAY_ELM(v, i) ((uint64_t __rte_atomic *) \
+	((struct rte_rcu_ebr_cnt *)(v + 1) + v->max_threads) + i)
+
+#define __RTE_EBR_EPOCH_INACTIVE 0
+#define __RTE_EBR_EPOCH_INIT 1
+
+/* Reader thread state */
+struct __rte_cache_aligned rte_rcu_ebr_cnt {
+	RTE_ATOMIC(uint64_t) epoch;
+	/**< Epoch at the entry of the current critical section.
+	 *   Value 0 indicates the thread is not in a critical section.
+	 */
+	uint32_t nest;
+	/**< Nesting level of critical sections, only used by the reader. */
+};
+
+/* RTE Epoch Based Reclamation variable structure.
+ * It is followed in memory by the reader state array and
+ * the registered thread ID bitmap, both sized on 'max_threads'.
+ */
+struct __rte_cache_aligned rte_rcu_ebr {
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint64_t) epoch;
+	/**< Current epoch, advanced at the start of each grace period */
+	RTE_ATOMIC(uint64_t) acked_epoch;
+	/**< Latest grace period known to be over */
+
+	alignas(RTE_CACHE_LINE_SIZE) uint32_t num_elems;
+	/**< Number of elements in the thread ID array */
+	RTE_ATOMIC(uint32_t) num_threads;
+	/**< Number of threads currently using this EBR variable */
+	uint32_t max_threads;
+	/**< Maximum number of threads using this EBR variable */
+
+	alignas(RTE_CACHE_LINE_SIZE) struct rte_rcu_ebr_cnt ebr_cnt[];
+	/**< Reader state array of 'max_threads' elements */
+};
+
+#define RTE_RCU_EBR_DQ_NAMESIZE RTE_RCU_QSBR_DQ_NAMESIZE
+
+/**
+ * Enqueue and reclaim operations are multi-thread safe by default.
+ * Set this flag if multi-thread safety is not required.
+ */
+#define RTE_RCU_EBR_DQ_MT_UNSAFE RTE_RCU_QSBR_DQ_MT_UNSAFE
+
+/**
+ * Parameters used when creating the defer queue.
+ * These are the same as for the QSBR defer queue.
+ */
+struct rte_rcu_ebr_dq_parameters {
+	const char *name;
+	/**< Name of the queue. */
+	uint32_t flags;
+	/**< Flags to control API behaviors */
+	uint32_t size;
+	/**< Number of entries in queue. */
+	uint32_t esize;
+	/**< Size (in bytes) of each element in the defer queue.
+	 *   This has to be multiple of 4B.
+	 */
+	uint32_t trigger_reclaim_limit;
+	/**< Trigger automatic reclamation in rte_rcu_ebr_dq_enqueue,
+	 *   after the defer queue has at least these many resources waiting.
+	 *   If this is greater than 'size', auto reclamation is not triggered.
+	 */
+	uint32_t max_reclaim_size;
+	/**< When automatic reclamation is enabled, reclaim at the max
+	 *   these many resources.
+	 */
+	rte_rcu_qsbr_free_resource_t free_fn;
+	/**< Function to call to free the resource. */
+	void *p;
+	/**< Pointer passed to the free function. This can be NULL. */
+	struct rte_rcu_ebr *v;
+	/**< RCU EBR variable to use for this defer queue */
+};
+
+/* RTE EBR defer queue structure. */
+struct rte_rcu_ebr_dq;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the size of the memory occupied by an EBR variable.
+ *
+ * @param max_threads
+ *   Maximum number of reader threads using this variable.
+ * @return
+ *   On success - size of memory in bytes required for this EBR variable.
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - max_threads is 0
+ */
+__rte_experimental
+size_t
+rte_rcu_ebr_get_memsize(uint32_t max_threads);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Initialize an EBR variable.
+ *
+ * @param v
+ *   EBR variable
+ * @param max_threads
+ *   Maximum number of reader threads using this variable.
+ *   This should be the same value as passed to rte_rcu_ebr_get_memsize.
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - max_threads is 0 or 'v' is NULL.
+ */
+__rte_experimental
+int
+rte_rcu_ebr_init(struct rte_rcu_ebr *v, uint32_t max_threads);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register a reader thread on an EBR variable.
+ * This is implemented as a lock-free function. It is multi-thread safe.
+ * A thread must be registered before entering read-side critical sections.
+ *
+ * @param v
+ *   EBR variable
+ * @param thread_id
+ *   Reader thread ID, between 0 and (max_threads - 1).
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid parameters
+ */
+__rte_experimental
+int
+rte_rcu_ebr_thread_register(struct rte_rcu_ebr *v, unsigned int thread_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Remove a reader thread from an EBR variable.
+ * This is implemented as a lock-free function. It is multi-thread safe.
+ * The thread must not be in a read-side critical section.
+ *
+ * @param v
+ *   EBR variable
+ * @param thread_id
+ *   Reader thread ID
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid parameters
+ */
+__rte_experimental
+int
+rte_rcu_ebr_thread_unregister(struct rte_rcu_ebr *v, unsigned int thread_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enter a read-side critical section.
+ * Elements of the shared data structure loaded in the critical section
+ * are not freed before the thread leaves it.
+ * Critical sections can be nested, only the outermost one is tracked.
+ * The thread may block inside a critical section, but it delays all
+ * the grace periods started meanwhile.
+ *
+ * @param v
+ *   EBR variable
+ * @param thread_id
+ *   Registered reader thread ID
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_rcu_ebr_read_lock(struct rte_rcu_ebr *v, unsigned int thread_id)
+{
+	struct rte_rcu_ebr_cnt *c;
+	uint64_t e;
+
+	RTE_ASSERT(v != NULL && thread_id < v->max_threads);
+
+	c = &v->ebr_cnt[thread_id];
+	if (c->nest++ != 0)
+		return;
+
+	e = rte_atomic_load_explicit(&v->epoch, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&c->epoch, e, rte_memory_order_relaxed);
+
+	/* The loads of the shared data structure must not move above
+	 * the store of the epoch, or the writer could miss this reader
+	 * while it is already referencing removed elements.
+	 * Hence a store-load barrier is required.
+	 */
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Leave a read-side critical section.
+ *
+ * @param v
+ *   EBR variable
+ * @param thread_id
+ *   Registered reader thread ID
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_rcu_ebr_read_unlock(struct rte_rcu_ebr *v, unsigned int thread_id)
+{
+	struct rte_rcu_ebr_cnt *c;
+
+	RTE_ASSERT(v != NULL && thread_id < v->max_threads);
+
+	c = &v->ebr_cnt[thread_id];
+	RTE_ASSERT(c->nest != 0);
+	if (--c->nest != 0)
+		return;
+
+	/* The loads of the shared data structure must complete
+	 * before the writer sees this reader leaving.
+	 */
+	rte_atomic_store_explicit(&c->epoch, __RTE_EBR_EPOCH_INACTIVE,
+		rte_memory_order_release);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Start a grace period, after the elements to free have been removed
+ * from the shared data structure.
+ * This is implemented as a lock-free function. It is multi-thread safe.
+ *
+ * @param v
+ *   EBR variable
+ * @return
+ *   Token of this grace period, to pass to rte_rcu_ebr_check.
+ */
+__rte_experimental
+uint64_t
+rte_rcu_ebr_start(struct rte_rcu_ebr *v);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Check if a grace period is over, i.e. if all the reader threads
+ * in a critical section entered it after the grace period started.
+ * This is implemented as a lock-free function. It is multi-thread safe.
+ * When 'wait' is true, it must not be called from a read-side critical
+ * section on the same variable.
+ *
+ * @param v
+ *   EBR variable
+ * @param t
+ *   Token returned by rte_rcu_ebr_start
+ * @param wait
+ *   If true, block till the grace period is over.
+ * @return
+ *   - 0 if the grace period is not over.
+ *   - 1 if the grace period is over.
+ */
+__rte_experimental
+int
+rte_rcu_ebr_check(struct rte_rcu_ebr *v, uint64_t t, bool wait);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Wait for a full grace period.
+ * This is a wrapper around rte_rcu_ebr_start and rte_rcu_ebr_check.
+ * It must not be called from a read-side critical section on the same
+ * variable.
+ *
+ * @param v
+ *   EBR variable
+ */
+__rte_experimental
+void
+rte_rcu_ebr_synchronize(struct rte_rcu_ebr *v);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dump the details of an EBR variable to a file.
+ * It is NOT multi-thread safe.
+ *
+ * @param f
+ *   A pointer to a file for output
+ * @param v
+ *   EBR variable
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - NULL parameters are passed
+ */
+__rte_experimental
+int
+rte_rcu_ebr_dump(FILE *f, struct rte_rcu_ebr *v);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a defer queue, to store the elements that can be freed once
+ * a grace period of an EBR variable is over.
+ * See rte_rcu_qsbr_dq_create.
+ *
+ * @param params
+ *   Parameters to create a defer queue.
+ * @return
+ *   On success - Valid pointer to defer queue
+ *   On error - NULL
+ *   Possible rte_errno codes are:
+ *   - EINVAL - NULL parameters are passed
+ *   - ENOMEM - Not enough memory
+ */
+__rte_experimental
+struct rte_rcu_ebr_dq *
+rte_rcu_ebr_dq_create(const struct rte_rcu_ebr_dq_parameters *params);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue one resource to the defer queue and start the grace period.
+ * See rte_rcu_qsbr_dq_enqueue.
+ *
+ * @param dq
+ *   Defer queue to allocate an entry from.
+ * @param e
+ *   Pointer to resource data to copy to the defer queue.
+ * @return
+ *   On success - 0
+ *   On error - 1 with rte_errno set to
+ *   - EINVAL - NULL parameters are passed
+ *   - ENOSPC - Defer queue is full.
+ */
+__rte_experimental
+int
+rte_rcu_ebr_dq_enqueue(struct rte_rcu_ebr_dq *dq, void *e);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free resources from the defer queue.
+ * See rte_rcu_qsbr_dq_reclaim.
+ *
+ * @param dq
+ *   Defer queue to free an entry from.
+ * @param n
+ *   Maximum number of resources to free.
+ * @param freed
+ *   Number of resources that were freed.
+ * @param pending
+ *   Number of resources pending on the defer queue.
+ * @param available
+ *   Number of resources that can be added to the defer queue.
+ * @return
+ *   On success - 0
+ *   On error - 1 with rte_errno set to
+ *   - EINVAL - NULL parameters are passed
+ */
+__rte_experimental
+int
+rte_rcu_ebr_dq_reclaim(struct rte_rcu_ebr_dq *dq, unsigned int n,
+	unsigned int *freed, unsigned int *pending, unsigned int *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete a defer queue, after reclaiming all its resources.
+ * See rte_rcu_qsbr_dq_delete.
+ *
+ * @param dq
+ *   Defer queue to delete.
+ * @return
+ *   On success - 0
+ *   On error - 1
+ *   Possible rte_errno codes are:
+ *   - EAGAIN - Some of the resources have not completed their grace
+ *		period, try again.
+ */
+__rte_experimental
+int
+rte_rcu_ebr_dq_delete(struct rte_rcu_ebr_dq *dq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RCU_EBR_H_ */
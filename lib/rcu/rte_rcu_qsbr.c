@@ -237,13 +237,28 @@ rte_rcu_qsbr_dump(FILE *f, struct rte_rcu_qsbr *v)
  */
 struct rte_rcu_qsbr_dq *
 rte_rcu_qsbr_dq_create(const struct rte_rcu_qsbr_dq_parameters *params)
+{
+	if (params == NULL || params->v == NULL) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return NULL;
+	}
+
+	return __rte_rcu_dq_create(params, NULL);
+}
+
+/* Create a defer queue for either RCU flavor. */
+struct rte_rcu_qsbr_dq *
+__rte_rcu_dq_create(const struct rte_rcu_qsbr_dq_parameters *params,
+		struct rte_rcu_ebr *ebr)
 {
 	struct rte_rcu_qsbr_dq *dq;
 	uint32_t qs_fifo_size;
 	unsigned int flags;
 
 	if (params == NULL || params->free_fn == NULL ||
-		params->v == NULL || params->name == NULL ||
+		(params->v == NULL && ebr == NULL) || params->name == NULL ||
 		params->size == 0 || params->esize == 0 ||
 		(params->esize % 4 != 0)) {
 		RCU_LOG(ERR, "Invalid input parameter");
@@ -298,6 +313,7 @@ rte_rcu_qsbr_dq_create(const struct rte_rcu_qsbr_dq_parameters *params)
 	}
 
 	dq->v = params->v;
+	dq->ebr = ebr;
 	dq->size = params->size;
 	dq->esize = __RTE_QSBR_TOKEN_SIZE + params->esize;
 	dq->trigger_reclaim_limit = params->trigger_reclaim_limit;
@@ -308,6 +324,26 @@ rte_rcu_qsbr_dq_create(const struct rte_rcu_qsbr_dq_parameters *params)
 	return dq;
 }
 
+/* Start a grace period on the RCU variable of a defer queue. */
+static inline uint64_t
+rcu_dq_start(struct rte_rcu_qsbr_dq *dq)
+{
+	if (dq->ebr != NULL)
+		return rte_rcu_ebr_start(dq->ebr);
+
+	return rte_rcu_qsbr_start(dq->v);
+}
+
+/* Check if a grace period of a defer queue is over. */
+static inline int
+rcu_dq_check(struct rte_rcu_qsbr_dq *dq, uint64_t t)
+{
+	if (dq->ebr != NULL)
+		return rte_rcu_ebr_check(dq->ebr, t, false);
+
+	return rte_rcu_qsbr_check(dq->v, t, false);
+}
+
 /* Enqueue one resource to the defer queue to free after the grace
  * period is over.
  */
@@ -326,7 +362,7 @@ int rte_rcu_qsbr_dq_enqueue(struct rte_rcu_qsbr_dq *dq, void *e)
 	char data[dq->esize];
 	dq_elem = (__rte_rcu_qsbr_dq_elem_t *)data;
 	/* Start the grace period */
-	dq_elem->token = rte_rcu_qsbr_start(dq->v);
+	dq_elem->token = rcu_dq_start(dq);
 
 	/* Reclaim resources if the queue size has hit the reclaim
 	 * limit. This helps the queue from growing too large and
@@ -394,7 +430,7 @@ rte_rcu_qsbr_dq_reclaim(struct rte_rcu_qsbr_dq *dq, unsigned int n,
 		dq_elem = (__rte_rcu_qsbr_dq_elem_t *)data;
 
 		/* Reclaim the resource */
-		if (rte_rcu_qsbr_check(dq->v, dq_elem->token, false) != 1) {
+		if (rcu_dq_check(dq, dq_elem->token) != 1) {
 			rte_ring_dequeue_elem_finish(dq->r, 0);
 			break;
 		}
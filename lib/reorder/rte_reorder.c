@@ -13,6 +13,7 @@
 #include <rte_eal_memconfig.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
+#include <rte_soring.h>
 #include <rte_tailq.h>
 
 #include "rte_reorder.h"
@@ -32,6 +33,7 @@ EAL_REGISTER_TAILQ(rte_reorder_tailq)
 #define NO_FLAGS 0
 #define RTE_REORDER_PREFIX "RO_"
 #define RTE_REORDER_NAMESIZE 32
+#define RTE_REORDER_MP_FREE_BURST 64
 
 #define RTE_REORDER_SEQN_DYNFIELD_NAME "rte_reorder_seqn_dynfield"
 int rte_reorder_seqn_dynfield_offset = -1;
@@ -59,6 +61,27 @@ struct __rte_cache_aligned rte_reorder_buffer {
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
+static int
+rte_reorder_seqn_dynfield_register(void)
+{
+	static const struct rte_mbuf_dynfield reorder_seqn_dynfield_desc = {
+		.name = RTE_REORDER_SEQN_DYNFIELD_NAME,
+		.size = sizeof(rte_reorder_seqn_t),
+		.align = alignof(rte_reorder_seqn_t),
+	};
+
+	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
+	if (rte_reorder_seqn_dynfield_offset < 0) {
+		REORDER_LOG(ERR,
+			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
+			rte_errno);
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	return 0;
+}
+
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size)
 {
@@ -70,11 +93,6 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 		const char *name, unsigned int size)
 {
 	const unsigned int min_bufsize = rte_reorder_memory_footprint_get(size);
-	static const struct rte_mbuf_dynfield reorder_seqn_dynfield_desc = {
-		.name = RTE_REORDER_SEQN_DYNFIELD_NAME,
-		.size = sizeof(rte_reorder_seqn_t),
-		.align = alignof(rte_reorder_seqn_t),
-	};
 
 	if (b == NULL) {
 		REORDER_LOG(ERR, "Invalid reorder buffer parameter:"
@@ -101,14 +119,8 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 		return NULL;
 	}
 
-	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
-	if (rte_reorder_seqn_dynfield_offset < 0) {
-		REORDER_LOG(ERR,
-			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
-			rte_errno);
-		rte_errno = ENOMEM;
+	if (rte_reorder_seqn_dynfield_register() < 0)
 		return NULL;
-	}
 
 	memset(b, 0, bufsize);
 	strlcpy(b->name, name, sizeof(b->name));
@@ -553,3 +565,200 @@ rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_se
 
 	return 0;
 }
+
+/*
+ * Multi-producer reorder buffer.
+ *
+ * The order_buf/ready_buf pair of rte_reorder_buffer becomes one ring of
+ * min_seqn based slots: rte_reorder_mp_enqueue() fills the slots in sequence
+ * number order, workers take packets out of their slot and put them back
+ * once done, and draining stops at the first slot a worker still holds.
+ * The ring is a one stage rte_soring placed right after the structure.
+ */
+struct __rte_cache_aligned rte_reorder_mp {
+	char name[RTE_REORDER_NAMESIZE];
+	/** Sequence number the next enqueued packet gets. */
+	alignas(RTE_CACHE_LINE_SIZE) rte_reorder_seqn_t next_seqn;
+	/** Sequence number of the oldest packet not drained yet. */
+	alignas(RTE_CACHE_LINE_SIZE) rte_reorder_seqn_t min_seqn;
+	struct rte_soring *slots;
+};
+
+static void
+reorder_mp_slots_param(struct rte_soring_param *prm, const char *name,
+		unsigned int size)
+{
+	memset(prm, 0, sizeof(*prm));
+	prm->name = name;
+	prm->elems = size;
+	prm->elem_size = sizeof(struct rte_mbuf *);
+	prm->stages = 1;
+	/* one sequencer and one drain core, the workers use the stage */
+	prm->prod_synt = RTE_RING_SYNC_ST;
+	prm->cons_synt = RTE_RING_SYNC_ST;
+}
+
+struct rte_reorder_mp *
+rte_reorder_mp_create(const char *name, unsigned int socket_id, unsigned int size)
+{
+	struct rte_soring_param prm;
+	struct rte_reorder_mp *b;
+	unsigned int hdrsize;
+	ssize_t ringsize;
+	int ret;
+
+	if (name == NULL) {
+		REORDER_LOG(ERR, "Invalid reorder buffer name ptr:"
+					" NULL");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (!rte_is_power_of_2(size)) {
+		REORDER_LOG(ERR, "Invalid reorder buffer size"
+				" - Not a power of 2");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (rte_reorder_seqn_dynfield_register() < 0)
+		return NULL;
+
+	reorder_mp_slots_param(&prm, name, size);
+	ringsize = rte_soring_get_memsize(&prm);
+	if (ringsize < 0) {
+		REORDER_LOG(ERR, "Invalid reorder buffer size: %u", size);
+		rte_errno = -ringsize;
+		return NULL;
+	}
+
+	hdrsize = RTE_CACHE_LINE_ROUNDUP(sizeof(*b));
+	b = rte_zmalloc_socket("REORDER_MP", hdrsize + ringsize, 0, socket_id);
+	if (b == NULL) {
+		REORDER_LOG(ERR, "Memzone allocation failed");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(b->name, name, sizeof(b->name));
+	b->slots = RTE_PTR_ADD(b, hdrsize);
+	ret = rte_soring_init(b->slots, &prm);
+	if (ret != 0) {
+		REORDER_LOG(ERR, "Reorder buffer ring init failed: %d", ret);
+		rte_free(b);
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	return b;
+}
+
+void
+rte_reorder_mp_free(struct rte_reorder_mp *b)
+{
+	struct rte_mbuf *mbufs[RTE_REORDER_MP_FREE_BURST];
+	uint32_t i, n, token;
+
+	if (b == NULL)
+		return;
+
+	/*
+	 * Put back the packets no worker took, so they can be drained and
+	 * freed like the others. The ones held by a worker are its own.
+	 */
+	while ((n = rte_soring_acquire_burst(b->slots, mbufs, 0,
+			RTE_DIM(mbufs), &token, NULL)) != 0)
+		rte_soring_release(b->slots, NULL, 0, n, token);
+
+	while ((n = rte_soring_dequeue_burst(b->slots, mbufs,
+			RTE_DIM(mbufs), NULL)) != 0) {
+		for (i = 0; i != n; i++)
+			rte_pktmbuf_free(mbufs[i]);
+	}
+
+	rte_free(b);
+}
+
+unsigned int
+rte_reorder_mp_enqueue(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num)
+{
+	unsigned int i, n;
+
+	/*
+	 * The sequence numbers must be set before the workers can see the
+	 * packets. The ones of packets left out are set again next time.
+	 */
+	for (i = 0; i != num; i++)
+		*rte_reorder_seqn(mbufs[i]) = b->next_seqn + i;
+
+	n = rte_soring_enqueue_burst(b->slots, mbufs, num, NULL);
+	b->next_seqn += n;
+
+	return n;
+}
+
+unsigned int
+rte_reorder_mp_acquire(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num, uint32_t *token)
+{
+	return rte_soring_acquire_burst(b->slots, mbufs, 0, num, token, NULL);
+}
+
+void
+rte_reorder_mp_release(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num, uint32_t token)
+{
+	rte_soring_release(b->slots, mbufs, 0, num, token);
+}
+
+/*
+ * Take up to max_mbufs packets out of their slots, skipping the ones the
+ * workers dropped, whose slot was released empty.
+ */
+static unsigned int
+reorder_mp_drain_slots(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs)
+{
+	unsigned int i, n, drain_cnt;
+
+	n = rte_soring_dequeue_burst(b->slots, mbufs, max_mbufs, NULL);
+	b->min_seqn += n;
+
+	for (i = 0, drain_cnt = 0; i != n; i++) {
+		if (mbufs[i] != NULL)
+			mbufs[drain_cnt++] = mbufs[i];
+	}
+
+	return drain_cnt;
+}
+
+unsigned int
+rte_reorder_mp_drain(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs)
+{
+	return reorder_mp_drain_slots(b, mbufs, max_mbufs);
+}
+
+unsigned int
+rte_reorder_mp_drain_up_to_seqn(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs, rte_reorder_seqn_t seqn)
+{
+	/* sequence numbers wrap, compare their difference */
+	if ((int32_t)(seqn - b->min_seqn) <= 0)
+		return 0;
+
+	return reorder_mp_drain_slots(b, mbufs,
+			RTE_MIN(max_mbufs, seqn - b->min_seqn));
+}
+
+int
+rte_reorder_mp_min_seqn_set(struct rte_reorder_mp *b, rte_reorder_seqn_t min_seqn)
+{
+	if (rte_soring_count(b->slots) != 0)
+		return -ENOTEMPTY;
+
+	b->next_seqn = min_seqn;
+	b->min_seqn = min_seqn;
+
+	return 0;
+}
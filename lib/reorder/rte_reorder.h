@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 struct rte_reorder_buffer;
+struct rte_reorder_mp;
 
 typedef uint32_t rte_reorder_seqn_t;
 extern int rte_reorder_seqn_dynfield_offset;
@@ -231,6 +232,202 @@ __rte_experimental
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free multi-producer reorder buffer instance.
+ *
+ * Packets still in the buffer and not acquired by a worker are freed,
+ * whether they were released or never acquired.
+ * Packets acquired and not released yet belong to their worker, and keep
+ * the packets enqueued after them from being freed: the workers must have
+ * released all their packets beforehand.
+ *
+ * @param b
+ *   Pointer to multi-producer reorder buffer instance.
+ *   If b is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_reorder_mp_free(struct rte_reorder_mp *b);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a new multi-producer reorder buffer instance.
+ *
+ * Unlike rte_reorder_create(), where one core has to insert every packet
+ * to reorder, the order is recorded when packets enter the buffer:
+ * a single sequencer enqueues them with rte_reorder_mp_enqueue(),
+ * any number of workers acquire and release them concurrently
+ * with rte_reorder_mp_acquire() and rte_reorder_mp_release(),
+ * and a single core drains them in the original order.
+ *
+ * @param name
+ *   The name to be given to the reorder buffer instance.
+ * @param socket_id
+ *   The NUMA node on which the memory for the reorder buffer
+ *   instance is to be reserved.
+ * @param size
+ *   Max number of packets in flight between enqueue and drain,
+ *   must be a power of 2.
+ * @return
+ *   The initialized reorder buffer instance, or NULL on error
+ *   On error case, rte_errno will be set appropriately:
+ *    - ENOMEM - no appropriate memory area found
+ *    - EINVAL - invalid parameters
+ */
+__rte_experimental
+struct rte_reorder_mp *
+rte_reorder_mp_create(const char *name, unsigned int socket_id, unsigned int size)
+	__rte_malloc __rte_dealloc(rte_reorder_mp_free, 1);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enqueue packets in the multi-producer reorder buffer.
+ *
+ * Packets are given consecutive sequence numbers in rte_reorder_seqn(),
+ * their order of enqueue is the order in which they are drained.
+ * Not thread safe, only one core may enqueue to a given buffer.
+ *
+ * @param b
+ *   Multi-producer reorder buffer instance.
+ * @param mbufs
+ *   Array of packets to enqueue.
+ * @param num
+ *   The number of packets in the array.
+ * @return
+ *   Number of packets enqueued, less than num if the buffer is full.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mp_enqueue(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Acquire enqueued packets for processing.
+ *
+ * Thread safe, any number of workers may acquire from the same buffer.
+ * The packets belong to the worker until released with
+ * rte_reorder_mp_release().
+ *
+ * @param b
+ *   Multi-producer reorder buffer instance.
+ * @param mbufs
+ *   Array where acquired packets are stored.
+ * @param num
+ *   The number of elements in the mbufs array.
+ * @param token
+ *   Opaque value to pass to rte_reorder_mp_release().
+ * @return
+ *   Number of packets acquired.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mp_acquire(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num, uint32_t *token);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Release processed packets, making them available to drain
+ * once all the packets enqueued before them are released too.
+ *
+ * Thread safe, workers may release in any order.
+ *
+ * @param b
+ *   Multi-producer reorder buffer instance.
+ * @param mbufs
+ *   Packets to release, in the order they were acquired.
+ *   An entry may be replaced by another packet, or set to NULL
+ *   for a packet dropped by the worker, leaving a gap in the sequence.
+ *   If NULL, the acquired packets are released unchanged.
+ * @param num
+ *   The number of packets, as returned by rte_reorder_mp_acquire().
+ * @param token
+ *   Value obtained from rte_reorder_mp_acquire().
+ */
+__rte_experimental
+void
+rte_reorder_mp_release(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int num, uint32_t token);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch reordered packets from the multi-producer reorder buffer.
+ *
+ * Not thread safe, only one core may drain a given buffer.
+ *
+ * @param b
+ *   Multi-producer reorder buffer instance.
+ * @param mbufs
+ *   Array where reordered packets are stored.
+ * @param max_mbufs
+ *   The number of elements in the mbufs array.
+ * @return
+ *   Number of mbuf pointers written to mbufs. 0 <= N <= max_mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mp_drain(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch reordered packets up to specified sequence number (exclusive)
+ * from the multi-producer reorder buffer.
+ *
+ * Gaps are present for the packets dropped by the workers.
+ * Packets still processed by a worker are never skipped,
+ * the drain stops before them.
+ *
+ * @param b
+ *   Multi-producer reorder buffer instance.
+ * @param mbufs
+ *   Array where reordered packets are stored.
+ * @param max_mbufs
+ *   The number of elements in the mbufs array.
+ * @param seqn
+ *   Sequence number up to which buffer will be drained.
+ * @return
+ *   Number of mbuf pointers written to mbufs. 0 <= N <= max_mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mp_drain_up_to_seqn(struct rte_reorder_mp *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs, rte_reorder_seqn_t seqn);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Set the sequence number of the next packet enqueued
+ * in the multi-producer reorder buffer.
+ * To successfully set new value, the buffer has to be empty.
+ *
+ * @param b
+ *   Empty multi-producer reorder buffer instance to modify.
+ * @param min_seqn
+ *   New sequence number to set.
+ * @return
+ *   0 on success, -ENOTEMPTY if the buffer is not empty.
+ */
+__rte_experimental
+int
+rte_reorder_mp_min_seqn_set(struct rte_reorder_mp *b, rte_reorder_seqn_t min_seqn);
+
 #ifdef __cplusplus
 }
 #endif
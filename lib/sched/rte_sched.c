@@ -15,6 +15,8 @@
 #include <rte_mbuf.h>
 #include <rte_bitmap.h>
 #include <rte_reciprocal.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 
 #include "rte_sched.h"
 #include "rte_sched_log.h"
@@ -26,6 +28,20 @@
 #define RTE_SCHED_PORT_N_GRINDERS 8
 #endif
 
+/* Port credits shards may run ahead of the port time, in frames of MTU size */
+#ifndef RTE_SCHED_PORT_SHARD_BURST
+#define RTE_SCHED_PORT_SHARD_BURST 64
+#endif
+
+/* Maximum number of buckets of the virtual clock calendar, power of 2 */
+#ifndef RTE_SCHED_VCLOCK_BUCKETS
+#define RTE_SCHED_VCLOCK_BUCKETS 4096
+#endif
+
+/* Virtual clock time unit: 1 / 2^RTE_SCHED_VCLOCK_SHIFT byte of port time */
+#define RTE_SCHED_VCLOCK_SHIFT                16
+#define RTE_SCHED_VCLOCK_BURST_MAX            (INT64_MAX >> 2)
+
 #define RTE_SCHED_TB_RATE_CONFIG_ERR          (1e-7)
 #define RTE_SCHED_WRR_SHIFT                   3
 #define RTE_SCHED_MAX_QUEUES_PER_TC           RTE_SCHED_BE_QUEUES_PER_PIPE
@@ -51,6 +67,16 @@ struct rte_sched_pipe_profile {
 
 	/* Pipe best-effort traffic class queues */
 	uint8_t  wrr_cost[RTE_SCHED_BE_QUEUES_PER_PIPE];
+
+	/* Virtual clock: port time per pipe byte, and burst */
+	uint64_t vc_cost;
+	uint64_t vc_burst;
+};
+
+struct rte_sched_vclock_pipe {
+	uint64_t tat; /* theoretical arrival time of the next packet */
+	uint32_t next; /* next pipe in the same calendar bucket */
+	uint16_t qmask; /* active queues */
 };
 
 struct __rte_cache_aligned rte_sched_pipe {
@@ -71,6 +97,9 @@ struct __rte_cache_aligned rte_sched_pipe {
 	/* TC oversubscription */
 	uint64_t tc_ov_credits;
 	uint8_t tc_ov_period_id;
+
+	/* Virtual clock, in the padding of the cache line */
+	struct rte_sched_vclock_pipe vc;
 };
 
 struct rte_sched_queue {
@@ -93,6 +122,34 @@ enum grinder_state {
 	e_GRINDER_READ_MBUF
 };
 
+struct rte_sched_vclock_bucket {
+	uint32_t head;
+	uint32_t tail;
+};
+
+/*
+ * Virtual clock scheduler of a subport. Active pipes are kept in a calendar
+ * queue sorted by the theoretical arrival time of their next packet, in
+ * buckets of one MTU of port time. The pipe at the head of the earliest
+ * bucket is served once its bucket time is reached.
+ *
+ * When the subport is congested, the due pipes fall behind the port time.
+ * Rather than clamping each of them to its burst, which would break their
+ * relative order, the subport time is delayed by the offset, so that the
+ * earliest due pipe never lags behind by more than the smallest pipe burst.
+ */
+struct rte_sched_vclock {
+	uint64_t cursor; /* time of the earliest bucket */
+	uint64_t offset; /* subport time = port time - offset */
+	uint64_t lag_max;
+	uint32_t bucket_shift;
+	uint32_t bucket_mask; /* number of buckets - 1 */
+	uint32_t n_active;
+	struct rte_sched_pipe *pipe;
+	uint64_t bmp[RTE_SCHED_VCLOCK_BUCKETS / 64];
+	struct rte_sched_vclock_bucket bucket[];
+};
+
 struct rte_sched_subport_profile {
 	/* Token bucket (TB) */
 	uint64_t tb_period;
@@ -202,6 +259,9 @@ struct __rte_cache_aligned rte_sched_subport {
 	/* TC oversubscription activation */
 	int tc_ov_enabled;
 
+	/* Virtual clock scheduler, NULL when the grinders are used */
+	struct rte_sched_vclock *vc;
+
 	struct rte_sched_pipe *pipe;
 	struct rte_sched_queue *queue;
 	struct rte_sched_queue_extra *queue_extra;
@@ -238,6 +298,25 @@ struct __rte_cache_aligned rte_sched_port {
 	uint32_t n_pkts_out;
 	uint32_t subport_id;
 
+	/* Range of subports dequeued by this instance */
+	uint32_t subport_id_min;
+	uint32_t subport_id_max;
+
+	/* Sharding: port the shard belongs to, NULL when not a shard */
+	struct rte_sched_port *parent;
+
+	/* Port time reserved by the shards, measured in bytes */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint64_t) shard_time;
+
+	/*
+	 * CPU time shared by the shards, advanced by whichever shard holds
+	 * the lock. The bytes are read without the lock.
+	 */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint64_t) shard_cpu_bytes;
+	uint64_t shard_cpu_cycles;
+	rte_spinlock_t shard_lock;
+	struct rte_reciprocal_u64 shard_inv_cycles_per_byte;
+
 	/* Large data structures */
 	struct rte_sched_subport_profile *subport_profiles;
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_sched_subport *subports[0];
@@ -742,6 +821,14 @@ rte_sched_pipe_profile_convert(struct rte_sched_subport *subport,
 	dst->wrr_cost[1] = (uint8_t) wrr_cost[1];
 	dst->wrr_cost[2] = (uint8_t) wrr_cost[2];
 	dst->wrr_cost[3] = (uint8_t) wrr_cost[3];
+
+	/* Virtual clock */
+	dst->vc_cost = ((rate << RTE_SCHED_VCLOCK_SHIFT) + src->tb_rate / 2) /
+		src->tb_rate;
+	if (src->tb_size > RTE_SCHED_VCLOCK_BURST_MAX / dst->vc_cost)
+		dst->vc_burst = RTE_SCHED_VCLOCK_BURST_MAX;
+	else
+		dst->vc_burst = src->tb_size * dst->vc_cost;
 }
 
 static void
@@ -1007,15 +1094,82 @@ rte_sched_port_config(struct rte_sched_port_params *params)
 		/ params->rate;
 	port->inv_cycles_per_byte = rte_reciprocal_value(cycles_per_byte);
 	port->cycles_per_byte = cycles_per_byte;
+	port->shard_inv_cycles_per_byte =
+		rte_reciprocal_value_u64(cycles_per_byte);
+	port->shard_cpu_cycles = port->time_cpu_cycles;
+	rte_atomic_store_explicit(&port->shard_cpu_bytes, 0,
+				  rte_memory_order_relaxed);
+	rte_spinlock_init(&port->shard_lock);
 
 	/* Grinders */
 	port->pkts_out = NULL;
 	port->n_pkts_out = 0;
 	port->subport_id = 0;
+	port->subport_id_min = 0;
+	port->subport_id_max = port->n_subports_per_port;
 
 	return port;
 }
 
+struct rte_sched_port *
+rte_sched_port_shard_create(struct rte_sched_port *port,
+	uint32_t subport_id, uint32_t n_subports)
+{
+	struct rte_sched_port *shard;
+	uint32_t size, i;
+
+	/* Check user parameters */
+	if (port == NULL || port->parent != NULL) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for parameter port", __func__);
+		return NULL;
+	}
+
+	if (n_subports == 0 || subport_id >= port->n_subports_per_port ||
+	    n_subports > port->n_subports_per_port - subport_id) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for subport range", __func__);
+		return NULL;
+	}
+
+	for (i = subport_id; i < subport_id + n_subports; i++) {
+		if (port->subports[i] == NULL) {
+			SCHED_LOG(ERR,
+				"%s: Subport %u not configured", __func__, i);
+			return NULL;
+		}
+	}
+
+	size = sizeof(struct rte_sched_port) +
+		port->n_subports_per_port * sizeof(struct rte_sched_subport *);
+
+	shard = rte_malloc_socket("qos_shard", size, RTE_CACHE_LINE_SIZE,
+				  port->socket);
+	if (shard == NULL) {
+		SCHED_LOG(ERR, "%s: Memory allocation fails", __func__);
+		return NULL;
+	}
+
+	/*
+	 * The shard shares the configuration, the subport profiles and the
+	 * subports of the port, and owns the timing and grinder context
+	 * used to dequeue its own subports.
+	 */
+	memcpy(shard, port, size);
+
+	shard->pkts_out = NULL;
+	shard->n_pkts_out = 0;
+	shard->subport_id = subport_id;
+	shard->subport_id_min = subport_id;
+	shard->subport_id_max = subport_id + n_subports;
+	shard->parent = port;
+	shard->time_cpu_cycles = rte_get_tsc_cycles();
+	rte_atomic_store_explicit(&shard->shard_time, 0,
+				  rte_memory_order_relaxed);
+
+	return shard;
+}
+
 static inline void
 rte_sched_subport_free(struct rte_sched_port *port,
 	struct rte_sched_subport *subport)
@@ -1043,6 +1197,7 @@ rte_sched_subport_free(struct rte_sched_port *port,
 		}
 	}
 
+	rte_free(subport->vc);
 	rte_free(subport);
 }
 
@@ -1055,6 +1210,12 @@ rte_sched_port_free(struct rte_sched_port *port)
 	if (port == NULL)
 		return;
 
+	/* Subports and profiles belong to the port the shard was created from */
+	if (port->parent != NULL) {
+		rte_free(port);
+		return;
+	}
+
 	for (i = 0; i < port->n_subports_per_port; i++)
 		rte_sched_subport_free(port, port->subports[i]);
 
@@ -1184,6 +1345,109 @@ rte_sched_subport_tc_ov_config(struct rte_sched_port *port,
 	return 0;
 }
 
+static void
+rte_sched_vclock_lag_max_update(struct rte_sched_vclock *vc,
+	struct rte_sched_pipe_profile *pp)
+{
+	uint64_t lag_max = RTE_MAX(pp->vc_burst,
+		UINT64_C(1) << vc->bucket_shift);
+
+	vc->lag_max = RTE_MIN(vc->lag_max, lag_max);
+}
+
+int
+rte_sched_subport_vclock_config(struct rte_sched_port *port,
+	uint32_t subport_id,
+	bool vclock_enable)
+{
+	struct rte_sched_vclock *vc;
+	struct rte_sched_subport *s;
+	uint32_t n_pipes, n_buckets, bucket_shift, qindex, i;
+	uint64_t span;
+	size_t size;
+
+	if (port == NULL) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for parameter port", __func__);
+		return -EINVAL;
+	}
+
+	if (subport_id >= port->n_subports_per_port ||
+	    port->subports[subport_id] == NULL) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for parameter subport id", __func__);
+		return  -EINVAL;
+	}
+
+	s = port->subports[subport_id];
+	n_pipes = s->n_pipes_per_subport_enabled;
+
+	/* Active queues are tracked differently by each scheduler */
+	for (qindex = 0; qindex < rte_sched_subport_pipe_queues(s); qindex++) {
+		if (s->queue[qindex].qr != s->queue[qindex].qw) {
+			SCHED_LOG(ERR,
+				"%s: Subport %u has packets queued", __func__,
+				subport_id);
+			return -EBUSY;
+		}
+	}
+
+	if (!vclock_enable) {
+		rte_free(s->vc);
+		s->vc = NULL;
+		return 0;
+	}
+
+	if (s->vc != NULL)
+		return 0;
+
+	/* The pipe state fits in the cache line padding of the pipes */
+	RTE_BUILD_BUG_ON(RTE_ALIGN_CEIL(offsetof(struct rte_sched_pipe, vc),
+		RTE_CACHE_LINE_SIZE) != sizeof(struct rte_sched_pipe));
+
+	/* One bucket is the transmission time of (at least) one MTU */
+	bucket_shift = rte_log2_u64(rte_align64pow2(port->mtu)) +
+		RTE_SCHED_VCLOCK_SHIFT;
+
+	/*
+	 * The calendar spans the time between two MTU packets of the slowest
+	 * pipe. Pipes of slower profiles added later wait in its last bucket.
+	 */
+	span = 0;
+	for (i = 0; i < s->n_pipe_profiles; i++)
+		span = RTE_MAX(span, (port->mtu * s->pipe_profiles[i].vc_cost) >>
+			       bucket_shift);
+	n_buckets = RTE_MIN(rte_align64pow2(span + 2),
+			    (uint64_t)RTE_SCHED_VCLOCK_BUCKETS);
+	n_buckets = RTE_MAX(n_buckets, 64u);
+
+	size = sizeof(struct rte_sched_vclock) +
+		n_buckets * sizeof(struct rte_sched_vclock_bucket);
+	vc = rte_zmalloc_socket("subport_vclock", size, RTE_CACHE_LINE_SIZE,
+				port->socket);
+	if (vc == NULL) {
+		SCHED_LOG(ERR, "%s: Memory allocation fails", __func__);
+		return -ENOMEM;
+	}
+
+	vc->bucket_shift = bucket_shift;
+	vc->bucket_mask = n_buckets - 1;
+	vc->pipe = s->pipe;
+	vc->cursor = port->time << RTE_SCHED_VCLOCK_SHIFT;
+	vc->cursor &= ~((UINT64_C(1) << vc->bucket_shift) - 1);
+
+	vc->lag_max = RTE_SCHED_VCLOCK_BURST_MAX;
+	for (i = 0; i < s->n_pipe_profiles; i++)
+		rte_sched_vclock_lag_max_update(vc, s->pipe_profiles + i);
+
+	for (i = 0; i < n_pipes; i++)
+		memset(&s->pipe[i].vc, 0, sizeof(s->pipe[i].vc));
+
+	s->vc = vc;
+
+	return 0;
+}
+
 int
 rte_sched_subport_config(struct rte_sched_port *port,
 	uint32_t subport_id,
@@ -1205,6 +1469,13 @@ rte_sched_subport_config(struct rte_sched_port *port,
 		return 0;
 	}
 
+	if (port->parent != NULL) {
+		SCHED_LOG(ERR,
+			"%s: Subports can not be configured through a shard",
+			__func__);
+		return -EINVAL;
+	}
+
 	if (subport_id >= port->n_subports_per_port) {
 		SCHED_LOG(ERR,
 			"%s: Incorrect value for subport id", __func__);
@@ -1387,6 +1658,7 @@ rte_sched_pipe_config(struct rte_sched_port *port,
 	struct rte_sched_subport_profile *sp;
 	struct rte_sched_pipe *p;
 	struct rte_sched_pipe_profile *params;
+	struct rte_sched_vclock_pipe vc;
 	uint32_t n_subports = subport_id + 1;
 	uint32_t deactivate, profile, i;
 	int ret;
@@ -1448,8 +1720,10 @@ rte_sched_pipe_config(struct rte_sched_port *port,
 				subport_id, subport_tc_be_rate, s->tc_ov_rate);
 		}
 
-		/* Reset the pipe */
+		/* Reset the pipe, which stays in the virtual clock calendar */
+		vc = p->vc;
 		memset(p, 0, sizeof(struct rte_sched_pipe));
+		p->vc = vc;
 	}
 
 	if (deactivate)
@@ -1561,6 +1835,9 @@ rte_sched_subport_pipe_profile_add(struct rte_sched_port *port,
 	if (s->pipe_tc_be_rate_max < params->tc_rate[RTE_SCHED_TRAFFIC_CLASS_BE])
 		s->pipe_tc_be_rate_max = params->tc_rate[RTE_SCHED_TRAFFIC_CLASS_BE];
 
+	if (s->vc != NULL)
+		rte_sched_vclock_lag_max_update(s->vc, pp);
+
 	rte_sched_port_log_pipe_profile(s, *pipe_profile_id);
 
 	return 0;
@@ -1595,6 +1872,13 @@ rte_sched_port_subport_profile_add(struct rte_sched_port *port,
 		return -EINVAL;
 	}
 
+	if (port->parent != NULL) {
+		SCHED_LOG(ERR, "%s: "
+		"Subport profiles can not be added through a shard",
+		__func__);
+		return -EINVAL;
+	}
+
 	dst = port->subport_profiles + port->n_subport_profiles;
 
 	/* Subport profiles exceeds the max limit */
@@ -1988,6 +2272,79 @@ rte_sched_port_enqueue_qwa_prefetch0(struct rte_sched_port *port,
 	rte_bitmap_prefetch0(subport->bmp, qindex);
 }
 
+/*
+ * Virtual clock times are compared through their difference, so that they can
+ * wrap around.
+ */
+static inline int64_t
+rte_sched_vclock_diff(uint64_t a, uint64_t b)
+{
+	return (int64_t)(a - b);
+}
+
+static inline uint64_t
+rte_sched_vclock_now(struct rte_sched_port *port, struct rte_sched_vclock *vc)
+{
+	return (port->time << RTE_SCHED_VCLOCK_SHIFT) - vc->offset;
+}
+
+static inline void
+rte_sched_vclock_insert(struct rte_sched_vclock *vc, uint32_t pindex)
+{
+	uint64_t horizon = ((uint64_t)vc->bucket_mask + 1) << vc->bucket_shift;
+	int64_t d = rte_sched_vclock_diff(vc->pipe[pindex].vc.tat, vc->cursor);
+	uint32_t b;
+
+	/*
+	 * Pipes already due go to the earliest bucket, pipes beyond the
+	 * calendar to the last one, from which they are moved when reached.
+	 */
+	if (d < 0)
+		d = 0;
+	else if ((uint64_t)d >= horizon)
+		d = horizon - (UINT64_C(1) << vc->bucket_shift);
+
+	b = ((vc->cursor + d) >> vc->bucket_shift) & vc->bucket_mask;
+
+	vc->pipe[pindex].vc.next = RTE_SCHED_PIPE_INVALID;
+	if (vc->bmp[b / 64] & (UINT64_C(1) << (b % 64)))
+		vc->pipe[vc->bucket[b].tail].vc.next = pindex;
+	else {
+		vc->bmp[b / 64] |= UINT64_C(1) << (b % 64);
+		vc->bucket[b].head = pindex;
+	}
+	vc->bucket[b].tail = pindex;
+}
+
+static inline void
+rte_sched_vclock_activate(struct rte_sched_port *port,
+	struct rte_sched_subport *subport, uint32_t qindex)
+{
+	struct rte_sched_vclock *vc = subport->vc;
+	uint32_t pindex = qindex >> 4;
+	struct rte_sched_vclock_pipe *vp = &vc->pipe[pindex].vc;
+	struct rte_sched_pipe_profile *pp;
+	uint64_t now;
+
+	if (vp->qmask != 0) {
+		vp->qmask |= 1 << (qindex & (RTE_SCHED_QUEUES_PER_PIPE - 1));
+		return;
+	}
+
+	vp->qmask = 1 << (qindex & (RTE_SCHED_QUEUES_PER_PIPE - 1));
+
+	/* Credits of an idle pipe are limited to its token bucket size */
+	pp = subport->pipe_profiles + vc->pipe[pindex].profile;
+	now = rte_sched_vclock_now(port, vc);
+	if (rte_sched_vclock_diff(vp->tat, now - pp->vc_burst) < 0)
+		vp->tat = now - pp->vc_burst;
+
+	if (vc->n_active++ == 0)
+		vc->cursor = vp->tat & ~((UINT64_C(1) << vc->bucket_shift) - 1);
+
+	rte_sched_vclock_insert(vc, pindex);
+}
+
 static inline int
 rte_sched_port_enqueue_qwa(struct rte_sched_port *port,
 	struct rte_sched_subport *subport,
@@ -2018,8 +2375,11 @@ rte_sched_port_enqueue_qwa(struct rte_sched_port *port,
 	qbase[q->qw & (qsize - 1)] = pkt;
 	q->qw++;
 
-	/* Activate queue in the subport bitmap */
-	rte_bitmap_set(subport->bmp, qindex);
+	/* Activate queue in the subport bitmap, or in the virtual clock pipe */
+	if (subport->vc != NULL)
+		rte_sched_vclock_activate(port, subport, qindex);
+	else
+		rte_bitmap_set(subport->bmp, qindex);
 
 	/* Statistics */
 	rte_sched_port_update_subport_stats(port, subport, qindex, pkt);
@@ -2909,6 +3269,276 @@ grinder_handle(struct rte_sched_port *port,
 	}
 }
 
+static inline void
+rte_sched_vclock_subport_credits_update(struct rte_sched_port *port,
+	struct rte_sched_subport *subport)
+{
+	struct rte_sched_subport_profile *sp =
+		port->subport_profiles + subport->profile;
+	uint64_t n_periods;
+	uint32_t i;
+
+	/* Subport TB */
+	n_periods = (port->time - subport->tb_time) / sp->tb_period;
+	subport->tb_credits += n_periods * sp->tb_credits_per_period;
+	subport->tb_credits = RTE_MIN(subport->tb_credits, sp->tb_size);
+	subport->tb_time += n_periods * sp->tb_period;
+
+	/* Subport TCs */
+	if (unlikely(port->time >= subport->tc_time)) {
+		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
+			subport->tc_credits[i] = sp->tc_credits_per_period[i];
+
+		subport->tc_time = port->time + sp->tc_period;
+	}
+}
+
+/*
+ * Find the earliest non empty bucket among the n buckets starting at the
+ * cursor. Returns its distance from the cursor, n when they are all empty.
+ */
+static inline uint32_t
+rte_sched_vclock_find(struct rte_sched_vclock *vc, uint32_t n)
+{
+	uint32_t b = (vc->cursor >> vc->bucket_shift) & vc->bucket_mask;
+	uint32_t d = 0;
+
+	while (d < n) {
+		uint32_t pos = (b + d) & vc->bucket_mask;
+		uint64_t slab = vc->bmp[pos / 64] >> (pos % 64);
+
+		if (slab != 0)
+			return RTE_MIN(d + rte_ctz64(slab), n);
+
+		d += 64 - pos % 64;
+	}
+
+	return n;
+}
+
+static inline uint32_t
+rte_sched_vclock_pop(struct rte_sched_vclock *vc)
+{
+	uint32_t b = (vc->cursor >> vc->bucket_shift) & vc->bucket_mask;
+	uint32_t pindex = vc->bucket[b].head;
+
+	vc->bucket[b].head = vc->pipe[pindex].vc.next;
+	if (vc->bucket[b].head == RTE_SCHED_PIPE_INVALID)
+		vc->bmp[b / 64] &= ~(UINT64_C(1) << (b % 64));
+
+	return pindex;
+}
+
+/* Best effort queue with the fewest WRR tokens among the active ones */
+static inline uint32_t
+rte_sched_vclock_wrr(struct rte_sched_pipe *pipe, uint32_t be_mask)
+{
+	uint16_t wrr_tokens[RTE_SCHED_BE_QUEUES_PER_PIPE];
+	uint32_t i;
+
+	for (i = 0; i < RTE_SCHED_BE_QUEUES_PER_PIPE; i++)
+		wrr_tokens[i] = (be_mask & (1 << i)) ?
+			pipe->wrr_tokens[i] : UINT16_MAX;
+
+	return rte_min_pos_4_u16(wrr_tokens);
+}
+
+static inline void
+rte_sched_vclock_wrr_update(struct rte_sched_pipe *pipe,
+	struct rte_sched_pipe_profile *pp, uint32_t qpos, uint32_t pkt_len,
+	uint32_t be_mask)
+{
+	uint32_t wrr_tokens[RTE_SCHED_BE_QUEUES_PER_PIPE];
+	uint32_t i, wrr_tokens_min = UINT32_MAX;
+
+	for (i = 0; i < RTE_SCHED_BE_QUEUES_PER_PIPE; i++)
+		wrr_tokens[i] = (uint32_t)pipe->wrr_tokens[i] << RTE_SCHED_WRR_SHIFT;
+
+	wrr_tokens[qpos] += pkt_len * pp->wrr_cost[qpos];
+
+	for (i = 0; i < RTE_SCHED_BE_QUEUES_PER_PIPE; i++)
+		if (be_mask & (1 << i))
+			wrr_tokens_min = RTE_MIN(wrr_tokens_min, wrr_tokens[i]);
+
+	for (i = 0; i < RTE_SCHED_BE_QUEUES_PER_PIPE; i++)
+		pipe->wrr_tokens[i] = (be_mask & (1 << i)) ?
+			RTE_MIN((wrr_tokens[i] - wrr_tokens_min) >>
+				RTE_SCHED_WRR_SHIFT, (uint32_t)UINT8_MAX) : 0;
+}
+
+/* Queues of the pipe allowed by the mask of subport TCs with credits */
+static inline uint32_t
+rte_sched_vclock_tc_qmask(uint32_t tc_mask)
+{
+	uint32_t be_qmask = ((1 << RTE_SCHED_BE_QUEUES_PER_PIPE) - 1) <<
+		RTE_SCHED_TRAFFIC_CLASS_BE;
+
+	return (tc_mask & ((1 << RTE_SCHED_TRAFFIC_CLASS_BE) - 1)) |
+		(((tc_mask >> RTE_SCHED_TRAFFIC_CLASS_BE) & 1) * be_qmask);
+}
+
+/*
+ * Virtual clock dequeue of a subport. Pipes are served in the order of the
+ * theoretical arrival time (TAT) of their next packet, once it is reached by
+ * the port time. Each packet moves the TAT of its pipe forward by its
+ * transmission time at the pipe rate, so that the pipe is shaped to its token
+ * bucket, and oversubscribed pipes share the subport in proportion to their
+ * rate. Within a pipe, the traffic classes are served in strict priority,
+ * with WRR among the best effort queues.
+ */
+static inline uint32_t
+rte_sched_vclock_dequeue(struct rte_sched_port *port,
+	struct rte_sched_subport *subport, uint32_t n_pkts, uint64_t time_limit)
+{
+	struct rte_sched_vclock *vc = subport->vc;
+	uint32_t tc_mask = (1 << RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE) - 1;
+	uint32_t tc_qmask = rte_sched_vclock_tc_qmask(tc_mask);
+	uint32_t deferred = RTE_SCHED_PIPE_INVALID, deferred_tail = 0;
+	uint32_t count = 0, n_deferred = 0;
+
+	rte_sched_vclock_subport_credits_update(port, subport);
+
+	/* All the due pipes are served at once, then the next subport */
+	subport->pipe_exhaustion = 1;
+
+	while (count < n_pkts && vc->n_active != 0 &&
+	       port->time + port->mtu <= time_limit) {
+		uint64_t now = rte_sched_vclock_now(port, vc);
+		int64_t ahead = rte_sched_vclock_diff(now, vc->cursor);
+		int64_t lag_max = vc->lag_max;
+		uint32_t n, d, pindex, qpos, qindex, tc, pkt_len, qmask;
+		struct rte_sched_vclock_pipe *vp;
+		struct rte_sched_pipe_profile *pp;
+		struct rte_sched_queue *queue;
+		struct rte_sched_pipe *pipe;
+		struct rte_mbuf **qbase;
+		struct rte_mbuf *pkt;
+		uint16_t qsize;
+
+		if (ahead < 0)
+			break;
+
+		n = vc->bucket_mask + 1;
+		if (((uint64_t)ahead >> vc->bucket_shift) < n)
+			n = ((uint64_t)ahead >> vc->bucket_shift) + 1;
+
+		d = rte_sched_vclock_find(vc, n);
+		if (d == n)
+			break;
+
+		vc->cursor += (uint64_t)d << vc->bucket_shift;
+
+		/* Congestion: delay the subport time */
+		ahead = rte_sched_vclock_diff(now, vc->cursor);
+		if (ahead > lag_max) {
+			vc->offset += ahead - lag_max;
+			now -= ahead - lag_max;
+		}
+
+		pindex = rte_sched_vclock_pop(vc);
+		vp = &vc->pipe[pindex].vc;
+
+		/* Pipe parked in the last bucket of the calendar */
+		if (rte_sched_vclock_diff(vp->tat, vc->cursor) >=
+		    (int64_t)1 << vc->bucket_shift) {
+			rte_sched_vclock_insert(vc, pindex);
+			continue;
+		}
+
+		pipe = subport->pipe + pindex;
+		pp = subport->pipe_profiles + pipe->profile;
+
+		for (;;) {
+			qmask = vp->qmask & tc_qmask;
+			if (qmask == 0)
+				break;
+
+			qpos = rte_ctz32(qmask);
+			if (qpos >= RTE_SCHED_TRAFFIC_CLASS_BE)
+				qpos = RTE_SCHED_TRAFFIC_CLASS_BE +
+					rte_sched_vclock_wrr(pipe,
+						qmask >> RTE_SCHED_TRAFFIC_CLASS_BE);
+
+			qindex = (pindex << 4) + qpos;
+			queue = subport->queue + qindex;
+			qbase = rte_sched_subport_pipe_qbase(subport, qindex);
+			qsize = rte_sched_subport_pipe_qsize(port, subport, qindex);
+			pkt = qbase[queue->qr & (qsize - 1)];
+			pkt_len = pkt->pkt_len + port->frame_overhead;
+			tc = port->pipe_tc[qpos];
+
+			if (subport->tb_credits < pkt_len) {
+				tc_mask = 0;
+				tc_qmask = 0;
+				qmask = 0;
+				break;
+			}
+
+			if (subport->tc_credits[tc] >= pkt_len)
+				break;
+
+			tc_mask &= ~(1 << tc);
+			tc_qmask = rte_sched_vclock_tc_qmask(tc_mask);
+		}
+
+		/* Subport credits exhausted for all the active TCs of the pipe */
+		if (qmask == 0) {
+			vp->next = RTE_SCHED_PIPE_INVALID;
+			if (deferred == RTE_SCHED_PIPE_INVALID)
+				deferred = pindex;
+			else
+				vc->pipe[deferred_tail].vc.next = pindex;
+			deferred_tail = pindex;
+
+			if (tc_mask == 0 || ++n_deferred == n_pkts)
+				break;
+
+			continue;
+		}
+
+		/* Send packet */
+		subport->tb_credits -= pkt_len;
+		subport->tc_credits[tc] -= pkt_len;
+		port->time += pkt_len;
+		port->pkts_out[port->n_pkts_out++] = pkt;
+		queue->qr++;
+		count++;
+
+		if (queue->qr == queue->qw) {
+			vp->qmask &= ~(1 << qpos);
+			rte_sched_port_red_set_queue_empty_timestamp(port, subport,
+				qindex);
+		}
+
+		if (qpos >= RTE_SCHED_TRAFFIC_CLASS_BE)
+			rte_sched_vclock_wrr_update(pipe, pp,
+				qpos - RTE_SCHED_TRAFFIC_CLASS_BE, pkt_len,
+				vp->qmask >> RTE_SCHED_TRAFFIC_CLASS_BE);
+
+		rte_sched_port_pie_dequeue(subport, qindex, pkt_len,
+			port->time_cpu_cycles);
+
+		/* A busy pipe lags behind the port time by at most its burst */
+		if (rte_sched_vclock_diff(vp->tat, now - pp->vc_burst) < 0)
+			vp->tat = now - pp->vc_burst;
+		vp->tat += pkt_len * pp->vc_cost;
+
+		if (vp->qmask != 0)
+			rte_sched_vclock_insert(vc, pindex);
+		else
+			vc->n_active--;
+	}
+
+	while (deferred != RTE_SCHED_PIPE_INVALID) {
+		uint32_t pindex = deferred;
+
+		deferred = vc->pipe[pindex].vc.next;
+		rte_sched_vclock_insert(vc, pindex);
+	}
+
+	return count;
+}
+
 static inline void
 rte_sched_port_time_resync(struct rte_sched_port *port)
 {
@@ -2933,10 +3563,92 @@ rte_sched_port_time_resync(struct rte_sched_port *port)
 		port->time = port->time_cpu_bytes;
 
 	/* Reset pipe loop detection */
-	for (i = 0; i < port->n_subports_per_port; i++)
+	for (i = port->subport_id_min; i < port->subport_id_max; i++)
 		port->subports[i]->pipe_loop = RTE_SCHED_PIPE_INVALID;
 }
 
+/*
+ * Advance the CPU time shared by the shards of a port and return it, in
+ * bytes. Only one shard at a time advances it, the others use the value
+ * it had, so the elapsed time converted stays bounded by the interval
+ * between two dequeues of the shards.
+ */
+static inline uint64_t
+rte_sched_port_shard_time_resync(struct rte_sched_port *parent)
+{
+	uint64_t cycles, cycles_diff, bytes_diff, bytes;
+
+	if (!rte_spinlock_trylock(&parent->shard_lock))
+		return rte_atomic_load_explicit(&parent->shard_cpu_bytes,
+						rte_memory_order_relaxed);
+
+	bytes = rte_atomic_load_explicit(&parent->shard_cpu_bytes,
+					 rte_memory_order_relaxed);
+	cycles = rte_get_tsc_cycles();
+	if (cycles > parent->shard_cpu_cycles) {
+		cycles_diff = cycles - parent->shard_cpu_cycles;
+		bytes_diff = rte_reciprocal_divide_u64(
+				cycles_diff << RTE_SCHED_TIME_SHIFT,
+				&parent->shard_inv_cycles_per_byte);
+
+		parent->shard_cpu_cycles += (bytes_diff *
+			parent->cycles_per_byte) >> RTE_SCHED_TIME_SHIFT;
+		bytes += bytes_diff;
+		rte_atomic_store_explicit(&parent->shard_cpu_bytes, bytes,
+					  rte_memory_order_relaxed);
+	}
+
+	rte_spinlock_unlock(&parent->shard_lock);
+
+	return bytes;
+}
+
+/*
+ * Reserve port time for the next dequeue of a shard. The shards share the
+ * port rate through the port time of the parent, which is never allowed to
+ * run more than RTE_SCHED_PORT_SHARD_BURST frames ahead of the CPU time.
+ * Returns the number of bytes the shard may send, zero when the port is busy.
+ */
+static inline uint64_t
+rte_sched_port_shard_reserve(struct rte_sched_port *port, uint32_t n_pkts)
+{
+	struct rte_sched_port *parent = port->parent;
+	uint64_t burst = (uint64_t)port->mtu * RTE_SCHED_PORT_SHARD_BURST;
+	uint64_t time, base, credits, now;
+
+	now = rte_sched_port_shard_time_resync(parent);
+
+	time = rte_atomic_load_explicit(&parent->shard_time,
+					rte_memory_order_relaxed);
+	do {
+		base = RTE_MAX(time, now);
+		if (base - now + port->mtu > burst)
+			return 0;
+
+		credits = RTE_MIN((uint64_t)n_pkts * port->mtu,
+				  now + burst - base);
+	} while (!rte_atomic_compare_exchange_weak_explicit(&parent->shard_time,
+			&time, base + credits,
+			rte_memory_order_relaxed, rte_memory_order_relaxed));
+
+	return credits;
+}
+
+/* Give back the reserved port time the shard did not use. */
+static inline void
+rte_sched_port_shard_release(struct rte_sched_port *port, uint64_t credits,
+	uint64_t consumed)
+{
+	struct rte_sched_port *parent = port->parent;
+
+	if (credits > consumed)
+		rte_atomic_fetch_sub_explicit(&parent->shard_time,
+			credits - consumed, rte_memory_order_relaxed);
+	else if (credits < consumed)
+		rte_atomic_fetch_add_explicit(&parent->shard_time,
+			consumed - credits, rte_memory_order_relaxed);
+}
+
 static inline int
 rte_sched_port_exceptions(struct rte_sched_subport *subport, int second_pass)
 {
@@ -2957,25 +3669,40 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 {
 	struct rte_sched_subport *subport;
 	uint32_t subport_id = port->subport_id;
+	uint32_t n_subports_max = port->subport_id_max - port->subport_id_min;
 	uint32_t i, n_subports = 0, count;
+	uint64_t credits = 0, time_start, time_limit = UINT64_MAX;
 
 	port->pkts_out = pkts;
 	port->n_pkts_out = 0;
 
 	rte_sched_port_time_resync(port);
 
+	time_start = port->time;
+	if (port->parent != NULL) {
+		credits = rte_sched_port_shard_reserve(port, n_pkts);
+		if (credits == 0)
+			return 0;
+
+		time_limit = time_start + credits;
+	}
+
 	/* Take each queue in the grinder one step further */
 	for (i = 0, count = 0; ; i++)  {
 		subport = port->subports[subport_id];
 
-		count += grinder_handle(port, subport,
-				i & (RTE_SCHED_PORT_N_GRINDERS - 1));
+		if (subport->vc != NULL)
+			count += rte_sched_vclock_dequeue(port, subport,
+					n_pkts - count, time_limit);
+		else
+			count += grinder_handle(port, subport,
+					i & (RTE_SCHED_PORT_N_GRINDERS - 1));
 
-		if (count == n_pkts) {
+		if (count == n_pkts || port->time + port->mtu > time_limit) {
 			subport_id++;
 
-			if (subport_id == port->n_subports_per_port)
-				subport_id = 0;
+			if (subport_id == port->subport_id_max)
+				subport_id = port->subport_id_min;
 
 			port->subport_id = subport_id;
 			break;
@@ -2987,15 +3714,19 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 			n_subports++;
 		}
 
-		if (subport_id == port->n_subports_per_port)
-			subport_id = 0;
+		if (subport_id == port->subport_id_max)
+			subport_id = port->subport_id_min;
 
-		if (n_subports == port->n_subports_per_port) {
+		if (n_subports == n_subports_max) {
 			port->subport_id = subport_id;
 			break;
 		}
 	}
 
+	if (port->parent != NULL)
+		rte_sched_port_shard_release(port, credits,
+					     port->time - time_start);
+
 	return count;
 }
 
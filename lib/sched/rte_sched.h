@@ -52,6 +52,7 @@
  */
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_mbuf.h>
 #include <rte_meter.h>
 
@@ -577,6 +578,40 @@ rte_sched_port_enqueue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 int
 rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint32_t n_pkts);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler port shard creation
+ *
+ * A shard is a handle to the port scheduler instance that owns a contiguous
+ * range of subports, so that the port can be scheduled by multiple lcores,
+ * each one running the enqueue and dequeue of a different shard.
+ * The rate of the port is shared by all its shards: the port time is
+ * reserved without locks at each dequeue, and never runs ahead of the
+ * CPU time by more than a small number of frames.
+ *
+ * Only the packets of the shard subports must be enqueued to a shard.
+ * Subports and subport profiles can not be configured through a shard,
+ * and the port must not be dequeued directly while it has shards.
+ * All the subports of the range must be configured before shard creation.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param subport_id
+ *   First subport ID of the shard
+ * @param n_subports
+ *   Number of subports of the shard
+ * @return
+ *   Handle to the shard upon success, to be freed with
+ *   rte_sched_port_free() before the port, or NULL otherwise.
+ */
+__rte_experimental
+struct rte_sched_port *
+rte_sched_port_shard_create(struct rte_sched_port *port,
+	uint32_t subport_id, uint32_t n_subports)
+	__rte_malloc __rte_dealloc(rte_sched_port_free, 1);
+
 /**
  * Hierarchical scheduler subport traffic class
  * oversubscription enable/disable.
@@ -594,6 +629,43 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 int
 rte_sched_subport_tc_ov_config(struct rte_sched_port *port, uint32_t subport_id, bool tc_ov_enable);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler subport virtual clock enable/disable.
+ *
+ * In virtual clock mode, the pipes of the subport are no longer served by the
+ * grinders. Each active pipe is instead kept in a calendar queue, sorted by
+ * the theoretical arrival time of its next packet, which advances by the
+ * packet transmission time at the pipe token bucket rate. Due pipes are
+ * served in that order, so that every pipe is shaped to its token bucket
+ * rate and size, and oversubscribed pipes share the subport bandwidth in
+ * proportion to their rate. Within a pipe, traffic classes are served in
+ * strict priority, with WRR among the best effort queues. The subport token
+ * bucket and traffic class rates are enforced, while the pipe traffic class
+ * rates and the traffic class oversubscription are not applied.
+ *
+ * The mode allocates a calendar of 64 to 4096 buckets of 8 bytes, sized
+ * from the rates of the pipe profiles, on top of the subport memory.
+ *
+ * This function should be called at the time of subport initialization,
+ * when all the subport queues are empty.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param subport_id
+ *   Subport ID
+ * @param vclock_enable
+ *   Boolean flag to enable/disable the virtual clock mode
+ * @return
+ *   0 upon success, error code otherwise
+ */
+__rte_experimental
+int
+rte_sched_subport_vclock_config(struct rte_sched_port *port,
+	uint32_t subport_id, bool vclock_enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,25 @@ struct rte_stack_lf {
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_stack_lf_elem elems[];
 };
 
+/** Number of slots in the elimination array of a lock-free stack. */
+#define RTE_STACK_LF_ELIM_SLOTS 8
+/** Number of pause iterations a push waits in the elimination array. */
+#define RTE_STACK_LF_ELIM_SPIN 16
+
+/* Elimination array slot, where a push blocked on the stack head offers its
+ * list of elements to a concurrent pop. The slot state is made of the slot
+ * phase in the lowest bits and of a number of elements in the upper bits.
+ */
+struct __rte_cache_aligned rte_stack_lf_elim_slot {
+	/** Slot phase and number of elements offered or taken */
+	RTE_ATOMIC(uint64_t) state;
+	/** First of the elements offered by the push */
+	struct rte_stack_lf_elem *first;
+	/** First of the elements left by the pop */
+	struct rte_stack_lf_elem *rest;
+	RTE_CACHE_GUARD;
+};
+
 /* Structure containing the LIFO, its current length, and a lock for mutual
  * exclusion.
  */
@@ -76,6 +95,8 @@ struct __rte_cache_aligned rte_stack {
 	const struct rte_memzone *memzone;
 	uint32_t capacity; /**< Usable size of the stack. */
 	uint32_t flags; /**< Flags supplied at creation. */
+	/** Elimination array, NULL unless created with RTE_STACK_F_ELIM. */
+	struct rte_stack_lf_elim_slot *elim;
 	union {
 		struct rte_stack_lf stack_lf; /**< Lock-free LIFO structure. */
 		struct rte_stack_std stack_std;	/**< LIFO structure. */
@@ -88,6 +109,13 @@ struct __rte_cache_aligned rte_stack {
  */
 #define RTE_STACK_F_LF 0x0001
 
+/**
+ * The lock-free stack pairs concurrent push and pop operations through an
+ * elimination array when the stack head is contended, so that they exchange
+ * their objects without modifying the stack. This flag requires RTE_STACK_F_LF.
+ */
+#define RTE_STACK_F_ELIM 0x0002
+
 #include "rte_stack_std.h"
 #include "rte_stack_lf.h"
 
@@ -197,6 +225,9 @@ rte_stack_free_count(struct rte_stack *s)
  *    - RTE_STACK_F_LF: If this flag is set, the stack uses lock-free
  *      variants of the push and pop functions. Otherwise, it achieves
  *      thread-safety using a lock.
+ *    - RTE_STACK_F_ELIM: If this flag is set along with RTE_STACK_F_LF,
+ *      push and pop operations failing to update the stack head try to
+ *      exchange their objects through an elimination array.
  * @return
  *   On success, the pointer to the new allocated stack. NULL on error with
  *    rte_errno set appropriately. Possible errno values include:
@@ -205,6 +236,7 @@ rte_stack_free_count(struct rte_stack *s)
  *    - ENOMEM - insufficient memory to create the stack
  *    - ENAMETOOLONG - name size exceeds RTE_STACK_NAMESIZE
  *    - ENOTSUP - platform does not support given flags combination.
+ *    - EINVAL - RTE_STACK_F_ELIM is given without RTE_STACK_F_LF.
  */
 struct rte_stack *
 rte_stack_create(const char *name, unsigned int count, int socket_id,
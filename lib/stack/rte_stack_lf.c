@@ -2,10 +2,12 @@
  * Copyright(c) 2019 Intel Corporation
  */
 
+#include <string.h>
+
 #include "rte_stack.h"
 
 void
-rte_stack_lf_init(struct rte_stack *s, unsigned int count)
+rte_stack_lf_init(struct rte_stack *s, unsigned int count, uint32_t flags)
 {
 	struct rte_stack_lf_elem *elems = s->stack_lf.elems;
 	unsigned int i;
@@ -13,15 +15,26 @@ rte_stack_lf_init(struct rte_stack *s, unsigned int count)
 	for (i = 0; i < count; i++)
 		__rte_stack_lf_push_elems(&s->stack_lf.free,
 					  &elems[i], &elems[i], 1);
+
+	/* The elimination array follows the list elements */
+	if (flags & RTE_STACK_F_ELIM) {
+		s->elim = RTE_PTR_ADD(elems, RTE_CACHE_LINE_ROUNDUP(count *
+				sizeof(struct rte_stack_lf_elem)));
+		memset(s->elim, 0, RTE_STACK_LF_ELIM_SLOTS *
+				sizeof(struct rte_stack_lf_elim_slot));
+	}
 }
 
 ssize_t
-rte_stack_lf_get_memsize(unsigned int count)
+rte_stack_lf_get_memsize(unsigned int count, uint32_t flags)
 {
 	ssize_t sz = sizeof(struct rte_stack);
 
 	sz += RTE_CACHE_LINE_ROUNDUP(count * sizeof(struct rte_stack_lf_elem));
 
+	if (flags & RTE_STACK_F_ELIM)
+		sz += RTE_STACK_LF_ELIM_SLOTS * sizeof(struct rte_stack_lf_elim_slot);
+
 	/* Add padding to avoid false sharing conflicts caused by
 	 * next-line hardware prefetchers.
 	 */
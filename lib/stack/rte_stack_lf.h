@@ -5,6 +5,9 @@
 #ifndef _RTE_STACK_LF_H_
 #define _RTE_STACK_LF_H_
 
+#include <rte_pause.h>
+#include <rte_random.h>
+
 #if !(defined(RTE_ARCH_X86_64) || defined(RTE_ARCH_ARM64))
 #include "rte_stack_lf_stubs.h"
 #else
@@ -20,6 +23,133 @@
 #define RTE_STACK_LF_SUPPORTED
 #endif
 
+#define __RTE_STACK_ELIM_EMPTY		0 /**< Slot is free */
+#define __RTE_STACK_ELIM_OFFER		1 /**< Push waits for a pop */
+#define __RTE_STACK_ELIM_BUSY		2 /**< Slot is being written */
+#define __RTE_STACK_ELIM_DONE		3 /**< Pop took elements */
+#define __RTE_STACK_ELIM_PHASE_MASK	3
+#define __RTE_STACK_ELIM_CNT_SHIFT	2
+
+/**
+ * @internal Offer a list of elements to the pops through the elimination
+ * array. The elements not taken by a pop are pushed to the used list.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param first
+ *   The first element of the list, holding the top of the pushed objects.
+ * @param last
+ *   The last element of the list.
+ * @param n
+ *   The number of elements in the list.
+ * @return
+ *   1 if the elements were handled, 0 if no pop took any of them.
+ */
+static __rte_always_inline int
+__rte_stack_lf_elim_push(struct rte_stack *s,
+			 struct rte_stack_lf_elem *first,
+			 struct rte_stack_lf_elem *last,
+			 unsigned int n)
+{
+	struct rte_stack_lf_elim_slot *slot;
+	uint64_t state, offer;
+	unsigned int i, taken;
+
+	slot = &s->elim[rte_rand() & (RTE_STACK_LF_ELIM_SLOTS - 1)];
+
+	state = __RTE_STACK_ELIM_EMPTY;
+	if (!rte_atomic_compare_exchange_strong_explicit(&slot->state, &state,
+			__RTE_STACK_ELIM_BUSY, rte_memory_order_acquire,
+			rte_memory_order_relaxed))
+		return 0;
+
+	/* The elements are written before the offer is visible. */
+	slot->first = first;
+	offer = ((uint64_t)n << __RTE_STACK_ELIM_CNT_SHIFT) | __RTE_STACK_ELIM_OFFER;
+	rte_atomic_store_explicit(&slot->state, offer, rte_memory_order_release);
+
+	for (i = 0; i < RTE_STACK_LF_ELIM_SPIN; i++) {
+		rte_pause();
+		state = rte_atomic_load_explicit(&slot->state, rte_memory_order_acquire);
+		if (state != offer)
+			break;
+	}
+
+	/* Withdraw the offer, unless a pop is already taking it. */
+	if (state == offer && rte_atomic_compare_exchange_strong_explicit(
+			&slot->state, &state, __RTE_STACK_ELIM_EMPTY,
+			rte_memory_order_acquire, rte_memory_order_acquire))
+		return 0;
+
+	/* The pop owns the slot until it is done reading the elements. */
+	while ((state & __RTE_STACK_ELIM_PHASE_MASK) != __RTE_STACK_ELIM_DONE) {
+		rte_pause();
+		state = rte_atomic_load_explicit(&slot->state, rte_memory_order_acquire);
+	}
+
+	taken = state >> __RTE_STACK_ELIM_CNT_SHIFT;
+	first = slot->rest;
+	rte_atomic_store_explicit(&slot->state, __RTE_STACK_ELIM_EMPTY,
+				  rte_memory_order_release);
+
+	/* The pop took the top of the list, push what is left. */
+	if (taken != n)
+		__rte_stack_lf_push_elems(&s->stack_lf.used, first, last, n - taken);
+
+	return 1;
+}
+
+/**
+ * @internal Take objects offered by a push in the elimination array.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to take.
+ * @return
+ *   The number of objects taken (either 0 or *n*).
+ */
+static __rte_always_inline unsigned int
+__rte_stack_lf_elim_pop(struct rte_stack *s, void **obj_table, unsigned int n)
+{
+	struct rte_stack_lf_elem *tmp, *first, *last = NULL;
+	struct rte_stack_lf_elim_slot *slot;
+	uint64_t state;
+	unsigned int i;
+
+	slot = &s->elim[rte_rand() & (RTE_STACK_LF_ELIM_SLOTS - 1)];
+
+	/* Only an offer of at least n elements is taken. */
+	state = rte_atomic_load_explicit(&slot->state, rte_memory_order_relaxed);
+	if ((state & __RTE_STACK_ELIM_PHASE_MASK) != __RTE_STACK_ELIM_OFFER ||
+	    (state >> __RTE_STACK_ELIM_CNT_SHIFT) < n)
+		return 0;
+
+	if (!rte_atomic_compare_exchange_strong_explicit(&slot->state, &state,
+			__RTE_STACK_ELIM_BUSY, rte_memory_order_acquire,
+			rte_memory_order_relaxed))
+		return 0;
+
+	first = slot->first;
+	for (tmp = first, i = 0; i < n; i++, tmp = tmp->next) {
+		obj_table[i] = tmp->data;
+		last = tmp;
+	}
+
+	/* Hand the rest of the list back to the push. */
+	slot->rest = tmp;
+	rte_atomic_store_explicit(&slot->state,
+			((uint64_t)n << __RTE_STACK_ELIM_CNT_SHIFT) | __RTE_STACK_ELIM_DONE,
+			rte_memory_order_release);
+
+	/* Push the list elements to the free list */
+	__rte_stack_lf_push_elems(&s->stack_lf.free, first, last, n);
+
+	return n;
+}
+
 /**
  * @internal Push several objects on the lock-free stack (MT-safe).
  *
@@ -52,6 +182,12 @@ __rte_stack_lf_push(struct rte_stack *s,
 	for (tmp = first, i = 0; i < n; i++, tmp = tmp->next)
 		tmp->data = obj_table[n - i - 1];
 
+	/* On contention, try handing them to a pop before retrying */
+	if (s->elim != NULL &&
+	    (__rte_stack_lf_try_push_elems(&s->stack_lf.used, first, last, n) ||
+	     __rte_stack_lf_elim_push(s, first, last, n)))
+		return n;
+
 	/* Push them to the used list */
 	__rte_stack_lf_push_elems(&s->stack_lf.used, first, last, n);
 
@@ -73,14 +209,24 @@ __rte_stack_lf_push(struct rte_stack *s,
 static __rte_always_inline unsigned int
 __rte_stack_lf_pop(struct rte_stack *s, void **obj_table, unsigned int n)
 {
-	struct rte_stack_lf_elem *first, *last = NULL;
+	struct rte_stack_lf_elem *first = NULL, *last = NULL;
 
 	if (unlikely(n == 0))
 		return 0;
 
+	/* On contention, try taking the objects of a waiting push */
+	if (s->elim != NULL) {
+		first = __rte_stack_lf_try_pop_elems(&s->stack_lf.used,
+						     n, obj_table, &last);
+		if (first == NULL &&
+		    __rte_stack_lf_elim_pop(s, obj_table, n) != 0)
+			return n;
+	}
+
 	/* Pop n used elements */
-	first = __rte_stack_lf_pop_elems(&s->stack_lf.used,
-					 n, obj_table, &last);
+	if (first == NULL)
+		first = __rte_stack_lf_pop_elems(&s->stack_lf.used,
+						 n, obj_table, &last);
 	if (unlikely(first == NULL))
 		return 0;
 
@@ -97,19 +243,23 @@ __rte_stack_lf_pop(struct rte_stack *s, void **obj_table, unsigned int n)
  *   A pointer to the stack structure.
  * @param count
  *   The size of the stack.
+ * @param flags
+ *   The flags supplied at creation.
  */
 void
-rte_stack_lf_init(struct rte_stack *s, unsigned int count);
+rte_stack_lf_init(struct rte_stack *s, unsigned int count, uint32_t flags);
 
 /**
  * @internal Return the memory required for a lock-free stack.
  *
  * @param count
  *   The size of the stack.
+ * @param flags
+ *   The flags supplied at creation.
  * @return
  *   The bytes to allocate for a lock-free stack.
  */
 ssize_t
-rte_stack_lf_get_memsize(unsigned int count);
+rte_stack_lf_get_memsize(unsigned int count, uint32_t flags);
 
 #endif /* _RTE_STACK_LF_H_ */
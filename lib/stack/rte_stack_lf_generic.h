@@ -71,6 +71,103 @@ __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 	rte_atomic_fetch_add_explicit(&list->len, num, rte_memory_order_seq_cst);
 }
 
+static __rte_always_inline int
+__rte_stack_lf_try_push_elems(struct rte_stack_lf_list *list,
+			      struct rte_stack_lf_elem *first,
+			      struct rte_stack_lf_elem *last,
+			      unsigned int num)
+{
+	struct rte_stack_lf_head old_head, new_head;
+
+	old_head = list->head;
+
+	/* An acquire fence (or stronger) is needed for weak memory
+	 * models to establish a synchronized-with relationship between
+	 * the list->head load and store-release operations (as part of
+	 * the rte_atomic128_cmp_exchange()).
+	 */
+	rte_smp_mb();
+
+	new_head.top = first;
+	new_head.cnt = old_head.cnt + 1;
+
+	last->next = old_head.top;
+
+	/* Single attempt, the caller handles the contention. */
+	if (rte_atomic128_cmp_exchange((rte_int128_t *)&list->head,
+				       (rte_int128_t *)&old_head,
+				       (rte_int128_t *)&new_head,
+				       0, rte_memory_order_release,
+				       rte_memory_order_relaxed) == 0)
+		return 0;
+
+	/* NOTE: review for potential ordering optimization */
+	rte_atomic_fetch_add_explicit(&list->len, num, rte_memory_order_seq_cst);
+
+	return 1;
+}
+
+static __rte_always_inline struct rte_stack_lf_elem *
+__rte_stack_lf_try_pop_elems(struct rte_stack_lf_list *list,
+			     unsigned int num,
+			     void **obj_table,
+			     struct rte_stack_lf_elem **last)
+{
+	struct rte_stack_lf_head old_head, new_head;
+	struct rte_stack_lf_elem *tmp;
+	unsigned int i;
+
+	/* Reserve num elements, if available */
+	while (1) {
+		/* NOTE: review for potential ordering optimization */
+		uint64_t len = rte_atomic_load_explicit(&list->len, rte_memory_order_seq_cst);
+
+		if (unlikely(len < num))
+			return NULL;
+
+		/* NOTE: review for potential ordering optimization */
+		if (rte_atomic_compare_exchange_strong_explicit(&list->len, &len, len - num,
+				rte_memory_order_seq_cst, rte_memory_order_seq_cst))
+			break;
+	}
+
+	old_head = list->head;
+
+	/* An acquire fence (or stronger) is needed for weak memory
+	 * models to ensure the LF LIFO element reads are properly
+	 * ordered with respect to the head pointer read.
+	 */
+	rte_smp_mb();
+
+	tmp = old_head.top;
+
+	for (i = 0; i < num && tmp != NULL; i++) {
+		if (obj_table)
+			obj_table[i] = tmp->data;
+		if (last)
+			*last = tmp;
+		tmp = tmp->next;
+	}
+
+	new_head.top = tmp;
+	new_head.cnt = old_head.cnt + 1;
+
+	/* Single attempt, on contention the reservation is given back and
+	 * the caller handles it.
+	 */
+	if (i != num || rte_atomic128_cmp_exchange((rte_int128_t *)&list->head,
+				(rte_int128_t *)&old_head,
+				(rte_int128_t *)&new_head,
+				0, rte_memory_order_release,
+				rte_memory_order_relaxed) == 0) {
+		/* NOTE: review for potential ordering optimization */
+		rte_atomic_fetch_add_explicit(&list->len, num, rte_memory_order_seq_cst);
+		return NULL;
+	}
+
+	return old_head.top;
+}
+
 static __rte_always_inline struct rte_stack_lf_elem *
 __rte_stack_lf_pop_elems(struct rte_stack_lf_list *list,
 			 unsigned int num,
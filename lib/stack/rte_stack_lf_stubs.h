@@ -27,6 +27,34 @@ __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 	RTE_SET_USED(num);
 }
 
+static __rte_always_inline int
+__rte_stack_lf_try_push_elems(struct rte_stack_lf_list *list,
+			      struct rte_stack_lf_elem *first,
+			      struct rte_stack_lf_elem *last,
+			      unsigned int num)
+{
+	RTE_SET_USED(first);
+	RTE_SET_USED(last);
+	RTE_SET_USED(list);
+	RTE_SET_USED(num);
+
+	return 0;
+}
+
+static __rte_always_inline struct rte_stack_lf_elem *
+__rte_stack_lf_try_pop_elems(struct rte_stack_lf_list *list,
+			     unsigned int num,
+			     void **obj_table,
+			     struct rte_stack_lf_elem **last)
+{
+	RTE_SET_USED(obj_table);
+	RTE_SET_USED(last);
+	RTE_SET_USED(list);
+	RTE_SET_USED(num);
+
+	return NULL;
+}
+
 static __rte_always_inline struct rte_stack_lf_elem *
 __rte_stack_lf_pop_elems(struct rte_stack_lf_list *list,
 			 unsigned int num,
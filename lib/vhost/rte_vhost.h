@@ -42,6 +42,8 @@ extern "C" {
 #define RTE_VHOST_USER_NET_COMPLIANT_OL_FLAGS	(1ULL << 8)
 #define RTE_VHOST_USER_NET_STATS_ENABLE	(1ULL << 9)
 #define RTE_VHOST_USER_ASYNC_CONNECT	(1ULL << 10)
+/* attach guest buffers to dequeued mbufs instead of copying them */
+#define RTE_VHOST_USER_DEQUEUE_ZERO_COPY	(1ULL << 11)
 
 /* Features. */
 #ifndef VIRTIO_NET_F_GUEST_ANNOUNCE
@@ -1169,6 +1171,86 @@ rte_vhost_vring_stats_get(int vid, uint16_t queue_id,
 int
 rte_vhost_vring_stats_reset(int vid, uint16_t queue_id);
 
+/**
+ * Waiting mode advised for a vhost queue in adaptive polling.
+ */
+enum rte_vhost_poll_state {
+	/** Traffic is flowing, keep polling the queue. */
+	RTE_VHOST_POLL_BUSY,
+	/**
+	 * The queue is idle, wait with rte_power_monitor() on the condition
+	 * returned by rte_vhost_get_monitor_addr().
+	 */
+	RTE_VHOST_POLL_MONITOR,
+	/**
+	 * The queue stayed idle, guest notifications are enabled: poll the
+	 * queue once more, then wait on its kick eventfd.
+	 */
+	RTE_VHOST_POLL_INTERRUPT,
+};
+
+/**
+ * Adaptive polling configuration of a vhost queue.
+ */
+struct rte_vhost_adaptive_poll_conf {
+	/**
+	 * Maximum idle time in microseconds before leaving busy polling.
+	 * It is shortened to twice the average gap between packet arrivals
+	 * when traffic is sparse.
+	 */
+	uint32_t busy_poll_us;
+	/** Idle time in microseconds before switching to interrupt mode. */
+	uint32_t monitor_us;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Enable or disable adaptive polling of a vhost dequeue queue.
+ *
+ * When enabled, rte_vhost_dequeue_burst() and
+ * rte_vhost_async_try_dequeue_burst() track the packet arrivals on the
+ * queue and move it between busy polling, power monitor waits and
+ * interrupts, which rte_vhost_adaptive_poll_state_get() reports. The guest
+ * notifications of the queue are enabled only in interrupt mode.
+ * Transitions and wakeups are counted in the vring statistics.
+ *
+ * @param vid
+ *  vhost device ID
+ * @param queue_id
+ *  vhost dequeue queue ID
+ * @param conf
+ *  adaptive polling configuration, NULL to disable
+ * @return
+ *  0 on success, -1 on failure
+ */
+__rte_experimental
+int
+rte_vhost_adaptive_poll_configure(int vid, uint16_t queue_id,
+		const struct rte_vhost_adaptive_poll_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Get the waiting mode advised for a vhost queue in adaptive polling.
+ *
+ * This function is meant to be called by the thread dequeuing from the queue,
+ * after an empty dequeue burst.
+ *
+ * @param vid
+ *  vhost device ID
+ * @param queue_id
+ *  vhost dequeue queue ID
+ * @return
+ *  the rte_vhost_poll_state of the queue, -1 on failure or if adaptive
+ *  polling is not enabled
+ */
+__rte_experimental
+int
+rte_vhost_adaptive_poll_state_get(int vid, uint16_t queue_id);
+
 #ifdef __cplusplus
 }
 #endif
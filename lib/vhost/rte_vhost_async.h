@@ -286,6 +286,56 @@ __rte_experimental
 int
 rte_vhost_async_dma_unconfigure(int16_t dma_id, uint16_t vchan_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Configure doorbell batching of a DMA vChannel in Vhost asynchronous
+ * data path.
+ *
+ * By default, the DMA copies of each enqueue or dequeue burst are submitted
+ * to the DMA device at the end of the burst. With a non-zero threshold, the
+ * copies of all the virtqueues using the vChannel are accumulated and
+ * submitted at once, when at least 'submit_threshold' copies are pending,
+ * when completions are polled on the vChannel, or when
+ * rte_vhost_async_dma_submit() is called. Completions are still returned
+ * to the virtqueue owning each copy.
+ *
+ * The application serving several virtqueues with the same vChannel is
+ * expected to call rte_vhost_async_dma_submit() once per polling loop.
+ *
+ * @param dma_id
+ *  the identifier of DMA device
+ * @param vchan_id
+ *  the identifier of virtual DMA channel
+ * @param submit_threshold
+ *  number of pending copies triggering a submission, 0 to submit every burst
+ * @return
+ *  0 on success, and -1 on failure
+ */
+__rte_experimental
+int
+rte_vhost_async_dma_batch_configure(int16_t dma_id, uint16_t vchan_id,
+		uint16_t submit_threshold);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Submit to the DMA device the copies pending on a DMA vChannel, which were
+ * enqueued by any virtqueue of the Vhost asynchronous data path.
+ *
+ * @param dma_id
+ *  the identifier of DMA device
+ * @param vchan_id
+ *  the identifier of virtual DMA channel
+ * @return
+ *  0 on success, and -1 on failure
+ */
+__rte_experimental
+int
+rte_vhost_async_dma_submit(int16_t dma_id, uint16_t vchan_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,10 +12,13 @@
 #include <numaif.h>
 #endif
 
+#include <rte_cpuflags.h>
+#include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_log.h>
 #include <rte_memory.h>
 #include <rte_malloc.h>
+#include <rte_vect.h>
 #include <rte_vhost.h>
 
 #include "iotlb.h"
@@ -56,6 +59,16 @@ static const struct vhost_vq_stats_name_off vhost_vq_stat_strings[] = {
 	{"inflight_submitted",     offsetof(struct vhost_virtqueue, stats.inflight_submitted)},
 	{"inflight_completed",     offsetof(struct vhost_virtqueue, stats.inflight_completed)},
 	{"mbuf_alloc_failed",      offsetof(struct vhost_virtqueue, stats.mbuf_alloc_failed)},
+	{"poll_state",             offsetof(struct vhost_virtqueue, stats.poll_state)},
+	{"poll_monitor_entries",   offsetof(struct vhost_virtqueue, stats.poll_monitor_entries)},
+	{"poll_intr_entries",      offsetof(struct vhost_virtqueue, stats.poll_intr_entries)},
+	{"poll_wakeups",           offsetof(struct vhost_virtqueue, stats.poll_wakeups)},
+	{"poll_wakeup_cycles",     offsetof(struct vhost_virtqueue, stats.poll_wakeup_cycles)},
+	{"poll_wakeup_cycles_max", offsetof(struct vhost_virtqueue,
+		stats.poll_wakeup_cycles_max)},
+	{"poll_arrival_gap_cycles", offsetof(struct vhost_virtqueue,
+		stats.poll_arrival_gap_cycles)},
+	{"zero_copy_packets",      offsetof(struct vhost_virtqueue, stats.zero_copy_packets)},
 };
 
 #define VHOST_NB_VQ_STATS RTE_DIM(vhost_vq_stat_strings)
@@ -420,6 +433,7 @@ free_vq(struct virtio_net *dev, struct vhost_virtqueue *vq)
 	rte_rwlock_write_unlock(&vq->access_lock);
 	rte_free(vq->batch_copy_elems);
 	rte_free(vq->log_cache);
+	vhost_zcopy_free(dev, vq);
 	rte_free(vq);
 }
 
@@ -434,6 +448,7 @@ free_device(struct virtio_net *dev)
 	for (i = 0; i < dev->nr_vring; i++)
 		free_vq(dev, dev->virtqueue[i]);
 
+	vhost_zcopy_detached_free(dev);
 	rte_free(dev);
 }
 
@@ -691,6 +706,19 @@ reset_device(struct virtio_net *dev)
  * Invoked when there is a new vhost-user connection established (when
  * there is a new virtio device being attached).
  */
+static bool
+vhost_packed_vec_supported(void)
+{
+#if defined(CC_AVX512_SUPPORT)
+	return rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+		rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
+		rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) == 1 &&
+		rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512VL) == 1;
+#else
+	return false;
+#endif
+}
+
 int
 vhost_new_device(struct vhost_backend_ops *ops)
 {
@@ -736,6 +764,8 @@ vhost_new_device(struct vhost_backend_ops *ops)
 
 	dev->vid = i;
 	dev->flags = VIRTIO_DEV_BUILTIN_VIRTIO_NET;
+	if (vhost_packed_vec_supported())
+		dev->flags |= VIRTIO_DEV_PACKED_VEC;
 	dev->backend_req_fd = -1;
 	dev->postcopy_ufd = -1;
 	rte_spinlock_init(&dev->backend_req_lock);
@@ -860,6 +890,131 @@ vhost_enable_linearbuf(int vid)
 	dev->linearbuf = 1;
 }
 
+void
+vhost_enable_dequeue_zero_copy(int vid)
+{
+	struct virtio_net *dev = get_device(vid);
+
+	if (dev == NULL)
+		return;
+
+	dev->dequeue_zero_copy = 1;
+}
+
+static void
+vhost_zcopy_put(struct vhost_zcopy *zcopy)
+{
+	if (rte_atomic_fetch_sub_explicit(&zcopy->refcnt, 1,
+			rte_memory_order_acq_rel) == 1)
+		rte_free(zcopy);
+}
+
+/* Free callback of the external buffers attached by zero-copy dequeue */
+static void
+vhost_zcopy_buf_free(void *addr __rte_unused, void *opaque)
+{
+	struct vhost_zcopy_buf *buf = opaque;
+	struct vhost_zcopy *zcopy = buf->zcopy;
+
+	struct vhost_zcopy_mem *zmem;
+
+	rte_atomic_fetch_add_explicit(&zcopy->nr_done, 1, rte_memory_order_relaxed);
+	/* Pairs with the done check of vhost_zcopy_mem_retire(). */
+	rte_atomic_store_explicit(&buf->done, true, rte_memory_order_seq_cst);
+
+	/* Release the guest memory if it was removed while the buffer was lent. */
+	zmem = rte_atomic_exchange_explicit(&buf->mem, NULL, rte_memory_order_seq_cst);
+	if (zmem != NULL)
+		vhost_zcopy_mem_put(zmem);
+
+	vhost_zcopy_put(zcopy);
+}
+
+int
+vhost_zcopy_alloc(struct virtio_net *dev, struct vhost_virtqueue *vq)
+{
+	struct vhost_zcopy *zcopy;
+	uint16_t i;
+
+	vhost_zcopy_free(dev, vq);
+
+	zcopy = rte_zmalloc_socket(NULL, sizeof(*zcopy) +
+			vq->size * (sizeof(zcopy->bufs[0]) + sizeof(zcopy->pending[0])),
+			RTE_CACHE_LINE_SIZE, vq->numa_node);
+	if (zcopy == NULL) {
+		VHOST_CONFIG_LOG(dev->ifname, ERR,
+			"failed to allocate zero-copy dequeue state (vq %u)", vq->index);
+		return -1;
+	}
+
+	zcopy->size = vq->size;
+	zcopy->pending = (uint16_t *)&zcopy->bufs[vq->size];
+	for (i = 0; i < vq->size; i++) {
+		zcopy->bufs[i].zcopy = zcopy;
+		zcopy->bufs[i].shinfo.free_cb = vhost_zcopy_buf_free;
+		zcopy->bufs[i].shinfo.fcb_opaque = &zcopy->bufs[i];
+	}
+	rte_atomic_store_explicit(&zcopy->refcnt, 1, rte_memory_order_relaxed);
+
+	vq->zcopy = zcopy;
+
+	return 0;
+}
+
+/* Drop the detached states whose buffers all came back. */
+static void
+vhost_zcopy_detached_prune(struct virtio_net *dev)
+{
+	struct vhost_zcopy **prev = &dev->zcopy_detached;
+	struct vhost_zcopy *zcopy;
+
+	while ((zcopy = *prev) != NULL) {
+		if (rte_atomic_load_explicit(&zcopy->refcnt,
+				rte_memory_order_acquire) == 1) {
+			*prev = zcopy->next;
+			vhost_zcopy_put(zcopy);
+		} else {
+			prev = &zcopy->next;
+		}
+	}
+}
+
+void
+vhost_zcopy_free(struct virtio_net *dev, struct vhost_virtqueue *vq)
+{
+	struct vhost_zcopy *zcopy = vq->zcopy;
+
+	if (zcopy == NULL)
+		return;
+
+	vq->zcopy = NULL;
+	vhost_zcopy_detached_prune(dev);
+
+	/*
+	 * Buffers still lent keep the state alive until their mbufs are freed.
+	 * The device keeps track of it until then, so that the guest memory
+	 * they point into is not unmapped under them.
+	 */
+	if (rte_atomic_load_explicit(&zcopy->refcnt, rte_memory_order_acquire) > 1) {
+		zcopy->next = dev->zcopy_detached;
+		dev->zcopy_detached = zcopy;
+	} else {
+		vhost_zcopy_put(zcopy);
+	}
+}
+
+/* Drop the device references on the detached states, its memory is gone. */
+void
+vhost_zcopy_detached_free(struct virtio_net *dev)
+{
+	struct vhost_zcopy *zcopy;
+
+	while ((zcopy = dev->zcopy_detached) != NULL) {
+		dev->zcopy_detached = zcopy->next;
+		vhost_zcopy_put(zcopy);
+	}
+}
+
 int
 rte_vhost_get_mtu(int vid, uint16_t *mtu)
 {
@@ -2016,6 +2171,7 @@ rte_vhost_async_dma_configure(int16_t dma_id, uint16_t vchan_id)
 		}
 
 		dma_copy_track[dma_id].vchans = vchans;
+		dma_copy_track[dma_id].max_vchans = info.max_vchans;
 	}
 
 	if (dma_copy_track[dma_id].vchans[vchan_id].pkts_cmpl_flag_addr) {
@@ -2038,6 +2194,7 @@ rte_vhost_async_dma_configure(int16_t dma_id, uint16_t vchan_id)
 		if (dma_copy_track[dma_id].nr_vchans == 0) {
 			rte_free(dma_copy_track[dma_id].vchans);
 			dma_copy_track[dma_id].vchans = NULL;
+			dma_copy_track[dma_id].max_vchans = 0;
 		}
 		goto error;
 	}
@@ -2272,6 +2429,59 @@ int rte_vhost_vring_stats_reset(int vid, uint16_t queue_id)
 	 * above write access_lock preventing them to be updated.
 	 */
 	memset(&vq->stats, 0, sizeof(vq->stats));
+	vq->stats.poll_state = vq->adaptive.state;
+
+out_unlock:
+	rte_rwlock_write_unlock(&vq->access_lock);
+
+	return ret;
+}
+
+int
+rte_vhost_adaptive_poll_configure(int vid, uint16_t queue_id,
+		const struct rte_vhost_adaptive_poll_conf *conf)
+{
+	struct virtio_net *dev = get_device(vid);
+	struct vhost_adaptive_poll *ap;
+	struct vhost_virtqueue *vq;
+	uint64_t us_cycles;
+	int ret = 0;
+
+	if (dev == NULL)
+		return -1;
+
+	if (queue_id >= dev->nr_vring || !(queue_id & 1))
+		return -1;
+
+	vq = dev->virtqueue[queue_id];
+	if (vq == NULL)
+		return -1;
+
+	rte_rwlock_write_lock(&vq->access_lock);
+
+	if (unlikely(!vq->access_ok)) {
+		ret = -1;
+		goto out_unlock;
+	}
+
+	ap = &vq->adaptive;
+	if (ap->state == RTE_VHOST_POLL_INTERRUPT) {
+		vq->notif_enable = 0;
+		vhost_enable_guest_notification(dev, vq, 0);
+	}
+
+	memset(ap, 0, sizeof(*ap));
+	vq->stats.poll_state = RTE_VHOST_POLL_BUSY;
+	if (conf == NULL)
+		goto out_unlock;
+
+	us_cycles = rte_get_tsc_hz() / US_PER_S;
+	ap->busy_cycles = conf->busy_poll_us * us_cycles;
+	ap->monitor_cycles = conf->monitor_us * us_cycles;
+	ap->avg_gap = ap->busy_cycles;
+	ap->last_arrival = rte_rdtsc();
+	ap->last_poll = ap->last_arrival;
+	ap->enabled = true;
 
 out_unlock:
 	rte_rwlock_write_unlock(&vq->access_lock);
@@ -2279,9 +2489,108 @@ int rte_vhost_vring_stats_reset(int vid, uint16_t queue_id)
 	return ret;
 }
 
+int
+rte_vhost_adaptive_poll_state_get(int vid, uint16_t queue_id)
+{
+	struct virtio_net *dev = get_device(vid);
+	struct vhost_virtqueue *vq;
+
+	if (dev == NULL)
+		return -1;
+
+	if (queue_id >= dev->nr_vring || !(queue_id & 1))
+		return -1;
+
+	vq = dev->virtqueue[queue_id];
+	if (vq == NULL || !vq->adaptive.enabled)
+		return -1;
+
+	return vq->adaptive.state;
+}
+
+static struct async_dma_vchan_info *
+vhost_async_dma_vchan_get(int16_t dma_id, uint16_t vchan_id)
+{
+	struct rte_dma_info info;
+
+	if (!rte_dma_is_valid(dma_id)) {
+		VHOST_CONFIG_LOG("dma", ERR, "DMA %d is not found.", dma_id);
+		return NULL;
+	}
+
+	if (rte_dma_info_get(dma_id, &info) != 0) {
+		VHOST_CONFIG_LOG("dma", ERR, "Fail to get DMA %d information.", dma_id);
+		return NULL;
+	}
+
+	if (vchan_id >= info.max_vchans || !dma_copy_track[dma_id].vchans ||
+		!dma_copy_track[dma_id].vchans[vchan_id].pkts_cmpl_flag_addr) {
+		VHOST_CONFIG_LOG("dma", ERR, "Invalid channel %d:%u.", dma_id, vchan_id);
+		return NULL;
+	}
+
+	return &dma_copy_track[dma_id].vchans[vchan_id];
+}
+
+int
+rte_vhost_async_dma_batch_configure(int16_t dma_id, uint16_t vchan_id,
+		uint16_t submit_threshold)
+{
+	struct async_dma_vchan_info *dma_info;
+
+	pthread_mutex_lock(&vhost_dma_lock);
+
+	dma_info = vhost_async_dma_vchan_get(dma_id, vchan_id);
+	if (dma_info == NULL) {
+		pthread_mutex_unlock(&vhost_dma_lock);
+		return -1;
+	}
+
+	rte_spinlock_lock(&dma_info->dma_lock);
+	dma_info->submit_threshold = RTE_MIN(submit_threshold, dma_info->ring_size);
+	if (dma_info->nr_pending >= dma_info->submit_threshold && dma_info->nr_pending) {
+		rte_dma_submit(dma_id, vchan_id);
+		dma_info->nr_pending = 0;
+	}
+	rte_spinlock_unlock(&dma_info->dma_lock);
+
+	pthread_mutex_unlock(&vhost_dma_lock);
+	return 0;
+}
+
+int
+rte_vhost_async_dma_submit(int16_t dma_id, uint16_t vchan_id)
+{
+	struct async_dma_vchan_info *dma_info;
+
+	/* data path call: check against the channel count cached at
+	 * configure time rather than querying the DMA device
+	 */
+	if (unlikely(dma_id < 0 || dma_id >= RTE_DMADEV_DEFAULT_MAX ||
+			vchan_id >= dma_copy_track[dma_id].max_vchans ||
+			!dma_copy_track[dma_id].vchans ||
+			!dma_copy_track[dma_id].vchans[vchan_id].pkts_cmpl_flag_addr)) {
+		VHOST_DATA_LOG("dma", ERR, "%s: invalid channel %d:%u.",
+			__func__, dma_id, vchan_id);
+		return -1;
+	}
+
+	dma_info = &dma_copy_track[dma_id].vchans[vchan_id];
+
+	rte_spinlock_lock(&dma_info->dma_lock);
+	if (dma_info->nr_pending) {
+		rte_dma_submit(dma_id, vchan_id);
+		dma_info->nr_pending = 0;
+	}
+	rte_spinlock_unlock(&dma_info->dma_lock);
+
+	return 0;
+}
+
 int
 rte_vhost_async_dma_unconfigure(int16_t dma_id, uint16_t vchan_id)
 {
+	struct async_dma_vchan_info *dma_info;
 	struct rte_dma_info info;
 	struct rte_dma_stats stats = { 0 };
 
@@ -2309,19 +2618,27 @@ rte_vhost_async_dma_unconfigure(int16_t dma_id, uint16_t vchan_id)
 		goto error;
 	}
 
-	if (stats.submitted - stats.completed != 0) {
+	/* nr_pending is updated by the data path under dma_lock, hold it
+	 * until the channel is unregistered
+	 */
+	dma_info = &dma_copy_track[dma_id].vchans[vchan_id];
+	rte_spinlock_lock(&dma_info->dma_lock);
+	if (stats.submitted - stats.completed != 0 || dma_info->nr_pending != 0) {
+		rte_spinlock_unlock(&dma_info->dma_lock);
 		VHOST_CONFIG_LOG("dma", ERR,
 				 "Do not unconfigure when there are inflight packets.");
 		goto error;
 	}
 
-	rte_free(dma_copy_track[dma_id].vchans[vchan_id].pkts_cmpl_flag_addr);
-	dma_copy_track[dma_id].vchans[vchan_id].pkts_cmpl_flag_addr = NULL;
+	rte_free(dma_info->pkts_cmpl_flag_addr);
+	dma_info->pkts_cmpl_flag_addr = NULL;
+	rte_spinlock_unlock(&dma_info->dma_lock);
 	dma_copy_track[dma_id].nr_vchans--;
 
 	if (dma_copy_track[dma_id].nr_vchans == 0) {
 		rte_free(dma_copy_track[dma_id].vchans);
 		dma_copy_track[dma_id].vchans = NULL;
+		dma_copy_track[dma_id].max_vchans = 0;
 	}
 
 	pthread_mutex_unlock(&vhost_dma_lock);
@@ -41,6 +41,8 @@
 #define VIRTIO_DEV_STATS_ENABLED ((uint32_t)1 << 6)
 /*  Used to indicate the application has requested iommu support */
 #define VIRTIO_DEV_SUPPORT_IOMMU ((uint32_t)1 << 7)
+/*  Used to indicate the packed ring batches use the vectorized path */
+#define VIRTIO_DEV_PACKED_VEC ((uint32_t)1 << 8)
 
 /* Backend value set by guest. */
 #define VIRTIO_DEV_STOPPED -1
@@ -153,12 +155,92 @@ struct virtqueue_stats {
 	uint64_t inflight_completed;
 	uint64_t mbuf_alloc_failed;
 	uint64_t guest_notifications_suppressed;
+	/* Adaptive polling, see struct vhost_adaptive_poll */
+	uint64_t poll_state;
+	uint64_t poll_monitor_entries;
+	uint64_t poll_intr_entries;
+	uint64_t poll_wakeups;
+	uint64_t poll_wakeup_cycles;
+	uint64_t poll_wakeup_cycles_max;
+	uint64_t poll_arrival_gap_cycles;
+	uint64_t zero_copy_packets;
 	/* Counters below are atomic, and should be incremented as such. */
 	RTE_ATOMIC(uint64_t) guest_notifications;
 	RTE_ATOMIC(uint64_t) guest_notifications_offloaded;
 	RTE_ATOMIC(uint64_t) guest_notifications_error;
 };
 
+/**
+ * Adaptive polling state of a dequeue virtqueue
+ */
+struct vhost_adaptive_poll {
+	/* idle time before leaving busy polling */
+	uint64_t busy_cycles;
+	/* idle time before enabling guest notifications */
+	uint64_t monitor_cycles;
+	/* TSC of the last non empty and of the last poll */
+	uint64_t last_arrival;
+	uint64_t last_poll;
+	/* moving average of the time between two non empty polls */
+	uint64_t avg_gap;
+	bool enabled;
+	/* enum rte_vhost_poll_state */
+	uint8_t state;
+};
+
+/* Minimum data length for a dequeued buffer to be attached instead of copied */
+#define VHOST_ZCOPY_MIN_LEN	512
+
+/**
+ * Guest buffer lent to an mbuf by zero-copy dequeue
+ */
+struct vhost_zcopy_buf {
+	struct rte_mbuf_ext_shared_info shinfo;
+	struct vhost_zcopy *zcopy;
+	/* set by the mbuf free callback, cleared when made used */
+	RTE_ATOMIC(bool) done;
+	/* attached to an mbuf and not made used yet */
+	bool lent;
+	/* unmapped guest memory the buffer points into, if any */
+	RTE_ATOMIC(struct vhost_zcopy_mem *) mem;
+};
+
+/**
+ * Zero-copy dequeue state of a split virtqueue
+ *
+ * The used ring update of a lent buffer is deferred until the mbuf is freed.
+ * The structure is reference counted, one reference for the virtqueue and
+ * one per lent buffer, as mbufs may be freed after the virtqueue is gone.
+ */
+struct vhost_zcopy {
+	RTE_ATOMIC(uint32_t) refcnt;
+	/* lent buffers freed but not yet made used */
+	RTE_ATOMIC(uint32_t) nr_done;
+	uint16_t nr_pending;
+	uint16_t size;
+	/* head descriptor indexes of lent buffers, in lending order */
+	uint16_t *pending;
+	/* next in the device list, once detached from its virtqueue */
+	struct vhost_zcopy *next;
+	/* indexed by head descriptor index */
+	struct vhost_zcopy_buf bufs[];
+};
+
+/**
+ * Guest memory removed by the front-end while zero-copy mbufs point into it
+ *
+ * The mappings are released with the last of these mbufs. The structure is
+ * reference counted, one reference per lent buffer and one for its creator.
+ */
+struct vhost_zcopy_mem {
+	RTE_ATOMIC(uint32_t) refcnt;
+	bool dma_mapped;
+	struct rte_vhost_memory *mem;
+	uint32_t nr_guest_pages;
+	struct guest_page *guest_pages;
+	char *ifname;
+};
+
 /**
  * iovec
  */
@@ -187,6 +269,13 @@ struct async_dma_vchan_info {
 	/* ring index mask for 'pkts_cmpl_flag_addr' */
 	uint16_t ring_mask;
 
+	/*
+	 * Copies enqueued by any virtqueue but not submitted yet, the
+	 * doorbell is rung once they reach 'submit_threshold'.
+	 */
+	uint16_t nr_pending;
+	uint16_t submit_threshold;
+
 	/**
 	 * DMA virtual channel lock. Although it is able to bind DMA
 	 * virtual channels to data plane threads, vhost control plane
@@ -205,6 +294,8 @@ struct async_dma_vchan_info {
 
 struct async_dma_info {
 	struct async_dma_vchan_info *vchans;
+	/* number of entries in vchans, i.e. the DMA max_vchans */
+	uint16_t max_vchans;
 	/* number of registered virtual channels */
 	uint16_t nr_vchans;
 };
@@ -362,6 +453,8 @@ struct __rte_cache_aligned vhost_virtqueue {
 
 	struct vhost_vring_addr ring_addrs;
 	struct virtqueue_stats	stats;
+	struct vhost_adaptive_poll adaptive;
+	struct vhost_zcopy	*zcopy;
 
 	RTE_ATOMIC(bool) irq_pending;
 	struct vhost_reconnect_vring *reconnect_log;
@@ -505,6 +598,9 @@ struct __rte_cache_aligned virtio_net {
 
 	int			extbuf;
 	int			linearbuf;
+	int			dequeue_zero_copy;
+	/* zero-copy states of freed virtqueues with buffers still lent */
+	struct vhost_zcopy	*zcopy_detached;
 	struct vhost_virtqueue	*virtqueue[VHOST_MAX_QUEUE_PAIRS * 2];
 
 	rte_rwlock_t	iotlb_pending_lock;
@@ -885,6 +981,11 @@ void vhost_setup_virtio_net(int vid, bool enable, bool legacy_ol_flags, bool sta
 	bool support_iommu);
 void vhost_enable_extbuf(int vid);
 void vhost_enable_linearbuf(int vid);
+void vhost_enable_dequeue_zero_copy(int vid);
+int vhost_zcopy_alloc(struct virtio_net *dev, struct vhost_virtqueue *vq);
+void vhost_zcopy_free(struct virtio_net *dev, struct vhost_virtqueue *vq);
+void vhost_zcopy_detached_free(struct virtio_net *dev);
+void vhost_zcopy_mem_put(struct vhost_zcopy_mem *zmem);
 int vhost_enable_guest_notification(struct virtio_net *dev,
 		struct vhost_virtqueue *vq, int enable);
 
@@ -924,6 +1025,17 @@ vhost_iova_to_vva(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	return __vhost_iova_to_vva(dev, vq, iova, len, perm);
 }
 
+int vhost_rx_batch_packed_check_avx(struct virtio_net *dev,
+			struct vhost_virtqueue *vq, struct rte_mbuf **pkts,
+			uint64_t *desc_addrs, uint64_t *lens)
+	__rte_requires_shared_capability(&vq->iotlb_lock);
+int vhost_tx_batch_packed_check_avx(struct virtio_net *dev,
+			struct vhost_virtqueue *vq, uint16_t avail_idx,
+			uint64_t *desc_addrs, uint64_t *lens, uint16_t *ids)
+	__rte_requires_shared_capability(&vq->iotlb_lock);
+void vhost_flush_batch_packed_avx(struct vhost_virtqueue *vq,
+			uint64_t *lens, uint16_t *ids, uint16_t flags);
+
 #define vhost_avail_event(vr) \
 	(*(volatile uint16_t*)&(vr)->used->ring[(vr)->size])
 #define vhost_used_event(vr) \
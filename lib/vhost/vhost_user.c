@@ -173,6 +173,28 @@ get_blk_size(int fd)
 	return ret == -1 ? (uint64_t)-1 : (uint64_t)stat.st_blksize;
 }
 
+static void
+async_dma_unmap_pages(const char *ifname, const struct guest_page *pages,
+		uint32_t nr_pages)
+{
+	int ret = 0;
+	uint32_t i;
+
+	for (i = 0; i < nr_pages; i++) {
+		ret = rte_vfio_container_dma_unmap(RTE_VFIO_DEFAULT_CONTAINER_FD,
+						   pages[i].host_user_addr,
+						   pages[i].host_iova,
+						   pages[i].size);
+		if (ret) {
+			/* like DMA map, ignore the kernel driver case when unmap. */
+			if (rte_errno == EINVAL)
+				return;
+
+			VHOST_CONFIG_LOG(ifname, ERR, "DMA engine unmap failed");
+		}
+	}
+}
+
 static void
 async_dma_map(struct virtio_net *dev, bool do_map)
 {
@@ -209,42 +231,144 @@ async_dma_map(struct virtio_net *dev, bool do_map)
 		}
 
 	} else {
-		for (i = 0; i < dev->nr_guest_pages; i++) {
-			page = &dev->guest_pages[i];
-			ret = rte_vfio_container_dma_unmap(RTE_VFIO_DEFAULT_CONTAINER_FD,
-							   page->host_user_addr,
-							   page->host_iova,
-							   page->size);
-			if (ret) {
-				/* like DMA map, ignore the kernel driver case when unmap. */
-				if (rte_errno == EINVAL)
-					return;
+		async_dma_unmap_pages(dev->ifname, dev->guest_pages, dev->nr_guest_pages);
+	}
+}
 
-				VHOST_CONFIG_LOG(dev->ifname, ERR, "DMA engine unmap failed");
-			}
+static void
+unmap_mem_regions(struct rte_vhost_memory *mem)
+{
+	struct rte_vhost_mem_region *reg;
+	uint32_t i;
+
+	for (i = 0; i < mem->nregions; i++) {
+		reg = &mem->regions[i];
+		if (reg->host_user_addr) {
+			munmap(reg->mmap_addr, reg->mmap_size);
+			close(reg->fd);
 		}
 	}
 }
 
+/* Release guest memory removed while zero-copy buffers pointed into it. */
+void
+vhost_zcopy_mem_put(struct vhost_zcopy_mem *zmem)
+{
+	if (rte_atomic_fetch_sub_explicit(&zmem->refcnt, 1,
+			rte_memory_order_acq_rel) != 1)
+		return;
+
+	if (zmem->dma_mapped)
+		async_dma_unmap_pages(zmem->ifname, zmem->guest_pages,
+				zmem->nr_guest_pages);
+	unmap_mem_regions(zmem->mem);
+	rte_free(zmem->mem);
+	rte_free(zmem);
+}
+
+/* Make a buffer still lent reference the guest memory being removed. */
 static void
-free_mem_region(struct virtio_net *dev)
+vhost_zcopy_mem_retire_buf(struct vhost_zcopy_buf *buf, struct vhost_zcopy_mem *zmem)
 {
+	struct vhost_zcopy_mem *expected = NULL;
+
+	rte_atomic_fetch_add_explicit(&zmem->refcnt, 1, rte_memory_order_relaxed);
+
+	/* Lent before an earlier change, the buffer points into older memory. */
+	if (!rte_atomic_compare_exchange_strong_explicit(&buf->mem, &expected,
+			zmem, rte_memory_order_seq_cst, rte_memory_order_relaxed)) {
+		rte_atomic_fetch_sub_explicit(&zmem->refcnt, 1, rte_memory_order_relaxed);
+		return;
+	}
+
+	/*
+	 * The mbuf free callback sets done before it takes the reference, so
+	 * either it sees the reference, or the buffer is seen as done here.
+	 * Whichever takes the reference back drops it.
+	 */
+	if (rte_atomic_load_explicit(&buf->done, rte_memory_order_seq_cst) &&
+			rte_atomic_compare_exchange_strong_explicit(&buf->mem, &zmem,
+				NULL, rte_memory_order_seq_cst, rte_memory_order_relaxed))
+		rte_atomic_fetch_sub_explicit(&zmem->refcnt, 1, rte_memory_order_relaxed);
+}
+
+static void
+vhost_zcopy_mem_retire_state(struct vhost_zcopy *zcopy, struct vhost_zcopy_mem *zmem)
+{
+	uint16_t i;
+
+	for (i = 0; i < zcopy->nr_pending; i++)
+		vhost_zcopy_mem_retire_buf(&zcopy->bufs[zcopy->pending[i]], zmem);
+}
+
+/*
+ * Hand the guest memory over to the zero-copy buffers still pointing into it,
+ * so that it is unmapped only once their mbufs are freed. The virtqueues are
+ * locked, or not processed anymore.
+ */
+static void
+vhost_zcopy_mem_retire(struct virtio_net *dev)
+{
+	struct vhost_zcopy_mem *zmem;
+	struct vhost_zcopy *zcopy;
+	size_t pages_sz, name_sz;
 	uint32_t i;
-	struct rte_vhost_mem_region *reg;
 
+	pages_sz = dev->nr_guest_pages * sizeof(*dev->guest_pages);
+	name_sz = strlen(dev->ifname) + 1;
+	zmem = rte_zmalloc(NULL, sizeof(*zmem) + pages_sz + name_sz, 0);
+	if (zmem == NULL) {
+		/* Leaking the mappings is safer than unmapping them under the mbufs. */
+		VHOST_CONFIG_LOG(dev->ifname, ERR,
+			"failed to allocate zero-copy memory state, guest memory is leaked");
+		rte_free(dev->mem);
+		dev->mem = NULL;
+		return;
+	}
+
+	rte_atomic_store_explicit(&zmem->refcnt, 1, rte_memory_order_relaxed);
+	zmem->dma_mapped = rte_vfio_is_enabled("vfio");
+	zmem->mem = dev->mem;
+	zmem->nr_guest_pages = dev->nr_guest_pages;
+	zmem->guest_pages = (struct guest_page *)(zmem + 1);
+	if (pages_sz != 0)
+		memcpy(zmem->guest_pages, dev->guest_pages, pages_sz);
+	zmem->ifname = (char *)zmem->guest_pages + pages_sz;
+	memcpy(zmem->ifname, dev->ifname, name_sz);
+	dev->mem = NULL;
+
+	for (i = 0; i < dev->nr_vring; i++) {
+		if (dev->virtqueue[i] != NULL && dev->virtqueue[i]->zcopy != NULL)
+			vhost_zcopy_mem_retire_state(dev->virtqueue[i]->zcopy, zmem);
+	}
+	for (zcopy = dev->zcopy_detached; zcopy != NULL; zcopy = zcopy->next)
+		vhost_zcopy_mem_retire_state(zcopy, zmem);
+
+	/* Unmapped right away if no buffer is lent. */
+	vhost_zcopy_mem_put(zmem);
+}
+
+/*
+ * Unmap the guest memory. With zero-copy dequeue, the unmap may be deferred,
+ * dev->mem is reset in both cases.
+ */
+static void
+free_mem_region(struct virtio_net *dev)
+{
 	if (!dev || !dev->mem)
 		return;
 
+	if (dev->dequeue_zero_copy) {
+		vhost_zcopy_mem_retire(dev);
+		return;
+	}
+
 	if (dev->async_copy && rte_vfio_is_enabled("vfio"))
 		async_dma_map(dev, false);
 
-	for (i = 0; i < dev->mem->nregions; i++) {
-		reg = &dev->mem->regions[i];
-		if (reg->host_user_addr) {
-			munmap(reg->mmap_addr, reg->mmap_size);
-			close(reg->fd);
-		}
-	}
+	unmap_mem_regions(dev->mem);
+	rte_free(dev->mem);
+	dev->mem = NULL;
 }
 
 void
@@ -258,8 +382,6 @@ vhost_backend_cleanup(struct virtio_net *dev)
 
 	if (dev->mem) {
 		free_mem_region(dev);
-		rte_free(dev->mem);
-		dev->mem = NULL;
 	}
 
 	rte_free(dev->guest_pages);
@@ -536,6 +658,10 @@ vhost_user_set_vring_num(struct virtio_net **pdev,
 				"failed to allocate memory for vq internal data.");
 			return RTE_VHOST_MSG_RESULT_ERR;
 		}
+
+		if (dev->dequeue_zero_copy && (vq->index & 1) &&
+				vhost_zcopy_alloc(dev, vq) < 0)
+			return RTE_VHOST_MSG_RESULT_ERR;
 	}
 
 	rte_free(vq->batch_copy_elems);
@@ -1334,7 +1460,7 @@ vhost_user_mmap_region(struct virtio_net *dev,
 		return -1;
 	}
 
-	populate = dev->async_copy ? MAP_POPULATE : 0;
+	populate = (dev->async_copy || dev->dequeue_zero_copy) ? MAP_POPULATE : 0;
 	mmap_addr = mmap(NULL, mmap_size, PROT_READ | PROT_WRITE,
 			MAP_SHARED | populate, region->fd, 0);
 
@@ -1348,7 +1474,8 @@ vhost_user_mmap_region(struct virtio_net *dev,
 	region->host_user_addr = (uint64_t)(uintptr_t)mmap_addr + mmap_offset;
 	mem_set_dump(dev, mmap_addr, mmap_size, false, alignment);
 
-	if (dev->async_copy) {
+	/* Zero-copy dequeue hands guest buffer IOVAs to the application. */
+	if (dev->async_copy || dev->dequeue_zero_copy) {
 		if (add_guest_pages(dev, region, alignment) < 0) {
 			VHOST_CONFIG_LOG(dev->ifname, ERR,
 				"adding guest pages to region failed.");
@@ -1438,8 +1565,6 @@ vhost_user_set_mem_table(struct virtio_net **pdev,
 			vhost_user_iotlb_flush_all(dev);
 
 		free_mem_region(dev);
-		rte_free(dev->mem);
-		dev->mem = NULL;
 	}
 
 	/*
@@ -1495,7 +1620,7 @@ vhost_user_set_mem_table(struct virtio_net **pdev,
 		dev->mem->nregions++;
 	}
 
-	if (dev->async_copy && rte_vfio_is_enabled("vfio"))
+	if ((dev->async_copy || dev->dequeue_zero_copy) && rte_vfio_is_enabled("vfio"))
 		async_dma_map(dev, true);
 
 	if (vhost_user_postcopy_register(dev, main_fd, ctx) < 0)
@@ -1534,8 +1659,6 @@ vhost_user_set_mem_table(struct virtio_net **pdev,
 
 free_mem_table:
 	free_mem_region(dev);
-	rte_free(dev->mem);
-	dev->mem = NULL;
 
 free_guest_pages:
 	rte_free(dev->guest_pages);
@@ -2262,6 +2385,7 @@ vhost_user_get_vring_base(struct virtio_net **pdev,
 	} else {
 		rte_free(vq->shadow_used_split);
 		vq->shadow_used_split = NULL;
+		vhost_zcopy_free(dev, vq);
 	}
 
 	rte_free(vq->batch_copy_elems);
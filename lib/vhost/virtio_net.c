@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <linux/virtio_net.h>
 
+#include <rte_cycles.h>
 #include <rte_mbuf.h>
 #include <rte_memcpy.h>
 #include <rte_net.h>
@@ -52,6 +53,62 @@ is_valid_virt_queue_idx(uint32_t idx, int is_tx, uint32_t nr_vring)
 	return (is_tx ^ (idx & 1)) == 0 && idx < nr_vring;
 }
 
+/*
+ * Advise busy polling while packets arrive, then power monitor waits once
+ * the queue is idle for longer than the arrival gap, and guest notifications
+ * once it stays idle.
+ */
+static __rte_always_inline void
+vhost_adaptive_poll_update(struct virtio_net *dev, struct vhost_virtqueue *vq,
+		uint16_t nb_pkts)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_adaptive_poll *ap = &vq->adaptive;
+	struct virtqueue_stats *stats = &vq->stats;
+	uint64_t now = rte_rdtsc();
+	uint64_t idle, wakeup;
+
+	if (nb_pkts == 0) {
+		idle = now - ap->last_arrival;
+		ap->last_poll = now;
+
+		if (ap->state == RTE_VHOST_POLL_BUSY &&
+				idle > RTE_MIN(ap->busy_cycles, 2 * ap->avg_gap)) {
+			ap->state = RTE_VHOST_POLL_MONITOR;
+			stats->poll_monitor_entries++;
+		} else if (ap->state == RTE_VHOST_POLL_MONITOR &&
+				idle > ap->monitor_cycles) {
+			ap->state = RTE_VHOST_POLL_INTERRUPT;
+			stats->poll_intr_entries++;
+			vq->notif_enable = 1;
+			vhost_enable_guest_notification(dev, vq, 1);
+		}
+		stats->poll_state = ap->state;
+		return;
+	}
+
+	if (ap->state != RTE_VHOST_POLL_BUSY) {
+		/* Upper bound of the time the packets waited to be polled. */
+		wakeup = now - ap->last_poll;
+		stats->poll_wakeups++;
+		stats->poll_wakeup_cycles += wakeup;
+		if (wakeup > stats->poll_wakeup_cycles_max)
+			stats->poll_wakeup_cycles_max = wakeup;
+
+		if (ap->state == RTE_VHOST_POLL_INTERRUPT) {
+			vq->notif_enable = 0;
+			vhost_enable_guest_notification(dev, vq, 0);
+		}
+		ap->state = RTE_VHOST_POLL_BUSY;
+		stats->poll_state = ap->state;
+	}
+
+	ap->avg_gap = (ap->avg_gap * 7 + (now - ap->last_arrival)) / 8;
+	stats->poll_arrival_gap_cycles = ap->avg_gap;
+	ap->last_arrival = now;
+	ap->last_poll = now;
+}
+
 static inline void
 vhost_queue_stats_update(const struct virtio_net *dev, struct vhost_virtqueue *vq,
 		struct rte_mbuf **pkts, uint16_t count)
@@ -136,6 +193,17 @@ vhost_async_dma_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	return nr_segs;
 }
 
+static __rte_always_inline void
+vhost_async_dma_submit_pending(int16_t dma_id, uint16_t vchan_id,
+		struct async_dma_vchan_info *dma_info)
+{
+	if (dma_info->nr_pending == 0)
+		return;
+
+	rte_dma_submit(dma_id, vchan_id);
+	dma_info->nr_pending = 0;
+}
+
 static __rte_always_inline uint16_t
 vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		int16_t dma_id, uint16_t vchan_id, uint16_t head_idx,
@@ -160,8 +228,13 @@ vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 			head_idx -= vq->size;
 	}
 
-	if (likely(nr_copies > 0))
-		rte_dma_submit(dma_id, vchan_id);
+	/*
+	 * The doorbell is shared by all the virtqueues using this vChannel,
+	 * it is rung once enough copies are pending.
+	 */
+	dma_info->nr_pending += nr_copies;
+	if (dma_info->nr_pending >= dma_info->submit_threshold)
+		vhost_async_dma_submit_pending(dma_id, vchan_id, dma_info);
 
 	rte_spinlock_unlock(&dma_info->dma_lock);
 
@@ -183,6 +256,9 @@ vhost_async_dma_check_completed(struct virtio_net *dev, int16_t dma_id, uint16_t
 
 	rte_spinlock_lock(&dma_info->dma_lock);
 
+	/* Copies of other virtqueues may still wait for the doorbell. */
+	vhost_async_dma_submit_pending(dma_id, vchan_id, dma_info);
+
 	/**
 	 * Print error log for debugging, if DMA reports error during
 	 * DMA transfer. We do not handle error in vhost level.
@@ -402,6 +478,13 @@ vhost_flush_enqueue_batch_packed(struct virtio_net *dev,
 
 	flags = PACKED_DESC_ENQUEUE_USED_FLAG(vq->used_wrap_counter);
 
+#ifdef CC_AVX512_SUPPORT
+	if (dev->flags & VIRTIO_DEV_PACKED_VEC) {
+		vhost_flush_batch_packed_avx(vq, lens, ids, flags);
+		goto log;
+	}
+#endif
+
 	vhost_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
 		desc_base[i].id = ids[i];
 		desc_base[i].len = lens[i];
@@ -413,6 +496,10 @@ vhost_flush_enqueue_batch_packed(struct virtio_net *dev,
 		desc_base[i].flags = flags;
 	}
 
+#ifdef CC_AVX512_SUPPORT
+log:
+#endif
+
 	vhost_log_cache_used_vring(dev, vq, last_used_idx *
 				   sizeof(struct vring_packed_desc),
 				   sizeof(struct vring_packed_desc) *
@@ -1460,6 +1547,12 @@ virtio_dev_rx_sync_batch_check(struct virtio_net *dev,
 	uint32_t buf_offset = sizeof(struct virtio_net_hdr_mrg_rxbuf);
 	uint16_t i;
 
+#ifdef CC_AVX512_SUPPORT
+	if (dev->flags & VIRTIO_DEV_PACKED_VEC)
+		return vhost_rx_batch_packed_check_avx(dev, vq, pkts,
+						       desc_addrs, lens);
+#endif
+
 	if (unlikely(avail_idx & PACKED_BATCH_MASK))
 		return -1;
 
@@ -3093,6 +3186,103 @@ virtio_dev_pktmbuf_prep(struct virtio_net *dev, struct rte_mbuf *pkt,
 	return -1;
 }
 
+/*
+ * Make used the guest buffers whose mbufs were freed by the application.
+ */
+static __rte_always_inline void
+vhost_zcopy_reclaim_split(struct virtio_net *dev, struct vhost_virtqueue *vq)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_zcopy *zcopy = vq->zcopy;
+	struct vhost_zcopy_buf *buf;
+	uint16_t i, head_idx, nr_pending = 0;
+
+	if (likely(rte_atomic_load_explicit(&zcopy->nr_done,
+			rte_memory_order_relaxed) == 0))
+		return;
+
+	for (i = 0; i < zcopy->nr_pending; i++) {
+		head_idx = zcopy->pending[i];
+		buf = &zcopy->bufs[head_idx];
+		if (!rte_atomic_load_explicit(&buf->done, rte_memory_order_acquire)) {
+			zcopy->pending[nr_pending++] = head_idx;
+			continue;
+		}
+
+		rte_atomic_store_explicit(&buf->done, false, rte_memory_order_relaxed);
+		buf->lent = false;
+		update_shadow_used_ring_split(vq, head_idx, 0);
+	}
+
+	zcopy->nr_pending = nr_pending;
+	if (vq->shadow_used_idx == 0)
+		return;
+
+	rte_atomic_fetch_sub_explicit(&zcopy->nr_done, vq->shadow_used_idx,
+		rte_memory_order_relaxed);
+
+	flush_shadow_used_ring_split(dev, vq);
+	vhost_vring_call_split(dev, vq);
+}
+
+/*
+ * Attach the guest buffer to the mbuf instead of copying it, when the packet
+ * data is large enough and contiguous in host memory.
+ */
+static __rte_always_inline int
+vhost_zcopy_dequeue_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
+		struct buf_vector *buf_vec, uint16_t nr_vec, uint16_t head_idx,
+		struct rte_mbuf *m, bool legacy_ol_flags)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_zcopy *zcopy = vq->zcopy;
+	struct vhost_zcopy_buf *buf = &zcopy->bufs[head_idx];
+	struct buf_vector *data;
+	uint32_t offset, data_len;
+	rte_iova_t data_iova;
+
+	/* A guest reusing a descriptor still in flight gets its data copied. */
+	if (unlikely(buf->lent))
+		return -1;
+
+	if (nr_vec == 1 && buf_vec[0].buf_len > dev->vhost_hlen) {
+		data = &buf_vec[0];
+		offset = dev->vhost_hlen;
+	} else if (nr_vec == 2 && buf_vec[0].buf_len == dev->vhost_hlen) {
+		data = &buf_vec[1];
+		offset = 0;
+	} else {
+		return -1;
+	}
+
+	data_len = data->buf_len - offset;
+	if (data_len < VHOST_ZCOPY_MIN_LEN || data_len > UINT16_MAX)
+		return -1;
+
+	data_iova = gpa_to_hpa(dev, data->buf_iova + offset, data_len);
+	if (unlikely(data_iova == 0))
+		return -1;
+
+	rte_mbuf_ext_refcnt_set(&buf->shinfo, 1);
+	rte_atomic_fetch_add_explicit(&zcopy->refcnt, 1, rte_memory_order_relaxed);
+	rte_pktmbuf_attach_extbuf(m, (void *)(uintptr_t)(data->buf_addr + offset),
+		data_iova, data_len, &buf->shinfo);
+	m->data_len = data_len;
+	m->pkt_len = data_len;
+
+	buf->lent = true;
+	zcopy->pending[zcopy->nr_pending++] = head_idx;
+
+	if (virtio_net_with_host_offload(dev))
+		vhost_dequeue_offload(dev,
+			(struct virtio_net_hdr *)(uintptr_t)buf_vec[0].buf_addr,
+			m, legacy_ol_flags);
+
+	vq->stats.zero_copy_packets++;
+
+	return 0;
+}
+
 __rte_always_inline
 static uint16_t
 virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
@@ -3103,8 +3293,12 @@ virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 {
 	uint16_t i;
 	uint16_t avail_entries;
+	uint16_t nr_zcopy = 0;
 	static bool allocerr_warned;
 
+	if (vq->zcopy != NULL)
+		vhost_zcopy_reclaim_split(dev, vq);
+
 	/*
 	 * The ordering between avail index and
 	 * desc reads needs to be enforced.
@@ -3141,6 +3335,14 @@ virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 						VHOST_ACCESS_RO) < 0))
 			break;
 
+		/* The used ring update is deferred until the mbuf is freed. */
+		if (vq->zcopy != NULL && vhost_zcopy_dequeue_split(dev, vq,
+				buf_vec, nr_vec, head_idx, pkts[i],
+				legacy_ol_flags) == 0) {
+			nr_zcopy++;
+			continue;
+		}
+
 		update_shadow_used_ring_split(vq, head_idx, 0);
 
 		if (unlikely(buf_len <= dev->vhost_hlen))
@@ -3178,12 +3380,14 @@ virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	if (unlikely(count != i))
 		rte_pktmbuf_free_bulk(&pkts[i], count - i);
 
-	if (likely(vq->shadow_used_idx)) {
-		vq->last_avail_idx += vq->shadow_used_idx;
+	if (likely(vq->shadow_used_idx || nr_zcopy)) {
+		vq->last_avail_idx += vq->shadow_used_idx + nr_zcopy;
 		vhost_virtqueue_reconnect_log_split(vq);
 		do_data_copy_dequeue(vq);
-		flush_shadow_used_ring_split(dev, vq);
-		vhost_vring_call_split(dev, vq);
+		if (vq->shadow_used_idx) {
+			flush_shadow_used_ring_split(dev, vq);
+			vhost_vring_call_split(dev, vq);
+		}
 	}
 
 	return i;
@@ -3212,21 +3416,24 @@ virtio_dev_tx_split_compliant(struct virtio_net *dev,
 }
 
 static __rte_always_inline int
-vhost_reserve_avail_batch_packed(struct virtio_net *dev,
-				 struct vhost_virtqueue *vq,
-				 struct rte_mbuf **pkts,
-				 uint16_t avail_idx,
-				 uintptr_t *desc_addrs,
-				 uint16_t *ids)
+vhost_avail_batch_packed_check(struct virtio_net *dev,
+			       struct vhost_virtqueue *vq,
+			       uint16_t avail_idx,
+			       uintptr_t *desc_addrs,
+			       uint64_t *lens,
+			       uint16_t *ids)
 	__rte_requires_shared_capability(&vq->iotlb_lock)
 {
 	bool wrap = vq->avail_wrap_counter;
 	struct vring_packed_desc *descs = vq->desc_packed;
-	uint64_t lens[PACKED_BATCH_SIZE];
-	uint64_t buf_lens[PACKED_BATCH_SIZE];
-	uint32_t buf_offset = sizeof(struct virtio_net_hdr_mrg_rxbuf);
 	uint16_t flags, i;
 
+#ifdef CC_AVX512_SUPPORT
+	if (dev->flags & VIRTIO_DEV_PACKED_VEC)
+		return vhost_tx_batch_packed_check_avx(dev, vq, avail_idx,
+				(uint64_t *)desc_addrs, lens, ids);
+#endif
+
 	if (unlikely(avail_idx & PACKED_BATCH_MASK))
 		return -1;
 	if (unlikely((avail_idx + PACKED_BATCH_SIZE) > vq->size))
@@ -3258,6 +3465,30 @@ vhost_reserve_avail_batch_packed(struct virtio_net *dev,
 			return -1;
 	}
 
+	vhost_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE)
+		ids[i] = descs[avail_idx + i].id;
+
+	return 0;
+}
+
+static __rte_always_inline int
+vhost_reserve_avail_batch_packed(struct virtio_net *dev,
+				 struct vhost_virtqueue *vq,
+				 struct rte_mbuf **pkts,
+				 uint16_t avail_idx,
+				 uintptr_t *desc_addrs,
+				 uint16_t *ids)
+	__rte_requires_shared_capability(&vq->iotlb_lock)
+{
+	uint64_t lens[PACKED_BATCH_SIZE];
+	uint64_t buf_lens[PACKED_BATCH_SIZE];
+	uint32_t buf_offset = sizeof(struct virtio_net_hdr_mrg_rxbuf);
+	uint16_t i;
+
+	if (vhost_avail_batch_packed_check(dev, vq, avail_idx, desc_addrs,
+					   lens, ids))
+		return -1;
+
 	vhost_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
 		if (virtio_dev_pktmbuf_prep(dev, pkts[i], lens[i]))
 			goto err;
@@ -3274,7 +3505,6 @@ vhost_reserve_avail_batch_packed(struct virtio_net *dev,
 	vhost_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
 		pkts[i]->pkt_len = lens[i] - buf_offset;
 		pkts[i]->data_len = pkts[i]->pkt_len;
-		ids[i] = descs[avail_idx + i].id;
 	}
 
 	return 0;
@@ -3683,6 +3913,9 @@ rte_vhost_dequeue_burst(int vid, uint16_t queue_id,
 
 	vhost_queue_stats_update(dev, vq, pkts, nb_rx);
 
+	if (unlikely(vq->adaptive.enabled))
+		vhost_adaptive_poll_update(dev, vq, nb_rx);
+
 out:
 	vhost_user_iotlb_rd_unlock(vq);
 
@@ -4312,6 +4545,9 @@ rte_vhost_async_try_dequeue_burst(int vid, uint16_t queue_id,
 	*nr_inflight = vq->async->pkts_inflight_n;
 	vhost_queue_stats_update(dev, vq, pkts, nb_rx);
 
+	if (unlikely(vq->adaptive.enabled))
+		vhost_adaptive_poll_update(dev, vq, nb_rx);
+
 out:
 	vhost_user_iotlb_rd_unlock(vq);
 
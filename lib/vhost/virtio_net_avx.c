@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 agent
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "vhost.h"
+
+#define DESC_FLAGS_LANES	0x80808080 /* 16-bit flags lane of 4 descs */
+#define DESC_LEN_ID_LANES	0x70707070 /* 16-bit len and id lanes */
+
+/* Descriptor addresses in the low half, len/id/flags qwords in the high. */
+#define DESC_QWORDS_SPLIT	_mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0)
+
+static __rte_always_inline int
+vhost_batch_flags_check_avx(__m512i v_desc, uint16_t flags_mask,
+			    bool wrap_counter)
+{
+	uint16_t expected = wrap_counter ? VRING_DESC_F_AVAIL :
+					   VRING_DESC_F_USED;
+	__m512i v_flags = _mm512_and_si512(v_desc,
+					   _mm512_set1_epi16(flags_mask));
+
+	return _mm512_mask_cmpneq_epu16_mask(DESC_FLAGS_LANES, v_flags,
+					     _mm512_set1_epi16(expected)) ? -1 : 0;
+}
+
+/*
+ * Translate the batch descriptor addresses, all at once when they are
+ * all contained in the same guest memory region. Otherwise, or when the
+ * IOMMU is in use, fall back to one translation per descriptor.
+ */
+static __rte_always_inline int
+vhost_batch_translate_avx(struct virtio_net *dev, struct vhost_virtqueue *vq,
+			  __m256i v_addr, __m256i v_len, uint64_t *desc_addrs,
+			  uint8_t perm)
+	__rte_requires_shared_capability(&vq->iotlb_lock)
+{
+	struct rte_vhost_memory *mem = dev->mem;
+	struct rte_vhost_mem_region *reg;
+	uint64_t lens[PACKED_BATCH_SIZE];
+	uint64_t addrs[PACKED_BATCH_SIZE];
+	__m256i v_end = _mm256_add_epi64(v_addr, v_len);
+	uint32_t i;
+
+	if (!(dev->features & (1ULL << VIRTIO_F_IOMMU_PLATFORM))) {
+		for (i = 0; i < mem->nregions; i++) {
+			reg = &mem->regions[i];
+			if (_mm256_cmplt_epu64_mask(v_addr,
+					_mm256_set1_epi64x(reg->guest_phys_addr)) |
+			    _mm256_cmpgt_epu64_mask(v_end,
+					_mm256_set1_epi64x(reg->guest_phys_addr +
+							   reg->size)))
+				continue;
+
+			_mm256_storeu_si256((void *)desc_addrs,
+				_mm256_add_epi64(v_addr,
+					_mm256_set1_epi64x(reg->host_user_addr -
+							   reg->guest_phys_addr)));
+			return 0;
+		}
+	}
+
+	_mm256_storeu_si256((void *)addrs, v_addr);
+	_mm256_storeu_si256((void *)lens, v_len);
+
+	vhost_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+		uint64_t len = lens[i];
+
+		desc_addrs[i] = vhost_iova_to_vva(dev, vq, addrs[i], &len,
+						  perm);
+		if (unlikely(!desc_addrs[i] || len != lens[i]))
+			return -1;
+	}
+
+	return 0;
+}
+
+int
+vhost_rx_batch_packed_check_avx(struct virtio_net *dev,
+				struct vhost_virtqueue *vq,
+				struct rte_mbuf **pkts,
+				uint64_t *desc_addrs,
+				uint64_t *lens)
+{
+	struct vring_packed_desc *descs = vq->desc_packed;
+	uint16_t avail_idx = vq->last_avail_idx;
+	uint32_t buf_offset = sizeof(struct virtio_net_hdr_mrg_rxbuf);
+	__m512i v_desc, v_split;
+	__m256i v_addr, v_len, v_need;
+
+	RTE_BUILD_BUG_ON(PACKED_BATCH_SIZE != 4);
+
+	if (unlikely(avail_idx & PACKED_BATCH_MASK))
+		return -1;
+
+	if (unlikely((avail_idx + PACKED_BATCH_SIZE) > vq->size))
+		return -1;
+
+	if (unlikely((pkts[0]->next != NULL) | (pkts[1]->next != NULL) |
+		     (pkts[2]->next != NULL) | (pkts[3]->next != NULL)))
+		return -1;
+
+	v_desc = _mm512_loadu_si512((void *)&descs[avail_idx]);
+	if (vhost_batch_flags_check_avx(v_desc,
+			VRING_DESC_F_AVAIL | VRING_DESC_F_USED,
+			vq->avail_wrap_counter))
+		return -1;
+
+	rte_atomic_thread_fence(rte_memory_order_acquire);
+
+	/* Reload now that the descriptors are known to be available. */
+	v_desc = _mm512_loadu_si512((void *)&descs[avail_idx]);
+	v_split = _mm512_permutexvar_epi64(DESC_QWORDS_SPLIT, v_desc);
+	v_addr = _mm512_castsi512_si256(v_split);
+	v_len = _mm256_and_si256(_mm512_extracti64x4_epi64(v_split, 1),
+				 _mm256_set1_epi64x(UINT32_MAX));
+
+	v_need = _mm256_set_epi64x(pkts[3]->pkt_len, pkts[2]->pkt_len,
+				   pkts[1]->pkt_len, pkts[0]->pkt_len);
+	v_need = _mm256_add_epi64(v_need, _mm256_set1_epi64x(buf_offset));
+	if (unlikely(_mm256_cmpgt_epu64_mask(v_need, v_len)))
+		return -1;
+
+	_mm256_storeu_si256((void *)lens, v_len);
+
+	return vhost_batch_translate_avx(dev, vq, v_addr, v_len, desc_addrs,
+					 VHOST_ACCESS_RW);
+}
+
+int
+vhost_tx_batch_packed_check_avx(struct virtio_net *dev,
+				struct vhost_virtqueue *vq,
+				uint16_t avail_idx,
+				uint64_t *desc_addrs,
+				uint64_t *lens,
+				uint16_t *ids)
+{
+	struct vring_packed_desc *descs = vq->desc_packed;
+	__m512i v_desc, v_split;
+	__m256i v_addr, v_hi, v_len;
+
+	RTE_BUILD_BUG_ON(PACKED_BATCH_SIZE != 4);
+
+	if (unlikely(avail_idx & PACKED_BATCH_MASK))
+		return -1;
+
+	if (unlikely((avail_idx + PACKED_BATCH_SIZE) > vq->size))
+		return -1;
+
+	v_desc = _mm512_loadu_si512((void *)&descs[avail_idx]);
+	if (vhost_batch_flags_check_avx(v_desc,
+			VRING_DESC_F_AVAIL | VRING_DESC_F_USED |
+			PACKED_DESC_SINGLE_DEQUEUE_FLAG,
+			vq->avail_wrap_counter))
+		return -1;
+
+	rte_atomic_thread_fence(rte_memory_order_acquire);
+
+	v_desc = _mm512_loadu_si512((void *)&descs[avail_idx]);
+	v_split = _mm512_permutexvar_epi64(DESC_QWORDS_SPLIT, v_desc);
+	v_addr = _mm512_castsi512_si256(v_split);
+	v_hi = _mm512_extracti64x4_epi64(v_split, 1);
+	v_len = _mm256_and_si256(v_hi, _mm256_set1_epi64x(UINT32_MAX));
+
+	_mm256_storeu_si256((void *)lens, v_len);
+	/* ids are the 16 bits following len in each descriptor */
+	_mm_storel_epi64((void *)ids,
+			 _mm256_cvtepi64_epi16(_mm256_srli_epi64(v_hi, 32)));
+
+	return vhost_batch_translate_avx(dev, vq, v_addr, v_len, desc_addrs,
+					 VHOST_ACCESS_RW);
+}
+
+void
+vhost_flush_batch_packed_avx(struct vhost_virtqueue *vq, uint64_t *lens,
+			     uint16_t *ids, uint16_t flags)
+{
+	struct vring_packed_desc *desc_base =
+		&vq->desc_packed[vq->last_used_idx];
+	uint64_t hi = (uint64_t)flags << 48;
+	__m512i v_used;
+
+	RTE_BUILD_BUG_ON(offsetof(struct vring_packed_desc, len) != 8);
+	RTE_BUILD_BUG_ON(offsetof(struct vring_packed_desc, id) != 12);
+	RTE_BUILD_BUG_ON(offsetof(struct vring_packed_desc, flags) != 14);
+
+	v_used = _mm512_set_epi64(
+		hi | (uint64_t)ids[3] << 32 | (uint32_t)lens[3], 0,
+		hi | (uint64_t)ids[2] << 32 | (uint32_t)lens[2], 0,
+		hi | (uint64_t)ids[1] << 32 | (uint32_t)lens[1], 0,
+		hi | (uint64_t)ids[0] << 32 | (uint32_t)lens[0], 0);
+
+	/* Write id and len of the whole batch before making it used. */
+	_mm512_mask_storeu_epi16((void *)desc_base, DESC_LEN_ID_LANES, v_used);
+	rte_atomic_thread_fence(rte_memory_order_release);
+	_mm512_mask_storeu_epi16((void *)desc_base, DESC_FLAGS_LANES, v_used);
+}